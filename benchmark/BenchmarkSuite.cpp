@@ -0,0 +1,188 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BenchmarkSuite.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+
+namespace benchmark
+{
+    static const char * const WORKING_SET_NAMES[] = { "L1", "L2", "DRAM" };
+    static const size_t WORKING_SET_BYTES[] = { 16 * 1024, 512 * 1024, 256 * 1024 * 1024 };
+
+    static volatile uint8_t sink;
+
+    void consume(const void * data, const size_t size)
+    {
+        const uint8_t * bytes = (const uint8_t *)data;
+
+        for (size_t i = 0; i < size; i++) {
+            sink = sink ^ bytes[i];
+        }
+    }
+
+    static double measure(Benchmark * benchmark, const uint64_t runs)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (uint64_t i = 0; i < runs; i++) {
+            benchmark->run();
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static void writeEscaped(FILE * file, const std::string & text)
+    {
+        fputc('"', file);
+
+        for (size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '"' || text[i] == '\\') {
+                fputc('\\', file);
+            }
+
+            fputc(text[i], file);
+        }
+
+        fputc('"', file);
+    }
+
+    // ================= BenchmarkOptions ================= //
+
+    BenchmarkOptions::BenchmarkOptions()
+        : minimalTime(0.25)
+    {
+        this->workingSets[L1_WORKING_SET] = true;
+        this->workingSets[L2_WORKING_SET] = true;
+        this->workingSets[DRAM_WORKING_SET] = true;
+    }
+
+    // ================= BenchmarkSuite ================= //
+
+    BenchmarkSuite::BenchmarkSuite()
+    {
+    }
+
+    BenchmarkSuite::~BenchmarkSuite()
+    {
+        for (size_t i = 0; i < this->entries.size(); i++) {
+            delete this->entries[i].benchmark;
+        }
+    }
+
+    void BenchmarkSuite::add(const std::string & name, const std::string & type, Benchmark * benchmark)
+    {
+        Entry entry;
+
+        entry.name = name;
+        entry.type = type;
+        entry.benchmark = benchmark;
+
+        this->entries.push_back(entry);
+    }
+
+    bool BenchmarkSuite::run(const BenchmarkOptions & options, std::vector<BenchmarkResult> & results)
+    {
+        printf("%-36s %-7s %-5s %12s %16s\n", "benchmark", "type", "set", "ns/item", "items/s");
+
+        for (size_t i = 0; i < this->entries.size(); i++) {
+            const Entry & entry = this->entries[i];
+
+            if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+
+            for (size_t set = 0; set < 3; set++) {
+                if (!options.workingSets[set]) {
+                    continue;
+                }
+
+                size_t count = WORKING_SET_BYTES[set] / entry.benchmark->getBytesPerItem();
+
+                if (count < 2) {
+                    count = 2;
+                }
+
+                entry.benchmark->prepare(count);
+                entry.benchmark->run();
+
+                // Calibration: grow the number of runs until it takes a tenth of the time
+                uint64_t runs = 1;
+                double time = measure(entry.benchmark, runs);
+
+                while (time < options.minimalTime / 10) {
+                    runs *= 2;
+                    time = measure(entry.benchmark, runs);
+                }
+
+                runs = (uint64_t)(runs * options.minimalTime / time) + 1;
+                time = measure(entry.benchmark, runs);
+
+                entry.benchmark->release();
+
+                BenchmarkResult result;
+
+                result.name = entry.name;
+                result.type = entry.type;
+                result.workingSet = WORKING_SET_NAMES[set];
+                result.items = count;
+                result.bytes = count * entry.benchmark->getBytesPerItem();
+                result.runs = runs;
+                result.nanosecondsPerItem = time * 1E9 / ((double)runs * count);
+                result.itemsPerSecond = (double)runs * count / time;
+
+                results.push_back(result);
+
+                printf("%-36s %-7s %-5s %12.3f %16.0f\n", result.name.c_str(), result.type.c_str(), result.workingSet.c_str(), result.nanosecondsPerItem, result.itemsPerSecond);
+                fflush(stdout);
+            }
+        }
+
+        return true;
+    }
+
+    bool BenchmarkSuite::writeJson(const char * path, const std::vector<BenchmarkResult> & results)
+    {
+        FILE * file = fopen(path, "w");
+
+        if (file == 0) {
+            return false;
+        }
+
+        fprintf(file, "{\n  \"benchmarks\": [\n");
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult & result = results[i];
+
+            fprintf(file, "    {\"name\": ");
+            writeEscaped(file, result.name);
+            fprintf(file, ", \"type\": ");
+            writeEscaped(file, result.type);
+            fprintf(file, ", \"working_set\": ");
+            writeEscaped(file, result.workingSet);
+            fprintf(file, ", \"items\": %zu, \"bytes\": %zu, \"runs\": %llu, \"ns_per_item\": %.6f, \"items_per_second\": %.1f}%s\n",
+                result.items, result.bytes, (unsigned long long)result.runs, result.nanosecondsPerItem, result.itemsPerSecond,
+                i + 1 < results.size() ? "," : "");
+        }
+
+        fprintf(file, "  ]\n}\n");
+
+        return fclose(file) == 0;
+    }
+}
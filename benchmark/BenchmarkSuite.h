@@ -0,0 +1,261 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_BENCHMARK_SUITE_H_
+#define _GEOMETRY_BENCHMARK_SUITE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+    // Working set sizes: within L1 cache, within L2 cache and far beyond caches
+    enum WorkingSet
+    {
+        L1_WORKING_SET = 0x0,
+        L2_WORKING_SET = 0x1,
+        DRAM_WORKING_SET = 0x2
+    };
+
+    class Random
+    {
+    public:
+        inline Random(const uint64_t seed = 0x9E3779B97F4A7C15ull) : state(seed)
+        {
+        }
+
+        inline uint64_t next()
+        {
+            this->state ^= this->state << 13;
+            this->state ^= this->state >> 7;
+            this->state ^= this->state << 17;
+            return this->state;
+        }
+
+        // Uniform value within [minimum, maximum)
+        inline double uniform(const double minimum, const double maximum)
+        {
+            return minimum + (maximum - minimum) * (double)(this->next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    // A benchmark processes count items per run, prepare() allocates and fills
+    // the data, run() must not allocate memory
+    class Benchmark
+    {
+    public:
+        virtual ~Benchmark()
+        {
+        }
+
+        virtual size_t getBytesPerItem() const = 0;
+        virtual void prepare(const size_t count) = 0;
+        virtual void run() = 0;
+        virtual void release() = 0;
+    };
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        std::string type;
+        std::string workingSet;
+        size_t items;
+        size_t bytes;
+        uint64_t runs;
+        double nanosecondsPerItem;
+        double itemsPerSecond;
+    };
+
+    struct BenchmarkOptions
+    {
+        std::string filter;
+        std::string jsonPath;
+        double minimalTime;
+        bool workingSets[3];
+
+        BenchmarkOptions();
+    };
+
+    class BenchmarkSuite
+    {
+    public:
+        BenchmarkSuite();
+        virtual ~BenchmarkSuite();
+
+        // The suite owns the benchmark
+        void add(const std::string & name, const std::string & type, Benchmark * benchmark);
+
+        bool run(const BenchmarkOptions & options, std::vector<BenchmarkResult> & results);
+
+        static bool writeJson(const char * path, const std::vector<BenchmarkResult> & results);
+
+    private:
+        struct Entry
+        {
+            std::string name;
+            std::string type;
+            Benchmark * benchmark;
+        };
+
+        std::vector<Entry> entries;
+
+        BenchmarkSuite(const BenchmarkSuite &);
+        BenchmarkSuite & operator=(const BenchmarkSuite &);
+    };
+
+    // Keeps the compiler from dropping computations whose results are unused
+    void consume(const void * data, const size_t size);
+
+    // =============== Benchmark templates =============== //
+
+    // Applies operation(item, neighbour) to every item, where the neighbour is
+    // the next item of the pair, and stores the results
+    template<class Input, class Output, class Generator, class Operation> class MapBenchmark : public Benchmark
+    {
+    public:
+        MapBenchmark(const Generator & generator, const Operation & operation)
+            : generator(generator), operation(operation)
+        {
+        }
+
+        virtual size_t getBytesPerItem() const
+        {
+            return sizeof(Input) + sizeof(Output);
+        }
+
+        virtual void prepare(const size_t count)
+        {
+            Random random;
+            size_t evenCount = (count + 1) & ~(size_t)1;
+
+            this->inputs.clear();
+            this->inputs.reserve(evenCount);
+
+            for (size_t i = 0; i < evenCount; i++) {
+                this->inputs.push_back(this->generator(random));
+            }
+
+            this->outputs.assign(evenCount, Output());
+        }
+
+        virtual void run()
+        {
+            const size_t count = this->inputs.size();
+            const Input * inputs = this->inputs.data();
+            Output * outputs = this->outputs.data();
+
+            for (size_t i = 0; i < count; i++) {
+                outputs[i] = this->operation(inputs[i], inputs[i ^ 1]);
+            }
+
+            consume(outputs, sizeof(Output));
+        }
+
+        virtual void release()
+        {
+            std::vector<Input>().swap(this->inputs);
+            std::vector<Output>().swap(this->outputs);
+        }
+
+    private:
+        Generator generator;
+        Operation operation;
+        std::vector<Input> inputs;
+        std::vector<Output> outputs;
+    };
+
+    // Default side buffer sizer of a batch benchmark, the kernel keeps none
+    struct NoSideBuffers
+    {
+        void operator()(const size_t) const
+        {
+        }
+    };
+
+    // Calls a bulk kernel kernel(inputs, outputs, count) once per run, the
+    // buffers the kernel keeps on the side are sized by sizer(count) in prepare()
+    template<class Input, class Output, class Generator, class Kernel, class Sizer = NoSideBuffers> class BatchBenchmark : public Benchmark
+    {
+    public:
+        BatchBenchmark(const Generator & generator, const Kernel & kernel, const size_t outputsPerItem = 1, const Sizer & sizer = Sizer())
+            : generator(generator), kernel(kernel), sizer(sizer), outputsPerItem(outputsPerItem)
+        {
+        }
+
+        virtual size_t getBytesPerItem() const
+        {
+            return sizeof(Input) + sizeof(Output) * this->outputsPerItem;
+        }
+
+        virtual void prepare(const size_t count)
+        {
+            Random random;
+
+            this->inputs.clear();
+            this->inputs.reserve(count);
+
+            for (size_t i = 0; i < count; i++) {
+                this->inputs.push_back(this->generator(random));
+            }
+
+            this->outputs.assign(count * this->outputsPerItem, Output());
+            this->sizer(count);
+        }
+
+        virtual void run()
+        {
+            this->kernel(this->inputs.data(), this->outputs.data(), this->inputs.size());
+            consume(this->outputs.data(), sizeof(Output));
+        }
+
+        virtual void release()
+        {
+            std::vector<Input>().swap(this->inputs);
+            std::vector<Output>().swap(this->outputs);
+        }
+
+    private:
+        Generator generator;
+        Kernel kernel;
+        Sizer sizer;
+        size_t outputsPerItem;
+        std::vector<Input> inputs;
+        std::vector<Output> outputs;
+    };
+
+    template<class Input, class Output, class Generator, class Operation> Benchmark * makeMapBenchmark(const Generator & generator, const Operation & operation)
+    {
+        return new MapBenchmark<Input, Output, Generator, Operation>(generator, operation);
+    }
+
+    template<class Input, class Output, class Generator, class Kernel> Benchmark * makeBatchBenchmark(const Generator & generator, const Kernel & kernel, const size_t outputsPerItem = 1)
+    {
+        return new BatchBenchmark<Input, Output, Generator, Kernel>(generator, kernel, outputsPerItem);
+    }
+
+    template<class Input, class Output, class Generator, class Kernel, class Sizer> Benchmark * makeBatchBenchmark(const Generator & generator, const Kernel & kernel, const size_t outputsPerItem, const Sizer & sizer)
+    {
+        return new BatchBenchmark<Input, Output, Generator, Kernel, Sizer>(generator, kernel, outputsPerItem, sizer);
+    }
+}
+
+#endif /* _GEOMETRY_BENCHMARK_SUITE_H_ */
@@ -0,0 +1,603 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+
+#include "BenchmarkSuite.h"
+
+#include "../src/Angle.h"
+#include "../src/AngleBatch.h"
+#include "../src/Profiler.h"
+#include "../src/Quaternion.h"
+#include "../src/Vector.h"
+#include "../src/Matrix.h"
+#include "../src/planimetry/Vector2.h"
+#include "../src/planimetry/Matrix2x2.h"
+#include "../src/planimetry/Triangle2.h"
+#include "../src/planimetry/TriangleEdges2.h"
+#include "../src/planimetry/Rasterizer2F.h"
+#include "../src/planimetry/Converter2F.h"
+#include "../src/stereometry/Vector3.h"
+#include "../src/stereometry/Matrix3x3.h"
+#include "../src/stereometry/Matrix3x3Decomposition.h"
+#include "../src/stereometry/Triangle3.h"
+#include "../src/stereometry/Converter3F.h"
+#include "../src/stereometry/AxisBox3.h"
+#include "../src/stereometry/Projection3F.h"
+#include "../src/stereometry/OcclusionCuller3F.h"
+#include "../src/stereometry/Frustum3F.h"
+#include "../src/stereometry/ConvexShape3.h"
+#include "../src/stereometry/Gjk3.h"
+#include "../src/stereometry/TriangleIntersection3.h"
+#include "../src/stereometry/TriangleTree3F.h"
+#include "../src/stereometry/ClosestPoint3.h"
+#include "../src/stereometry/SignedDistanceField3F.h"
+#include "../src/stereometry/IsoSurface3F.h"
+#include "../src/stereometry/PointTree3F.h"
+#include "../src/stereometry/PointRegistration3F.h"
+
+using namespace benchmark;
+using namespace geometry;
+using namespace geometry::planimetry;
+using namespace geometry::stereometry;
+
+// ================= Planimetry ================= //
+
+template<class VectorType, typename FloatType> static VectorType generateVector2(Random & random)
+{
+    return VectorType((FloatType)random.uniform(-100.0, 100.0), (FloatType)random.uniform(-100.0, 100.0));
+}
+
+template<class VectorType, class MatrixType, class TriangleType, typename FloatType> static void addPlanimetryBenchmarks(BenchmarkSuite & suite, const char * type)
+{
+    auto vector = [](Random & random) { return generateVector2<VectorType, FloatType>(random); };
+
+    auto matrix = [](Random & random) {
+        MatrixType matrix;
+        matrix.r1c1 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r1c2 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r2c1 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r2c2 = (FloatType)random.uniform(-2.0, 2.0);
+        return matrix;
+    };
+
+    auto triangle = [](Random & random) {
+        return TriangleType(generateVector2<VectorType, FloatType>(random), generateVector2<VectorType, FloatType>(random), generateVector2<VectorType, FloatType>(random));
+    };
+
+    suite.add("vector2.add", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a + b; }));
+
+    suite.add("vector2.scalar", type, makeMapBenchmark<VectorType, FloatType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a.scalar(b); }));
+
+    suite.add("vector2.module", type, makeMapBenchmark<VectorType, FloatType>(vector,
+        [](const VectorType & a, const VectorType &) { return a.module(); }));
+
+    suite.add("vector2.normalize", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType &) { VectorType result(a); result.normalize(); return result; }));
+
+    suite.add("matrix2x2.multiply", type, makeMapBenchmark<MatrixType, MatrixType>(matrix,
+        [](const MatrixType & a, const MatrixType & b) { return a * b; }));
+
+    suite.add("matrix2x2.determinant", type, makeMapBenchmark<MatrixType, FloatType>(matrix,
+        [](const MatrixType & a, const MatrixType &) { return a.determinant(); }));
+
+    suite.add("triangle2.square", type, makeMapBenchmark<TriangleType, FloatType>(triangle,
+        [](const TriangleType & a, const TriangleType &) { return a.square(); }));
+
+    const TriangleEdges2Template<FloatType> edges(TriangleType(-80, -90, 95, -10, -20, 85));
+
+    suite.add("triangle2.batch.contain", type, makeBatchBenchmark<VectorType, uint8bit>(vector,
+        [edges](const VectorType * points, uint8bit * outputs, const size_t count) { containPoints(edges, points, outputs, count); }));
+
+    suite.add("triangle2.batch.barycentric", type, makeBatchBenchmark<VectorType, FloatType>(vector,
+        [edges](const VectorType * points, FloatType * outputs, const size_t count) { getBarycentric(edges, points, outputs, outputs + count, outputs + count * 2, 0, count); }, 3));
+}
+
+// ================= Stereometry ================= //
+
+template<class VectorType, typename FloatType> static VectorType generateVector3(Random & random)
+{
+    return VectorType((FloatType)random.uniform(-100.0, 100.0), (FloatType)random.uniform(-100.0, 100.0), (FloatType)random.uniform(-100.0, 100.0));
+}
+
+template<class VectorType, class MatrixType, class TriangleType, typename FloatType> static void addStereometryBenchmarks(BenchmarkSuite & suite, const char * type)
+{
+    auto vector = [](Random & random) { return generateVector3<VectorType, FloatType>(random); };
+
+    auto matrix = [](Random & random) {
+        MatrixType matrix;
+        matrix.r1c1 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r1c2 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r1c3 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r2c1 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r2c2 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r2c3 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r3c1 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r3c2 = (FloatType)random.uniform(-2.0, 2.0);
+        matrix.r3c3 = (FloatType)random.uniform(-2.0, 2.0);
+        return matrix;
+    };
+
+    auto triangle = [](Random & random) {
+        return TriangleType(generateVector3<VectorType, FloatType>(random), generateVector3<VectorType, FloatType>(random), generateVector3<VectorType, FloatType>(random));
+    };
+
+    suite.add("vector3.add", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a + b; }));
+
+    suite.add("vector3.scalar", type, makeMapBenchmark<VectorType, FloatType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a.scalar(b); }));
+
+    suite.add("vector3.vector", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a.vector(b); }));
+
+    suite.add("vector3.module", type, makeMapBenchmark<VectorType, FloatType>(vector,
+        [](const VectorType & a, const VectorType &) { return a.module(); }));
+
+    suite.add("vector3.normalize", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType &) { VectorType result(a); result.normalize(); return result; }));
+
+    suite.add("matrix3x3.multiply", type, makeMapBenchmark<MatrixType, MatrixType>(matrix,
+        [](const MatrixType & a, const MatrixType & b) { return a * b; }));
+
+    suite.add("matrix3x3.determinant", type, makeMapBenchmark<MatrixType, FloatType>(matrix,
+        [](const MatrixType & a, const MatrixType &) { return a.determinant(); }));
+
+    // Only the upper triangle is read, so any matrix is taken as a symmetric one
+    std::shared_ptr<std::vector<VectorType>> values(new std::vector<VectorType>());
+
+    auto sizeValues = [values](const size_t count) { values->assign(count, VectorType()); };
+
+    suite.add("matrix3x3.batch.eigen", type, makeBatchBenchmark<MatrixType, MatrixType>(matrix,
+        [values](const MatrixType * matrices, MatrixType * outputs, const size_t count) {
+            decomposeSymmetric(matrices, values->data(), outputs, count);
+        }, 1, sizeValues));
+
+    suite.add("matrix3x3.batch.svd", type, makeBatchBenchmark<MatrixType, MatrixType>(matrix,
+        [values](const MatrixType * matrices, MatrixType * outputs, const size_t count) {
+            decomposeSingularValues(matrices, outputs, values->data(), outputs + count, count);
+        }, 2, sizeValues));
+
+    suite.add("triangle3.square", type, makeMapBenchmark<TriangleType, FloatType>(triangle,
+        [](const TriangleType & a, const TriangleType &) { return a.square(); }));
+
+    suite.add("triangle3.intersect", type, makeMapBenchmark<TriangleType, uint8bit>(triangle,
+        [](const TriangleType & a, const TriangleType & b) { return (uint8bit)intersectTriangles(a, b); }));
+}
+
+// ================= Rasterizer ================= //
+
+static void addRasterizerBenchmarks(BenchmarkSuite & suite)
+{
+    std::shared_ptr<Rasterizer2F> rasterizer(new Rasterizer2F());
+    std::shared_ptr<RasterBuffer2F> buffer(new RasterBuffer2F());
+    buffer->setSize(1024, 1024);
+
+    // Triangles of about four pixels all over the buffer
+    auto triangle = [](Random & random) {
+        const float x = (float)random.uniform(0.0, 1020.0);
+        const float y = (float)random.uniform(0.0, 1020.0);
+
+        return Triangle2F(x, y, x + (float)random.uniform(0.0, 4.0), y + (float)random.uniform(-1.0, 1.0), x + (float)random.uniform(-1.0, 1.0), y + (float)random.uniform(0.0, 4.0));
+    };
+
+    suite.add("rasterizer.coverage", "float", makeBatchBenchmark<Triangle2F, uint8bit>(triangle,
+        [rasterizer, buffer](const Triangle2F * triangles, uint8bit * outputs, const size_t count) {
+            rasterizer->rasterize(triangles, 0, 0, count, *buffer);
+            outputs[0] = buffer->coverage[0];
+        }));
+}
+
+// ================= Culling ================= //
+
+static void addCullingBenchmarks(BenchmarkSuite & suite)
+{
+    Converter3F view;
+    view.setToIdentity();
+
+    const Matrix4x4F viewProjection = makeViewProjection(makePerspectiveProjection(AngleF(60.0f, DEGREES), 2.0f, 0.5f, 500.0f), view);
+
+    // A wall hiding the middle of the screen in front of the boxes
+    std::vector<Triangle3F> occluders;
+    occluders.push_back(Triangle3F(Vector3F(-10.0f, -6.0f, 20.0f), Vector3F(10.0f, -6.0f, 20.0f), Vector3F(10.0f, 6.0f, 20.0f)));
+    occluders.push_back(Triangle3F(Vector3F(-10.0f, -6.0f, 20.0f), Vector3F(10.0f, 6.0f, 20.0f), Vector3F(-10.0f, 6.0f, 20.0f)));
+
+    // Boxes all around the camera, about a tenth of them in the view
+    auto anyBox = [](Random & random) {
+        const Vector3F minimum((float)random.uniform(-200.0, 200.0), (float)random.uniform(-200.0, 200.0), (float)random.uniform(-200.0, 200.0));
+        const float size = (float)random.uniform(0.5, 4.0);
+
+        return AxisBox3F(minimum, Vector3F(minimum.x + size, minimum.y + size, minimum.z + size));
+    };
+
+    const Frustum3F frustum(viewProjection);
+
+    suite.add("frustum.boxes", "float", makeBatchBenchmark<AxisBox3F, uint8bit>(anyBox,
+        [frustum](const AxisBox3F * boxes, uint8bit * results, const size_t count) {
+            frustum.testBoxes(boxes, results, count);
+        }));
+
+    std::shared_ptr<std::vector<uint8bit> > lastPlanes(new std::vector<uint8bit>());
+
+    suite.add("frustum.boxes.coherent", "float", makeBatchBenchmark<AxisBox3F, uint8bit>(anyBox,
+        [frustum, lastPlanes](const AxisBox3F * boxes, uint8bit * results, const size_t count) {
+            frustum.testBoxes(boxes, results, count, &(*lastPlanes)[0]);
+        }, 1, [lastPlanes](const size_t count) { lastPlanes->assign(count, 0); }));
+
+    std::shared_ptr<std::vector<float> > radii(new std::vector<float>());
+
+    suite.add("frustum.spheres", "float", makeBatchBenchmark<Vector3F, uint8bit>(
+        [](Random & random) { return Vector3F((float)random.uniform(-200.0, 200.0), (float)random.uniform(-200.0, 200.0), (float)random.uniform(-200.0, 200.0)); },
+        [frustum, radii](const Vector3F * centres, uint8bit * results, const size_t count) {
+            frustum.testSpheres(centres, &(*radii)[0], results, count);
+        }, 1, [radii](const size_t count) { radii->assign(count, 2.0f); }));
+
+    std::shared_ptr<OcclusionCuller3F> culler(new OcclusionCuller3F());
+    culler->setSize(256, 128);
+    culler->beginFrame(viewProjection);
+    culler->addOccluders(&occluders[0], occluders.size());
+    culler->buildHierarchy();
+
+    auto box = [](Random & random) {
+        const Vector3F minimum((float)random.uniform(-60.0, 60.0), (float)random.uniform(-30.0, 30.0), (float)random.uniform(25.0, 100.0));
+        const float size = (float)random.uniform(0.5, 4.0);
+
+        return AxisBox3F(minimum, Vector3F(minimum.x + size, minimum.y + size, minimum.z + size));
+    };
+
+    suite.add("occlusion.boxes", "float", makeBatchBenchmark<AxisBox3F, uint8bit>(box,
+        [culler](const AxisBox3F * boxes, uint8bit * visible, const size_t count) {
+            culler->testBoxes(boxes, visible, count);
+        }));
+}
+
+// ================= Collision ================= //
+
+static void addCollisionBenchmarks(BenchmarkSuite & suite)
+{
+    const uint32bit SHAPE_COUNT = 1024;
+    const uint32bit HULL_POINT_COUNT = 32;
+
+    // Hulls of random points near each other, about half of the pairs touch
+    Random random(7);
+    std::shared_ptr<std::vector<Vector3F> > points(new std::vector<Vector3F>(SHAPE_COUNT * HULL_POINT_COUNT));
+    std::shared_ptr<std::vector<ConvexShape3F> > shapes(new std::vector<ConvexShape3F>(SHAPE_COUNT));
+
+    for (uint32bit i = 0; i < SHAPE_COUNT; i++) {
+        const Vector3F centre((float)random.uniform(-1.0, 1.0), (float)random.uniform(-1.0, 1.0), (float)random.uniform(-1.0, 1.0));
+        Vector3F * hull = &(*points)[i * HULL_POINT_COUNT];
+
+        for (uint32bit k = 0; k < HULL_POINT_COUNT; k++) {
+            hull[k] = centre + Vector3F((float)random.uniform(-0.5, 0.5), (float)random.uniform(-0.5, 0.5), (float)random.uniform(-0.5, 0.5));
+        }
+
+        (*shapes)[i] = ConvexShape3F::makeHull(hull, HULL_POINT_COUNT);
+    }
+
+    auto pair = [SHAPE_COUNT](Random & random) {
+        SweepPair3F result;
+        result.first = (uint32bit)random.uniform(0.0, SHAPE_COUNT - 1.0);
+        result.second = result.first + 1 + (uint32bit)random.uniform(0.0, SHAPE_COUNT - result.first - 1.0);
+
+        return result;
+    };
+
+    suite.add("gjk.contacts", "float", makeBatchBenchmark<SweepPair3F, ConvexContact3F>(pair,
+        [points, shapes](const SweepPair3F * pairs, ConvexContact3F * contacts, const size_t count) {
+            computeContacts(&(*shapes)[0], pairs, contacts, 0, count);
+        }));
+}
+
+// ================= Closest points ================= //
+
+static void addClosestPointBenchmarks(BenchmarkSuite & suite)
+{
+    auto point = [](Random & random) { return Vector3F((float)random.uniform(-2.0, 2.0), (float)random.uniform(-2.0, 2.0), (float)random.uniform(-2.0, 2.0)); };
+
+    const Triangle3F triangle(Vector3F(-1.0f, -1.0f, 0.0f), Vector3F(1.0f, -0.5f, 0.2f), Vector3F(0.0f, 1.0f, -0.3f));
+
+    suite.add("closest.triangle", "float", makeBatchBenchmark<Vector3F, Vector3F>(point,
+        [triangle](const Vector3F * points, Vector3F * results, const size_t count) {
+            findClosestPoints(triangle, points, results, count);
+        }));
+
+    // A sphere of about 80 thousand triangles, queried near its surface
+    const uint32bit RINGS = 200;
+    const uint32bit SEGMENTS = 200;
+
+    std::shared_ptr<IndexedMesh3F> mesh(new IndexedMesh3F());
+
+    for (uint32bit ring = 0; ring <= RINGS; ring++) {
+        const float latitude = 3.14159265f * ring / RINGS;
+
+        for (uint32bit segment = 0; segment < SEGMENTS; segment++) {
+            const float longitude = 6.28318531f * segment / SEGMENTS;
+
+            mesh->vertices.push_back(Vector3F(sinf(latitude) * cosf(longitude), sinf(latitude) * sinf(longitude), cosf(latitude)));
+        }
+    }
+
+    for (uint32bit ring = 0; ring < RINGS; ring++) {
+        for (uint32bit segment = 0; segment < SEGMENTS; segment++) {
+            const uint32bit a = ring * SEGMENTS + segment;
+            const uint32bit b = ring * SEGMENTS + (segment + 1) % SEGMENTS;
+            const uint32bit indices[6] = { a, a + SEGMENTS, b, b, a + SEGMENTS, b + SEGMENTS };
+
+            mesh->indices.insert(mesh->indices.end(), indices, indices + 6);
+        }
+    }
+
+    std::shared_ptr<TriangleTree3F> tree(new TriangleTree3F());
+    tree->build(*mesh);
+
+    auto nearPoint = [](Random & random) {
+        Vector3F direction((float)random.uniform(-1.0, 1.0), (float)random.uniform(-1.0, 1.0), (float)random.uniform(-1.0, 1.0));
+        direction.normalize();
+
+        return direction * (float)random.uniform(0.9, 1.1);
+    };
+
+    suite.add("closest.mesh", "float", makeBatchBenchmark<Vector3F, ClosestMeshPoint3F>(nearPoint,
+        [mesh, tree](const Vector3F * points, ClosestMeshPoint3F * results, const size_t count) {
+            findClosestPoints(*mesh, *tree, points, results, count);
+        }));
+
+    // The vertices of the sphere as a cloud of 40 thousand points
+    std::shared_ptr<PointTree3F> cloudTree(new PointTree3F());
+    cloudTree->build(mesh->vertices.data(), mesh->vertices.size());
+
+    suite.add("point_tree.nearest", "float", makeBatchBenchmark<Vector3F, NearestPoint3F>(nearPoint,
+        [cloudTree](const Vector3F * points, NearestPoint3F * results, const size_t count) {
+            cloudTree->findNearest(points, results, count);
+        }));
+
+    suite.add("registration.normals", "float", makeBatchBenchmark<Vector3F, Vector3F>(nearPoint,
+        [mesh, cloudTree](const Vector3F * points, Vector3F * results, const size_t count) {
+            estimateNormals(*cloudTree, mesh->vertices.data(), points, results, count);
+        }));
+
+    // The points are moved by a fixed rigid transform and then aligned back
+    Converter3F motion;
+    motion.warp = Matrix3x3F(0.936f, -0.275f, 0.218f, 0.289f, 0.956f, -0.036f, -0.199f, 0.097f, 0.975f);
+    motion.shift.setValues(0.5f, -0.25f, 1.0f);
+
+    suite.add("registration.rigid", "float", makeBatchBenchmark<Vector3F, Vector3F>(point,
+        [motion](const Vector3F * points, Vector3F * results, const size_t count) {
+            motion.convert(points, results, count);
+
+            Converter3F transform;
+            findRigidTransform(points, results, count, transform);
+        }));
+
+    std::shared_ptr<SignedDistanceField3F> field(new SignedDistanceField3F());
+    field->build(*mesh, *tree, Vector3F(-1.25f, -1.25f, -1.25f), 2.5f / 95.0f, 96, 96, 96, 2.0f * 2.5f / 95.0f);
+
+    suite.add("sdf.sample", "float", makeMapBenchmark<Vector3F, float>(nearPoint,
+        [field](const Vector3F & a, const Vector3F &) { return field->sample(a); }));
+
+    // The inputs are the slices of a noisy field, 16 by 16 voxels each, about one in twenty inside
+    std::shared_ptr<IndexedMesh3F> surface(new IndexedMesh3F());
+
+    suite.add("iso_surface.extract", "float", makeBatchBenchmark<float, float>(
+        [](Random & random) { return (float)random.uniform(-0.05, 1.0); },
+        [surface](const float * values, float * results, const size_t count) {
+            const uint32bit slices = (uint32bit)(count / 256);
+
+            if (slices >= 2 && extractIsoSurface(values, 16, 16, slices, Vector3F(0.0f, 0.0f, 0.0f), 1.0f, 0.0f, *surface)) {
+                results[0] = (float)surface->indices.size();
+            }
+        }));
+}
+
+// ================= Converters ================= //
+
+static void addConverterBenchmarks(BenchmarkSuite & suite)
+{
+    Converter2F converter2;
+    converter2.buildConvesion(AngleF(30.0f, DEGREES), Vector2F(1.0f, -2.0f));
+
+    suite.add("converter2.convert", "float", makeMapBenchmark<Vector2F, Vector2F>(
+        [](Random & random) { return generateVector2<Vector2F, float>(random); },
+        [converter2](const Vector2F & a, const Vector2F &) { return converter2.convert(a); }));
+
+    Converter3F converter3;
+    converter3.warp.r1c2 = 0.5f;
+    converter3.warp.r2c3 = -0.25f;
+    converter3.shift.setValues(1.0f, 2.0f, 3.0f);
+
+    suite.add("converter3.convert", "float", makeMapBenchmark<Vector3F, Vector3F>(
+        [](Random & random) { return generateVector3<Vector3F, float>(random); },
+        [converter3](const Vector3F & a, const Vector3F &) { return converter3.convert(a); }));
+}
+
+// ================= Angles and quaternions ================= //
+
+template<class AngleType, class QuaternionType, typename FloatType> static void addAngleBenchmarks(BenchmarkSuite & suite, const char * type)
+{
+    auto angle = [](Random & random) { return AngleType((FloatType)random.uniform(-10.0, 10.0)); };
+    auto radians = [](Random & random) { return (FloatType)random.uniform(-10.0, 10.0); };
+
+    auto quaternion = [](Random & random) {
+        return QuaternionType((FloatType)random.uniform(-1.0, 1.0), (FloatType)random.uniform(-1.0, 1.0), (FloatType)random.uniform(-1.0, 1.0), (FloatType)random.uniform(-1.0, 1.0));
+    };
+
+    suite.add("angle.cos", type, makeMapBenchmark<AngleType, FloatType>(angle,
+        [](const AngleType & a, const AngleType &) { return a.cos(); }));
+
+    suite.add("angle.sin", type, makeMapBenchmark<AngleType, FloatType>(angle,
+        [](const AngleType & a, const AngleType &) { return a.sin(); }));
+
+    suite.add("angle.sincos", type, makeMapBenchmark<AngleType, FloatType>(angle,
+        [](const AngleType & a, const AngleType &) { FloatType sine, cosine; a.sincos(sine, cosine); return sine + cosine; }));
+
+    suite.add("angle.batch.sincos", type, makeBatchBenchmark<AngleType, FloatType>(angle,
+        [](const AngleType * angles, FloatType * outputs, const size_t count) { sincos(angles, outputs, outputs + count, count); }, 2));
+
+    suite.add("radians.batch.sincos", type, makeBatchBenchmark<FloatType, FloatType>(radians,
+        [](const FloatType * values, FloatType * outputs, const size_t count) { sincos(values, outputs, outputs + count, count); }, 2));
+
+    suite.add("radians.batch.sincos.fast", type, makeBatchBenchmark<FloatType, FloatType>(radians,
+        [](const FloatType * values, FloatType * outputs, const size_t count) { sincos(values, outputs, outputs + count, count, FAST_TRIGONOMETRY); }, 2));
+
+    suite.add("radians.batch.normalize", type, makeBatchBenchmark<FloatType, FloatType>(radians,
+        [](const FloatType * values, FloatType * outputs, const size_t count) { normalizeAngles(values, outputs, count, SIGNED_RANGE); }));
+
+    suite.add("degrees.batch.convert", type, makeBatchBenchmark<FloatType, FloatType>(radians,
+        [](const FloatType * values, FloatType * outputs, const size_t count) { convertAngles(values, outputs, count, DEGREES, RADIANS); }));
+
+    suite.add("quaternion.normalize", type, makeMapBenchmark<QuaternionType, QuaternionType>(quaternion,
+        [](const QuaternionType & a, const QuaternionType &) { QuaternionType result(a); result.normalize(); return result; }));
+}
+
+// ================= Generic vectors and matrices ================= //
+
+template<typename FloatType> static void addGenericBenchmarks(BenchmarkSuite & suite, const char * type)
+{
+    typedef Vector<FloatType, 4> VectorType;
+    typedef Matrix<FloatType, 4, 4> MatrixType;
+
+    auto vector = [](Random & random) {
+        VectorType vector;
+
+        for (uint32bit i = 0; i < 4; i++) {
+            vector[i] = (FloatType)random.uniform(-100.0, 100.0);
+        }
+
+        return vector;
+    };
+
+    auto matrix = [](Random & random) {
+        MatrixType matrix;
+
+        for (uint32bit i = 0; i < 4; i++) {
+            for (uint32bit j = 0; j < 4; j++) {
+                matrix(i, j) = (FloatType)random.uniform(-2.0, 2.0);
+            }
+        }
+
+        return matrix;
+    };
+
+    suite.add("vector4.add", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a + b; }));
+
+    suite.add("vector4.scalar", type, makeMapBenchmark<VectorType, FloatType>(vector,
+        [](const VectorType & a, const VectorType & b) { return a.scalar(b); }));
+
+    suite.add("vector4.normalize", type, makeMapBenchmark<VectorType, VectorType>(vector,
+        [](const VectorType & a, const VectorType &) { VectorType result(a); result.normalize(); return result; }));
+
+    suite.add("matrix4x4.multiply", type, makeMapBenchmark<MatrixType, MatrixType>(matrix,
+        [](const MatrixType & a, const MatrixType & b) { return a * b; }));
+
+    suite.add("matrix4x4.vector", type, makeMapBenchmark<MatrixType, VectorType>(matrix,
+        [](const MatrixType & a, const MatrixType & b) { return a * b.row(0); }));
+
+    suite.add("matrix4x4.determinant", type, makeMapBenchmark<MatrixType, FloatType>(matrix,
+        [](const MatrixType & a, const MatrixType &) { return a.determinant(); }));
+}
+
+// ================= Entry point ================= //
+
+static void printUsage(const char * program)
+{
+    printf("Usage: %s [--filter text] [--json path] [--min-time seconds] [--sets l1,l2,dram]\n", program);
+}
+
+static bool parseOptions(const int argc, char ** argv, BenchmarkOptions & options)
+{
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--filter") == 0) {
+            options.filter = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--json") == 0) {
+            options.jsonPath = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--min-time") == 0) {
+            options.minimalTime = atof(argv[++i]);
+
+            if (!(options.minimalTime > 0.0)) {
+                return false;
+            }
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--sets") == 0) {
+            const char * sets = argv[++i];
+
+            options.workingSets[L1_WORKING_SET] = strstr(sets, "l1") != 0;
+            options.workingSets[L2_WORKING_SET] = strstr(sets, "l2") != 0;
+            options.workingSets[DRAM_WORKING_SET] = strstr(sets, "dram") != 0;
+        }
+        else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char ** argv)
+{
+    BenchmarkOptions options;
+
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    BenchmarkSuite suite;
+
+    addPlanimetryBenchmarks<Vector2F, Matrix2x2F, Triangle2F, float>(suite, "float");
+    addPlanimetryBenchmarks<Vector2, Matrix2x2, Triangle2, double>(suite, "double");
+
+    addStereometryBenchmarks<Vector3F, Matrix3x3F, Triangle3F, float>(suite, "float");
+    addStereometryBenchmarks<Vector3, Matrix3x3, Triangle3, double>(suite, "double");
+
+    addGenericBenchmarks<float>(suite, "float");
+    addGenericBenchmarks<double>(suite, "double");
+
+    addConverterBenchmarks(suite);
+    addRasterizerBenchmarks(suite);
+    addCullingBenchmarks(suite);
+    addCollisionBenchmarks(suite);
+    addClosestPointBenchmarks(suite);
+
+    addAngleBenchmarks<AngleF, QuaternionF, float>(suite, "float");
+    addAngleBenchmarks<Angle, Quaternion, double>(suite, "double");
+
+    std::vector<BenchmarkResult> results;
+
+    if (!suite.run(options, results)) {
+        return 1;
+    }
+
+    if (!options.jsonPath.empty() && !BenchmarkSuite::writeJson(options.jsonPath.c_str(), results)) {
+        fprintf(stderr, "Cannot write %s\n", options.jsonPath.c_str());
+        return 1;
+    }
+
+#ifdef GEOMETRY_PROFILING
+    printf("\n");
+    Profiler::dump();
+#endif
+
+    return 0;
+}
@@ -19,6 +19,9 @@
 
 #include <math.h>
 
+#include "constants.h"
+#include "Trigonometry.h"
+
 namespace geometry
 {
     enum AngleScale
@@ -28,70 +31,93 @@ namespace geometry
         GRADIANS = 0x2
     };
 
+    enum AngleRange
+    {
+        // [0, full turn)
+        UNSIGNED_RANGE = 0x0,
+        // (-half turn, half turn]
+        SIGNED_RANGE = 0x1
+    };
+
     // =================== AngleTemplate header =================== //
 
     template<typename FloatType> class AngleTemplate
     {
     public:
-        static const FloatType ZERO;
+        static constexpr FloatType ZERO = FloatConstants<FloatType>::ZERO;
 
-        static const FloatType DEGREES_IN_RADIAN;
-        static const FloatType GRADIANS_IN_RADIAN;
-        static const FloatType DEGREES_IN_GRADIAN;
+        static constexpr FloatType DEGREES_IN_RADIAN = FloatType(57.2957795130823209);
+        static constexpr FloatType GRADIANS_IN_RADIAN = FloatType(63.6619772367581343);
+        static constexpr FloatType DEGREES_IN_GRADIAN = FloatType(0.9);
 
-        virtual ~AngleTemplate()
-        {
-        }
+        static constexpr FloatType RADIANS_IN_TURN = FloatType(6.28318530717958648);
+        static constexpr FloatType DEGREES_IN_TURN = FloatType(360.0);
+        static constexpr FloatType GRADIANS_IN_TURN = FloatType(400.0);
+
+        constexpr AngleTemplate();
+        constexpr AngleTemplate(const FloatType radians);
+
+        constexpr void setToZero();
 
-        inline void setToZero();
+        constexpr FloatType get(const AngleScale scale) const;
+        constexpr void set(const FloatType angle, const AngleScale scale);
 
-        inline FloatType get(const AngleScale scale) const;
-        inline void set(const FloatType angle, const AngleScale scale);
+        constexpr void setValueOf(const AngleTemplate<FloatType>& angle);
 
-        inline void setValueOf(const AngleTemplate<FloatType>& angle);
+        constexpr FloatType radians() const;
+        constexpr void setRadians(const FloatType radians);
 
-        inline FloatType radians() const;
-        inline void setRadians(const FloatType radians);
+        constexpr FloatType degrees() const;
+        constexpr void setDegrees(const FloatType degrees);
 
-        inline FloatType degrees() const;
-        inline void setDegrees(const FloatType degrees);
+        constexpr FloatType gradians() const;
+        constexpr void setGradians(const FloatType gradians);
 
-        inline FloatType gradians() const;
-        inline void setGradians(const FloatType gradians);
+        constexpr void add(const FloatType angle, const AngleScale scale);
+        constexpr void addRadians(const FloatType radians);
+        constexpr void addDegrees(const FloatType degrees);
+        constexpr void addGradians(const FloatType gradians);
 
-        inline void add(const FloatType angle, const AngleScale scale);
-        inline void addRadians(const FloatType radians);
-        inline void addDegrees(const FloatType degrees);
-        inline void addGradians(const FloatType gradians);
+        constexpr void subtract(const FloatType angle, const AngleScale scale);
+        constexpr void subtractRadians(const FloatType radians);
+        constexpr void subtractDegrees(const FloatType degrees);
+        constexpr void subtractGradians(const FloatType gradians);
 
-        inline void subtract(const FloatType angle, const AngleScale scale);
-        inline void subtractRadians(const FloatType radians);
-        inline void subtractDegrees(const FloatType degrees);
-        inline void subtractGradians(const FloatType gradians);
+        constexpr void multiply(const FloatType value);
+        constexpr void divide(const FloatType value);
 
-        inline void multiply(const FloatType value);
-        inline void divide(const FloatType value);
+        inline void sincos(FloatType & sine, FloatType & cosine, const TrigonometryAccuracy accuracy = PRECISE_TRIGONOMETRY) const;
 
-        inline bool operator < (const FloatType radians) const;
-        inline bool operator < (const AngleTemplate<FloatType>& angle) const;
-        inline bool operator > (const FloatType radians) const;
-        inline bool operator > (const AngleTemplate<FloatType>& angle) const;
-        inline bool operator <= (const FloatType radians) const;
-        inline bool operator <= (const AngleTemplate<FloatType>& angle) const;
-        inline bool operator >= (const FloatType radians) const;
-        inline bool operator >= (const AngleTemplate<FloatType>& angle) const;
-        inline bool operator==(const FloatType radians) const;
-        inline bool operator==(const AngleTemplate<FloatType>& angle) const;
-        inline bool operator!=(const FloatType radians) const;
-        inline bool operator!=(const AngleTemplate<FloatType>& angle) const;
+        inline void normalize(const AngleRange range);
 
-        inline operator FloatType() const;
+        // The shortest signed rotation from the angle to this one, in radians
+        inline FloatType difference(const AngleTemplate<FloatType>& angle) const;
 
-        inline FloatType operator/(const AngleTemplate<FloatType>& angle) const;
+        constexpr bool operator < (const FloatType radians) const;
+        constexpr bool operator < (const AngleTemplate<FloatType>& angle) const;
+        constexpr bool operator > (const FloatType radians) const;
+        constexpr bool operator > (const AngleTemplate<FloatType>& angle) const;
+        constexpr bool operator <= (const FloatType radians) const;
+        constexpr bool operator <= (const AngleTemplate<FloatType>& angle) const;
+        constexpr bool operator >= (const FloatType radians) const;
+        constexpr bool operator >= (const AngleTemplate<FloatType>& angle) const;
+        constexpr bool operator==(const FloatType radians) const;
+        constexpr bool operator==(const AngleTemplate<FloatType>& angle) const;
+        constexpr bool operator!=(const FloatType radians) const;
+        constexpr bool operator!=(const AngleTemplate<FloatType>& angle) const;
+
+        constexpr operator FloatType() const;
+
+        constexpr FloatType operator/(const AngleTemplate<FloatType>& angle) const;
+
+        static constexpr FloatType getTurn(const AngleScale scale);
+
+        // Wraps an angle into the range without branches: only selects are used
+        inline static FloatType wrap(const FloatType angle, const AngleRange range, const AngleScale scale = RADIANS);
     protected:
         FloatType value;
 
-        inline static FloatType toRadians(const FloatType angle, const AngleScale scale);
+        static constexpr FloatType toRadians(const FloatType angle, const AngleScale scale);
     };
 
     // =================== Angle<double> header =================== //
@@ -101,34 +127,35 @@ namespace geometry
     class Angle : public AngleTemplate<double>
     {
     public:
-        inline Angle();
-        inline Angle(const AngleF & angle);
-        inline Angle(const double radians);
-        inline Angle(const double angle, const AngleScale scale);
-        virtual ~Angle();
+        constexpr Angle();
+        constexpr Angle(const AngleF & angle);
+        constexpr Angle(const double radians);
+        constexpr Angle(const double angle, const AngleScale scale);
 
-        inline void setValueOf(const AngleF& angle);
+        constexpr void setValueOf(const AngleF& angle);
 
-        inline AngleF toFloat() const;
+        constexpr AngleF toFloat() const;
+
+        inline Angle getNormalized(const AngleRange range) const;
 
         inline double cos() const;
         inline double sin() const;
         inline double tg() const;
         inline double ctg() const;
 
-        inline Angle operator+(const double radians) const;
-        inline Angle operator+(const Angle& angle) const;
-        inline Angle operator-(const double radians) const;
-        inline Angle operator-(const Angle& angle) const;
-        inline Angle operator*(const double value) const;
-        inline Angle operator/(const double value) const;
-
-        inline Angle& operator+=(const double radians);
-        inline Angle& operator+=(const Angle& angle);
-        inline Angle& operator-=(const double radians);
-        inline Angle& operator-=(const Angle& angle);
-        inline Angle& operator*=(const double value);
-        inline Angle& operator/=(const double value);
+        constexpr Angle operator+(const double radians) const;
+        constexpr Angle operator+(const Angle& angle) const;
+        constexpr Angle operator-(const double radians) const;
+        constexpr Angle operator-(const Angle& angle) const;
+        constexpr Angle operator*(const double value) const;
+        constexpr Angle operator/(const double value) const;
+
+        constexpr Angle& operator+=(const double radians);
+        constexpr Angle& operator+=(const Angle& angle);
+        constexpr Angle& operator-=(const double radians);
+        constexpr Angle& operator-=(const Angle& angle);
+        constexpr Angle& operator*=(const double value);
+        constexpr Angle& operator/=(const double value);
     };
 
     // =================== Angle<float> header ==================== //
@@ -136,44 +163,65 @@ namespace geometry
     class AngleF : public AngleTemplate<float>
     {
     public:
-        inline AngleF();
-        inline AngleF(const Angle& angle);
-        inline AngleF(const float radians);
-        inline AngleF(const float angle, const AngleScale scale);
-        virtual ~AngleF();
+        constexpr AngleF();
+        constexpr AngleF(const Angle& angle);
+        constexpr AngleF(const float radians);
+        constexpr AngleF(const float angle, const AngleScale scale);
+
+        constexpr void setValueOf(const Angle& angle);
 
-        inline void setValueOf(const Angle& angle);
+        constexpr Angle toDouble() const;
 
-        inline Angle toDouble() const;
+        inline AngleF getNormalized(const AngleRange range) const;
 
         inline float cos() const;
         inline float sin() const;
         inline float tg() const;
         inline float ctg() const;
 
-        inline AngleF operator+(const float radians) const;
-        inline AngleF operator+(const AngleF& angle) const;
-        inline AngleF operator-(const float radians) const;
-        inline AngleF operator-(const AngleF& angle) const;
-        inline AngleF operator*(const float value) const;
-        inline AngleF operator/(const float value) const;
-
-        inline AngleF& operator+=(const float radians);
-        inline AngleF& operator+=(const AngleF& angle);
-        inline AngleF& operator-=(const float radians);
-        inline AngleF& operator-=(const AngleF& angle);
-        inline AngleF& operator*=(const float value);
-        inline AngleF& operator/=(const float value);
+        constexpr AngleF operator+(const float radians) const;
+        constexpr AngleF operator+(const AngleF& angle) const;
+        constexpr AngleF operator-(const float radians) const;
+        constexpr AngleF operator-(const AngleF& angle) const;
+        constexpr AngleF operator*(const float value) const;
+        constexpr AngleF operator/(const float value) const;
+
+        constexpr AngleF& operator+=(const float radians);
+        constexpr AngleF& operator+=(const AngleF& angle);
+        constexpr AngleF& operator-=(const float radians);
+        constexpr AngleF& operator-=(const AngleF& angle);
+        constexpr AngleF& operator*=(const float value);
+        constexpr AngleF& operator/=(const float value);
     };
 
     // =============== AngleTemplate inline methods =============== //
 
-    template<typename FloatType> void AngleTemplate<FloatType>::setToZero()
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::ZERO;
+
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::DEGREES_IN_RADIAN;
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::GRADIANS_IN_RADIAN;
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::DEGREES_IN_GRADIAN;
+
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::RADIANS_IN_TURN;
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::DEGREES_IN_TURN;
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::GRADIANS_IN_TURN;
+
+    template<typename FloatType> constexpr AngleTemplate<FloatType>::AngleTemplate()
+        : value(ZERO)
+    {
+    }
+
+    template<typename FloatType> constexpr AngleTemplate<FloatType>::AngleTemplate(const FloatType radians)
+        : value(radians)
+    {
+    }
+
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::setToZero()
     {
         this->value = ZERO;
     }
 
-    template<typename FloatType> FloatType AngleTemplate<FloatType>::get(const AngleScale scale) const
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::get(const AngleScale scale) const
     {
         if (scale == AngleScale::DEGREES)
         {
@@ -188,167 +236,212 @@ namespace geometry
         return this->value;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::set(const FloatType angle, const AngleScale scale)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::set(const FloatType angle, const AngleScale scale)
     {
         this->value = AngleTemplate<FloatType>::toRadians(angle, scale);
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::setValueOf(const AngleTemplate<FloatType>& angle)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::setValueOf(const AngleTemplate<FloatType>& angle)
     {
         this->value = angle.value;
     }
 
-    template<typename FloatType> FloatType AngleTemplate<FloatType>::radians() const
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::radians() const
     {
         return this->value;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::setRadians(const FloatType radians)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::setRadians(const FloatType radians)
     {
         this->value = radians;
     }
 
-    template<typename FloatType> FloatType AngleTemplate<FloatType>::degrees() const
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::degrees() const
     {
         return this->value * DEGREES_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::setDegrees(const FloatType degrees)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::setDegrees(const FloatType degrees)
     {
         this->value = degrees / DEGREES_IN_RADIAN;
     }
 
-    template<typename FloatType> FloatType AngleTemplate<FloatType>::gradians() const
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::gradians() const
     {
         return this->value * GRADIANS_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::setGradians(const FloatType gradians)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::setGradians(const FloatType gradians)
     {
         this->value = gradians / GRADIANS_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::add(const FloatType angle, const AngleScale scale)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::add(const FloatType angle, const AngleScale scale)
     {
         this->value += AngleTemplate<FloatType>::toRadians(angle, scale);
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::addRadians(const FloatType radians)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::addRadians(const FloatType radians)
     {
         this->value += radians;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::addDegrees(const FloatType degrees)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::addDegrees(const FloatType degrees)
     {
         this->value += degrees / DEGREES_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::addGradians(const FloatType gradians)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::addGradians(const FloatType gradians)
     {
         this->value += gradians / GRADIANS_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::subtract(const FloatType angle, const AngleScale scale)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::subtract(const FloatType angle, const AngleScale scale)
     {
         this->value -= AngleTemplate<FloatType>::toRadians(angle, scale);
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::subtractRadians(const FloatType radians)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::subtractRadians(const FloatType radians)
     {
         this->value -= radians;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::subtractDegrees(const FloatType degrees)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::subtractDegrees(const FloatType degrees)
     {
         this->value -= degrees / DEGREES_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::subtractGradians(const FloatType gradians)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::subtractGradians(const FloatType gradians)
     {
         this->value -= gradians / GRADIANS_IN_RADIAN;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::multiply(const FloatType value)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::multiply(const FloatType value)
     {
         this->value *= value;
     }
 
-    template<typename FloatType> void AngleTemplate<FloatType>::divide(const FloatType value)
+    template<typename FloatType> constexpr void AngleTemplate<FloatType>::divide(const FloatType value)
     {
         this->value /= value;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator < (const FloatType radians) const
+    template<typename FloatType> void AngleTemplate<FloatType>::sincos(FloatType & sine, FloatType & cosine, const TrigonometryAccuracy accuracy) const
+    {
+        geometry::sincos(this->value, sine, cosine, accuracy);
+    }
+
+    template<typename FloatType> void AngleTemplate<FloatType>::normalize(const AngleRange range)
+    {
+        this->value = AngleTemplate<FloatType>::wrap(this->value, range);
+    }
+
+    template<typename FloatType> FloatType AngleTemplate<FloatType>::difference(const AngleTemplate<FloatType>& angle) const
+    {
+        return AngleTemplate<FloatType>::wrap(this->value - angle.value, SIGNED_RANGE);
+    }
+
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator < (const FloatType radians) const
     {
         return this->value < radians;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator < (const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator < (const AngleTemplate<FloatType>& angle) const
     {
         return this->value < angle.value;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator > (const FloatType radians) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator > (const FloatType radians) const
     {
         return this->value > radians;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator > (const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator > (const AngleTemplate<FloatType>& angle) const
     {
         return this->value > angle.value;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator <= (const FloatType radians) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator <= (const FloatType radians) const
     {
         return this->value <= radians;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator <= (const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator <= (const AngleTemplate<FloatType>& angle) const
     {
         return this->value <= angle.value;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator >= (const FloatType radians) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator >= (const FloatType radians) const
     {
         return this->value >= radians;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator >= (const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator >= (const AngleTemplate<FloatType>& angle) const
     {
         return this->value >= angle.value;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator==(const FloatType radians) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator==(const FloatType radians) const
     {
         return this->value == radians;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator==(const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator==(const AngleTemplate<FloatType>& angle) const
     {
-        return this->value == angle.radians;
+        return this->value == angle.value;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator!=(const FloatType radians) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator!=(const FloatType radians) const
     {
         return this->value != radians;
     }
 
-    template<typename FloatType> bool AngleTemplate<FloatType>::operator!=(const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr bool AngleTemplate<FloatType>::operator!=(const AngleTemplate<FloatType>& angle) const
     {
-        return this->value != angle.radians;
+        return this->value != angle.value;
     }
 
-    template<typename FloatType> AngleTemplate<FloatType>::operator FloatType() const
+    template<typename FloatType> constexpr AngleTemplate<FloatType>::operator FloatType() const
     {
         return this->value;
     }
 
-    template<typename FloatType> FloatType AngleTemplate<FloatType>::operator/(const AngleTemplate<FloatType>& angle) const
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::operator/(const AngleTemplate<FloatType>& angle) const
     {
         return this->value / angle.value;
     }
 
-    template<typename FloatType> FloatType AngleTemplate<FloatType>::toRadians(const FloatType angle, const AngleScale scale)
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::getTurn(const AngleScale scale)
+    {
+        if (scale == AngleScale::DEGREES)
+        {
+            return DEGREES_IN_TURN;
+        }
+
+        if (scale == AngleScale::GRADIANS)
+        {
+            return GRADIANS_IN_TURN;
+        }
+
+        return RADIANS_IN_TURN;
+    }
+
+    template<typename FloatType> FloatType AngleTemplate<FloatType>::wrap(const FloatType angle, const AngleRange range, const AngleScale scale)
+    {
+        const FloatType turn = AngleTemplate<FloatType>::getTurn(scale);
+
+        if (range == AngleRange::SIGNED_RANGE)
+        {
+            return angle - turn * ceil((angle - turn / 2) / turn);
+        }
+
+        const FloatType result = angle - turn * floor(angle / turn);
+
+        // Rounding may give exactly one turn for tiny negative angles
+        return result >= turn ? result - turn : result;
+    }
+
+    template<typename FloatType> constexpr FloatType AngleTemplate<FloatType>::toRadians(const FloatType angle, const AngleScale scale)
     {
         if (scale == AngleScale::DEGREES)
         {
@@ -365,36 +458,41 @@ namespace geometry
 
     // =============== Angle<double> inline methods =============== //
 
-    Angle::Angle()
+    constexpr Angle::Angle()
+        : AngleTemplate<double>()
     {
-        this->value = ZERO;
     }
 
-    Angle::Angle(const AngleF& angle)
+    constexpr Angle::Angle(const AngleF& angle)
+        : AngleTemplate<double>(angle.radians())
     {
-        this->value = angle.radians();
     }
 
-    Angle::Angle(const double radians)
+    constexpr Angle::Angle(const double radians)
+        : AngleTemplate<double>(radians)
     {
-        this->value = radians;
     }
 
-    Angle::Angle(const double angle, const AngleScale scale)
+    constexpr Angle::Angle(const double angle, const AngleScale scale)
+        : AngleTemplate<double>(AngleTemplate<double>::toRadians(angle, scale))
     {
-        this->set(angle, scale);
     }
 
-    void Angle::setValueOf(const AngleF& angle)
+    constexpr void Angle::setValueOf(const AngleF& angle)
     {
         this->value = angle.radians();
     }
 
-    AngleF Angle::toFloat() const
+    constexpr AngleF Angle::toFloat() const
     {
         return AngleF((float)this->value);
     }
 
+    Angle Angle::getNormalized(const AngleRange range) const
+    {
+        return Angle(AngleTemplate<double>::wrap(this->value, range));
+    }
+
     double Angle::cos() const
     {
         return ::cos(this->value);
@@ -415,67 +513,67 @@ namespace geometry
         return 1.0 / ::tan(this->value);
     }
 
-    Angle Angle::operator+(const double radians) const
+    constexpr Angle Angle::operator+(const double radians) const
     {
         return Angle(this->value + radians);
     }
 
-    Angle Angle::operator+(const Angle& angle) const
+    constexpr Angle Angle::operator+(const Angle& angle) const
     {
         return Angle(this->value + angle.value);
     }
 
-    Angle Angle::operator-(const double radians) const
+    constexpr Angle Angle::operator-(const double radians) const
     {
         return Angle(this->value - radians);
     }
 
-    Angle Angle::operator-(const Angle& angle) const
+    constexpr Angle Angle::operator-(const Angle& angle) const
     {
         return Angle(this->value - angle.value);
     }
 
-    Angle Angle::operator*(const double value) const
+    constexpr Angle Angle::operator*(const double value) const
     {
         return Angle(this->value * value);
     }
 
-    Angle Angle::operator/(const double value) const
+    constexpr Angle Angle::operator/(const double value) const
     {
         return Angle(this->value / value);
     }
 
-    Angle& Angle::operator+=(const double radians)
+    constexpr Angle& Angle::operator+=(const double radians)
     {
         this->value += radians;
         return (*this);
     }
 
-    Angle& Angle::operator+=(const Angle& angle)
+    constexpr Angle& Angle::operator+=(const Angle& angle)
     {
         this->value += angle.value;
         return (*this);
     }
 
-    Angle& Angle::operator-=(const double radians)
+    constexpr Angle& Angle::operator-=(const double radians)
     {
         this->value -= radians;
         return (*this);
     }
 
-    Angle& Angle::operator-=(const Angle& angle)
+    constexpr Angle& Angle::operator-=(const Angle& angle)
     {
         this->value -= angle.value;
         return (*this);
     }
 
-    Angle& Angle::operator*=(const double value)
+    constexpr Angle& Angle::operator*=(const double value)
     {
         this->value *= value;
         return (*this);
     }
 
-    Angle& Angle::operator/=(const double value)
+    constexpr Angle& Angle::operator/=(const double value)
     {
         this->value /= value;
         return (*this);
@@ -483,36 +581,41 @@ namespace geometry
 
     // =============== Angle<float> inline methods ================ //
 
-    AngleF::AngleF()
+    constexpr AngleF::AngleF()
+        : AngleTemplate<float>()
     {
-        this->value = AngleF::ZERO;
     }
 
-    AngleF::AngleF(const Angle& angle)
+    constexpr AngleF::AngleF(const Angle& angle)
+        : AngleTemplate<float>((float)angle.radians())
     {
-        this->value = (float)angle.radians();
     }
 
-    AngleF::AngleF(const float radians)
+    constexpr AngleF::AngleF(const float radians)
+        : AngleTemplate<float>(radians)
     {
-        this->value = radians;
     }
 
-    AngleF::AngleF(const float angle, const AngleScale scale)
+    constexpr AngleF::AngleF(const float angle, const AngleScale scale)
+        : AngleTemplate<float>(AngleTemplate<float>::toRadians(angle, scale))
     {
-        this->set(angle, scale);
     }
 
-    void AngleF::setValueOf(const Angle& angle)
+    constexpr void AngleF::setValueOf(const Angle& angle)
     {
         this->value = (float)angle.radians();
     }
 
-    Angle AngleF::toDouble() const
+    constexpr Angle AngleF::toDouble() const
     {
         return Angle(this->value);
     }
 
+    AngleF AngleF::getNormalized(const AngleRange range) const
+    {
+        return AngleF(AngleTemplate<float>::wrap(this->value, range));
+    }
+
     float AngleF::cos() const
     {
         return ::cosf(this->value);
@@ -533,67 +636,67 @@ namespace geometry
         return 1.0f / ::tanf(this->value);
     }
 
-    AngleF AngleF::operator+(const float radians) const
+    constexpr AngleF AngleF::operator+(const float radians) const
     {
         return AngleF(this->value + radians);
     }
 
-    AngleF AngleF::operator+(const AngleF& angle) const
+    constexpr AngleF AngleF::operator+(const AngleF& angle) const
     {
         return AngleF(this->value + angle.value);
     }
 
-    AngleF AngleF::operator-(const float radians) const
+    constexpr AngleF AngleF::operator-(const float radians) const
     {
         return AngleF(this->value - radians);
     }
 
-    AngleF AngleF::operator-(const AngleF& angle) const
+    constexpr AngleF AngleF::operator-(const AngleF& angle) const
     {
         return AngleF(this->value - angle.value);
     }
 
-    AngleF AngleF::operator*(const float value) const
+    constexpr AngleF AngleF::operator*(const float value) const
     {
         return AngleF(this->value * value);
     }
 
-    AngleF AngleF::operator/(const float value) const
+    constexpr AngleF AngleF::operator/(const float value) const
     {
         return AngleF(this->value / value);
     }
 
-    AngleF& AngleF::operator+=(const float radians)
+    constexpr AngleF& AngleF::operator+=(const float radians)
     {
         this->value += radians;
         return (*this);
     }
 
-    AngleF& AngleF::operator+=(const AngleF& angle)
+    constexpr AngleF& AngleF::operator+=(const AngleF& angle)
     {
         this->value += angle.value;
         return (*this);
     }
 
-    AngleF& AngleF::operator-=(const float radians)
+    constexpr AngleF& AngleF::operator-=(const float radians)
     {
         this->value -= radians;
         return (*this);
     }
 
-    AngleF& AngleF::operator-=(const AngleF& angle)
+    constexpr AngleF& AngleF::operator-=(const AngleF& angle)
     {
         this->value -= angle.value;
         return (*this);
     }
 
-    AngleF& AngleF::operator*=(const float value)
+    constexpr AngleF& AngleF::operator*=(const float value)
     {
         this->value *= value;
         return (*this);
     }
 
-    AngleF& AngleF::operator/=(const float value)
+    constexpr AngleF& AngleF::operator/=(const float value)
     {
         this->value /= value;
         return (*this);
@@ -0,0 +1,647 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AngleBatch.h"
+#include "Profiler.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define GEOMETRY_AVX2_TRIGONOMETRY
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#define GEOMETRY_SIMD_ANGLES
+#endif
+
+namespace geometry
+{
+    static_assert(sizeof(AngleF) == sizeof(float), "the angles are read as packed radians");
+    static_assert(sizeof(Angle) == sizeof(double), "the angles are read as packed radians");
+
+    // ========================= SIMD lanes ========================== //
+
+    // The precise sine and cosine and the wrapping run over SIMD lanes of
+    // floats or doubles, one value in each lane. The wrappers are overloaded
+    // by the register type, the floats of the precise sine and cosine are
+    // widened to double lanes.
+
+    template<typename FloatType> struct LaneTraits
+    {
+    };
+
+#if defined(__AVX512F__)
+    template<> struct LaneTraits<float>
+    {
+        typedef __m512 Register;
+        typedef __mmask16 Mask;
+
+        static const size_t COUNT = 16;
+    };
+
+    template<> struct LaneTraits<double>
+    {
+        typedef __m512d Register;
+        typedef __mmask8 Mask;
+
+        static const size_t COUNT = 8;
+    };
+
+    static inline __m512 setLanes(const float value) { return _mm512_set1_ps(value); }
+    static inline __m512 addLanes(const __m512 a, const __m512 b) { return _mm512_add_ps(a, b); }
+    static inline __m512 subtractLanes(const __m512 a, const __m512 b) { return _mm512_sub_ps(a, b); }
+    static inline __m512 multiplyLanes(const __m512 a, const __m512 b) { return _mm512_mul_ps(a, b); }
+    static inline __m512 divideLanes(const __m512 a, const __m512 b) { return _mm512_div_ps(a, b); }
+    static inline __m512 floorLanes(const __m512 a) { return _mm512_floor_ps(a); }
+    static inline __m512 ceilLanes(const __m512 a) { return _mm512_ceil_ps(a); }
+    static inline __mmask16 lessLanes(const __m512 a, const __m512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static inline __mmask16 equalLanes(const __m512 a, const __m512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static inline __m512 selectLanes(const __mmask16 mask, const __m512 chosen, const __m512 other) { return _mm512_mask_blend_ps(mask, other, chosen); }
+    static inline __m512 loadLanes(const float * values) { return _mm512_loadu_ps(values); }
+    static inline void storeLanes(float * values, const __m512 a) { _mm512_storeu_ps(values, a); }
+
+    static inline __m512d setLanes(const double value) { return _mm512_set1_pd(value); }
+    static inline __m512d addLanes(const __m512d a, const __m512d b) { return _mm512_add_pd(a, b); }
+    static inline __m512d subtractLanes(const __m512d a, const __m512d b) { return _mm512_sub_pd(a, b); }
+    static inline __m512d multiplyLanes(const __m512d a, const __m512d b) { return _mm512_mul_pd(a, b); }
+    static inline __m512d divideLanes(const __m512d a, const __m512d b) { return _mm512_div_pd(a, b); }
+    static inline __m512d floorLanes(const __m512d a) { return _mm512_floor_pd(a); }
+    static inline __m512d ceilLanes(const __m512d a) { return _mm512_ceil_pd(a); }
+    static inline __mmask8 lessLanes(const __m512d a, const __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline __mmask8 equalLanes(const __m512d a, const __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static inline __m512d selectLanes(const __mmask8 mask, const __m512d chosen, const __m512d other) { return _mm512_mask_blend_pd(mask, other, chosen); }
+    static inline __m512d loadLanes(const double * values) { return _mm512_loadu_pd(values); }
+    static inline void storeLanes(double * values, const __m512d a) { _mm512_storeu_pd(values, a); }
+
+    static inline __m512d loadWidened(const float * values) { return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(values)); }
+    static inline void storeNarrowed(float * values, const __m512d a) { _mm256_storeu_ps(values, _mm512_maskz_cvtpd_ps(0xFF, a)); }
+#elif defined(__AVX__)
+    template<> struct LaneTraits<float>
+    {
+        typedef __m256 Register;
+        typedef __m256 Mask;
+
+        static const size_t COUNT = 8;
+    };
+
+    template<> struct LaneTraits<double>
+    {
+        typedef __m256d Register;
+        typedef __m256d Mask;
+
+        static const size_t COUNT = 4;
+    };
+
+    static inline __m256 setLanes(const float value) { return _mm256_set1_ps(value); }
+    static inline __m256 addLanes(const __m256 a, const __m256 b) { return _mm256_add_ps(a, b); }
+    static inline __m256 subtractLanes(const __m256 a, const __m256 b) { return _mm256_sub_ps(a, b); }
+    static inline __m256 multiplyLanes(const __m256 a, const __m256 b) { return _mm256_mul_ps(a, b); }
+    static inline __m256 divideLanes(const __m256 a, const __m256 b) { return _mm256_div_ps(a, b); }
+    static inline __m256 floorLanes(const __m256 a) { return _mm256_floor_ps(a); }
+    static inline __m256 ceilLanes(const __m256 a) { return _mm256_ceil_ps(a); }
+    static inline __m256 lessLanes(const __m256 a, const __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline __m256 equalLanes(const __m256 a, const __m256 b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static inline __m256 selectLanes(const __m256 mask, const __m256 chosen, const __m256 other) { return _mm256_blendv_ps(other, chosen, mask); }
+    static inline __m256 loadLanes(const float * values) { return _mm256_loadu_ps(values); }
+    static inline void storeLanes(float * values, const __m256 a) { _mm256_storeu_ps(values, a); }
+
+    static inline __m256d setLanes(const double value) { return _mm256_set1_pd(value); }
+    static inline __m256d addLanes(const __m256d a, const __m256d b) { return _mm256_add_pd(a, b); }
+    static inline __m256d subtractLanes(const __m256d a, const __m256d b) { return _mm256_sub_pd(a, b); }
+    static inline __m256d multiplyLanes(const __m256d a, const __m256d b) { return _mm256_mul_pd(a, b); }
+    static inline __m256d divideLanes(const __m256d a, const __m256d b) { return _mm256_div_pd(a, b); }
+    static inline __m256d floorLanes(const __m256d a) { return _mm256_floor_pd(a); }
+    static inline __m256d ceilLanes(const __m256d a) { return _mm256_ceil_pd(a); }
+    static inline __m256d lessLanes(const __m256d a, const __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline __m256d equalLanes(const __m256d a, const __m256d b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static inline __m256d selectLanes(const __m256d mask, const __m256d chosen, const __m256d other) { return _mm256_blendv_pd(other, chosen, mask); }
+    static inline __m256d loadLanes(const double * values) { return _mm256_loadu_pd(values); }
+    static inline void storeLanes(double * values, const __m256d a) { _mm256_storeu_pd(values, a); }
+
+    static inline __m256d loadWidened(const float * values) { return _mm256_cvtps_pd(_mm_loadu_ps(values)); }
+    static inline void storeNarrowed(float * values, const __m256d a) { _mm_storeu_ps(values, _mm256_cvtpd_ps(a)); }
+#elif defined(__SSE4_1__)
+    template<> struct LaneTraits<float>
+    {
+        typedef __m128 Register;
+        typedef __m128 Mask;
+
+        static const size_t COUNT = 4;
+    };
+
+    template<> struct LaneTraits<double>
+    {
+        typedef __m128d Register;
+        typedef __m128d Mask;
+
+        static const size_t COUNT = 2;
+    };
+
+    static inline __m128 setLanes(const float value) { return _mm_set1_ps(value); }
+    static inline __m128 addLanes(const __m128 a, const __m128 b) { return _mm_add_ps(a, b); }
+    static inline __m128 subtractLanes(const __m128 a, const __m128 b) { return _mm_sub_ps(a, b); }
+    static inline __m128 multiplyLanes(const __m128 a, const __m128 b) { return _mm_mul_ps(a, b); }
+    static inline __m128 divideLanes(const __m128 a, const __m128 b) { return _mm_div_ps(a, b); }
+    static inline __m128 floorLanes(const __m128 a) { return _mm_floor_ps(a); }
+    static inline __m128 ceilLanes(const __m128 a) { return _mm_ceil_ps(a); }
+    static inline __m128 lessLanes(const __m128 a, const __m128 b) { return _mm_cmplt_ps(a, b); }
+    static inline __m128 equalLanes(const __m128 a, const __m128 b) { return _mm_cmpeq_ps(a, b); }
+    static inline __m128 selectLanes(const __m128 mask, const __m128 chosen, const __m128 other) { return _mm_blendv_ps(other, chosen, mask); }
+    static inline __m128 loadLanes(const float * values) { return _mm_loadu_ps(values); }
+    static inline void storeLanes(float * values, const __m128 a) { _mm_storeu_ps(values, a); }
+
+    static inline __m128d setLanes(const double value) { return _mm_set1_pd(value); }
+    static inline __m128d addLanes(const __m128d a, const __m128d b) { return _mm_add_pd(a, b); }
+    static inline __m128d subtractLanes(const __m128d a, const __m128d b) { return _mm_sub_pd(a, b); }
+    static inline __m128d multiplyLanes(const __m128d a, const __m128d b) { return _mm_mul_pd(a, b); }
+    static inline __m128d divideLanes(const __m128d a, const __m128d b) { return _mm_div_pd(a, b); }
+    static inline __m128d floorLanes(const __m128d a) { return _mm_floor_pd(a); }
+    static inline __m128d ceilLanes(const __m128d a) { return _mm_ceil_pd(a); }
+    static inline __m128d lessLanes(const __m128d a, const __m128d b) { return _mm_cmplt_pd(a, b); }
+    static inline __m128d equalLanes(const __m128d a, const __m128d b) { return _mm_cmpeq_pd(a, b); }
+    static inline __m128d selectLanes(const __m128d mask, const __m128d chosen, const __m128d other) { return _mm_blendv_pd(other, chosen, mask); }
+    static inline __m128d loadLanes(const double * values) { return _mm_loadu_pd(values); }
+    static inline void storeLanes(double * values, const __m128d a) { _mm_storeu_pd(values, a); }
+
+    static inline __m128d loadWidened(const float * values) { return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i *)values))); }
+    static inline void storeNarrowed(float * values, const __m128d a) { _mm_storel_pi((__m64 *)values, _mm_cvtpd_ps(a)); }
+#endif
+
+#ifdef GEOMETRY_SIMD_ANGLES
+    template<typename FloatType> struct Lanes
+    {
+        typedef typename LaneTraits<FloatType>::Register Register;
+        typedef typename LaneTraits<FloatType>::Mask Mask;
+
+        static const size_t COUNT = LaneTraits<FloatType>::COUNT;
+
+        Register value;
+
+        inline Lanes()
+        {
+        }
+
+        inline Lanes(const Register value) : value(value)
+        {
+        }
+
+        explicit inline Lanes(const FloatType value) : value(setLanes(value))
+        {
+        }
+    };
+
+    template<typename FloatType> static inline Lanes<FloatType> operator+ (const Lanes<FloatType> a, const Lanes<FloatType> b)
+    {
+        return addLanes(a.value, b.value);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> operator- (const Lanes<FloatType> a, const Lanes<FloatType> b)
+    {
+        return subtractLanes(a.value, b.value);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> operator* (const Lanes<FloatType> a, const Lanes<FloatType> b)
+    {
+        return multiplyLanes(a.value, b.value);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> operator/ (const Lanes<FloatType> a, const Lanes<FloatType> b)
+    {
+        return divideLanes(a.value, b.value);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> floor(const Lanes<FloatType> value)
+    {
+        return floorLanes(value.value);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> ceil(const Lanes<FloatType> value)
+    {
+        return ceilLanes(value.value);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> select(const typename Lanes<FloatType>::Mask mask, const Lanes<FloatType> chosen, const Lanes<FloatType> other)
+    {
+        return selectLanes(mask, chosen.value, other.value);
+    }
+
+    typedef Lanes<double> DoubleLanes;
+
+    // applySincosQuadrant over the lanes, the quadrant is kept a double, so
+    // infinities and NaN give NaN instead of an invalid conversion
+    static inline void applySincosQuadrant(const DoubleLanes quadrant, const DoubleLanes sine, const DoubleLanes cosine, DoubleLanes & resultSine, DoubleLanes & resultCosine)
+    {
+        const DoubleLanes half = floor(quadrant * DoubleLanes(0.5));
+        const DoubleLanes next = floor((quadrant + DoubleLanes(1.0)) * DoubleLanes(0.5));
+
+        const DoubleLanes::Mask swap = equalLanes((quadrant - half * DoubleLanes(2.0)).value, setLanes(1.0));
+
+        // The sine is negative in the quadrants 2 and 3, the cosine in 1 and 2
+        const DoubleLanes sineSign = DoubleLanes(1.0) - (half - floor(half * DoubleLanes(0.5)) * DoubleLanes(2.0)) * DoubleLanes(2.0);
+        const DoubleLanes cosineSign = DoubleLanes(1.0) - (next - floor(next * DoubleLanes(0.5)) * DoubleLanes(2.0)) * DoubleLanes(2.0);
+
+        resultSine = select(swap, cosine, sine) * sineSign;
+        resultCosine = select(swap, sine, cosine) * cosineSign;
+    }
+
+    // The double sincosKernel of Trigonometry.h over the lanes
+    static inline void sincosKernel(const DoubleLanes radians, DoubleLanes & sine, DoubleLanes & cosine)
+    {
+        const DoubleLanes quadrant = floor(radians * DoubleLanes(0.636619772367581343) + DoubleLanes(0.5));
+
+        const DoubleLanes first = radians - quadrant * DoubleLanes(1.57079632673412561417E+0);
+        const DoubleLanes secondPart = quadrant * DoubleLanes(6.07710050630396597660E-11);
+        const DoubleLanes thirdPart = quadrant * DoubleLanes(2.02226624871116645580E-21);
+
+        const DoubleLanes second = first - secondPart;
+        const DoubleLanes secondError = (first - (second + (first - second))) + ((first - second) - secondPart);
+        const DoubleLanes third = second - thirdPart;
+        const DoubleLanes thirdError = (second - (third + (second - third))) + ((second - third) - thirdPart);
+
+        const DoubleLanes tail = (secondError + thirdError) - quadrant * DoubleLanes(8.47842766036889956997E-32);
+        const DoubleLanes reduced = third + tail;
+        const DoubleLanes reducedTail = tail - (reduced - third);
+
+        const DoubleLanes square = reduced * reduced;
+        const DoubleLanes cube = square * reduced;
+
+        const DoubleLanes sinePolynomial = ((((DoubleLanes(1.58962301576546568060E-10) * square
+                - DoubleLanes(2.50507477628578072866E-8)) * square
+                + DoubleLanes(2.75573136213857245213E-6)) * square
+                - DoubleLanes(1.98412698295895385996E-4)) * square
+                + DoubleLanes(8.33333333332211858878E-3));
+
+        const DoubleLanes cosinePolynomial = (((((DoubleLanes(-1.13585365213876817300E-11) * square
+                + DoubleLanes(2.08757008419747316778E-9)) * square
+                - DoubleLanes(2.75573141792967388112E-7)) * square
+                + DoubleLanes(2.48015872888517045348E-5)) * square
+                - DoubleLanes(1.38888888888730564116E-3)) * square
+                + DoubleLanes(4.16666666666665929218E-2)) * square;
+
+        const DoubleLanes halfSquare = DoubleLanes(0.5) * square;
+        const DoubleLanes cosineHead = DoubleLanes(1.0) - halfSquare;
+
+        applySincosQuadrant(quadrant,
+            reduced - ((square * (DoubleLanes(0.5) * reducedTail - cube * sinePolynomial) - reducedTail) + cube * DoubleLanes(1.66666666666666307295E-1)),
+            cosineHead + (((DoubleLanes(1.0) - cosineHead) - halfSquare) + (square * cosinePolynomial - reduced * reducedTail)),
+            sine, cosine);
+    }
+
+    // The float sincosKernel of Trigonometry.h over the lanes, the floats
+    // are widened to doubles as there
+    static inline void sincosFloatKernel(const DoubleLanes radians, DoubleLanes & sine, DoubleLanes & cosine)
+    {
+        const DoubleLanes quadrant = floor(radians * DoubleLanes(0.636619772367581343) + DoubleLanes(0.5));
+
+        const DoubleLanes reduced = (radians - quadrant * DoubleLanes(1.57079632673412561417E+0)) - quadrant * DoubleLanes(6.07710050650619224932E-11);
+        const DoubleLanes square = reduced * reduced;
+
+        const DoubleLanes sinePolynomial = (((((DoubleLanes(1.58962301576546568060E-10) * square
+                - DoubleLanes(2.50507477628578072866E-8)) * square
+                + DoubleLanes(2.75573136213857245213E-6)) * square
+                - DoubleLanes(1.98412698295895385996E-4)) * square
+                + DoubleLanes(8.33333333332211858878E-3)) * square
+                - DoubleLanes(1.66666666666666307295E-1));
+
+        const DoubleLanes cosinePolynomial = (((((DoubleLanes(-1.13585365213876817300E-11) * square
+                + DoubleLanes(2.08757008419747316778E-9)) * square
+                - DoubleLanes(2.75573141792967388112E-7)) * square
+                + DoubleLanes(2.48015872888517045348E-5)) * square
+                - DoubleLanes(1.38888888888730564116E-3)) * square
+                + DoubleLanes(4.16666666666665929218E-2));
+
+        applySincosQuadrant(quadrant,
+            reduced + reduced * square * sinePolynomial,
+            DoubleLanes(1.0) - DoubleLanes(0.5) * square + square * square * cosinePolynomial,
+            sine, cosine);
+    }
+
+    // Returns the number of processed values, the rest is left to the scalar kernels
+    static size_t sincosLanes(const double * radians, double * sines, double * cosines, const size_t count)
+    {
+        size_t i = 0;
+
+        for (; i + DoubleLanes::COUNT <= count; i += DoubleLanes::COUNT) {
+            DoubleLanes sine, cosine;
+            sincosKernel(DoubleLanes(loadLanes(radians + i)), sine, cosine);
+
+            storeLanes(sines + i, sine.value);
+            storeLanes(cosines + i, cosine.value);
+        }
+
+        return i;
+    }
+
+    static size_t sincosLanes(const float * radians, float * sines, float * cosines, const size_t count)
+    {
+        size_t i = 0;
+
+        for (; i + DoubleLanes::COUNT <= count; i += DoubleLanes::COUNT) {
+            DoubleLanes sine, cosine;
+            sincosFloatKernel(DoubleLanes(loadWidened(radians + i)), sine, cosine);
+
+            storeNarrowed(sines + i, sine.value);
+            storeNarrowed(cosines + i, cosine.value);
+        }
+
+        return i;
+    }
+
+    // AngleTemplate::wrap over the lanes, the range is chosen out of the loops
+    template<typename FloatType> static inline Lanes<FloatType> wrapSigned(const Lanes<FloatType> angle, const Lanes<FloatType> turn, const Lanes<FloatType> halfTurn)
+    {
+        return angle - turn * ceil((angle - halfTurn) / turn);
+    }
+
+    template<typename FloatType> static inline Lanes<FloatType> wrapUnsigned(const Lanes<FloatType> angle, const Lanes<FloatType> turn)
+    {
+        const Lanes<FloatType> result = angle - turn * floor(angle / turn);
+
+        // Rounding may give exactly one turn for tiny negative angles
+        return select(lessLanes(result.value, turn.value), result, result - turn);
+    }
+
+#endif
+
+#ifdef GEOMETRY_AVX2_TRIGONOMETRY
+
+    // The same computation as sincosFastKernel for eight values at once,
+    // returns the number of processed values
+    static size_t sincosFastAvx2(const float * radians, float * sines, float * cosines, const size_t count)
+    {
+        const __m256 twoOverPi = _mm256_set1_ps(0.636619772f);
+        const __m256 part1 = _mm256_set1_ps(1.5703125f);
+        const __m256 part2 = _mm256_set1_ps(4.837512969970703125E-4f);
+        const __m256 part3 = _mm256_set1_ps(7.54978995489188216E-8f);
+
+        const __m256 sine0 = _mm256_set1_ps(-1.9515295891E-4f);
+        const __m256 sine1 = _mm256_set1_ps(8.3321608736E-3f);
+        const __m256 sine2 = _mm256_set1_ps(-1.6666654611E-1f);
+
+        const __m256 cosine0 = _mm256_set1_ps(2.443315711809948E-5f);
+        const __m256 cosine1 = _mm256_set1_ps(-1.388731625493765E-3f);
+        const __m256 cosine2 = _mm256_set1_ps(4.166664568298827E-2f);
+
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        const __m256i oneBit = _mm256_set1_epi32(1);
+        const __m256i twoBit = _mm256_set1_epi32(2);
+
+        size_t i = 0;
+
+        for (; i + 8 <= count; i += 8) {
+            __m256 value = _mm256_loadu_ps(radians + i);
+            __m256 quadrant = _mm256_round_ps(_mm256_mul_ps(value, twoOverPi), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            __m256i index = _mm256_cvtps_epi32(quadrant);
+
+            __m256 reduced = _mm256_fnmadd_ps(quadrant, part1, value);
+            reduced = _mm256_fnmadd_ps(quadrant, part2, reduced);
+            reduced = _mm256_fnmadd_ps(quadrant, part3, reduced);
+
+            __m256 square = _mm256_mul_ps(reduced, reduced);
+
+            __m256 sine = _mm256_fmadd_ps(_mm256_fmadd_ps(sine0, square, sine1), square, sine2);
+            sine = _mm256_fmadd_ps(_mm256_mul_ps(sine, square), reduced, reduced);
+
+            __m256 cosine = _mm256_fmadd_ps(_mm256_fmadd_ps(cosine0, square, cosine1), square, cosine2);
+            cosine = _mm256_fmadd_ps(_mm256_mul_ps(square, square), cosine, _mm256_fnmadd_ps(half, square, one));
+
+            __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(index, oneBit), oneBit));
+            __m256 sineSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(index, twoBit), 30));
+            __m256 cosineSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(index, oneBit), twoBit), 30));
+
+            _mm256_storeu_ps(sines + i, _mm256_xor_ps(_mm256_blendv_ps(sine, cosine, swap), sineSign));
+            _mm256_storeu_ps(cosines + i, _mm256_xor_ps(_mm256_blendv_ps(cosine, sine, swap), cosineSign));
+        }
+
+        return i;
+    }
+
+#endif
+
+    // The kernels are not exact for huge arguments, such values are recomputed
+    template<typename FloatType> static void fixLargeArguments(const FloatType * radians, FloatType * sines, FloatType * cosines, const size_t count, const FloatType limit, const TrigonometryAccuracy accuracy)
+    {
+        for (size_t i = 0; i < count; i++) {
+            if (!(fabs(radians[i]) <= limit)) {
+                sincos(radians[i], sines[i], cosines[i], accuracy);
+            }
+        }
+    }
+
+    template<typename FloatType> static void sincosArray(const FloatType * radians, FloatType * sines, FloatType * cosines, const size_t count, const FloatType limit, const TrigonometryAccuracy accuracy)
+    {
+        size_t i = 0;
+
+#ifdef GEOMETRY_SIMD_ANGLES
+        i = sincosLanes(radians, sines, cosines, count);
+#endif
+
+        for (; i < count; i++) {
+            sincosKernel(radians[i], sines[i], cosines[i]);
+        }
+
+        fixLargeArguments<FloatType>(radians, sines, cosines, count, limit, accuracy);
+    }
+
+    static void sincosFastArray(const float * radians, float * sines, float * cosines, const size_t count)
+    {
+        size_t i = 0;
+
+#ifdef GEOMETRY_AVX2_TRIGONOMETRY
+        i = sincosFastAvx2(radians, sines, cosines, count);
+#endif
+
+        for (; i < count; i++) {
+            sincosFastKernel(radians[i], sines[i], cosines[i]);
+        }
+
+        fixLargeArguments<float>(radians, sines, cosines, count, TRIGONOMETRY_KERNEL_LIMIT_FLOAT, FAST_TRIGONOMETRY);
+    }
+
+    void sincos(const AngleF * angles, float * sines, float * cosines, const size_t count, const TrigonometryAccuracy accuracy)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.sincos.float");
+
+        const float * radians = reinterpret_cast<const float *>(angles);
+
+        if (accuracy == FAST_TRIGONOMETRY) {
+            sincosFastArray(radians, sines, cosines, count);
+            return;
+        }
+
+        sincosArray<float>(radians, sines, cosines, count, (float)TRIGONOMETRY_KERNEL_LIMIT_DOUBLE, accuracy);
+    }
+
+    void sincos(const Angle * angles, double * sines, double * cosines, const size_t count, const TrigonometryAccuracy accuracy)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.sincos.double");
+
+        sincosArray<double>(reinterpret_cast<const double *>(angles), sines, cosines, count, TRIGONOMETRY_KERNEL_LIMIT_DOUBLE, accuracy);
+    }
+
+    void sincos(const float * radians, float * sines, float * cosines, const size_t count, const TrigonometryAccuracy accuracy)
+    {
+        GEOMETRY_PROFILE_SCOPE("radians.sincos.float");
+
+        if (accuracy == FAST_TRIGONOMETRY) {
+            sincosFastArray(radians, sines, cosines, count);
+            return;
+        }
+
+        sincosArray<float>(radians, sines, cosines, count, (float)TRIGONOMETRY_KERNEL_LIMIT_DOUBLE, accuracy);
+    }
+
+    void sincos(const double * radians, double * sines, double * cosines, const size_t count, const TrigonometryAccuracy accuracy)
+    {
+        GEOMETRY_PROFILE_SCOPE("radians.sincos.double");
+
+        sincosArray<double>(radians, sines, cosines, count, TRIGONOMETRY_KERNEL_LIMIT_DOUBLE, accuracy);
+    }
+
+    // ============ Bulk scale conversion and wrapping ============ //
+
+    template<typename FloatType> static FloatType getScaleFactor(const AngleScale sourceScale, const AngleScale targetScale)
+    {
+        return AngleTemplate<FloatType>::getTurn(targetScale) / AngleTemplate<FloatType>::getTurn(sourceScale);
+    }
+
+    template<typename FloatType> static void convertAngleArray(const FloatType * source, FloatType * target, const size_t count, const AngleScale sourceScale, const AngleScale targetScale)
+    {
+        if (sourceScale == targetScale) {
+            for (size_t i = 0; i < count; i++) {
+                target[i] = source[i];
+            }
+
+            return;
+        }
+
+        const FloatType factor = getScaleFactor<FloatType>(sourceScale, targetScale);
+
+        for (size_t i = 0; i < count; i++) {
+            target[i] = source[i] * factor;
+        }
+    }
+
+    // The range branch is outside of the loops, the values which do not
+    // fill the lanes are wrapped one by one
+    template<typename FloatType> static void normalizeAngleArray(const FloatType * source, FloatType * target, const size_t count, const AngleRange range, const AngleScale scale)
+    {
+        size_t i = 0;
+
+#ifdef GEOMETRY_SIMD_ANGLES
+        const FloatType turn = AngleTemplate<FloatType>::getTurn(scale);
+        const Lanes<FloatType> turnLanes(turn);
+        const Lanes<FloatType> halfTurn(turn / 2);
+        const size_t lanes = Lanes<FloatType>::COUNT;
+
+        if (range == SIGNED_RANGE) {
+            for (; i + lanes <= count; i += lanes) {
+                storeLanes(target + i, wrapSigned(Lanes<FloatType>(loadLanes(source + i)), turnLanes, halfTurn).value);
+            }
+        }
+        else {
+            for (; i + lanes <= count; i += lanes) {
+                storeLanes(target + i, wrapUnsigned(Lanes<FloatType>(loadLanes(source + i)), turnLanes).value);
+            }
+        }
+#endif
+
+        for (; i < count; i++) {
+            target[i] = AngleTemplate<FloatType>::wrap(source[i], range, scale);
+        }
+    }
+
+    template<typename FloatType> static void differAngleArrays(const FloatType * minuends, const FloatType * subtrahends, FloatType * differences, const size_t count, const AngleScale scale)
+    {
+        size_t i = 0;
+
+#ifdef GEOMETRY_SIMD_ANGLES
+        const FloatType turn = AngleTemplate<FloatType>::getTurn(scale);
+        const Lanes<FloatType> turnLanes(turn);
+        const Lanes<FloatType> halfTurn(turn / 2);
+        const size_t lanes = Lanes<FloatType>::COUNT;
+
+        for (; i + lanes <= count; i += lanes) {
+            const Lanes<FloatType> difference = Lanes<FloatType>(loadLanes(minuends + i)) - Lanes<FloatType>(loadLanes(subtrahends + i));
+            storeLanes(differences + i, wrapSigned(difference, turnLanes, halfTurn).value);
+        }
+#endif
+
+        for (; i < count; i++) {
+            differences[i] = AngleTemplate<FloatType>::wrap(minuends[i] - subtrahends[i], SIGNED_RANGE, scale);
+        }
+    }
+
+    void convertAngles(const float * source, float * target, const size_t count, const AngleScale sourceScale, const AngleScale targetScale)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.convert.float");
+
+        convertAngleArray<float>(source, target, count, sourceScale, targetScale);
+    }
+
+    void convertAngles(const double * source, double * target, const size_t count, const AngleScale sourceScale, const AngleScale targetScale)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.convert.double");
+
+        convertAngleArray<double>(source, target, count, sourceScale, targetScale);
+    }
+
+    void normalizeAngles(const float * source, float * target, const size_t count, const AngleRange range, const AngleScale scale)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.normalize.float");
+
+        normalizeAngleArray<float>(source, target, count, range, scale);
+    }
+
+    void normalizeAngles(const double * source, double * target, const size_t count, const AngleRange range, const AngleScale scale)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.normalize.double");
+
+        normalizeAngleArray<double>(source, target, count, range, scale);
+    }
+
+    void normalizeAngles(AngleF * angles, const size_t count, const AngleRange range)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.normalize.float");
+
+        float * radians = reinterpret_cast<float *>(angles);
+        normalizeAngleArray<float>(radians, radians, count, range, RADIANS);
+    }
+
+    void normalizeAngles(Angle * angles, const size_t count, const AngleRange range)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.normalize.double");
+
+        double * radians = reinterpret_cast<double *>(angles);
+        normalizeAngleArray<double>(radians, radians, count, range, RADIANS);
+    }
+
+    void differAngles(const float * minuends, const float * subtrahends, float * differences, const size_t count, const AngleScale scale)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.difference.float");
+
+        differAngleArrays<float>(minuends, subtrahends, differences, count, scale);
+    }
+
+    void differAngles(const double * minuends, const double * subtrahends, double * differences, const size_t count, const AngleScale scale)
+    {
+        GEOMETRY_PROFILE_SCOPE("angles.difference.double");
+
+        differAngleArrays<double>(minuends, subtrahends, differences, count, scale);
+    }
+}
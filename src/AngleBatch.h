@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_ANGLE_BATCH_H_
+#define _GEOMETRY_ANGLE_BATCH_H_
+
+#include <stddef.h>
+
+#include "Angle.h"
+#include "Trigonometry.h"
+
+namespace geometry
+{
+    // ================== Bulk sine and cosine ================== //
+
+    // Sine and cosine of count angles at once. The fast accuracy tier is used
+    // by the float versions only, the double versions are always precise.
+    // The precise kernels run over two, four or eight lanes when the library
+    // is built with SSE4.1, AVX or AVX-512, the fast one over eight with AVX2.
+    void sincos(const AngleF * angles, float * sines, float * cosines, const size_t count, const TrigonometryAccuracy accuracy = PRECISE_TRIGONOMETRY);
+    void sincos(const Angle * angles, double * sines, double * cosines, const size_t count, const TrigonometryAccuracy accuracy = PRECISE_TRIGONOMETRY);
+
+    void sincos(const float * radians, float * sines, float * cosines, const size_t count, const TrigonometryAccuracy accuracy = PRECISE_TRIGONOMETRY);
+    void sincos(const double * radians, double * sines, double * cosines, const size_t count, const TrigonometryAccuracy accuracy = PRECISE_TRIGONOMETRY);
+
+    // ============ Bulk scale conversion and wrapping ============ //
+
+    // The source and target may be the same array
+    void convertAngles(const float * source, float * target, const size_t count, const AngleScale sourceScale, const AngleScale targetScale);
+    void convertAngles(const double * source, double * target, const size_t count, const AngleScale sourceScale, const AngleScale targetScale);
+
+    void normalizeAngles(const float * source, float * target, const size_t count, const AngleRange range, const AngleScale scale = RADIANS);
+    void normalizeAngles(const double * source, double * target, const size_t count, const AngleRange range, const AngleScale scale = RADIANS);
+
+    void normalizeAngles(AngleF * angles, const size_t count, const AngleRange range);
+    void normalizeAngles(Angle * angles, const size_t count, const AngleRange range);
+
+    // The shortest signed rotations from the subtrahends to the minuends
+    void differAngles(const float * minuends, const float * subtrahends, float * differences, const size_t count, const AngleScale scale = RADIANS);
+    void differAngles(const double * minuends, const double * subtrahends, double * differences, const size_t count, const AngleScale scale = RADIANS);
+}
+
+#endif /* _GEOMETRY_ANGLE_BATCH_H_ */
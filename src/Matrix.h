@@ -0,0 +1,472 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_MATRIX_H_
+#define _GEOMETRY_MATRIX_H_
+
+#include <math.h>
+
+#include "Vector.h"
+#include "planimetry/Matrix2x2.h"
+#include "stereometry/Matrix3x3.h"
+#include "stereometry/Converter3F.h"
+
+namespace geometry
+{
+    // ========================= Matrix kernels ========================= //
+
+    // result (Rows x Columns) = a (Rows x Inner) * b (Inner x Columns)
+    template<typename FloatType, uint32bit Rows, uint32bit Inner, uint32bit Columns> struct MatrixProductKernel
+    {
+        static inline void multiply(const FloatType (&a)[Rows][Inner], const FloatType (&b)[Inner][Columns], FloatType (&result)[Rows][Columns])
+        {
+            Unroll<Rows>::apply([&](const uint32bit i) {
+                Unroll<Columns>::apply([&](const uint32bit k) {
+                    FloatType sum = FloatConstants<FloatType>::ZERO;
+                    Unroll<Inner>::apply([&](const uint32bit j) { sum += a[i][j] * b[j][k]; });
+                    result[i][k] = sum;
+                });
+            });
+        }
+    };
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> struct MatrixVectorKernel
+    {
+        static inline void multiply(const FloatType (&matrix)[Rows][Columns], const FloatType * vector, FloatType * result)
+        {
+            Unroll<Rows>::apply([&](const uint32bit i) {
+                result[i] = VectorKernels<FloatType, Columns>::scalar(matrix[i], vector);
+            });
+        }
+    };
+
+#ifdef GEOMETRY_SSE_VECTOR
+
+    template<> struct MatrixProductKernel<float, 4, 4, 4>
+    {
+        // Every row of the result is a combination of the rows of b
+        static inline void multiply(const float (&a)[4][4], const float (&b)[4][4], float (&result)[4][4])
+        {
+            const __m128 row0 = _mm_loadu_ps(b[0]);
+            const __m128 row1 = _mm_loadu_ps(b[1]);
+            const __m128 row2 = _mm_loadu_ps(b[2]);
+            const __m128 row3 = _mm_loadu_ps(b[3]);
+
+            for (uint32bit i = 0; i < 4; i++) {
+                __m128 row = _mm_mul_ps(_mm_set1_ps(a[i][0]), row0);
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i][1]), row1));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i][2]), row2));
+                row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i][3]), row3));
+                _mm_storeu_ps(result[i], row);
+            }
+        }
+    };
+
+    template<> struct MatrixVectorKernel<float, 4, 4>
+    {
+        static inline void multiply(const float (&matrix)[4][4], const float * vector, float * result)
+        {
+            const __m128 value = _mm_loadu_ps(vector);
+
+            __m128 row0 = _mm_mul_ps(_mm_loadu_ps(matrix[0]), value);
+            __m128 row1 = _mm_mul_ps(_mm_loadu_ps(matrix[1]), value);
+            __m128 row2 = _mm_mul_ps(_mm_loadu_ps(matrix[2]), value);
+            __m128 row3 = _mm_mul_ps(_mm_loadu_ps(matrix[3]), value);
+
+            // After the transposition the sums of the columns are the sums of the rows
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+            _mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(row0, row1), _mm_add_ps(row2, row3)));
+        }
+    };
+
+#endif
+
+    template<typename FloatType, uint32bit N> struct MatrixDeterminant
+    {
+        // Gaussian elimination with partial pivoting
+        static inline FloatType compute(const FloatType (&matrix)[N][N])
+        {
+            FloatType values[N][N];
+
+            for (uint32bit i = 0; i < N; i++) {
+                for (uint32bit j = 0; j < N; j++) {
+                    values[i][j] = matrix[i][j];
+                }
+            }
+
+            FloatType determinant = FloatConstants<FloatType>::UNIT;
+
+            for (uint32bit column = 0; column < N; column++) {
+                uint32bit pivot = column;
+
+                for (uint32bit row = column + 1; row < N; row++) {
+                    if (fabs(values[row][column]) > fabs(values[pivot][column])) {
+                        pivot = row;
+                    }
+                }
+
+                if (values[pivot][column] == FloatConstants<FloatType>::ZERO) {
+                    return FloatConstants<FloatType>::ZERO;
+                }
+
+                if (pivot != column) {
+                    for (uint32bit j = column; j < N; j++) {
+                        const FloatType swapped = values[column][j];
+                        values[column][j] = values[pivot][j];
+                        values[pivot][j] = swapped;
+                    }
+
+                    determinant = -determinant;
+                }
+
+                determinant *= values[column][column];
+
+                for (uint32bit row = column + 1; row < N; row++) {
+                    const FloatType factor = values[row][column] / values[column][column];
+
+                    for (uint32bit j = column + 1; j < N; j++) {
+                        values[row][j] -= factor * values[column][j];
+                    }
+                }
+            }
+
+            return determinant;
+        }
+    };
+
+    template<typename FloatType> struct MatrixDeterminant<FloatType, 1>
+    {
+        static inline FloatType compute(const FloatType (&matrix)[1][1])
+        {
+            return matrix[0][0];
+        }
+    };
+
+    template<typename FloatType> struct MatrixDeterminant<FloatType, 2>
+    {
+        static inline FloatType compute(const FloatType (&matrix)[2][2])
+        {
+            return matrix[0][0] * matrix[1][1] - matrix[0][1] * matrix[1][0];
+        }
+    };
+
+    template<typename FloatType> struct MatrixDeterminant<FloatType, 3>
+    {
+        static inline FloatType compute(const FloatType (&matrix)[3][3])
+        {
+            return matrix[0][0] * (matrix[1][1] * matrix[2][2] - matrix[1][2] * matrix[2][1])
+                 - matrix[0][1] * (matrix[1][0] * matrix[2][2] - matrix[1][2] * matrix[2][0])
+                 + matrix[0][2] * (matrix[1][0] * matrix[2][1] - matrix[1][1] * matrix[2][0]);
+        }
+    };
+
+    // Expansion by the 2x2 minors of the first two and the last two rows
+    template<typename FloatType> struct MatrixDeterminant<FloatType, 4>
+    {
+        static inline FloatType compute(const FloatType (&m)[4][4])
+        {
+            const FloatType s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+            const FloatType s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+            const FloatType s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+            const FloatType s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+            const FloatType s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+            const FloatType s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+            const FloatType c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+            const FloatType c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+            const FloatType c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+            const FloatType c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+            const FloatType c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+            const FloatType c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+
+            return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+    };
+
+    // ========================== Matrix header ========================= //
+
+    // A row-major matrix of any fixed size. As with Vector, the 2x2 and 3x3
+    // classes remain the main API and can be converted to and from it.
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> class Matrix
+    {
+    public:
+        static constexpr int32bit ZERO_MATRIX = 0x0;
+        static constexpr int32bit IDENTITY_MATRIX = 0x1;
+
+        FloatType values[Rows][Columns];
+
+        constexpr Matrix();
+        explicit constexpr Matrix(const int32bit matrixType);
+
+        inline void setToIdentity();
+        inline void setToZero();
+
+        inline FloatType & operator()(const uint32bit row, const uint32bit column);
+        inline FloatType operator()(const uint32bit row, const uint32bit column) const;
+
+        inline Vector<FloatType, Columns> row(const uint32bit index) const;
+        inline Vector<FloatType, Rows> column(const uint32bit index) const;
+
+        inline Matrix<FloatType, Columns, Rows> getTransposed() const;
+
+        // Defined for square matrices only
+        inline FloatType determinant() const;
+
+        template<uint32bit ResultColumns> inline Matrix<FloatType, Rows, ResultColumns> operator*(const Matrix<FloatType, Columns, ResultColumns> & matrix) const;
+        inline Vector<FloatType, Rows> operator*(const Vector<FloatType, Columns> & vector) const;
+
+        inline Matrix<FloatType, Rows, Columns> operator+(const Matrix<FloatType, Rows, Columns> & matrix) const;
+        inline Matrix<FloatType, Rows, Columns> operator-(const Matrix<FloatType, Rows, Columns> & matrix) const;
+        inline Matrix<FloatType, Rows, Columns> operator*(const FloatType value) const;
+        inline Matrix<FloatType, Rows, Columns> operator/(const FloatType value) const;
+
+        inline Matrix<FloatType, Rows, Columns> & operator*=(const Matrix<FloatType, Columns, Columns> & matrix);
+        inline Matrix<FloatType, Rows, Columns> & operator*=(const FloatType value);
+        inline Matrix<FloatType, Rows, Columns> & operator/=(const FloatType value);
+    };
+
+    typedef Matrix<float, 4, 4> Matrix4x4F;
+    typedef Matrix<double, 4, 4> Matrix4x4;
+
+    // ====================== Matrix inline methods ===================== //
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> constexpr int32bit Matrix<FloatType, Rows, Columns>::ZERO_MATRIX;
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> constexpr int32bit Matrix<FloatType, Rows, Columns>::IDENTITY_MATRIX;
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> constexpr Matrix<FloatType, Rows, Columns>::Matrix()
+        : values()
+    {
+        for (uint32bit i = 0; i < Rows && i < Columns; i++) {
+            this->values[i][i] = FloatConstants<FloatType>::UNIT;
+        }
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> constexpr Matrix<FloatType, Rows, Columns>::Matrix(const int32bit matrixType)
+        : values()
+    {
+        if (matrixType != ZERO_MATRIX) {
+            for (uint32bit i = 0; i < Rows && i < Columns; i++) {
+                this->values[i][i] = FloatConstants<FloatType>::UNIT;
+            }
+        }
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> void Matrix<FloatType, Rows, Columns>::setToIdentity()
+    {
+        Unroll<Rows>::apply([&](const uint32bit i) {
+            Unroll<Columns>::apply([&](const uint32bit j) {
+                this->values[i][j] = i == j ? FloatConstants<FloatType>::UNIT : FloatConstants<FloatType>::ZERO;
+            });
+        });
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> void Matrix<FloatType, Rows, Columns>::setToZero()
+    {
+        Unroll<Rows>::apply([&](const uint32bit i) {
+            Unroll<Columns>::apply([&](const uint32bit j) { this->values[i][j] = FloatConstants<FloatType>::ZERO; });
+        });
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> FloatType & Matrix<FloatType, Rows, Columns>::operator()(const uint32bit row, const uint32bit column)
+    {
+        return this->values[row][column];
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> FloatType Matrix<FloatType, Rows, Columns>::operator()(const uint32bit row, const uint32bit column) const
+    {
+        return this->values[row][column];
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Vector<FloatType, Columns> Matrix<FloatType, Rows, Columns>::row(const uint32bit index) const
+    {
+        Vector<FloatType, Columns> result;
+        Unroll<Columns>::apply([&](const uint32bit j) { result.values[j] = this->values[index][j]; });
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Vector<FloatType, Rows> Matrix<FloatType, Rows, Columns>::column(const uint32bit index) const
+    {
+        Vector<FloatType, Rows> result;
+        Unroll<Rows>::apply([&](const uint32bit i) { result.values[i] = this->values[i][index]; });
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Columns, Rows> Matrix<FloatType, Rows, Columns>::getTransposed() const
+    {
+        Matrix<FloatType, Columns, Rows> result(Matrix<FloatType, Columns, Rows>::ZERO_MATRIX);
+
+        Unroll<Rows>::apply([&](const uint32bit i) {
+            Unroll<Columns>::apply([&](const uint32bit j) { result.values[j][i] = this->values[i][j]; });
+        });
+
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> FloatType Matrix<FloatType, Rows, Columns>::determinant() const
+    {
+        static_assert(Rows == Columns, "The determinant is defined for square matrices only");
+        return MatrixDeterminant<FloatType, Rows>::compute(this->values);
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> template<uint32bit ResultColumns> Matrix<FloatType, Rows, ResultColumns> Matrix<FloatType, Rows, Columns>::operator*(const Matrix<FloatType, Columns, ResultColumns> & matrix) const
+    {
+        Matrix<FloatType, Rows, ResultColumns> result(Matrix<FloatType, Rows, ResultColumns>::ZERO_MATRIX);
+        MatrixProductKernel<FloatType, Rows, Columns, ResultColumns>::multiply(this->values, matrix.values, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Vector<FloatType, Rows> Matrix<FloatType, Rows, Columns>::operator*(const Vector<FloatType, Columns> & vector) const
+    {
+        Vector<FloatType, Rows> result;
+        MatrixVectorKernel<FloatType, Rows, Columns>::multiply(this->values, vector.values, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> Matrix<FloatType, Rows, Columns>::operator+(const Matrix<FloatType, Rows, Columns> & matrix) const
+    {
+        Matrix<FloatType, Rows, Columns> result(ZERO_MATRIX);
+        VectorKernels<FloatType, Rows * Columns>::add(this->values[0], matrix.values[0], result.values[0]);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> Matrix<FloatType, Rows, Columns>::operator-(const Matrix<FloatType, Rows, Columns> & matrix) const
+    {
+        Matrix<FloatType, Rows, Columns> result(ZERO_MATRIX);
+        VectorKernels<FloatType, Rows * Columns>::subtract(this->values[0], matrix.values[0], result.values[0]);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> Matrix<FloatType, Rows, Columns>::operator*(const FloatType value) const
+    {
+        Matrix<FloatType, Rows, Columns> result(ZERO_MATRIX);
+        VectorKernels<FloatType, Rows * Columns>::multiply(this->values[0], value, result.values[0]);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> Matrix<FloatType, Rows, Columns>::operator/(const FloatType value) const
+    {
+        Matrix<FloatType, Rows, Columns> result(ZERO_MATRIX);
+        VectorKernels<FloatType, Rows * Columns>::multiply(this->values[0], FloatConstants<FloatType>::UNIT / value, result.values[0]);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> & Matrix<FloatType, Rows, Columns>::operator*=(const Matrix<FloatType, Columns, Columns> & matrix)
+    {
+        const Matrix<FloatType, Rows, Columns> source(*this);
+        MatrixProductKernel<FloatType, Rows, Columns, Columns>::multiply(source.values, matrix.values, this->values);
+        return (*this);
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> & Matrix<FloatType, Rows, Columns>::operator*=(const FloatType value)
+    {
+        VectorKernels<FloatType, Rows * Columns>::multiply(this->values[0], value, this->values[0]);
+        return (*this);
+    }
+
+    template<typename FloatType, uint32bit Rows, uint32bit Columns> Matrix<FloatType, Rows, Columns> & Matrix<FloatType, Rows, Columns>::operator/=(const FloatType value)
+    {
+        VectorKernels<FloatType, Rows * Columns>::multiply(this->values[0], FloatConstants<FloatType>::UNIT / value, this->values[0]);
+        return (*this);
+    }
+
+    // ================ Conversions of the existing classes ============== //
+
+    template<typename FloatType, class VectorType> inline Matrix<FloatType, 2, 2> toMatrix(const planimetry::Matrix2x2Template<FloatType, VectorType> & matrix)
+    {
+        Matrix<FloatType, 2, 2> result;
+
+        result.values[0][0] = matrix.r1c1;
+        result.values[0][1] = matrix.r1c2;
+        result.values[1][0] = matrix.r2c1;
+        result.values[1][1] = matrix.r2c2;
+
+        return result;
+    }
+
+    template<typename FloatType, class VectorType> inline Matrix<FloatType, 3, 3> toMatrix(const stereometry::Matrix3x3Template<FloatType, VectorType> & matrix)
+    {
+        Matrix<FloatType, 3, 3> result;
+
+        result.values[0][0] = matrix.r1c1;
+        result.values[0][1] = matrix.r1c2;
+        result.values[0][2] = matrix.r1c3;
+        result.values[1][0] = matrix.r2c1;
+        result.values[1][1] = matrix.r2c2;
+        result.values[1][2] = matrix.r2c3;
+        result.values[2][0] = matrix.r3c1;
+        result.values[2][1] = matrix.r3c2;
+        result.values[2][2] = matrix.r3c3;
+
+        return result;
+    }
+
+    // The affine transformation as a 4x4 matrix acting on (x, y, z, 1)
+    inline Matrix<float, 4, 4> toMatrix(const stereometry::Converter3F & converter)
+    {
+        Matrix<float, 4, 4> result;
+
+        result.values[0][0] = converter.warp.r1c1;
+        result.values[0][1] = converter.warp.r1c2;
+        result.values[0][2] = converter.warp.r1c3;
+        result.values[0][3] = converter.shift.x;
+        result.values[1][0] = converter.warp.r2c1;
+        result.values[1][1] = converter.warp.r2c2;
+        result.values[1][2] = converter.warp.r2c3;
+        result.values[1][3] = converter.shift.y;
+        result.values[2][0] = converter.warp.r3c1;
+        result.values[2][1] = converter.warp.r3c2;
+        result.values[2][2] = converter.warp.r3c3;
+        result.values[2][3] = converter.shift.z;
+        result.values[3][0] = 0.0f;
+        result.values[3][1] = 0.0f;
+        result.values[3][2] = 0.0f;
+        result.values[3][3] = 1.0f;
+
+        return result;
+    }
+
+    inline planimetry::Matrix2x2F toMatrix2x2F(const Matrix<float, 2, 2> & matrix)
+    {
+        return planimetry::Matrix2x2F(matrix.values[0][0], matrix.values[0][1], matrix.values[1][0], matrix.values[1][1]);
+    }
+
+    inline planimetry::Matrix2x2 toMatrix2x2(const Matrix<double, 2, 2> & matrix)
+    {
+        return planimetry::Matrix2x2(matrix.values[0][0], matrix.values[0][1], matrix.values[1][0], matrix.values[1][1]);
+    }
+
+    inline stereometry::Matrix3x3F toMatrix3x3F(const Matrix<float, 3, 3> & matrix)
+    {
+        return stereometry::Matrix3x3F(
+            matrix.values[0][0], matrix.values[0][1], matrix.values[0][2],
+            matrix.values[1][0], matrix.values[1][1], matrix.values[1][2],
+            matrix.values[2][0], matrix.values[2][1], matrix.values[2][2]
+        );
+    }
+
+    inline stereometry::Matrix3x3 toMatrix3x3(const Matrix<double, 3, 3> & matrix)
+    {
+        return stereometry::Matrix3x3(
+            matrix.values[0][0], matrix.values[0][1], matrix.values[0][2],
+            matrix.values[1][0], matrix.values[1][1], matrix.values[1][2],
+            matrix.values[2][0], matrix.values[2][1], matrix.values[2][2]
+        );
+    }
+}
+
+#endif /* _GEOMETRY_MATRIX_H_ */
@@ -0,0 +1,410 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Memory.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace geometry
+{
+    static size_t alignSize(const size_t size, const size_t alignment)
+    {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+    static uint8bit * alignPointer(uint8bit * pointer, const size_t alignment)
+    {
+        return pointer + (alignSize((size_t)(uintptr_t)pointer, alignment) - (size_t)(uintptr_t)pointer);
+    }
+
+    static void clearStatistics(MemoryStatistics & statistics)
+    {
+        statistics.reserved = 0;
+        statistics.used = 0;
+        statistics.wasted = 0;
+        statistics.systemAllocations = 0;
+    }
+
+    static void addStatistics(MemoryStatistics & sum, const MemoryStatistics & statistics)
+    {
+        sum.reserved += statistics.reserved;
+        sum.used += statistics.used;
+        sum.wasted += statistics.wasted;
+        sum.systemAllocations += statistics.systemAllocations;
+    }
+
+    // ====================== Monotonic arena ====================== //
+
+    const size_t Arena::DEFAULT_BLOCK_SIZE;
+
+    Arena::Arena(const size_t blockSize) : blocks(0), position(0), limit(0), blockSize(blockSize > 0 ? blockSize : DEFAULT_BLOCK_SIZE)
+    {
+        clearStatistics(this->statistics);
+    }
+
+    Arena::~Arena()
+    {
+        this->release();
+    }
+
+    void * Arena::allocate(const size_t size, const size_t alignment)
+    {
+        if (this->blocks != 0) {
+            uint8bit * start = alignPointer(this->position, alignment);
+
+            if (start <= this->limit && size <= (size_t)(this->limit - start)) {
+                this->statistics.wasted += (size_t)(start - this->position);
+                this->statistics.used += size;
+                this->position = start + size;
+                return start;
+            }
+        }
+
+        return this->allocateInNewBlock(size, alignment);
+    }
+
+    void * Arena::allocateInNewBlock(const size_t size, const size_t alignment)
+    {
+        if (size > (size_t)-1 - sizeof(Block) - alignment) {
+            return 0;
+        }
+
+        // Requests larger than a block get a block of their own
+        const size_t required = size + alignment;
+        Block * block = this->createBlock(required > this->blockSize ? required : this->blockSize);
+
+        if (block == 0) {
+            return 0;
+        }
+
+        this->statistics.wasted += (size_t)(this->limit - this->position);
+
+        block->next = this->blocks;
+        this->blocks = block;
+
+        this->position = (uint8bit *)(block + 1);
+        this->limit = this->position + block->size;
+
+        return this->allocate(size, alignment);
+    }
+
+    Arena::Block * Arena::createBlock(const size_t size)
+    {
+        Block * block = (Block *)malloc(sizeof(Block) + size);
+
+        if (block == 0) {
+            return 0;
+        }
+
+        block->next = 0;
+        block->size = size;
+
+        this->statistics.reserved += size;
+        this->statistics.systemAllocations++;
+
+        return block;
+    }
+
+    void Arena::reset()
+    {
+        if (this->blocks != 0 && this->blocks->next != 0) {
+            const size_t total = this->statistics.reserved;
+
+            this->release();
+            this->blocks = this->createBlock(total);
+        }
+
+        if (this->blocks != 0) {
+            this->position = (uint8bit *)(this->blocks + 1);
+            this->limit = this->position + this->blocks->size;
+        }
+
+        this->statistics.used = 0;
+        this->statistics.wasted = 0;
+    }
+
+    void Arena::release()
+    {
+        while (this->blocks != 0) {
+            Block * next = this->blocks->next;
+            ::free(this->blocks);
+            this->blocks = next;
+        }
+
+        this->position = 0;
+        this->limit = 0;
+
+        this->statistics.reserved = 0;
+        this->statistics.used = 0;
+        this->statistics.wasted = 0;
+    }
+
+    void Arena::getStatistics(MemoryStatistics & statistics) const
+    {
+        statistics = this->statistics;
+    }
+
+    // ====================== Thread arenas ====================== //
+
+    // The last set and arena used by the thread. Sets are told apart by
+    // identifiers rather than by addresses which may be reused.
+    struct LocalArena
+    {
+        uint64bit set;
+        Arena * arena;
+    };
+
+    static thread_local LocalArena localArena = { 0, 0 };
+
+    static std::atomic<uint64bit> lastArenaSet(0);
+
+    ArenaSet::ArenaSet(const size_t blockSize) : blockSize(blockSize), identifier(++lastArenaSet)
+    {
+    }
+
+    ArenaSet::~ArenaSet()
+    {
+        for (size_t i = 0; i < this->entries.size(); i++) {
+            delete this->entries[i].arena;
+        }
+    }
+
+    Arena & ArenaSet::getLocal()
+    {
+        if (localArena.set == this->identifier) {
+            return *localArena.arena;
+        }
+
+        const std::thread::id thread = std::this_thread::get_id();
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        Arena * arena = 0;
+
+        for (size_t i = 0; i < this->entries.size() && arena == 0; i++) {
+            if (this->entries[i].thread == thread) {
+                arena = this->entries[i].arena;
+            }
+        }
+
+        if (arena == 0) {
+            Entry entry;
+            entry.thread = thread;
+            entry.arena = arena = new Arena(this->blockSize);
+            this->entries.push_back(entry);
+        }
+
+        localArena.set = this->identifier;
+        localArena.arena = arena;
+
+        return *arena;
+    }
+
+    void ArenaSet::reset()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        for (size_t i = 0; i < this->entries.size(); i++) {
+            this->entries[i].arena->reset();
+        }
+    }
+
+    void ArenaSet::release()
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        for (size_t i = 0; i < this->entries.size(); i++) {
+            this->entries[i].arena->release();
+        }
+    }
+
+    void ArenaSet::getStatistics(MemoryStatistics & statistics) const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        clearStatistics(statistics);
+
+        for (size_t i = 0; i < this->entries.size(); i++) {
+            MemoryStatistics arenaStatistics;
+            this->entries[i].arena->getStatistics(arenaStatistics);
+            addStatistics(statistics, arenaStatistics);
+        }
+    }
+
+    // ================= Fixed size pool allocator ================= //
+
+    PoolAllocator::PoolAllocator(const size_t itemSize, const size_t itemsPerChunk, const size_t alignment)
+        : itemSize(itemSize), itemsPerChunk(itemsPerChunk > 0 ? itemsPerChunk : 1),
+          alignment(alignment > alignof(FreeItem) ? alignment : alignof(FreeItem)),
+          chunkInUse(0), itemsTaken(0), freeItems(0)
+    {
+        // Free items keep the link to the next one in their own memory
+        this->stride = alignSize(itemSize > sizeof(FreeItem) ? itemSize : sizeof(FreeItem), this->alignment);
+
+        clearStatistics(this->statistics);
+    }
+
+    PoolAllocator::~PoolAllocator()
+    {
+        this->release();
+    }
+
+    uint8bit * PoolAllocator::getChunk(const size_t index) const
+    {
+        return alignPointer((uint8bit *)this->chunks[index], this->alignment);
+    }
+
+    void * PoolAllocator::allocate()
+    {
+        void * item = 0;
+
+        if (this->freeItems != 0) {
+            item = this->freeItems;
+            this->freeItems = this->freeItems->next;
+        }
+        else {
+            if (this->itemsTaken == this->itemsPerChunk && this->chunkInUse < this->chunks.size()) {
+                this->chunkInUse++;
+                this->itemsTaken = 0;
+            }
+
+            if (this->chunkInUse == this->chunks.size()) {
+                const size_t chunkSize = this->stride * this->itemsPerChunk + this->alignment;
+                void * chunk = malloc(chunkSize);
+
+                if (chunk == 0) {
+                    return 0;
+                }
+
+                this->chunks.push_back(chunk);
+                this->statistics.reserved += chunkSize;
+                this->statistics.systemAllocations++;
+            }
+
+            item = this->getChunk(this->chunkInUse) + this->itemsTaken * this->stride;
+            this->itemsTaken++;
+        }
+
+        this->statistics.used += this->itemSize;
+        this->statistics.wasted += this->stride - this->itemSize;
+
+        return item;
+    }
+
+    void PoolAllocator::free(void * item)
+    {
+        if (item == 0) {
+            return;
+        }
+
+        FreeItem * freeItem = (FreeItem *)item;
+        freeItem->next = this->freeItems;
+        this->freeItems = freeItem;
+
+        this->statistics.used -= this->itemSize;
+        this->statistics.wasted -= this->stride - this->itemSize;
+    }
+
+    void PoolAllocator::reset()
+    {
+        this->chunkInUse = 0;
+        this->itemsTaken = 0;
+        this->freeItems = 0;
+
+        this->statistics.used = 0;
+        this->statistics.wasted = 0;
+    }
+
+    void PoolAllocator::release()
+    {
+        for (size_t i = 0; i < this->chunks.size(); i++) {
+            ::free(this->chunks[i]);
+        }
+
+        this->chunks.clear();
+        this->reset();
+        this->statistics.reserved = 0;
+    }
+
+    size_t PoolAllocator::getItemSize() const
+    {
+        return this->itemSize;
+    }
+
+    size_t PoolAllocator::getAlignment() const
+    {
+        return this->alignment;
+    }
+
+    void PoolAllocator::getStatistics(MemoryStatistics & statistics) const
+    {
+        statistics = this->statistics;
+    }
+
+    // ===================== Pools by item size ===================== //
+
+    PoolSet::PoolSet(const size_t itemsPerChunk) : itemsPerChunk(itemsPerChunk)
+    {
+    }
+
+    PoolSet::~PoolSet()
+    {
+        for (size_t i = 0; i < this->pools.size(); i++) {
+            delete this->pools[i];
+        }
+    }
+
+    PoolAllocator & PoolSet::getPool(const size_t itemSize, const size_t alignment)
+    {
+        // A container uses two or three sizes, a list is found faster than
+        // a map. A pool aligned more than asked for serves as well.
+        for (size_t i = 0; i < this->pools.size(); i++) {
+            if (this->pools[i]->getItemSize() == itemSize && this->pools[i]->getAlignment() >= alignment) {
+                return *this->pools[i];
+            }
+        }
+
+        this->pools.push_back(new PoolAllocator(itemSize, this->itemsPerChunk, alignment));
+
+        return *this->pools.back();
+    }
+
+    void PoolSet::reset()
+    {
+        for (size_t i = 0; i < this->pools.size(); i++) {
+            this->pools[i]->reset();
+        }
+    }
+
+    void PoolSet::release()
+    {
+        for (size_t i = 0; i < this->pools.size(); i++) {
+            this->pools[i]->release();
+        }
+    }
+
+    void PoolSet::getStatistics(MemoryStatistics & statistics) const
+    {
+        clearStatistics(statistics);
+
+        for (size_t i = 0; i < this->pools.size(); i++) {
+            MemoryStatistics poolStatistics;
+            this->pools[i]->getStatistics(poolStatistics);
+            addStatistics(statistics, poolStatistics);
+        }
+    }
+}
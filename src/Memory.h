@@ -0,0 +1,366 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_MEMORY_H_
+#define _GEOMETRY_MEMORY_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+
+namespace geometry
+{
+    // Bytes taken from the system (reserved), handed out to the callers
+    // (used) and lost to alignment or to block tails that were too short
+    // for a request (wasted). systemAllocations counts the calls to malloc,
+    // in the steady state of a reused allocator it stays the same.
+    struct MemoryStatistics
+    {
+        size_t reserved;
+        size_t used;
+        size_t wasted;
+        uint64bit systemAllocations;
+    };
+
+    // ====================== Monotonic arena ====================== //
+
+    // Allocates from large blocks by moving a pointer, single allocations
+    // cannot be freed. reset() makes all the memory available again without
+    // returning it to the system: when the arena had to grow, the blocks are
+    // merged into one, so a builder that needs the same amount of memory on
+    // every rebuild stops calling malloc after the first one.
+    //
+    // An arena is not thread safe, parallel builders use an ArenaSet.
+    class Arena
+    {
+    public:
+        static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit Arena(const size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~Arena();
+
+        // Returns 0 when the system is out of memory. alignment must be
+        // a power of two.
+        void * allocate(const size_t size, const size_t alignment = alignof(double));
+
+        // Memory for count objects of type T, the objects are not constructed
+        template<typename T> T * allocateArray(const size_t count);
+
+        // Constructs an object in the arena, its destructor is never called
+        template<typename T, typename... Arguments> T * create(Arguments &&... arguments);
+
+        void reset();
+
+        // Returns all the blocks to the system
+        void release();
+
+        void getStatistics(MemoryStatistics & statistics) const;
+
+    private:
+        struct Block
+        {
+            Block * next;
+            size_t size;
+        };
+
+        Block * blocks;
+        uint8bit * position;
+        uint8bit * limit;
+        size_t blockSize;
+
+        MemoryStatistics statistics;
+
+        void * allocateInNewBlock(const size_t size, const size_t alignment);
+        Block * createBlock(const size_t size);
+
+        Arena(const Arena &);
+        Arena & operator=(const Arena &);
+    };
+
+    template<typename T> T * Arena::allocateArray(const size_t count)
+    {
+        if (count > (size_t)-1 / sizeof(T)) {
+            return 0;
+        }
+
+        return (T *)this->allocate(sizeof(T) * count, alignof(T));
+    }
+
+    template<typename T, typename... Arguments> T * Arena::create(Arguments &&... arguments)
+    {
+        void * memory = this->allocate(sizeof(T), alignof(T));
+
+        return memory != 0 ? new (memory) T(std::forward<Arguments>(arguments)...) : 0;
+    }
+
+    // ==================== Standard allocator ==================== //
+
+    // Lets standard containers draw from an arena. deallocate does nothing,
+    // the memory comes back with the reset of the arena.
+    template<typename T> class ArenaAllocator
+    {
+    public:
+        typedef T value_type;
+
+        Arena * arena;
+
+        explicit ArenaAllocator(Arena & arena) : arena(&arena)
+        {
+        }
+
+        template<typename U> ArenaAllocator(const ArenaAllocator<U> & allocator) : arena(allocator.arena)
+        {
+        }
+
+        T * allocate(const size_t count)
+        {
+            T * memory = this->arena->allocateArray<T>(count);
+
+            if (memory == 0) {
+                throw std::bad_alloc();
+            }
+
+            return memory;
+        }
+
+        void deallocate(T *, const size_t)
+        {
+        }
+
+        template<typename U> bool operator==(const ArenaAllocator<U> & allocator) const
+        {
+            return this->arena == allocator.arena;
+        }
+
+        template<typename U> bool operator!=(const ArenaAllocator<U> & allocator) const
+        {
+            return this->arena != allocator.arena;
+        }
+    };
+
+    // ====================== Thread arenas ====================== //
+
+    // One arena per thread for parallel builders, every thread gets its own
+    // arena on the first call of getLocal(). The arenas stay alive until the
+    // set is destroyed, reset() resets all of them and must not be called
+    // while a builder is running.
+    class ArenaSet
+    {
+    public:
+        explicit ArenaSet(const size_t blockSize = Arena::DEFAULT_BLOCK_SIZE);
+        ~ArenaSet();
+
+        Arena & getLocal();
+
+        void reset();
+        void release();
+
+        // The sums over the arenas of all threads
+        void getStatistics(MemoryStatistics & statistics) const;
+
+    private:
+        struct Entry
+        {
+            std::thread::id thread;
+            Arena * arena;
+        };
+
+        size_t blockSize;
+        uint64bit identifier;
+
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+
+        ArenaSet(const ArenaSet &);
+        ArenaSet & operator=(const ArenaSet &);
+    };
+
+    // ================= Fixed size pool allocator ================= //
+
+    // Hands out items of one size from chunks of itemsPerChunk items and
+    // keeps the freed items in a list. reset() frees all the items at once
+    // and keeps the chunks. Not thread safe.
+    class PoolAllocator
+    {
+    public:
+        PoolAllocator(const size_t itemSize, const size_t itemsPerChunk = 256, const size_t alignment = alignof(double));
+        ~PoolAllocator();
+
+        // Returns 0 when the system is out of memory
+        void * allocate();
+        void free(void * item);
+
+        void reset();
+        void release();
+
+        size_t getItemSize() const;
+        size_t getAlignment() const;
+
+        void getStatistics(MemoryStatistics & statistics) const;
+
+    private:
+        struct FreeItem
+        {
+            FreeItem * next;
+        };
+
+        size_t itemSize;
+        size_t itemsPerChunk;
+        size_t alignment;
+        size_t stride;
+
+        std::vector<void *> chunks;
+        size_t chunkInUse;
+        size_t itemsTaken;
+        FreeItem * freeItems;
+
+        MemoryStatistics statistics;
+
+        uint8bit * getChunk(const size_t index) const;
+
+        PoolAllocator(const PoolAllocator &);
+        PoolAllocator & operator=(const PoolAllocator &);
+    };
+
+    // Typed front end of PoolAllocator constructing and destroying objects
+    template<typename T> class ObjectPool
+    {
+    public:
+        explicit ObjectPool(const size_t itemsPerChunk = 256) : pool(sizeof(T), itemsPerChunk, alignof(T))
+        {
+        }
+
+        template<typename... Arguments> T * create(Arguments &&... arguments)
+        {
+            void * memory = this->pool.allocate();
+
+            return memory != 0 ? new (memory) T(std::forward<Arguments>(arguments)...) : 0;
+        }
+
+        void destroy(T * object)
+        {
+            if (object != 0) {
+                object->~T();
+                this->pool.free(object);
+            }
+        }
+
+        // Frees all objects without calling their destructors
+        void reset()
+        {
+            this->pool.reset();
+        }
+
+        void getStatistics(MemoryStatistics & statistics) const
+        {
+            this->pool.getStatistics(statistics);
+        }
+
+    private:
+        PoolAllocator pool;
+    };
+
+    // ===================== Pools by item size ===================== //
+
+    // A pool for every item size asked for, so node based containers, as
+    // std::unordered_set, take their nodes from the pools through
+    // PoolSetAllocator. Not thread safe.
+    class PoolSet
+    {
+    public:
+        explicit PoolSet(const size_t itemsPerChunk = 256);
+        ~PoolSet();
+
+        PoolAllocator & getPool(const size_t itemSize, const size_t alignment);
+
+        void reset();
+        void release();
+
+        // The sums over the pools
+        void getStatistics(MemoryStatistics & statistics) const;
+
+    private:
+        size_t itemsPerChunk;
+        std::vector<PoolAllocator *> pools;
+
+        PoolSet(const PoolSet &);
+        PoolSet & operator=(const PoolSet &);
+    };
+
+    // Lets standard containers draw single items from a pool set. Arrays,
+    // as the buckets of a hash set, come from the heap; a container which
+    // does not grow past its largest size reuses them.
+    template<typename T> class PoolSetAllocator
+    {
+    public:
+        typedef T value_type;
+
+        PoolSet * pools;
+
+        explicit PoolSetAllocator(PoolSet & pools) : pools(&pools)
+        {
+        }
+
+        template<typename U> PoolSetAllocator(const PoolSetAllocator<U> & allocator) : pools(allocator.pools)
+        {
+        }
+
+        T * allocate(const size_t count)
+        {
+            if (count != 1) {
+                return std::allocator<T>().allocate(count);
+            }
+
+            void * memory = this->pools->getPool(sizeof(T), alignof(T)).allocate();
+
+            if (memory == 0) {
+                throw std::bad_alloc();
+            }
+
+            return (T *)memory;
+        }
+
+        void deallocate(T * memory, const size_t count)
+        {
+            if (count != 1) {
+                std::allocator<T>().deallocate(memory, count);
+            }
+            else {
+                this->pools->getPool(sizeof(T), alignof(T)).free(memory);
+            }
+        }
+
+        template<typename U> bool operator==(const PoolSetAllocator<U> & allocator) const
+        {
+            return this->pools == allocator.pools;
+        }
+
+        template<typename U> bool operator!=(const PoolSetAllocator<U> & allocator) const
+        {
+            return this->pools != allocator.pools;
+        }
+    };
+}
+
+#endif /* _GEOMETRY_MEMORY_H_ */
@@ -0,0 +1,317 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Profiler.h"
+
+#include <string.h>
+#include <chrono>
+#include <mutex>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace geometry
+{
+    // ==================== Region registry ==================== //
+
+    static std::mutex & getRegistryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<ProfileRegion *> & getRegistry()
+    {
+        static std::vector<ProfileRegion *> regions;
+        return regions;
+    }
+
+    static uint64bit getNanoseconds()
+    {
+        return (uint64bit)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // =================== Hardware counters =================== //
+
+#ifdef __linux__
+
+    // One counter group per thread, opened on the first use in the thread
+    class ThreadCounters
+    {
+    public:
+        ThreadCounters() : amount(0)
+        {
+            static const uint32bit types[PROFILE_COUNTER_AMOUNT] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE
+            };
+
+            static const uint64bit configs[PROFILE_COUNTER_AMOUNT] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES
+            };
+
+            for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+                perf_event_attr attributes;
+                memset(&attributes, 0, sizeof(attributes));
+
+                attributes.size = sizeof(attributes);
+                attributes.type = types[i];
+                attributes.config = configs[i];
+                attributes.disabled = this->amount == 0 ? 1 : 0;
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                const int leader = this->amount == 0 ? -1 : this->descriptors[0];
+                const int descriptor = (int)syscall(__NR_perf_event_open, &attributes, 0, -1, leader, 0);
+
+                // Counters missing on this processor or in a virtual machine are skipped
+                if (descriptor >= 0) {
+                    this->descriptors[this->amount] = descriptor;
+                    this->slots[this->amount] = (ProfileCounter)i;
+                    this->amount++;
+                }
+            }
+
+            if (this->amount > 0) {
+                ioctl(this->descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(this->descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+
+        ~ThreadCounters()
+        {
+            for (uint32bit i = this->amount; i > 0; i--) {
+                close(this->descriptors[i - 1]);
+            }
+        }
+
+        bool isOpen() const
+        {
+            return this->amount > 0;
+        }
+
+        // Cumulative values scaled up when the group had to share the
+        // hardware with other groups, unavailable counters stay zero
+        void read(uint64bit * values) const
+        {
+            memset(values, 0, sizeof(uint64bit) * PROFILE_COUNTER_AMOUNT);
+
+            if (this->amount == 0) {
+                return;
+            }
+
+            uint64bit buffer[3 + PROFILE_COUNTER_AMOUNT];
+            const ssize_t expected = (ssize_t)(sizeof(uint64bit) * (3 + this->amount));
+
+            if (::read(this->descriptors[0], buffer, sizeof(buffer)) != expected || buffer[2] == 0) {
+                return;
+            }
+
+            const double scale = (double)buffer[1] / (double)buffer[2];
+
+            for (uint32bit i = 0; i < this->amount; i++) {
+                values[this->slots[i]] = buffer[1] == buffer[2] ? buffer[3 + i] : (uint64bit)((double)buffer[3 + i] * scale);
+            }
+        }
+
+    private:
+        int descriptors[PROFILE_COUNTER_AMOUNT];
+        ProfileCounter slots[PROFILE_COUNTER_AMOUNT];
+        uint32bit amount;
+
+        ThreadCounters(const ThreadCounters &);
+        ThreadCounters & operator=(const ThreadCounters &);
+    };
+
+    static ThreadCounters & getThreadCounters()
+    {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    static void readCounters(uint64bit * values)
+    {
+        getThreadCounters().read(values);
+    }
+
+    bool Profiler::hasHardwareCounters()
+    {
+        return getThreadCounters().isOpen();
+    }
+
+#else
+
+    static void readCounters(uint64bit * values)
+    {
+        memset(values, 0, sizeof(uint64bit) * PROFILE_COUNTER_AMOUNT);
+    }
+
+    bool Profiler::hasHardwareCounters()
+    {
+        return false;
+    }
+
+#endif
+
+    // ===================== ProfileRegion ===================== //
+
+    ProfileRegion::ProfileRegion(const char * name) : name(name), calls(0), nanoseconds(0)
+    {
+        for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+            this->counters[i] = 0;
+        }
+
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+        getRegistry().push_back(this);
+    }
+
+    void ProfileRegion::add(const uint64bit nanoseconds, const uint64bit * counters)
+    {
+        this->calls.fetch_add(1, std::memory_order_relaxed);
+        this->nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+        for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+            this->counters[i].fetch_add(counters[i], std::memory_order_relaxed);
+        }
+    }
+
+    void ProfileRegion::getStatistics(ProfileStatistics & statistics) const
+    {
+        statistics.name = this->name;
+        statistics.calls = this->calls.load(std::memory_order_relaxed);
+        statistics.nanoseconds = this->nanoseconds.load(std::memory_order_relaxed);
+
+        for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+            statistics.counters[i] = this->counters[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void ProfileRegion::reset()
+    {
+        this->calls = 0;
+        this->nanoseconds = 0;
+
+        for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+            this->counters[i] = 0;
+        }
+    }
+
+    // ====================== ProfileScope ====================== //
+
+    ProfileScope::ProfileScope(ProfileRegion & region) : region(region)
+    {
+        readCounters(this->startCounters);
+        this->startTime = getNanoseconds();
+    }
+
+    ProfileScope::~ProfileScope()
+    {
+        const uint64bit finishTime = getNanoseconds();
+
+        uint64bit counters[PROFILE_COUNTER_AMOUNT];
+        readCounters(counters);
+
+        for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+            counters[i] = counters[i] > this->startCounters[i] ? counters[i] - this->startCounters[i] : 0;
+        }
+
+        this->region.add(finishTime - this->startTime, counters);
+    }
+
+    // ======================== Profiler ======================== //
+
+    void Profiler::getStatistics(std::vector<ProfileStatistics> & statistics)
+    {
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+
+        const std::vector<ProfileRegion *> & regions = getRegistry();
+
+        statistics.resize(regions.size());
+
+        for (size_t i = 0; i < regions.size(); i++) {
+            regions[i]->getStatistics(statistics[i]);
+        }
+    }
+
+    void Profiler::reset()
+    {
+        std::lock_guard<std::mutex> lock(getRegistryMutex());
+
+        const std::vector<ProfileRegion *> & regions = getRegistry();
+
+        for (size_t i = 0; i < regions.size(); i++) {
+            regions[i]->reset();
+        }
+    }
+
+    void Profiler::dump(FILE * stream)
+    {
+        std::vector<ProfileStatistics> statistics;
+        getStatistics(statistics);
+
+        fprintf(stream, "%-32s %10s %12s", "region", "calls", "ms");
+
+        for (uint32bit i = 0; i < PROFILE_COUNTER_AMOUNT; i++) {
+            fprintf(stream, " %14s", getProfileCounterName((ProfileCounter)i));
+        }
+
+        fprintf(stream, " %6s\n", "ipc");
+
+        for (size_t i = 0; i < statistics.size(); i++) {
+            const ProfileStatistics & region = statistics[i];
+
+            if (region.calls == 0) {
+                continue;
+            }
+
+            fprintf(stream, "%-32s %10llu %12.3f", region.name, (unsigned long long)region.calls, (double)region.nanoseconds * 1.0E-6);
+
+            for (uint32bit j = 0; j < PROFILE_COUNTER_AMOUNT; j++) {
+                fprintf(stream, " %14llu", (unsigned long long)region.counters[j]);
+            }
+
+            const uint64bit cycles = region.counters[CYCLES_COUNTER];
+            fprintf(stream, " %6.2f\n", cycles == 0 ? 0.0 : (double)region.counters[INSTRUCTIONS_COUNTER] / (double)cycles);
+        }
+    }
+
+    const char * getProfileCounterName(const ProfileCounter counter)
+    {
+        switch (counter) {
+        case CYCLES_COUNTER:
+            return "cycles";
+        case INSTRUCTIONS_COUNTER:
+            return "instructions";
+        case L1_DATA_MISSES_COUNTER:
+            return "l1d-misses";
+        case LAST_LEVEL_CACHE_MISSES_COUNTER:
+            return "llc-misses";
+        case BRANCH_MISSES_COUNTER:
+            return "branch-misses";
+        default:
+            return "unknown";
+        }
+    }
+}
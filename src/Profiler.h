@@ -0,0 +1,117 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_PROFILER_H_
+#define _GEOMETRY_PROFILER_H_
+
+#include <stdio.h>
+#include <vector>
+#include <atomic>
+
+#include "types.h"
+
+// Profiling regions are compiled out unless GEOMETRY_PROFILING is defined.
+// With it every region records its calls, wall time and, on Linux, the
+// perf_event counters of the thread that entered the region.
+#ifdef GEOMETRY_PROFILING
+#define GEOMETRY_PROFILE_CONCATENATE_(a, b) a##b
+#define GEOMETRY_PROFILE_CONCATENATE(a, b) GEOMETRY_PROFILE_CONCATENATE_(a, b)
+#define GEOMETRY_PROFILE_SCOPE(name) \
+    static geometry::ProfileRegion GEOMETRY_PROFILE_CONCATENATE(geometryProfileRegion, __LINE__)(name); \
+    geometry::ProfileScope GEOMETRY_PROFILE_CONCATENATE(geometryProfileScope, __LINE__)(GEOMETRY_PROFILE_CONCATENATE(geometryProfileRegion, __LINE__))
+#else
+#define GEOMETRY_PROFILE_SCOPE(name)
+#endif
+
+namespace geometry
+{
+    enum ProfileCounter {
+        CYCLES_COUNTER,
+        INSTRUCTIONS_COUNTER,
+        L1_DATA_MISSES_COUNTER,
+        LAST_LEVEL_CACHE_MISSES_COUNTER,
+        BRANCH_MISSES_COUNTER,
+        PROFILE_COUNTER_AMOUNT
+    };
+
+    struct ProfileStatistics
+    {
+        const char * name;
+        uint64bit calls;
+        uint64bit nanoseconds;
+        uint64bit counters[PROFILE_COUNTER_AMOUNT];
+    };
+
+    // A named region aggregating the measurements of all its scopes. Regions
+    // must have static storage duration, they register themselves on creation.
+    class ProfileRegion
+    {
+    public:
+        explicit ProfileRegion(const char * name);
+
+        void add(const uint64bit nanoseconds, const uint64bit * counters);
+
+        void getStatistics(ProfileStatistics & statistics) const;
+        void reset();
+
+    private:
+        const char * name;
+        std::atomic<uint64bit> calls;
+        std::atomic<uint64bit> nanoseconds;
+        std::atomic<uint64bit> counters[PROFILE_COUNTER_AMOUNT];
+
+        ProfileRegion(const ProfileRegion &);
+        ProfileRegion & operator=(const ProfileRegion &);
+    };
+
+    // Measures the lifetime of the object. Nested scopes are inclusive.
+    // The counters cover the calling thread only, work done by helper
+    // threads inside the region is reflected in the wall time alone.
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(ProfileRegion & region);
+        ~ProfileScope();
+
+    private:
+        ProfileRegion & region;
+        uint64bit startTime;
+        uint64bit startCounters[PROFILE_COUNTER_AMOUNT];
+
+        ProfileScope(const ProfileScope &);
+        ProfileScope & operator=(const ProfileScope &);
+    };
+
+    class Profiler
+    {
+    public:
+        // Whether hardware counters can be read in the calling thread. It is
+        // false on other systems than Linux and when perf_event_open is denied,
+        // regions still count calls and wall time then.
+        static bool hasHardwareCounters();
+
+        static void getStatistics(std::vector<ProfileStatistics> & statistics);
+        static void reset();
+
+        // Prints a table of all regions that were entered at least once
+        static void dump(FILE * stream = stdout);
+    };
+
+    const char * getProfileCounterName(const ProfileCounter counter);
+}
+
+#endif /* _GEOMETRY_PROFILER_H_ */
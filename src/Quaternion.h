@@ -27,29 +27,28 @@ namespace geometry
     template<typename FloatType> class BasicQuaternionTemplate
     {
     public:
-        static const FloatType ZERO;
-        static const FloatType UNIT;
-        static const FloatType EPSYLON;
-        static const FloatType NEGATIVE_EPSYLON;
-        static const FloatType SQUARE_EPSYLON;
+        static constexpr FloatType ZERO = FloatConstants<FloatType>::ZERO;
+        static constexpr FloatType UNIT = FloatConstants<FloatType>::UNIT;
+        static constexpr FloatType EPSYLON = FloatConstants<FloatType>::EPSYLON;
+        static constexpr FloatType NEGATIVE_EPSYLON = FloatConstants<FloatType>::NEGATIVE_EPSYLON;
+        static constexpr FloatType SQUARE_EPSYLON = FloatConstants<FloatType>::SQUARE_EPSYLON;
 
         FloatType w, x, y, z;
 
-        virtual ~BasicQuaternionTemplate()
-        {
-        }
+        constexpr BasicQuaternionTemplate();
+        constexpr BasicQuaternionTemplate(const FloatType w, const FloatType x, const FloatType y, const FloatType z);
 
-        inline void setValuesOf(const BasicQuaternionTemplate<FloatType> & q);
-        inline void setValues(const FloatType w, const FloatType x, const FloatType y, const FloatType z);
+        constexpr void setValuesOf(const BasicQuaternionTemplate<FloatType> & q);
+        constexpr void setValues(const FloatType w, const FloatType x, const FloatType y, const FloatType z);
 
-        inline void setToZero();
+        constexpr void setToZero();
 
-        inline bool isZero() const;
-        inline bool isUnit() const;
-        inline bool isCloseTo(const FloatType w, const FloatType x, const FloatType y, const FloatType z) const;
-        inline bool isCloseTo(const BasicQuaternionTemplate<FloatType>& quaternion) const;
+        constexpr bool isZero() const;
+        constexpr bool isUnit() const;
+        constexpr bool isCloseTo(const FloatType w, const FloatType x, const FloatType y, const FloatType z) const;
+        constexpr bool isCloseTo(const BasicQuaternionTemplate<FloatType>& quaternion) const;
 
-        inline void conjugate();
+        constexpr void conjugate();
     };
 
 
@@ -60,20 +59,19 @@ namespace geometry
     class Quaternion : public BasicQuaternionTemplate<double>
     {
     public:
-        inline Quaternion();
-        inline Quaternion(const QuaternionF & q);
-        inline Quaternion(const double w, const double x, const double y, const double z);
-        virtual ~Quaternion();
+        constexpr Quaternion();
+        constexpr Quaternion(const QuaternionF & q);
+        constexpr Quaternion(const double w, const double x, const double y, const double z);
 
-        inline void setValuesOf(const QuaternionF & q);
+        constexpr void setValuesOf(const QuaternionF & q);
 
-        inline Quaternion getConjugated() const;
+        constexpr Quaternion getConjugated() const;
 
         inline double module() const;
 
         inline bool normalize();
 
-        inline QuaternionF toFloat() const;
+        constexpr QuaternionF toFloat() const;
     };
 
 
@@ -83,26 +81,40 @@ namespace geometry
     {
     public:
 
-        inline QuaternionF();
-        inline QuaternionF(const Quaternion & q);
-        inline QuaternionF(const float w, const float x, const float y, const float z);
-        virtual ~QuaternionF();
+        constexpr QuaternionF();
+        constexpr QuaternionF(const Quaternion & q);
+        constexpr QuaternionF(const float w, const float x, const float y, const float z);
 
-        inline void setValuesOf(const Quaternion & q);
+        constexpr void setValuesOf(const Quaternion & q);
 
-        inline QuaternionF getConjugated() const;
+        constexpr QuaternionF getConjugated() const;
 
         inline float module() const;
 
         inline bool normalize();
 
-        inline Quaternion toDouble() const;
+        constexpr Quaternion toDouble() const;
     };
 
     // ============== Quaternion Template inline methods ============== //
 
+    template<typename FloatType> constexpr FloatType BasicQuaternionTemplate<FloatType>::ZERO;
+    template<typename FloatType> constexpr FloatType BasicQuaternionTemplate<FloatType>::UNIT;
+    template<typename FloatType> constexpr FloatType BasicQuaternionTemplate<FloatType>::EPSYLON;
+    template<typename FloatType> constexpr FloatType BasicQuaternionTemplate<FloatType>::NEGATIVE_EPSYLON;
+    template<typename FloatType> constexpr FloatType BasicQuaternionTemplate<FloatType>::SQUARE_EPSYLON;
+
+    template<typename FloatType> constexpr BasicQuaternionTemplate<FloatType>::BasicQuaternionTemplate()
+        : w(ZERO), x(ZERO), y(ZERO), z(ZERO)
+    {
+    }
+
+    template<typename FloatType> constexpr BasicQuaternionTemplate<FloatType>::BasicQuaternionTemplate(const FloatType w, const FloatType x, const FloatType y, const FloatType z)
+        : w(w), x(x), y(y), z(z)
+    {
+    }
 
-    template<typename FloatType> void BasicQuaternionTemplate<FloatType>::setValuesOf(const BasicQuaternionTemplate<FloatType> & q)
+    template<typename FloatType> constexpr void BasicQuaternionTemplate<FloatType>::setValuesOf(const BasicQuaternionTemplate<FloatType> & q)
     {
         this->w = q.w;
         this->x = q.x;
@@ -110,7 +122,7 @@ namespace geometry
         this->z = q.z;
     }
 
-    template<typename FloatType> void BasicQuaternionTemplate<FloatType>::setValues(const FloatType w, const FloatType x, const FloatType y, const FloatType z)
+    template<typename FloatType> constexpr void BasicQuaternionTemplate<FloatType>::setValues(const FloatType w, const FloatType x, const FloatType y, const FloatType z)
     {
         this->w = w;
         this->x = x;
@@ -118,7 +130,7 @@ namespace geometry
         this->z = z;
     }
 
-    template<typename FloatType> void BasicQuaternionTemplate<FloatType>::setToZero()
+    template<typename FloatType> constexpr void BasicQuaternionTemplate<FloatType>::setToZero()
     {
         this->x = ZERO;
         this->y = ZERO;
@@ -126,19 +138,19 @@ namespace geometry
         this->w = ZERO;
     }
 
-    template<typename FloatType> bool BasicQuaternionTemplate<FloatType>::isZero() const
+    template<typename FloatType> constexpr bool BasicQuaternionTemplate<FloatType>::isZero() const
     {
         return this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w <= SQUARE_EPSYLON;
     }
 
-    template<typename FloatType> bool BasicQuaternionTemplate<FloatType>::isUnit() const
+    template<typename FloatType> constexpr bool BasicQuaternionTemplate<FloatType>::isUnit() const
     {
         FloatType difference = this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w - UNIT;
 
         return NEGATIVE_EPSYLON <= difference && difference <= EPSYLON;
     }
 
-    template<typename FloatType> bool BasicQuaternionTemplate<FloatType>::isCloseTo(const FloatType w, const FloatType x, const FloatType y, const FloatType z) const
+    template<typename FloatType> constexpr bool BasicQuaternionTemplate<FloatType>::isCloseTo(const FloatType w, const FloatType x, const FloatType y, const FloatType z) const
     {
         FloatType dw = this->w - w;
         FloatType dx = this->x - x;
@@ -148,7 +160,7 @@ namespace geometry
         return dw * dw + dx * dx + dy * dy + dz * dz <= SQUARE_EPSYLON;
     }
 
-    template<typename FloatType> bool BasicQuaternionTemplate<FloatType>::isCloseTo(const BasicQuaternionTemplate<FloatType>& quaternion) const
+    template<typename FloatType> constexpr bool BasicQuaternionTemplate<FloatType>::isCloseTo(const BasicQuaternionTemplate<FloatType>& quaternion) const
     {
         FloatType dw = this->w - quaternion.w;
         FloatType dx = this->x - quaternion.x;
@@ -159,7 +171,7 @@ namespace geometry
 
     }
 
-    template<typename FloatType> void BasicQuaternionTemplate<FloatType>::conjugate()
+    template<typename FloatType> constexpr void BasicQuaternionTemplate<FloatType>::conjugate()
     {
         this->x = -this->x;
         this->y = -this->y;
@@ -168,31 +180,22 @@ namespace geometry
 
     // ============== Quaternion<double> inline methods =============== //
 
-    Quaternion::Quaternion()
+    constexpr Quaternion::Quaternion()
+        : BasicQuaternionTemplate<double>()
     {
-        this->w = ZERO;
-        this->x = ZERO;
-        this->y = ZERO;
-        this->z = ZERO;
     }
 
-    Quaternion::Quaternion(const QuaternionF & q)
+    constexpr Quaternion::Quaternion(const QuaternionF & q)
+        : BasicQuaternionTemplate<double>(q.w, q.x, q.y, q.z)
     {
-        this->w = q.w;
-        this->x = q.x;
-        this->y = q.y;
-        this->z = q.z;
     }
 
-    Quaternion::Quaternion(const double w, const double x, const double y, const double z)
+    constexpr Quaternion::Quaternion(const double w, const double x, const double y, const double z)
+        : BasicQuaternionTemplate<double>(w, x, y, z)
     {
-        this->w = w;
-        this->x = x;
-        this->y = y;
-        this->z = z;
     }
 
-    void Quaternion::setValuesOf(const QuaternionF & q)
+    constexpr void Quaternion::setValuesOf(const QuaternionF & q)
     {
         this->w = q.w;
         this->x = q.x;
@@ -200,7 +203,7 @@ namespace geometry
         this->z = q.z;
     }
 
-    Quaternion Quaternion::getConjugated() const
+    constexpr Quaternion Quaternion::getConjugated() const
     {
         return Quaternion(this->w, -this->x, -this->y, -this->z);
     }
@@ -230,38 +233,29 @@ namespace geometry
         return true;
     }
 
-    QuaternionF Quaternion::toFloat() const
+    constexpr QuaternionF Quaternion::toFloat() const
     {
         return QuaternionF((float)this->w, (float)this->x, (float)this->y, (float)this->z);
     }
 
     // =============== Quaternion<float> inline methods =============== //
 
-    QuaternionF::QuaternionF()
+    constexpr QuaternionF::QuaternionF()
+        : BasicQuaternionTemplate<float>()
     {
-        this->w = ZERO;
-        this->x = ZERO;
-        this->y = ZERO;
-        this->z = ZERO;
     }
 
-    QuaternionF::QuaternionF(const Quaternion & q)
+    constexpr QuaternionF::QuaternionF(const Quaternion & q)
+        : BasicQuaternionTemplate<float>((float)q.w, (float)q.x, (float)q.y, (float)q.z)
     {
-        this->w = (float)q.w;
-        this->x = (float)q.x;
-        this->y = (float)q.y;
-        this->z = (float)q.z;
     }
 
-    QuaternionF::QuaternionF(const float w, const float x, const float y, const float z)
+    constexpr QuaternionF::QuaternionF(const float w, const float x, const float y, const float z)
+        : BasicQuaternionTemplate<float>(w, x, y, z)
     {
-        this->w = w;
-        this->x = x;
-        this->y = y;
-        this->z = z;
     }
 
-    void QuaternionF::setValuesOf(const Quaternion & q)
+    constexpr void QuaternionF::setValuesOf(const Quaternion & q)
     {
         this->w = (float)q.w;
         this->x = (float)q.x;
@@ -269,7 +263,7 @@ namespace geometry
         this->z = (float)q.z;
     }
 
-    QuaternionF QuaternionF::getConjugated() const
+    constexpr QuaternionF QuaternionF::getConjugated() const
     {
         return QuaternionF(this->w, -this->x, -this->y, -this->z);
     }
@@ -299,7 +293,7 @@ namespace geometry
         return true;
     }
 
-    Quaternion QuaternionF::toDouble() const
+    constexpr Quaternion QuaternionF::toDouble() const
     {
         return Quaternion(this->w, this->x, this->y, this->z);
     }
@@ -0,0 +1,274 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ThreadPool.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace geometry
+{
+    static thread_local bool insideParallelLoop = false;
+
+    static std::atomic<uint32bit> defaultThreadCount(0);
+    static std::atomic<bool> defaultThreadPinning(false);
+
+    // Marks the calling thread as running a part of a loop for its lifetime
+    class ParallelLoopScope
+    {
+    public:
+        ParallelLoopScope()
+        {
+            insideParallelLoop = true;
+        }
+
+        ~ParallelLoopScope()
+        {
+            insideParallelLoop = false;
+        }
+    };
+
+    static uint32bit getCoreCount()
+    {
+        uint32bit cores = std::thread::hardware_concurrency();
+
+        return cores > 0 ? cores : 1;
+    }
+
+    static void pinCurrentThread(const uint32bit core)
+    {
+#ifdef _WIN32
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (core % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+        cpu_set_t cores;
+        CPU_ZERO(&cores);
+        CPU_SET(core % CPU_SETSIZE, &cores);
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+#else
+        (void)core;
+#endif
+    }
+
+    // ====================== Thread pool ====================== //
+
+    ThreadPool::ThreadPool(const uint32bit threadCount, const bool pinThreads)
+        : slices(threadCount > 0 ? threadCount : getCoreCount()), generation(0), pendingWorkers(0), stopping(false),
+          failure(), cancelled(false), body(0), function(0), grain(1), participants(0)
+    {
+        this->workers.reserve(this->slices.size() - 1);
+
+        for (uint32bit worker = 1; worker < this->slices.size(); worker++) {
+            this->workers.push_back(std::thread(&ThreadPool::serve, this, worker, pinThreads));
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->stateMutex);
+            this->stopping = true;
+        }
+
+        this->startCondition.notify_all();
+
+        for (size_t i = 0; i < this->workers.size(); i++) {
+            this->workers[i].join();
+        }
+    }
+
+    uint32bit ThreadPool::getThreadCount() const
+    {
+        return (uint32bit)this->slices.size();
+    }
+
+    ThreadPool & ThreadPool::getDefault()
+    {
+        static ThreadPool pool(defaultThreadCount.load(), defaultThreadPinning.load());
+        return pool;
+    }
+
+    void ThreadPool::setDefaultThreadCount(const uint32bit threadCount)
+    {
+        defaultThreadCount.store(threadCount);
+    }
+
+    void ThreadPool::setDefaultThreadPinning(const bool pinThreads)
+    {
+        defaultThreadPinning.store(pinThreads);
+    }
+
+    bool ThreadPool::isInsideParallelLoop()
+    {
+        return insideParallelLoop;
+    }
+
+    void ThreadPool::run(const size_t begin, const size_t end, const size_t grain, const LoopBody body, const void * function, const uint32bit maximalThreads)
+    {
+        const size_t partCount = (end - begin - 1) / grain + 1;
+
+        size_t threads = this->slices.size();
+
+        if (maximalThreads > 0 && maximalThreads < threads) {
+            threads = maximalThreads;
+        }
+
+        if (partCount < threads) {
+            threads = partCount;
+        }
+
+        std::unique_lock<std::mutex> loopLock(this->loopMutex, std::defer_lock);
+
+        if (threads < 2 || insideParallelLoop || !loopLock.try_lock()) {
+            for (size_t first = begin; first < end; first += grain) {
+                body(function, first, end - first > grain ? first + grain : end);
+            }
+            return;
+        }
+
+        // Every slice gets a whole number of parts, the first ones one more
+        const size_t partsPerSlice = partCount / threads;
+        const size_t extraParts = partCount % threads;
+
+        for (size_t i = 0, part = 0; i < threads; i++) {
+            Slice & slice = this->slices[i];
+
+            slice.next.store(begin + part * grain, std::memory_order_relaxed);
+            part += partsPerSlice + (i < extraParts ? 1 : 0);
+            slice.end = part < partCount ? begin + part * grain : end;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->stateMutex);
+
+            this->body = body;
+            this->function = function;
+            this->grain = grain;
+            this->participants = (uint32bit)threads;
+            this->pendingWorkers = (uint32bit)threads - 1;
+            this->failure = std::exception_ptr();
+            this->cancelled.store(false, std::memory_order_relaxed);
+            this->generation++;
+        }
+
+        this->startCondition.notify_all();
+
+        {
+            ParallelLoopScope scope;
+            this->work(0);
+        }
+
+        std::exception_ptr failure;
+
+        {
+            std::unique_lock<std::mutex> lock(this->stateMutex);
+
+            while (this->pendingWorkers > 0) {
+                this->finishCondition.wait(lock);
+            }
+
+            failure = this->failure;
+            this->failure = std::exception_ptr();
+        }
+
+        loopLock.unlock();
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    void ThreadPool::work(const uint32bit participant)
+    {
+        this->drain(this->slices[participant]);
+
+        for (uint32bit i = 1; i < this->participants; i++) {
+            this->drain(this->slices[(participant + i) % this->participants]);
+        }
+    }
+
+    void ThreadPool::drain(Slice & slice)
+    {
+        while (!this->cancelled.load(std::memory_order_relaxed)) {
+            const size_t first = slice.next.fetch_add(this->grain, std::memory_order_relaxed);
+
+            if (first >= slice.end) {
+                return;
+            }
+
+            try {
+                this->body(this->function, first, slice.end - first > this->grain ? first + this->grain : slice.end);
+            }
+            catch (...) {
+                this->fail(std::current_exception());
+                return;
+            }
+        }
+    }
+
+    void ThreadPool::fail(const std::exception_ptr & exception)
+    {
+        std::lock_guard<std::mutex> lock(this->stateMutex);
+
+        if (!this->failure) {
+            this->failure = exception;
+        }
+
+        this->cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    void ThreadPool::serve(const uint32bit worker, const bool pinThread)
+    {
+        if (pinThread) {
+            pinCurrentThread(worker % getCoreCount());
+        }
+
+        // Loops started by the workers themselves always stay in their thread
+        insideParallelLoop = true;
+
+        uint64bit seenGeneration = 0;
+
+        std::unique_lock<std::mutex> lock(this->stateMutex);
+
+        while (true) {
+            while (!this->stopping && this->generation == seenGeneration) {
+                this->startCondition.wait(lock);
+            }
+
+            if (this->stopping) {
+                return;
+            }
+
+            seenGeneration = this->generation;
+
+            if (worker >= this->participants) {
+                continue;
+            }
+
+            lock.unlock();
+            this->work(worker);
+            lock.lock();
+
+            if (--this->pendingWorkers == 0) {
+                this->finishCondition.notify_one();
+            }
+        }
+    }
+}
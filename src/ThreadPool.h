@@ -0,0 +1,195 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_THREAD_POOL_H_
+#define _GEOMETRY_THREAD_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "types.h"
+
+#if defined(GEOMETRY_USE_TBB)
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#elif defined(GEOMETRY_USE_OPENMP)
+#include <omp.h>
+#endif
+
+// The batch kernels of the library share one parallel_for backend. By default
+// it is the work stealing pool below; GEOMETRY_USE_TBB or GEOMETRY_USE_OPENMP
+// hand the loops to Intel TBB or to the OpenMP runtime instead.
+namespace geometry
+{
+    // Loop parts of a few thousand light items outweigh the cost of
+    // taking them from a slice by far
+    const size_t DEFAULT_PARALLEL_GRAIN = 4096;
+
+    // Calls function(begin, end) for every grain sized part of the range in
+    // the caller's thread
+    template<class Function> void runSequentially(const size_t begin, const size_t end, const size_t grain, const Function & function)
+    {
+        for (size_t first = begin; first < end; first += grain) {
+            function(first, end - first > grain ? first + grain : end);
+        }
+    }
+
+    // ====================== Thread pool ====================== //
+
+    // Every loop run by the pool splits its range into one slice per
+    // participant; a participant takes grain sized parts from the front of
+    // its own slice and, once it is drained, steals parts from the slices of
+    // the others. The calling thread is a participant too.
+    //
+    // A loop started from inside a loop of any pool, or while the pool is
+    // busy with a loop of another thread, runs in the calling thread: nested
+    // parallelism never adds threads over the ones that already work.
+    //
+    // An exception thrown by the function stops the loop: the parts not
+    // taken yet are skipped, and the first exception is rethrown in the
+    // calling thread once every participant has returned.
+    class ThreadPool
+    {
+    public:
+        // threadCount = 0 means one thread per core; the pool starts one
+        // worker less since the caller takes part in every loop. With
+        // pinThreads set the workers are bound to the cores 1, 2 and so on,
+        // core 0 is left to the caller.
+        explicit ThreadPool(const uint32bit threadCount = 0, const bool pinThreads = false);
+        ~ThreadPool();
+
+        // The number of threads working on a loop, the caller included
+        uint32bit getThreadCount() const;
+
+        // Calls function(first, last) for disjoint parts of [begin, end) that
+        // are at most grain long. maximalThreads limits the participants of
+        // this loop, 0 means all threads of the pool.
+        template<class Function> void parallelFor(const size_t begin, const size_t end, const size_t grain, const Function & function, const uint32bit maximalThreads = 0);
+
+        // The pool used by the library, it is created on the first call.
+        // setDefaultThreadCount and setDefaultThreadPinning take effect only
+        // if they are called before that.
+        static ThreadPool & getDefault();
+        static void setDefaultThreadCount(const uint32bit threadCount);
+        static void setDefaultThreadPinning(const bool pinThreads);
+
+        // Whether the calling thread is running a part of some parallel loop
+        static bool isInsideParallelLoop();
+
+    private:
+        typedef void (*LoopBody)(const void * function, const size_t first, const size_t last);
+
+        // Padded to a cache line, the slices are hit by different threads
+        struct Slice
+        {
+            std::atomic<size_t> next;
+            size_t end;
+            uint8bit padding[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<Slice> slices;
+
+        std::mutex loopMutex;
+
+        std::mutex stateMutex;
+        std::condition_variable startCondition;
+        std::condition_variable finishCondition;
+        uint64bit generation;
+        uint32bit pendingWorkers;
+        bool stopping;
+
+        // The first exception of the current loop, set under stateMutex
+        std::exception_ptr failure;
+        std::atomic<bool> cancelled;
+
+        LoopBody body;
+        const void * function;
+        size_t grain;
+        uint32bit participants;
+
+        template<class Function> static void callLoopBody(const void * function, const size_t first, const size_t last);
+
+        void run(const size_t begin, const size_t end, const size_t grain, const LoopBody body, const void * function, const uint32bit maximalThreads);
+        void work(const uint32bit participant);
+        void drain(Slice & slice);
+        void fail(const std::exception_ptr & exception);
+        void serve(const uint32bit worker, const bool pinThread);
+
+        ThreadPool(const ThreadPool &);
+        ThreadPool & operator=(const ThreadPool &);
+    };
+
+    template<class Function> void ThreadPool::callLoopBody(const void * function, const size_t first, const size_t last)
+    {
+        (*(const Function *)function)(first, last);
+    }
+
+    template<class Function> void ThreadPool::parallelFor(const size_t begin, const size_t end, const size_t grain, const Function & function, const uint32bit maximalThreads)
+    {
+        if (begin >= end) {
+            return;
+        }
+
+        this->run(begin, end, grain > 0 ? grain : 1, &ThreadPool::callLoopBody<Function>, &function, maximalThreads);
+    }
+
+    // ====================== parallelFor ====================== //
+
+    // Runs function(first, last) over grain sized parts of [begin, end) with
+    // the configured backend. maximalThreads = 1 keeps the loop in the
+    // calling thread, 0 lets the backend use all its threads. The pool and
+    // TBB rethrow an exception of the function in the calling thread, with
+    // OpenMP the function must not throw.
+    template<class Function> void parallelFor(const size_t begin, const size_t end, const size_t grain, const Function & function, const uint32bit maximalThreads = 0)
+    {
+        const size_t step = grain > 0 ? grain : 1;
+
+        if (begin >= end) {
+            return;
+        }
+
+        if (maximalThreads == 1 || end - begin <= step) {
+            runSequentially(begin, end, step, function);
+            return;
+        }
+
+#if defined(GEOMETRY_USE_TBB)
+        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end, step), [&](const tbb::blocked_range<size_t> & range) {
+            function(range.begin(), range.end());
+        }, tbb::simple_partitioner());
+#elif defined(GEOMETRY_USE_OPENMP)
+        // OpenMP serializes nested regions unless the application enables them
+        const long long partCount = (long long)((end - begin + step - 1) / step);
+
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(maximalThreads > 0 ? (int)maximalThreads : omp_get_max_threads())
+        for (long long part = 0; part < partCount; part++) {
+            const size_t first = begin + (size_t)part * step;
+            function(first, end - first > step ? first + step : end);
+        }
+#else
+        ThreadPool::getDefault().parallelFor(begin, end, step, function, maximalThreads);
+#endif
+    }
+}
+
+#endif /* _GEOMETRY_THREAD_POOL_H_ */
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_TRIGONOMETRY_H_
+#define _GEOMETRY_TRIGONOMETRY_H_
+
+#include <math.h>
+
+namespace geometry
+{
+    enum TrigonometryAccuracy
+    {
+        // Error within 1 ulp
+        PRECISE_TRIGONOMETRY = 0x0,
+        // Absolute error within 1E-6, float values only
+        FAST_TRIGONOMETRY = 0x1
+    };
+
+    // Sine and cosine kernels: Cody-Waite reduction to [-pi/4, pi/4] and
+    // minimax polynomials of the Cephes library. The batch functions of
+    // AngleBatch.h run the same computation over SIMD lanes. The kernels are
+    // exact enough only for |radians| <= TRIGONOMETRY_KERNEL_LIMIT, larger
+    // arguments are passed to the C library by the checked functions below.
+
+    const float TRIGONOMETRY_KERNEL_LIMIT_FLOAT = 8192.0f;
+    const double TRIGONOMETRY_KERNEL_LIMIT_DOUBLE = 823549.0;
+
+    // Arguments beyond the limit, infinities and NaN are replaced by the
+    // limit, so their quadrants convert to int; the kernel results of such
+    // arguments are wrong and are replaced by the checked functions
+    template<typename FloatType> inline FloatType clampKernelArgument(const FloatType radians, const FloatType limit)
+    {
+        return radians > limit ? limit : (radians >= -limit ? radians : -limit);
+    }
+
+    // Applies the quadrant of the reduced argument to the sine and cosine of it
+    template<typename FloatType> inline void applySincosQuadrant(const int quadrant, const FloatType sine, const FloatType cosine, FloatType & resultSine, FloatType & resultCosine)
+    {
+        const bool swap = (quadrant & 1) != 0;
+        const FloatType sineSign = FloatType(1 - (quadrant & 2));
+        const FloatType cosineSign = FloatType(1 - ((quadrant + 1) & 2));
+
+        resultSine = (swap ? cosine : sine) * sineSign;
+        resultCosine = (swap ? sine : cosine) * cosineSign;
+    }
+
+    // The reduced argument is kept as a sum of two doubles and the last
+    // additions of both series take its tail and their own rounding errors,
+    // as in the kernels of fdlibm, which keeps the error within 1 ulp
+    inline void sincosKernel(const double argument, double & sine, double & cosine)
+    {
+        const double radians = clampKernelArgument(argument, TRIGONOMETRY_KERNEL_LIMIT_DOUBLE);
+        const double quadrant = floor(radians * 0.636619772367581343 + 0.5);
+
+        // The parts of pi / 2 have 33 significant bits, so their products
+        // with the quadrant are exact; the differences are summed with
+        // their errors, so the arguments near the multiples of pi / 2 keep
+        // their precision
+        const double first = radians - quadrant * 1.57079632673412561417E+0;
+        const double secondPart = quadrant * 6.07710050630396597660E-11;
+        const double thirdPart = quadrant * 2.02226624871116645580E-21;
+
+        const double second = first - secondPart;
+        const double secondError = (first - (second + (first - second))) + ((first - second) - secondPart);
+        const double third = second - thirdPart;
+        const double thirdError = (second - (third + (second - third))) + ((second - third) - thirdPart);
+
+        const double tail = (secondError + thirdError) - quadrant * 8.47842766036889956997E-32;
+        const double reduced = third + tail;
+        const double reducedTail = tail - (reduced - third);
+
+        const double square = reduced * reduced;
+        const double cube = square * reduced;
+
+        const double sinePolynomial = ((((1.58962301576546568060E-10 * square
+                - 2.50507477628578072866E-8) * square
+                + 2.75573136213857245213E-6) * square
+                - 1.98412698295895385996E-4) * square
+                + 8.33333333332211858878E-3);
+
+        const double cosinePolynomial = (((((-1.13585365213876817300E-11 * square
+                + 2.08757008419747316778E-9) * square
+                - 2.75573141792967388112E-7) * square
+                + 2.48015872888517045348E-5) * square
+                - 1.38888888888730564116E-3) * square
+                + 4.16666666666665929218E-2) * square;
+
+        const double halfSquare = 0.5 * square;
+        const double cosineHead = 1.0 - halfSquare;
+
+        applySincosQuadrant<double>((int)quadrant,
+            reduced - ((square * (0.5 * reducedTail - cube * sinePolynomial) - reducedTail) + cube * 1.66666666666666307295E-1),
+            cosineHead + (((1.0 - cosineHead) - halfSquare) + (square * cosinePolynomial - reduced * reducedTail)),
+            sine, cosine);
+    }
+
+    // Float result with double precision evaluation inside
+    inline void sincosKernel(const float radians, float & sine, float & cosine)
+    {
+        const double argument = clampKernelArgument((double)radians, TRIGONOMETRY_KERNEL_LIMIT_DOUBLE);
+        const double quadrant = floor(argument * 0.636619772367581343 + 0.5);
+
+        const double reduced = (argument - quadrant * 1.57079632673412561417E+0) - quadrant * 6.07710050650619224932E-11;
+        const double square = reduced * reduced;
+
+        const double sinePolynomial = (((((1.58962301576546568060E-10 * square
+                - 2.50507477628578072866E-8) * square
+                + 2.75573136213857245213E-6) * square
+                - 1.98412698295895385996E-4) * square
+                + 8.33333333332211858878E-3) * square
+                - 1.66666666666666307295E-1);
+
+        const double cosinePolynomial = (((((-1.13585365213876817300E-11 * square
+                + 2.08757008419747316778E-9) * square
+                - 2.75573141792967388112E-7) * square
+                + 2.48015872888517045348E-5) * square
+                - 1.38888888888730564116E-3) * square
+                + 4.16666666666665929218E-2);
+
+        double doubleSine, doubleCosine;
+
+        applySincosQuadrant<double>((int)quadrant,
+            reduced + reduced * square * sinePolynomial,
+            1.0 - 0.5 * square + square * square * cosinePolynomial,
+            doubleSine, doubleCosine);
+
+        sine = (float)doubleSine;
+        cosine = (float)doubleCosine;
+    }
+
+    inline void sincosFastKernel(const float argument, float & sine, float & cosine)
+    {
+        const float radians = clampKernelArgument(argument, TRIGONOMETRY_KERNEL_LIMIT_FLOAT);
+        const float quadrant = floorf(radians * 0.636619772f + 0.5f);
+
+        const float reduced = ((radians - quadrant * 1.5703125f)
+                                        - quadrant * 4.837512969970703125E-4f)
+                                        - quadrant * 7.54978995489188216E-8f;
+
+        const float square = reduced * reduced;
+
+        const float sinePolynomial = (-1.9515295891E-4f * square + 8.3321608736E-3f) * square - 1.6666654611E-1f;
+        const float cosinePolynomial = (2.443315711809948E-5f * square - 1.388731625493765E-3f) * square + 4.166664568298827E-2f;
+
+        applySincosQuadrant<float>((int)quadrant,
+            reduced + reduced * square * sinePolynomial,
+            1.0f - 0.5f * square + square * square * cosinePolynomial,
+            sine, cosine);
+    }
+
+    // ================= Checked sine and cosine ================= //
+
+    inline void sincos(const double radians, double & sine, double & cosine, const TrigonometryAccuracy = PRECISE_TRIGONOMETRY)
+    {
+        if (fabs(radians) <= TRIGONOMETRY_KERNEL_LIMIT_DOUBLE) {
+            sincosKernel(radians, sine, cosine);
+            return;
+        }
+
+        sine = ::sin(radians);
+        cosine = ::cos(radians);
+    }
+
+    inline void sincos(const float radians, float & sine, float & cosine, const TrigonometryAccuracy accuracy = PRECISE_TRIGONOMETRY)
+    {
+        if (accuracy == FAST_TRIGONOMETRY && fabsf(radians) <= TRIGONOMETRY_KERNEL_LIMIT_FLOAT) {
+            sincosFastKernel(radians, sine, cosine);
+            return;
+        }
+
+        if (fabs((double)radians) <= TRIGONOMETRY_KERNEL_LIMIT_DOUBLE) {
+            sincosKernel(radians, sine, cosine);
+            return;
+        }
+
+        sine = ::sinf(radians);
+        cosine = ::cosf(radians);
+    }
+}
+
+#endif /* _GEOMETRY_TRIGONOMETRY_H_ */
@@ -0,0 +1,449 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_VECTOR_H_
+#define _GEOMETRY_VECTOR_H_
+
+#include <math.h>
+
+#include "types.h"
+#include "constants.h"
+
+#include "planimetry/Vector2.h"
+#include "stereometry/Vector3.h"
+#include "Quaternion.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_VECTOR
+#endif
+
+#ifdef __AVX__
+#include <immintrin.h>
+#define GEOMETRY_AVX_VECTOR
+#endif
+
+namespace geometry
+{
+    // ===================== Compile-time unrolling ===================== //
+
+    // Calls operation(0), ..., operation(Count - 1) without a loop
+    template<uint32bit Count> struct Unroll
+    {
+        template<class Operation> static inline void apply(const Operation & operation)
+        {
+            Unroll<Count - 1>::apply(operation);
+            operation(Count - 1);
+        }
+    };
+
+    template<> struct Unroll<0>
+    {
+        template<class Operation> static inline void apply(const Operation &)
+        {
+        }
+    };
+
+    // ========================= Vector kernels ========================= //
+
+    // Component-wise kernels of Vector. The sizes which fit a SIMD
+    // register are specialized below, the rest is unrolled at compile time.
+    template<typename FloatType, uint32bit N> struct VectorKernels
+    {
+        static inline void add(const FloatType * a, const FloatType * b, FloatType * result)
+        {
+            Unroll<N>::apply([&](const uint32bit i) { result[i] = a[i] + b[i]; });
+        }
+
+        static inline void subtract(const FloatType * a, const FloatType * b, FloatType * result)
+        {
+            Unroll<N>::apply([&](const uint32bit i) { result[i] = a[i] - b[i]; });
+        }
+
+        static inline void multiply(const FloatType * a, const FloatType value, FloatType * result)
+        {
+            Unroll<N>::apply([&](const uint32bit i) { result[i] = a[i] * value; });
+        }
+
+        static inline FloatType scalar(const FloatType * a, const FloatType * b)
+        {
+            FloatType result = FloatConstants<FloatType>::ZERO;
+            Unroll<N>::apply([&](const uint32bit i) { result += a[i] * b[i]; });
+            return result;
+        }
+    };
+
+#ifdef GEOMETRY_SSE_VECTOR
+
+    template<> struct VectorKernels<float, 4>
+    {
+        static inline void add(const float * a, const float * b, float * result)
+        {
+            _mm_storeu_ps(result, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+        }
+
+        static inline void subtract(const float * a, const float * b, float * result)
+        {
+            _mm_storeu_ps(result, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+        }
+
+        static inline void multiply(const float * a, const float value, float * result)
+        {
+            _mm_storeu_ps(result, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(value)));
+        }
+
+        static inline float scalar(const float * a, const float * b)
+        {
+            const __m128 products = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+            const __m128 pairs = _mm_add_ps(products, _mm_movehl_ps(products, products));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 0x55)));
+        }
+    };
+
+    template<> struct VectorKernels<double, 2>
+    {
+        static inline void add(const double * a, const double * b, double * result)
+        {
+            _mm_storeu_pd(result, _mm_add_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+        }
+
+        static inline void subtract(const double * a, const double * b, double * result)
+        {
+            _mm_storeu_pd(result, _mm_sub_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)));
+        }
+
+        static inline void multiply(const double * a, const double value, double * result)
+        {
+            _mm_storeu_pd(result, _mm_mul_pd(_mm_loadu_pd(a), _mm_set1_pd(value)));
+        }
+
+        static inline double scalar(const double * a, const double * b)
+        {
+            const __m128d products = _mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b));
+            return _mm_cvtsd_f64(_mm_add_sd(products, _mm_unpackhi_pd(products, products)));
+        }
+    };
+
+#endif
+
+#ifdef GEOMETRY_AVX_VECTOR
+
+    template<> struct VectorKernels<float, 8>
+    {
+        static inline void add(const float * a, const float * b, float * result)
+        {
+            _mm256_storeu_ps(result, _mm256_add_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b)));
+        }
+
+        static inline void subtract(const float * a, const float * b, float * result)
+        {
+            _mm256_storeu_ps(result, _mm256_sub_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b)));
+        }
+
+        static inline void multiply(const float * a, const float value, float * result)
+        {
+            _mm256_storeu_ps(result, _mm256_mul_ps(_mm256_loadu_ps(a), _mm256_set1_ps(value)));
+        }
+
+        static inline float scalar(const float * a, const float * b)
+        {
+            const __m256 products = _mm256_mul_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b));
+            const __m128 halves = _mm_add_ps(_mm256_castps256_ps128(products), _mm256_extractf128_ps(products, 1));
+            const __m128 pairs = _mm_add_ps(halves, _mm_movehl_ps(halves, halves));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 0x55)));
+        }
+    };
+
+    template<> struct VectorKernels<double, 4>
+    {
+        static inline void add(const double * a, const double * b, double * result)
+        {
+            _mm256_storeu_pd(result, _mm256_add_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+        }
+
+        static inline void subtract(const double * a, const double * b, double * result)
+        {
+            _mm256_storeu_pd(result, _mm256_sub_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b)));
+        }
+
+        static inline void multiply(const double * a, const double value, double * result)
+        {
+            _mm256_storeu_pd(result, _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(value)));
+        }
+
+        static inline double scalar(const double * a, const double * b)
+        {
+            const __m256d products = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b));
+            const __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(products), _mm256_extractf128_pd(products, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(halves, _mm_unpackhi_pd(halves, halves)));
+        }
+    };
+
+#endif
+
+    // ========================== Vector header ========================= //
+
+    // A vector of any fixed dimension. The two and three dimensional classes
+    // of planimetry and stereometry remain the main API, this template adds
+    // the other dimensions and converts to and from those classes.
+    template<typename FloatType, uint32bit N> class Vector
+    {
+    public:
+        static constexpr uint32bit DIMENSION = N;
+
+        FloatType values[N];
+
+        constexpr Vector();
+        explicit constexpr Vector(const FloatType value);
+
+        template<typename... Rest> constexpr Vector(const FloatType first, const FloatType second, const Rest... rest);
+
+        constexpr FloatType operator[](const uint32bit index) const;
+        constexpr FloatType & operator[](const uint32bit index);
+
+        inline void setToZero();
+
+        inline bool isZero() const;
+        inline bool isCloseTo(const Vector<FloatType, N> & vector) const;
+
+        inline FloatType scalar(const Vector<FloatType, N> & vector) const;
+        inline FloatType squareModule() const;
+        inline FloatType module() const;
+
+        inline bool normalize();
+
+        inline Vector<FloatType, N> operator+(const Vector<FloatType, N> & vector) const;
+        inline Vector<FloatType, N> operator-(const Vector<FloatType, N> & vector) const;
+        inline Vector<FloatType, N> operator-() const;
+        inline Vector<FloatType, N> operator*(const FloatType value) const;
+        inline Vector<FloatType, N> operator/(const FloatType value) const;
+
+        inline Vector<FloatType, N> & operator+=(const Vector<FloatType, N> & vector);
+        inline Vector<FloatType, N> & operator-=(const Vector<FloatType, N> & vector);
+        inline Vector<FloatType, N> & operator*=(const FloatType value);
+        inline Vector<FloatType, N> & operator/=(const FloatType value);
+    };
+
+    typedef Vector<float, 4> Vector4F;
+    typedef Vector<double, 4> Vector4;
+
+    // ====================== Vector inline methods ===================== //
+
+    template<typename FloatType, uint32bit N> constexpr uint32bit Vector<FloatType, N>::DIMENSION;
+
+    template<typename FloatType, uint32bit N> constexpr Vector<FloatType, N>::Vector()
+        : values()
+    {
+    }
+
+    template<typename FloatType, uint32bit N> constexpr Vector<FloatType, N>::Vector(const FloatType value)
+        : values()
+    {
+        for (uint32bit i = 0; i < N; i++) {
+            this->values[i] = value;
+        }
+    }
+
+    template<typename FloatType, uint32bit N> template<typename... Rest> constexpr Vector<FloatType, N>::Vector(const FloatType first, const FloatType second, const Rest... rest)
+        : values{ first, second, FloatType(rest)... }
+    {
+        static_assert(sizeof...(Rest) + 2 == N, "The number of components must be equal to the dimension");
+    }
+
+    template<typename FloatType, uint32bit N> constexpr FloatType Vector<FloatType, N>::operator[](const uint32bit index) const
+    {
+        return this->values[index];
+    }
+
+    template<typename FloatType, uint32bit N> constexpr FloatType & Vector<FloatType, N>::operator[](const uint32bit index)
+    {
+        return this->values[index];
+    }
+
+    template<typename FloatType, uint32bit N> void Vector<FloatType, N>::setToZero()
+    {
+        Unroll<N>::apply([&](const uint32bit i) { this->values[i] = FloatConstants<FloatType>::ZERO; });
+    }
+
+    template<typename FloatType, uint32bit N> bool Vector<FloatType, N>::isZero() const
+    {
+        return this->squareModule() <= FloatConstants<FloatType>::SQUARE_EPSYLON;
+    }
+
+    template<typename FloatType, uint32bit N> bool Vector<FloatType, N>::isCloseTo(const Vector<FloatType, N> & vector) const
+    {
+        return (*this - vector).squareModule() <= FloatConstants<FloatType>::SQUARE_EPSYLON;
+    }
+
+    template<typename FloatType, uint32bit N> FloatType Vector<FloatType, N>::scalar(const Vector<FloatType, N> & vector) const
+    {
+        return VectorKernels<FloatType, N>::scalar(this->values, vector.values);
+    }
+
+    template<typename FloatType, uint32bit N> FloatType Vector<FloatType, N>::squareModule() const
+    {
+        return VectorKernels<FloatType, N>::scalar(this->values, this->values);
+    }
+
+    template<typename FloatType, uint32bit N> FloatType Vector<FloatType, N>::module() const
+    {
+        return sqrt(this->squareModule());
+    }
+
+    template<typename FloatType, uint32bit N> bool Vector<FloatType, N>::normalize()
+    {
+        const FloatType squareModule = this->squareModule();
+
+        if (squareModule <= FloatConstants<FloatType>::SQUARE_EPSYLON) {
+            this->setToZero();
+            return false;
+        }
+
+        VectorKernels<FloatType, N>::multiply(this->values, FloatConstants<FloatType>::UNIT / sqrt(squareModule), this->values);
+
+        return true;
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> Vector<FloatType, N>::operator+(const Vector<FloatType, N> & vector) const
+    {
+        Vector<FloatType, N> result;
+        VectorKernels<FloatType, N>::add(this->values, vector.values, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> Vector<FloatType, N>::operator-(const Vector<FloatType, N> & vector) const
+    {
+        Vector<FloatType, N> result;
+        VectorKernels<FloatType, N>::subtract(this->values, vector.values, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> Vector<FloatType, N>::operator-() const
+    {
+        Vector<FloatType, N> result;
+        VectorKernels<FloatType, N>::multiply(this->values, -FloatConstants<FloatType>::UNIT, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> Vector<FloatType, N>::operator*(const FloatType value) const
+    {
+        Vector<FloatType, N> result;
+        VectorKernels<FloatType, N>::multiply(this->values, value, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> Vector<FloatType, N>::operator/(const FloatType value) const
+    {
+        Vector<FloatType, N> result;
+        VectorKernels<FloatType, N>::multiply(this->values, FloatConstants<FloatType>::UNIT / value, result.values);
+        return result;
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> & Vector<FloatType, N>::operator+=(const Vector<FloatType, N> & vector)
+    {
+        VectorKernels<FloatType, N>::add(this->values, vector.values, this->values);
+        return (*this);
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> & Vector<FloatType, N>::operator-=(const Vector<FloatType, N> & vector)
+    {
+        VectorKernels<FloatType, N>::subtract(this->values, vector.values, this->values);
+        return (*this);
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> & Vector<FloatType, N>::operator*=(const FloatType value)
+    {
+        VectorKernels<FloatType, N>::multiply(this->values, value, this->values);
+        return (*this);
+    }
+
+    template<typename FloatType, uint32bit N> Vector<FloatType, N> & Vector<FloatType, N>::operator/=(const FloatType value)
+    {
+        VectorKernels<FloatType, N>::multiply(this->values, FloatConstants<FloatType>::UNIT / value, this->values);
+        return (*this);
+    }
+
+    template<typename FloatType, uint32bit N> inline Vector<FloatType, N> operator*(const FloatType value, const Vector<FloatType, N> & vector)
+    {
+        return vector * value;
+    }
+
+    // ================ Conversions of the existing classes ============== //
+
+    inline Vector<float, 2> toVector(const planimetry::Vector2F & vector)
+    {
+        return Vector<float, 2>(vector.x, vector.y);
+    }
+
+    inline Vector<double, 2> toVector(const planimetry::Vector2 & vector)
+    {
+        return Vector<double, 2>(vector.x, vector.y);
+    }
+
+    inline Vector<float, 3> toVector(const stereometry::Vector3F & vector)
+    {
+        return Vector<float, 3>(vector.x, vector.y, vector.z);
+    }
+
+    inline Vector<double, 3> toVector(const stereometry::Vector3 & vector)
+    {
+        return Vector<double, 3>(vector.x, vector.y, vector.z);
+    }
+
+    // Quaternions become four dimensional vectors in the (w, x, y, z) order
+    inline Vector4F toVector(const QuaternionF & quaternion)
+    {
+        return Vector4F(quaternion.w, quaternion.x, quaternion.y, quaternion.z);
+    }
+
+    inline Vector4 toVector(const Quaternion & quaternion)
+    {
+        return Vector4(quaternion.w, quaternion.x, quaternion.y, quaternion.z);
+    }
+
+    inline planimetry::Vector2F toVector2F(const Vector<float, 2> & vector)
+    {
+        return planimetry::Vector2F(vector[0], vector[1]);
+    }
+
+    inline planimetry::Vector2 toVector2(const Vector<double, 2> & vector)
+    {
+        return planimetry::Vector2(vector[0], vector[1]);
+    }
+
+    inline stereometry::Vector3F toVector3F(const Vector<float, 3> & vector)
+    {
+        return stereometry::Vector3F(vector[0], vector[1], vector[2]);
+    }
+
+    inline stereometry::Vector3 toVector3(const Vector<double, 3> & vector)
+    {
+        return stereometry::Vector3(vector[0], vector[1], vector[2]);
+    }
+
+    inline QuaternionF toQuaternionF(const Vector4F & vector)
+    {
+        return QuaternionF(vector[0], vector[1], vector[2], vector[3]);
+    }
+
+    inline Quaternion toQuaternion(const Vector4 & vector)
+    {
+        return Quaternion(vector[0], vector[1], vector[2], vector[3]);
+    }
+}
+
+#endif /* _GEOMETRY_VECTOR_H_ */
@@ -18,13 +18,16 @@
 
 namespace geometry
 {
-    const float POSITIVE_EPSYLON_FLOAT = 1E-7f;
-    const float NEGATIVE_EPSYLON_FLOAT = -1E-7f;
-    const float POSITIVE_SQUARE_EPSYLON_FLOAT = 1E-14f;
-    const float NEGATIVE_SQUARE_EPSYLON_FLOAT = -1E-14f;
+    // Definitions for the cases when the constants are bound to references
+    constexpr float FloatConstants<float>::ZERO;
+    constexpr float FloatConstants<float>::UNIT;
+    constexpr float FloatConstants<float>::EPSYLON;
+    constexpr float FloatConstants<float>::NEGATIVE_EPSYLON;
+    constexpr float FloatConstants<float>::SQUARE_EPSYLON;
 
-    const double POSITIVE_EPSYLON_DOUBLE = 1E-15;
-    const double NEGATIVE_EPSYLON_DOUBLE = -1E-15;
-    const double POSITIVE_SQUARE_EPSYLON_DOUBLE = 1E-30;
-    const double NEGATIVE_SQUARE_EPSYLON_DOUBLE = -1E-30;
+    constexpr double FloatConstants<double>::ZERO;
+    constexpr double FloatConstants<double>::UNIT;
+    constexpr double FloatConstants<double>::EPSYLON;
+    constexpr double FloatConstants<double>::NEGATIVE_EPSYLON;
+    constexpr double FloatConstants<double>::SQUARE_EPSYLON;
 }
@@ -19,15 +19,37 @@
 
 namespace geometry
 {
-    extern const float POSITIVE_EPSYLON_FLOAT;
-    extern const float NEGATIVE_EPSYLON_FLOAT;
-    extern const float POSITIVE_SQUARE_EPSYLON_FLOAT;
-    extern const float NEGATIVE_SQUARE_EPSYLON_FLOAT;
+    constexpr float POSITIVE_EPSYLON_FLOAT = 1E-7f;
+    constexpr float NEGATIVE_EPSYLON_FLOAT = -1E-7f;
+    constexpr float POSITIVE_SQUARE_EPSYLON_FLOAT = 1E-14f;
+    constexpr float NEGATIVE_SQUARE_EPSYLON_FLOAT = -1E-14f;
 
-    extern const double POSITIVE_EPSYLON_DOUBLE;
-    extern const double NEGATIVE_EPSYLON_DOUBLE;
-    extern const double POSITIVE_SQUARE_EPSYLON_DOUBLE;
-    extern const double NEGATIVE_SQUARE_EPSYLON_DOUBLE;
+    constexpr double POSITIVE_EPSYLON_DOUBLE = 1E-15;
+    constexpr double NEGATIVE_EPSYLON_DOUBLE = -1E-15;
+    constexpr double POSITIVE_SQUARE_EPSYLON_DOUBLE = 1E-30;
+    constexpr double NEGATIVE_SQUARE_EPSYLON_DOUBLE = -1E-30;
+
+    // The constants of the float type used by the vector, matrix, angle and
+    // quaternion templates. All of them are known at compile time.
+    template<typename FloatType> struct FloatConstants;
+
+    template<> struct FloatConstants<float>
+    {
+        static constexpr float ZERO = 0.0f;
+        static constexpr float UNIT = 1.0f;
+        static constexpr float EPSYLON = POSITIVE_EPSYLON_FLOAT;
+        static constexpr float NEGATIVE_EPSYLON = NEGATIVE_EPSYLON_FLOAT;
+        static constexpr float SQUARE_EPSYLON = POSITIVE_SQUARE_EPSYLON_FLOAT;
+    };
+
+    template<> struct FloatConstants<double>
+    {
+        static constexpr double ZERO = 0.0;
+        static constexpr double UNIT = 1.0;
+        static constexpr double EPSYLON = POSITIVE_EPSYLON_DOUBLE;
+        static constexpr double NEGATIVE_EPSYLON = NEGATIVE_EPSYLON_DOUBLE;
+        static constexpr double SQUARE_EPSYLON = POSITIVE_SQUARE_EPSYLON_DOUBLE;
+    };
 }
 
 #endif
@@ -21,15 +21,38 @@
 
 #include "Angle.h"
 #include "Quaternion.h"
+#include "Vector.h"
+#include "Matrix.h"
+#include "ThreadPool.h"
+#include "Memory.h"
 
 #include "planimetry/Vector2.h"
 #include "planimetry/Triangle2.h"
+#include "planimetry/TriangleEdges2.h"
+#include "planimetry/Rasterizer2F.h"
 #include "planimetry/Line2.h"
-#include "planimetry/Matrix2x2F.h"
+#include "planimetry/Matrix2x2.h"
 #include "planimetry/Converter2F.h"
 
 #include "stereometry/Vector3.h"
 #include "stereometry/Triangle3.h"
 #include "stereometry/Line3.h"
+#include "stereometry/IndexedMesh3F.h"
+#include "stereometry/TriangleCache3F.h"
+#include "stereometry/AxisBox3.h"
+#include "stereometry/Projection3F.h"
+#include "stereometry/OcclusionCuller3F.h"
+#include "stereometry/Frustum3F.h"
+#include "stereometry/SweepAndPrune3F.h"
+#include "stereometry/ConvexShape3.h"
+#include "stereometry/Gjk3.h"
+#include "stereometry/TriangleIntersection3.h"
+#include "stereometry/TriangleTree3F.h"
+#include "stereometry/ClosestPoint3.h"
+#include "stereometry/SignedDistanceField3F.h"
+#include "stereometry/IsoSurface3F.h"
+#include "stereometry/Matrix3x3Decomposition.h"
+#include "stereometry/PointTree3F.h"
+#include "stereometry/PointRegistration3F.h"
 
 #endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace geometry
+{
+    namespace io
+    {
+        MappedFile::MappedFile()
+            : bytes(0), length(0), opened(false)
+#ifdef _WIN32
+            , fileHandle(INVALID_HANDLE_VALUE), mappingHandle(0)
+#else
+            , descriptor(-1)
+#endif
+        {
+        }
+
+        MappedFile::~MappedFile()
+        {
+            this->close();
+        }
+
+#ifdef _WIN32
+
+        bool MappedFile::open(const char * path)
+        {
+            this->close();
+
+            HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+            if (file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+
+            LARGE_INTEGER fileSize;
+
+            if (!GetFileSizeEx(file, &fileSize)) {
+                CloseHandle(file);
+                return false;
+            }
+
+            this->fileHandle = file;
+            this->length = (size_t)fileSize.QuadPart;
+            this->opened = true;
+
+            if (this->length == 0) {
+                return true;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+            if (mapping == NULL) {
+                this->close();
+                return false;
+            }
+
+            this->mappingHandle = mapping;
+            this->bytes = (const uint8bit *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+            if (this->bytes == 0) {
+                this->close();
+                return false;
+            }
+
+            return true;
+        }
+
+        void MappedFile::close()
+        {
+            if (this->bytes != 0) {
+                UnmapViewOfFile(this->bytes);
+            }
+
+            if (this->mappingHandle != 0) {
+                CloseHandle(this->mappingHandle);
+            }
+
+            if (this->fileHandle != INVALID_HANDLE_VALUE) {
+                CloseHandle(this->fileHandle);
+            }
+
+            this->bytes = 0;
+            this->length = 0;
+            this->opened = false;
+            this->fileHandle = INVALID_HANDLE_VALUE;
+            this->mappingHandle = 0;
+        }
+
+        void MappedFile::adviseSequential() const
+        {
+        }
+
+#else
+
+        bool MappedFile::open(const char * path)
+        {
+            this->close();
+
+            int file = ::open(path, O_RDONLY);
+
+            if (file < 0) {
+                return false;
+            }
+
+            struct stat status;
+
+            if (fstat(file, &status) != 0) {
+                ::close(file);
+                return false;
+            }
+
+            this->descriptor = file;
+            this->length = (size_t)status.st_size;
+            this->opened = true;
+
+            if (this->length == 0) {
+                return true;
+            }
+
+            void * mapping = mmap(0, this->length, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (mapping == MAP_FAILED) {
+                this->close();
+                return false;
+            }
+
+            this->bytes = (const uint8bit *)mapping;
+
+            return true;
+        }
+
+        void MappedFile::close()
+        {
+            if (this->bytes != 0) {
+                munmap((void *)this->bytes, this->length);
+            }
+
+            if (this->descriptor >= 0) {
+                ::close(this->descriptor);
+            }
+
+            this->bytes = 0;
+            this->length = 0;
+            this->opened = false;
+            this->descriptor = -1;
+        }
+
+        void MappedFile::adviseSequential() const
+        {
+            if (this->bytes != 0) {
+                madvise((void *)this->bytes, this->length, MADV_SEQUENTIAL);
+            }
+        }
+
+#endif
+    } /* namespace io */
+} /* namespace geometry */
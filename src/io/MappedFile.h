@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_IO_MAPPED_FILE_H_
+#define _GEOMETRY_IO_MAPPED_FILE_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        // Read-only memory mapping of a whole file. The mapped bytes stay
+        // valid until close() is called or the object is destroyed.
+        class MappedFile
+        {
+        public:
+            MappedFile();
+            virtual ~MappedFile();
+
+            bool open(const char * path);
+            void close();
+
+            // Hints the operating system that the file will be read front to back
+            void adviseSequential() const;
+
+            inline bool isOpen() const;
+
+            inline const uint8bit * data() const;
+            inline size_t size() const;
+
+        private:
+            const uint8bit * bytes;
+            size_t length;
+            bool opened;
+
+#ifdef _WIN32
+            pointer fileHandle;
+            pointer mappingHandle;
+#else
+            int descriptor;
+#endif
+
+            MappedFile(const MappedFile &);
+            MappedFile & operator=(const MappedFile &);
+        };
+
+        bool MappedFile::isOpen() const
+        {
+            return this->opened;
+        }
+
+        const uint8bit * MappedFile::data() const
+        {
+            return this->bytes;
+        }
+
+        size_t MappedFile::size() const
+        {
+            return this->length;
+        }
+    } /* namespace io */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_IO_MAPPED_FILE_H_ */
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ObjFile.h"
+
+#include <atomic>
+#include <vector>
+
+#include "MappedFile.h"
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+#include "TextParser.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        static const size_t MINIMAL_CHUNK_SIZE = 1 << 20;
+        static const uint32bit CHUNKS_PER_THREAD = 4;
+
+        // Negative (relative) face indices can point into a previous chunk, so
+        // they are kept as chunk local positions shifted below this bias and
+        // resolved once the vertex counts of all chunks are known
+        static const int64bit RELATIVE_INDEX_BIAS = (int64bit)1 << 40;
+
+        struct ObjChunk
+        {
+            const char8bit * begin;
+            const char8bit * end;
+
+            std::vector<stereometry::Vector3F> vertices;
+            std::vector<int64bit> indices;
+
+            size_t vertexOffset;
+            bool valid;
+        };
+
+        static const char8bit * parseFaceIndex(const char8bit * position, const char8bit * end, const size_t localVertexCount, int64bit & index)
+        {
+            int64bit value;
+
+            position = parseInteger(position, end, value);
+
+            // No file holds enough vertices for a relative index beyond the
+            // bias, and the biased position would overflow for it
+            if (position == 0 || value == 0 || value <= -RELATIVE_INDEX_BIAS) {
+                return 0;
+            }
+
+            if (value > 0) {
+                index = value - 1;
+            }
+            else {
+                index = (int64bit)localVertexCount + value - RELATIVE_INDEX_BIAS;
+            }
+
+            // Texture and normal references ("v/vt/vn", "v//vn") are not needed
+            return skipToken(position, end);
+        }
+
+        static void parseChunk(ObjChunk & chunk)
+        {
+            const char8bit * position = chunk.begin;
+            const char8bit * end = chunk.end;
+
+            chunk.valid = true;
+
+            while (position < end) {
+                position = skipSpaces(position, end);
+
+                if (position + 1 < end && position[0] == 'v' && isSpace(position[1])) {
+                    float32bit x, y, z;
+
+                    position = parseFloat(skipSpaces(position + 2, end), end, x);
+                    if (position != 0) position = parseFloat(skipSpaces(position, end), end, y);
+                    if (position != 0) position = parseFloat(skipSpaces(position, end), end, z);
+
+                    if (position == 0) {
+                        chunk.valid = false;
+                        return;
+                    }
+
+                    chunk.vertices.push_back(stereometry::Vector3F(x, y, z));
+                }
+                else if (position + 1 < end && position[0] == 'f' && isSpace(position[1])) {
+                    int64bit first, previous, current;
+                    size_t count = 0;
+
+                    position = skipSpaces(position + 2, end);
+
+                    while (position != 0 && position < end && *position != '\n') {
+                        position = parseFaceIndex(position, end, chunk.vertices.size(), current);
+
+                        if (position == 0) {
+                            break;
+                        }
+
+                        if (count == 0) {
+                            first = current;
+                        }
+                        else if (count >= 2) {
+                            chunk.indices.push_back(first);
+                            chunk.indices.push_back(previous);
+                            chunk.indices.push_back(current);
+                        }
+
+                        previous = current;
+                        count++;
+
+                        position = skipSpaces(position, end);
+                    }
+
+                    if (position == 0 || count < 3) {
+                        chunk.valid = false;
+                        return;
+                    }
+                }
+
+                position = skipLine(position, end);
+            }
+        }
+
+        bool readObjFile(const char * path, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            MappedFile file;
+
+            if (!file.open(path)) {
+                mesh.clear();
+                return false;
+            }
+
+            file.adviseSequential();
+
+            return parseObj((const char8bit *)file.data(), file.size(), mesh, threadCount);
+        }
+
+        bool parseObj(const char8bit * text, const size_t length, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("obj.parse");
+
+            mesh.clear();
+
+            const char8bit * end = text + length;
+
+            size_t threads = threadCount > 0 ? threadCount : ThreadPool::getDefault().getThreadCount();
+            size_t chunkCount = threads * CHUNKS_PER_THREAD;
+
+            if (chunkCount > length / MINIMAL_CHUNK_SIZE + 1) {
+                chunkCount = length / MINIMAL_CHUNK_SIZE + 1;
+            }
+
+            std::vector<ObjChunk> chunks(chunkCount);
+
+            const char8bit * begin = text;
+
+            for (size_t i = 0; i < chunkCount; i++) {
+                const char8bit * split = i + 1 == chunkCount ? end : skipLine(text + length / chunkCount * (i + 1), end);
+
+                if (split < begin) {
+                    split = begin;
+                }
+
+                chunks[i].begin = begin;
+                chunks[i].end = split;
+                begin = split;
+            }
+
+            parallelFor(0, chunkCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    parseChunk(chunks[i]);
+                }
+            }, threadCount);
+
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+
+            for (size_t i = 0; i < chunkCount; i++) {
+                if (!chunks[i].valid) {
+                    return false;
+                }
+
+                chunks[i].vertexOffset = vertexCount;
+                vertexCount += chunks[i].vertices.size();
+                indexCount += chunks[i].indices.size();
+            }
+
+            if (vertexCount >= 0xFFFFFFFFu) {
+                return false;
+            }
+
+            mesh.vertices.resize(vertexCount);
+            mesh.indices.resize(indexCount);
+
+            std::vector<size_t> indexOffsets(chunkCount);
+
+            for (size_t i = 0, offset = 0; i < chunkCount; i++) {
+                indexOffsets[i] = offset;
+                offset += chunks[i].indices.size();
+            }
+
+            std::atomic<bool> valid(true);
+
+            parallelFor(0, chunkCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const ObjChunk & chunk = chunks[i];
+
+                    for (size_t j = 0; j < chunk.vertices.size(); j++) {
+                        mesh.vertices[chunk.vertexOffset + j] = chunk.vertices[j];
+                    }
+
+                    for (size_t j = 0; j < chunk.indices.size(); j++) {
+                        int64bit index = chunk.indices[j];
+
+                        if (index < 0) {
+                            index += RELATIVE_INDEX_BIAS + (int64bit)chunk.vertexOffset;
+                        }
+
+                        if (index < 0 || index >= (int64bit)vertexCount) {
+                            valid.store(false, std::memory_order_relaxed);
+                            index = 0;
+                        }
+
+                        mesh.indices[indexOffsets[i] + j] = (uint32bit)index;
+                    }
+                }
+            }, threadCount);
+
+            if (!valid.load()) {
+                mesh.clear();
+                return false;
+            }
+
+            return true;
+        }
+    } /* namespace io */
+} /* namespace geometry */
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_IO_OBJ_FILE_H_
+#define _GEOMETRY_IO_OBJ_FILE_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "../stereometry/IndexedMesh3F.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        // Reads vertex positions ("v") and faces ("f") of a Wavefront OBJ file.
+        // Polygons are split into triangle fans, all other records are skipped.
+        // The text is split at line boundaries and the parts are parsed in
+        // parallel; threadCount limits the threads of the shared pool, 0 uses all of them.
+        bool readObjFile(const char * path, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+
+        bool parseObj(const char8bit * text, const size_t length, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+    } /* namespace io */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_IO_OBJ_FILE_H_ */
@@ -0,0 +1,393 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PackedMeshFile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        static const char8bit SIGNATURE[4] = { 'G', 'P', 'M', 'F' };
+        static const float32bit QUANTIZATION_STEPS = 65535.0f;
+
+        static inline uint64bit getIndexTableOffset(const uint64bit vertexCount)
+        {
+            uint64bit offset = sizeof(PackedMeshHeader) + vertexCount * 3 * sizeof(uint16bit);
+            return (offset + 7) & ~(uint64bit)7;
+        }
+
+        static inline uint64bit encodeZigzag(const int64bit value)
+        {
+            return ((uint64bit)value << 1) ^ (uint64bit)(value >> 63);
+        }
+
+        static inline int64bit decodeZigzag(const uint64bit value)
+        {
+            return (int64bit)(value >> 1) ^ -(int64bit)(value & 1);
+        }
+
+        static FILE * openForWriting(const char * path)
+        {
+#ifdef _MSC_VER
+            FILE * file = 0;
+            return fopen_s(&file, path, "wb") == 0 ? file : 0;
+#else
+            return fopen(path, "wb");
+#endif
+        }
+
+        // ================= PackedMeshView methods ================= //
+
+        PackedMeshView::PackedMeshView()
+            : indexTable(0)
+        {
+            memset(&this->header, 0, sizeof(this->header));
+        }
+
+        PackedMeshView::~PackedMeshView()
+        {
+        }
+
+        bool PackedMeshView::open(const char * path)
+        {
+            this->close();
+
+            if (!this->file.open(path) || this->file.size() < sizeof(PackedMeshHeader)) {
+                this->close();
+                return false;
+            }
+
+            memcpy(&this->header, this->file.data(), sizeof(PackedMeshHeader));
+
+            if (memcmp(this->header.signature, SIGNATURE, sizeof(SIGNATURE)) != 0
+                || this->header.version != VERSION
+                || this->header.verticesPerChunk == 0
+                || this->header.indicesPerChunk == 0
+                || this->header.vertexCount >= 0xFFFFFFFFu
+                || this->header.indexCount % 3 != 0) {
+                this->close();
+                return false;
+            }
+
+            // The counts are checked against the file before anything is
+            // sized by them: the vertices have to fit before the table and
+            // the indices into their chunks
+            uint64bit tableOffset = getIndexTableOffset(this->header.vertexCount);
+            uint64bit chunkCount = this->getIndexChunkCount();
+
+            if (this->file.size() < tableOffset || (this->file.size() - tableOffset) / sizeof(uint64bit) < chunkCount + 1) {
+                this->close();
+                return false;
+            }
+
+            this->indexTable = (const uint64bit *)(this->file.data() + tableOffset);
+
+            uint64bit previous = tableOffset + (chunkCount + 1) * sizeof(uint64bit);
+
+            // An index takes at least a byte of its chunk
+            for (uint64bit i = 0; i <= chunkCount; i++) {
+                if (this->indexTable[i] < previous || this->indexTable[i] > this->file.size()
+                    || (i > 0 && this->indexTable[i] - previous < this->getChunkSize(this->header.indexCount, this->header.indicesPerChunk, i - 1))) {
+                    this->close();
+                    return false;
+                }
+
+                previous = this->indexTable[i];
+            }
+
+            return true;
+        }
+
+        void PackedMeshView::close()
+        {
+            this->file.close();
+            this->indexTable = 0;
+            memset(&this->header, 0, sizeof(this->header));
+        }
+
+        stereometry::Converter3F PackedMeshView::getConverter() const
+        {
+            stereometry::Converter3F converter;
+
+            converter.warp.r1c1 = this->header.warp[0];
+            converter.warp.r1c2 = this->header.warp[1];
+            converter.warp.r1c3 = this->header.warp[2];
+
+            converter.warp.r2c1 = this->header.warp[3];
+            converter.warp.r2c2 = this->header.warp[4];
+            converter.warp.r2c3 = this->header.warp[5];
+
+            converter.warp.r3c1 = this->header.warp[6];
+            converter.warp.r3c2 = this->header.warp[7];
+            converter.warp.r3c3 = this->header.warp[8];
+
+            converter.shift.setValues(this->header.shift[0], this->header.shift[1], this->header.shift[2]);
+
+            return converter;
+        }
+
+        size_t PackedMeshView::decodeVertexChunk(const uint64bit chunk, stereometry::Vector3F * target) const
+        {
+            GEOMETRY_PROFILE_SCOPE("packed.decode_vertices");
+
+            const size_t count = (size_t)this->getChunkSize(this->header.vertexCount, this->header.verticesPerChunk, chunk);
+            const uint16bit * source = this->quantizedVertices() + chunk * this->header.verticesPerChunk * 3;
+
+            const stereometry::Converter3F converter = this->getConverter();
+
+            for (size_t i = 0; i < count; i++) {
+                target[i] = converter.convert(stereometry::Vector3F(source[i * 3], source[i * 3 + 1], source[i * 3 + 2]));
+            }
+
+            return count;
+        }
+
+        size_t PackedMeshView::decodeVertexChunk(const uint64bit chunk, float32bit * coordinates) const
+        {
+            GEOMETRY_PROFILE_SCOPE("packed.decode_vertices");
+
+            const size_t count = (size_t)this->getChunkSize(this->header.vertexCount, this->header.verticesPerChunk, chunk);
+            const uint16bit * source = this->quantizedVertices() + chunk * this->header.verticesPerChunk * 3;
+
+            const float32bit * warp = this->header.warp;
+            const float32bit * shift = this->header.shift;
+
+            // Straight-line loop without branches, it is vectorized by the compiler
+            for (size_t i = 0; i < count * 3; i += 3) {
+                float32bit x = (float32bit)source[i];
+                float32bit y = (float32bit)source[i + 1];
+                float32bit z = (float32bit)source[i + 2];
+
+                coordinates[i] = warp[0] * x + warp[1] * y + warp[2] * z + shift[0];
+                coordinates[i + 1] = warp[3] * x + warp[4] * y + warp[5] * z + shift[1];
+                coordinates[i + 2] = warp[6] * x + warp[7] * y + warp[8] * z + shift[2];
+            }
+
+            return count;
+        }
+
+        size_t PackedMeshView::decodeIndexChunk(const uint64bit chunk, uint32bit * target) const
+        {
+            GEOMETRY_PROFILE_SCOPE("packed.decode_indices");
+
+            const size_t count = (size_t)this->getChunkSize(this->header.indexCount, this->header.indicesPerChunk, chunk);
+
+            const uint8bit * position = this->file.data() + this->indexTable[chunk];
+            const uint8bit * end = this->file.data() + this->indexTable[chunk + 1];
+
+            int64bit previous = 0;
+
+            for (size_t i = 0; i < count; i++) {
+                uint64bit encoded = 0;
+                uint32bit shift = 0;
+
+                while (position < end && (*position & 0x80) != 0 && shift < 63) {
+                    encoded |= (uint64bit)(*position & 0x7F) << shift;
+                    shift += 7;
+                    position++;
+                }
+
+                if (position == end) {
+                    return i;
+                }
+
+                encoded |= (uint64bit)*position << shift;
+                position++;
+
+                previous += decodeZigzag(encoded);
+
+                if (previous < 0 || (uint64bit)previous >= this->header.vertexCount) {
+                    return i;
+                }
+
+                target[i] = (uint32bit)previous;
+            }
+
+            return count;
+        }
+
+        bool PackedMeshView::toIndexedMesh(stereometry::IndexedMesh3F & mesh, const uint32bit threadCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("packed.to_indexed_mesh");
+
+            mesh.clear();
+
+            if (!this->isOpen()) {
+                return false;
+            }
+
+            mesh.vertices.resize((size_t)this->header.vertexCount);
+            mesh.indices.resize((size_t)this->header.indexCount);
+
+            const uint64bit vertexChunks = this->getVertexChunkCount();
+            const uint64bit chunkCount = vertexChunks + this->getIndexChunkCount();
+
+            std::vector<uint8bit> failed((size_t)chunkCount, 0);
+
+            parallelFor(0, (size_t)chunkCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t chunk = first; chunk < last; chunk++) {
+                    if (chunk < vertexChunks) {
+                        this->decodeVertexChunk(chunk, &mesh.vertices[chunk * this->header.verticesPerChunk]);
+                        continue;
+                    }
+
+                    uint64bit indexChunk = chunk - vertexChunks;
+                    uint32bit * target = &mesh.indices[(size_t)(indexChunk * this->header.indicesPerChunk)];
+
+                    if (this->decodeIndexChunk(indexChunk, target) != this->getChunkSize(this->header.indexCount, this->header.indicesPerChunk, indexChunk)) {
+                        failed[chunk] = 1;
+                    }
+                }
+            }, threadCount);
+
+            for (size_t i = 0; i < failed.size(); i++) {
+                if (failed[i] != 0) {
+                    mesh.clear();
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // ================= Packed mesh writer ================= //
+
+        bool writePackedMesh(const char * path, const stereometry::IndexedMesh3F & mesh, const uint32bit verticesPerChunk, const uint32bit indicesPerChunk)
+        {
+            GEOMETRY_PROFILE_SCOPE("packed.write");
+
+            if (verticesPerChunk == 0 || indicesPerChunk == 0 || mesh.indices.size() % 3 != 0 || mesh.vertices.size() >= 0xFFFFFFFFu) {
+                return false;
+            }
+
+            PackedMeshHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.signature, SIGNATURE, sizeof(SIGNATURE));
+
+            header.version = PackedMeshView::VERSION;
+            header.vertexCount = mesh.vertices.size();
+            header.indexCount = mesh.indices.size();
+            header.verticesPerChunk = verticesPerChunk;
+            header.indicesPerChunk = indicesPerChunk;
+
+            stereometry::Vector3F minimum, maximum;
+
+            if (!mesh.vertices.empty()) {
+                minimum = mesh.vertices[0];
+                maximum = mesh.vertices[0];
+            }
+
+            for (size_t i = 1; i < mesh.vertices.size(); i++) {
+                const stereometry::Vector3F & vertex = mesh.vertices[i];
+
+                minimum.setValues(vertex.x < minimum.x ? vertex.x : minimum.x, vertex.y < minimum.y ? vertex.y : minimum.y, vertex.z < minimum.z ? vertex.z : minimum.z);
+                maximum.setValues(vertex.x > maximum.x ? vertex.x : maximum.x, vertex.y > maximum.y ? vertex.y : maximum.y, vertex.z > maximum.z ? vertex.z : maximum.z);
+            }
+
+            header.warp[0] = (maximum.x - minimum.x) / QUANTIZATION_STEPS;
+            header.warp[4] = (maximum.y - minimum.y) / QUANTIZATION_STEPS;
+            header.warp[8] = (maximum.z - minimum.z) / QUANTIZATION_STEPS;
+
+            header.shift[0] = minimum.x;
+            header.shift[1] = minimum.y;
+            header.shift[2] = minimum.z;
+
+            float32bit factors[3];
+
+            for (size_t axis = 0; axis < 3; axis++) {
+                float32bit step = header.warp[axis * 4];
+                factors[axis] = step > 0.0f ? 1.0f / step : 0.0f;
+            }
+
+            FILE * file = openForWriting(path);
+
+            if (file == 0) {
+                return false;
+            }
+
+            bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+            std::vector<uint16bit> quantized;
+            quantized.reserve((size_t)verticesPerChunk * 3);
+
+            for (size_t begin = 0; success && begin < mesh.vertices.size(); begin += verticesPerChunk) {
+                size_t end = begin + verticesPerChunk < mesh.vertices.size() ? begin + verticesPerChunk : mesh.vertices.size();
+
+                quantized.clear();
+
+                for (size_t i = begin; i < end; i++) {
+                    const float32bit coordinates[3] = { mesh.vertices[i].x - minimum.x, mesh.vertices[i].y - minimum.y, mesh.vertices[i].z - minimum.z };
+
+                    for (size_t axis = 0; axis < 3; axis++) {
+                        float32bit steps = coordinates[axis] * factors[axis] + 0.5f;
+                        quantized.push_back((uint16bit)(steps < QUANTIZATION_STEPS ? steps : QUANTIZATION_STEPS));
+                    }
+                }
+
+                success = fwrite(&quantized[0], sizeof(uint16bit), quantized.size(), file) == quantized.size();
+            }
+
+            const size_t tableOffset = (size_t)getIndexTableOffset(header.vertexCount);
+            const size_t chunkCount = (mesh.indices.size() + indicesPerChunk - 1) / indicesPerChunk;
+
+            static const uint8bit PADDING[8] = { 0 };
+            size_t padding = tableOffset - sizeof(PackedMeshHeader) - (size_t)header.vertexCount * 3 * sizeof(uint16bit);
+
+            success = success && fwrite(PADDING, 1, padding, file) == padding;
+
+            // The chunks are encoded before the table is written, the table needs their sizes
+            std::vector<uint64bit> table(chunkCount + 1);
+            std::vector<uint8bit> encoded;
+            encoded.reserve(mesh.indices.size() * 2);
+
+            table[0] = tableOffset + table.size() * sizeof(uint64bit);
+
+            for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+                size_t begin = chunk * indicesPerChunk;
+                size_t end = begin + indicesPerChunk < mesh.indices.size() ? begin + indicesPerChunk : mesh.indices.size();
+
+                int64bit previous = 0;
+
+                for (size_t i = begin; i < end; i++) {
+                    uint64bit value = encodeZigzag((int64bit)mesh.indices[i] - previous);
+                    previous = mesh.indices[i];
+
+                    while (value >= 0x80) {
+                        encoded.push_back((uint8bit)(value | 0x80));
+                        value >>= 7;
+                    }
+
+                    encoded.push_back((uint8bit)value);
+                }
+
+                table[chunk + 1] = table[0] + encoded.size();
+            }
+
+            success = success && fwrite(&table[0], sizeof(uint64bit), table.size(), file) == table.size();
+            success = success && (encoded.empty() || fwrite(&encoded[0], 1, encoded.size(), file) == encoded.size());
+
+            return fclose(file) == 0 && success;
+        }
+    } /* namespace io */
+} /* namespace geometry */
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_IO_PACKED_MESH_FILE_H_
+#define _GEOMETRY_IO_PACKED_MESH_FILE_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "../stereometry/Vector3.h"
+#include "../stereometry/Converter3F.h"
+#include "../stereometry/IndexedMesh3F.h"
+#include "MappedFile.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        // Native compact storage for point clouds and meshes. Layout of the
+        // file (little-endian):
+        //
+        //   PackedMeshHeader
+        //   vertices:    vertexCount * 3 uint16bit, quantized positions
+        //   index table: (index chunk count + 1) uint64bit file offsets of the index
+        //                chunks, aligned to 8 bytes
+        //   indices:     chunks of zigzag LEB128 deltas between consecutive indices
+        //
+        // A position is restored by the dequantizing transform stored in the
+        // header: vertex = warp * (qx, qy, qz) + shift. Every chunk is
+        // independent of others, so chunks can be decoded at random and in parallel.
+        struct PackedMeshHeader
+        {
+            char8bit signature[4];
+            uint32bit version;
+            uint64bit vertexCount;
+            uint64bit indexCount;
+            uint32bit verticesPerChunk;
+            uint32bit indicesPerChunk;
+            float32bit warp[9];
+            float32bit shift[3];
+        };
+
+        // =================== PackedMeshView header =================== //
+
+        class PackedMeshView
+        {
+        public:
+            static const uint32bit VERSION = 1;
+
+            PackedMeshView();
+            virtual ~PackedMeshView();
+
+            bool open(const char * path);
+            void close();
+
+            inline bool isOpen() const;
+
+            inline uint64bit getVertexCount() const;
+            inline uint64bit getIndexCount() const;
+
+            inline uint64bit getVertexChunkCount() const;
+            inline uint64bit getIndexChunkCount() const;
+
+            inline uint32bit getVerticesPerChunk() const;
+            inline uint32bit getIndicesPerChunk() const;
+
+            stereometry::Converter3F getConverter() const;
+
+            // Quantized positions as they are stored in the file: x, y, z per vertex
+            inline const uint16bit * quantizedVertices() const;
+
+            // Decoders return the number of written items
+            size_t decodeVertexChunk(const uint64bit chunk, stereometry::Vector3F * target) const;
+            size_t decodeVertexChunk(const uint64bit chunk, float32bit * coordinates) const;
+            size_t decodeIndexChunk(const uint64bit chunk, uint32bit * target) const;
+
+            bool toIndexedMesh(stereometry::IndexedMesh3F & mesh, const uint32bit threadCount = 0) const;
+
+        private:
+            MappedFile file;
+            PackedMeshHeader header;
+            const uint64bit * indexTable;
+
+            inline uint64bit getChunkSize(const uint64bit total, const uint32bit perChunk, const uint64bit chunk) const;
+        };
+
+        // Quantizes the positions to 16 bits per axis within the bounding box
+        // of the mesh. A mesh without indices is stored as a point cloud.
+        bool writePackedMesh(const char * path, const stereometry::IndexedMesh3F & mesh, const uint32bit verticesPerChunk = 65536, const uint32bit indicesPerChunk = 196608);
+
+        // ================ PackedMeshView inline methods ================ //
+
+        bool PackedMeshView::isOpen() const
+        {
+            return this->file.isOpen();
+        }
+
+        uint64bit PackedMeshView::getVertexCount() const
+        {
+            return this->header.vertexCount;
+        }
+
+        uint64bit PackedMeshView::getIndexCount() const
+        {
+            return this->header.indexCount;
+        }
+
+        uint64bit PackedMeshView::getVertexChunkCount() const
+        {
+            return (this->header.vertexCount + this->header.verticesPerChunk - 1) / this->header.verticesPerChunk;
+        }
+
+        uint64bit PackedMeshView::getIndexChunkCount() const
+        {
+            return (this->header.indexCount + this->header.indicesPerChunk - 1) / this->header.indicesPerChunk;
+        }
+
+        uint32bit PackedMeshView::getVerticesPerChunk() const
+        {
+            return this->header.verticesPerChunk;
+        }
+
+        uint32bit PackedMeshView::getIndicesPerChunk() const
+        {
+            return this->header.indicesPerChunk;
+        }
+
+        const uint16bit * PackedMeshView::quantizedVertices() const
+        {
+            return (const uint16bit *)(this->file.data() + sizeof(PackedMeshHeader));
+        }
+
+        uint64bit PackedMeshView::getChunkSize(const uint64bit total, const uint32bit perChunk, const uint64bit chunk) const
+        {
+            uint64bit begin = chunk * perChunk;
+
+            if (begin >= total) {
+                return 0;
+            }
+
+            return total - begin < perChunk ? total - begin : perChunk;
+        }
+    } /* namespace io */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_IO_PACKED_MESH_FILE_H_ */
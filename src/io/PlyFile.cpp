@@ -0,0 +1,531 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PlyFile.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+#include "TextParser.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        enum PlyFormat
+        {
+            PLY_ASCII = 0x0,
+            PLY_BINARY_LITTLE_ENDIAN = 0x1,
+            PLY_BINARY_BIG_ENDIAN = 0x2
+        };
+
+        enum PlyType
+        {
+            PLY_NONE = 0x0,
+            PLY_INT8 = 0x1,
+            PLY_UINT8 = 0x2,
+            PLY_INT16 = 0x3,
+            PLY_UINT16 = 0x4,
+            PLY_INT32 = 0x5,
+            PLY_UINT32 = 0x6,
+            PLY_FLOAT32 = 0x7,
+            PLY_FLOAT64 = 0x8
+        };
+
+        struct PlyProperty
+        {
+            std::string name;
+            PlyType type;
+            PlyType countType; // PLY_NONE for scalar properties
+        };
+
+        struct PlyElement
+        {
+            std::string name;
+            size_t count;
+            std::vector<PlyProperty> properties;
+        };
+
+        static const char8bit * const NO_POSITION = 0;
+
+        static PlyType parsePlyType(const std::string & name)
+        {
+            if (name == "char" || name == "int8") return PLY_INT8;
+            if (name == "uchar" || name == "uint8") return PLY_UINT8;
+            if (name == "short" || name == "int16") return PLY_INT16;
+            if (name == "ushort" || name == "uint16") return PLY_UINT16;
+            if (name == "int" || name == "int32") return PLY_INT32;
+            if (name == "uint" || name == "uint32") return PLY_UINT32;
+            if (name == "float" || name == "float32") return PLY_FLOAT32;
+            if (name == "double" || name == "float64") return PLY_FLOAT64;
+            return PLY_NONE;
+        }
+
+        static size_t getPlyTypeSize(const PlyType type)
+        {
+            static const size_t SIZES[] = { 0, 1, 1, 2, 2, 4, 4, 4, 8 };
+            return SIZES[type];
+        }
+
+        static inline double readBinaryValue(const uint8bit * source, const PlyType type, const bool swapBytes)
+        {
+            uint8bit bytes[8] = { 0 };
+            size_t size = getPlyTypeSize(type);
+
+            if (swapBytes) {
+                for (size_t i = 0; i < size; i++) {
+                    bytes[i] = source[size - 1 - i];
+                }
+            }
+            else {
+                memcpy(bytes, source, size);
+            }
+
+            switch (type) {
+                case PLY_INT8: { int8bit value; memcpy(&value, bytes, 1); return value; }
+                case PLY_UINT8: { uint8bit value; memcpy(&value, bytes, 1); return value; }
+                case PLY_INT16: { int16bit value; memcpy(&value, bytes, 2); return value; }
+                case PLY_UINT16: { uint16bit value; memcpy(&value, bytes, 2); return value; }
+                case PLY_INT32: { int32bit value; memcpy(&value, bytes, 4); return value; }
+                case PLY_UINT32: { uint32bit value; memcpy(&value, bytes, 4); return value; }
+                case PLY_FLOAT32: { float32bit value; memcpy(&value, bytes, 4); return value; }
+                case PLY_FLOAT64: { float64bit value; memcpy(&value, bytes, 8); return value; }
+                default: return 0.0;
+            }
+        }
+
+        static const char8bit * readNextLine(const char8bit * position, const char8bit * end, std::vector<std::string> & words)
+        {
+            words.clear();
+
+            while (position < end && *position != '\n') {
+                position = skipSpaces(position, end);
+
+                const char8bit * wordEnd = skipToken(position, end);
+
+                if (wordEnd > position) {
+                    words.push_back(std::string(position, wordEnd));
+                }
+
+                position = wordEnd;
+            }
+
+            return position < end ? position + 1 : NO_POSITION;
+        }
+
+        static const char8bit * parseHeader(const char8bit * position, const char8bit * end, PlyFormat & format, std::vector<PlyElement> & elements)
+        {
+            std::vector<std::string> words;
+
+            position = readNextLine(position, end, words);
+
+            if (position == NO_POSITION || words.size() != 1 || words[0] != "ply") {
+                return NO_POSITION;
+            }
+
+            bool hasFormat = false;
+
+            while (true) {
+                position = readNextLine(position, end, words);
+
+                if (position == NO_POSITION) {
+                    return NO_POSITION;
+                }
+
+                if (words.empty() || words[0] == "comment" || words[0] == "obj_info") {
+                    continue;
+                }
+
+                if (words[0] == "end_header") {
+                    return hasFormat ? position : NO_POSITION;
+                }
+
+                if (words[0] == "format" && words.size() >= 2) {
+                    if (words[1] == "ascii") format = PLY_ASCII;
+                    else if (words[1] == "binary_little_endian") format = PLY_BINARY_LITTLE_ENDIAN;
+                    else if (words[1] == "binary_big_endian") format = PLY_BINARY_BIG_ENDIAN;
+                    else return NO_POSITION;
+
+                    hasFormat = true;
+                }
+                else if (words[0] == "element" && words.size() == 3) {
+                    int64bit count;
+
+                    if (parseInteger(words[2].c_str(), words[2].c_str() + words[2].size(), count) == NO_POSITION || count < 0) {
+                        return NO_POSITION;
+                    }
+
+                    PlyElement element;
+                    element.name = words[1];
+                    element.count = (size_t)count;
+                    elements.push_back(element);
+                }
+                else if (words[0] == "property" && !elements.empty()) {
+                    PlyProperty property;
+
+                    if (words.size() == 3) {
+                        property.type = parsePlyType(words[1]);
+                        property.countType = PLY_NONE;
+                        property.name = words[2];
+                    }
+                    else if (words.size() == 5 && words[1] == "list") {
+                        property.countType = parsePlyType(words[2]);
+                        property.type = parsePlyType(words[3]);
+                        property.name = words[4];
+
+                        if (property.countType == PLY_NONE) {
+                            return NO_POSITION;
+                        }
+                    }
+                    else {
+                        return NO_POSITION;
+                    }
+
+                    if (property.type == PLY_NONE) {
+                        return NO_POSITION;
+                    }
+
+                    elements.back().properties.push_back(property);
+                }
+                else {
+                    return NO_POSITION;
+                }
+            }
+        }
+
+        // Reads elements of any layout one value at a time, for ascii data and
+        // for binary records with list properties
+        class PlyValueReader
+        {
+        public:
+            PlyValueReader(const char8bit * position, const char8bit * end, const PlyFormat format)
+                : position(position), end(end), format(format)
+            {
+            }
+
+            bool read(const PlyType type, double & value)
+            {
+                if (this->format == PLY_ASCII) {
+                    this->position = parseDouble(skipAsciiSpaces(), this->end, value);
+                    return this->position != NO_POSITION;
+                }
+
+                size_t size = getPlyTypeSize(type);
+
+                if ((size_t)(this->end - this->position) < size) {
+                    return false;
+                }
+
+                value = readBinaryValue((const uint8bit *)this->position, type, this->format == PLY_BINARY_BIG_ENDIAN);
+                this->position += size;
+
+                return true;
+            }
+
+            const char8bit * getPosition() const
+            {
+                return this->position;
+            }
+
+            size_t getRemainingSize() const
+            {
+                return (size_t)(this->end - this->position);
+            }
+
+            // The fewest bytes a value of the type takes
+            size_t getMinimalSize(const PlyType type) const
+            {
+                return this->format == PLY_ASCII ? 1 : getPlyTypeSize(type);
+            }
+
+            void setPosition(const char8bit * position)
+            {
+                this->position = position;
+            }
+
+        private:
+            const char8bit * position;
+            const char8bit * end;
+            PlyFormat format;
+
+            const char8bit * skipAsciiSpaces() const
+            {
+                const char8bit * current = this->position;
+
+                while (current < this->end && (isSpace(*current) || *current == '\n')) {
+                    current++;
+                }
+
+                return current;
+            }
+        };
+
+        static int findProperty(const PlyElement & element, const char * name)
+        {
+            for (size_t i = 0; i < element.properties.size(); i++) {
+                if (element.properties[i].name == name) {
+                    return (int)i;
+                }
+            }
+
+            return -1;
+        }
+
+        static bool hasFixedSize(const PlyElement & element, size_t & stride)
+        {
+            stride = 0;
+
+            for (size_t i = 0; i < element.properties.size(); i++) {
+                if (element.properties[i].countType != PLY_NONE) {
+                    return false;
+                }
+
+                stride += getPlyTypeSize(element.properties[i].type);
+            }
+
+            return true;
+        }
+
+        static bool readBinaryVertices(PlyValueReader & reader, const char8bit * end, const PlyElement & element, const bool swapBytes, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            size_t stride;
+            hasFixedSize(element, stride);
+
+            const char8bit * begin = reader.getPosition();
+
+            if ((size_t)(end - begin) / (stride > 0 ? stride : 1) < element.count) {
+                return false;
+            }
+
+            size_t offsets[3];
+            PlyType types[3];
+            const char * names[3] = { "x", "y", "z" };
+
+            for (size_t axis = 0; axis < 3; axis++) {
+                int property = findProperty(element, names[axis]);
+                offsets[axis] = 0;
+
+                for (int i = 0; i < property; i++) {
+                    offsets[axis] += getPlyTypeSize(element.properties[i].type);
+                }
+
+                types[axis] = element.properties[property].type;
+            }
+
+            mesh.vertices.resize(element.count);
+
+            const uint8bit * records = (const uint8bit *)begin;
+
+            parallelFor(0, element.count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const uint8bit * record = records + i * stride;
+
+                    mesh.vertices[i].setValues(
+                        (float32bit)readBinaryValue(record + offsets[0], types[0], swapBytes),
+                        (float32bit)readBinaryValue(record + offsets[1], types[1], swapBytes),
+                        (float32bit)readBinaryValue(record + offsets[2], types[2], swapBytes)
+                    );
+                }
+            }, threadCount);
+
+            reader.setPosition(begin + element.count * stride);
+
+            return true;
+        }
+
+        static bool readElement(PlyValueReader & reader, const PlyElement & element, const bool isVertex, const bool isFace, stereometry::IndexedMesh3F & mesh)
+        {
+            int coordinates[3] = { -1, -1, -1 };
+            int faceProperty = -1;
+
+            // The count comes from the header, a row takes at least a byte, or
+            // a value, for every property, so a count the rest of the body
+            // cannot hold is refused before anything is allocated
+            size_t rowSize = 0;
+
+            for (size_t i = 0; i < element.properties.size(); i++) {
+                const PlyProperty & property = element.properties[i];
+                rowSize += reader.getMinimalSize(property.countType != PLY_NONE ? property.countType : property.type);
+            }
+
+            if (reader.getRemainingSize() / (rowSize > 0 ? rowSize : 1) < element.count) {
+                return false;
+            }
+
+            if (isVertex) {
+                coordinates[0] = findProperty(element, "x");
+                coordinates[1] = findProperty(element, "y");
+                coordinates[2] = findProperty(element, "z");
+                mesh.vertices.resize(element.count);
+            }
+
+            if (isFace) {
+                faceProperty = findProperty(element, "vertex_indices");
+
+                if (faceProperty < 0) {
+                    faceProperty = findProperty(element, "vertex_index");
+                }
+
+                mesh.indices.reserve(element.count * 3);
+            }
+
+            for (size_t row = 0; row < element.count; row++) {
+                float32bit position[3] = { 0.0f, 0.0f, 0.0f };
+
+                for (size_t i = 0; i < element.properties.size(); i++) {
+                    const PlyProperty & property = element.properties[i];
+                    double value;
+
+                    if (property.countType == PLY_NONE) {
+                        if (!reader.read(property.type, value)) {
+                            return false;
+                        }
+
+                        for (size_t axis = 0; axis < 3; axis++) {
+                            if (coordinates[axis] == (int)i) {
+                                position[axis] = (float32bit)value;
+                            }
+                        }
+
+                        continue;
+                    }
+
+                    if (!reader.read(property.countType, value) || value < 0.0) {
+                        return false;
+                    }
+
+                    size_t count = (size_t)value;
+                    double first = 0.0, previous = 0.0;
+
+                    for (size_t j = 0; j < count; j++) {
+                        if (!reader.read(property.type, value)) {
+                            return false;
+                        }
+
+                        if (faceProperty != (int)i) {
+                            continue;
+                        }
+
+                        if (value < 0.0 || value >= 4294967295.0) {
+                            return false;
+                        }
+
+                        if (j == 0) {
+                            first = value;
+                        }
+                        else if (j >= 2) {
+                            mesh.indices.push_back((uint32bit)first);
+                            mesh.indices.push_back((uint32bit)previous);
+                            mesh.indices.push_back((uint32bit)value);
+                        }
+
+                        previous = value;
+                    }
+                }
+
+                if (isVertex) {
+                    mesh.vertices[row].setValues(position[0], position[1], position[2]);
+                }
+            }
+
+            return true;
+        }
+
+        bool readPlyFile(const char * path, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            MappedFile file;
+
+            if (!file.open(path)) {
+                mesh.clear();
+                return false;
+            }
+
+            file.adviseSequential();
+
+            return parsePly(file.data(), file.size(), mesh, threadCount);
+        }
+
+        bool parsePly(const uint8bit * data, const size_t length, stereometry::IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("ply.parse");
+
+            mesh.clear();
+
+            const char8bit * end = (const char8bit *)data + length;
+
+            PlyFormat format = PLY_ASCII;
+            std::vector<PlyElement> elements;
+
+            const char8bit * position = parseHeader((const char8bit *)data, end, format, elements);
+
+            if (position == NO_POSITION) {
+                return false;
+            }
+
+            PlyValueReader reader(position, end, format);
+
+            bool hasVertices = false;
+
+            for (size_t i = 0; i < elements.size(); i++) {
+                const PlyElement & element = elements[i];
+
+                bool isVertex = !hasVertices && element.name == "vertex";
+                bool isFace = element.name == "face";
+
+                if (isVertex && (findProperty(element, "x") < 0 || findProperty(element, "y") < 0 || findProperty(element, "z") < 0)) {
+                    return false;
+                }
+
+                size_t stride;
+                bool success;
+
+                if (format != PLY_ASCII && hasFixedSize(element, stride)) {
+                    if (isVertex) {
+                        success = readBinaryVertices(reader, end, element, format == PLY_BINARY_BIG_ENDIAN, mesh, threadCount);
+                    }
+                    else {
+                        success = (size_t)(end - reader.getPosition()) / (stride > 0 ? stride : 1) >= element.count;
+                        reader.setPosition(reader.getPosition() + (success ? element.count * stride : 0));
+                    }
+                }
+                else {
+                    success = readElement(reader, element, isVertex, isFace, mesh);
+                }
+
+                if (!success) {
+                    mesh.clear();
+                    return false;
+                }
+
+                hasVertices = hasVertices || isVertex;
+            }
+
+            for (size_t i = 0; i < mesh.indices.size(); i++) {
+                if (mesh.indices[i] >= mesh.vertices.size()) {
+                    mesh.clear();
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } /* namespace io */
+} /* namespace geometry */
@@ -0,0 +1,279 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StlFile.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        static const uint32bit EMPTY_SLOT = 0xFFFFFFFFu;
+        static const size_t WRITE_BLOCK_FACETS = 4096;
+
+        static inline uint32bit readCoordinateBits(const float32bit value)
+        {
+            // Adding zero turns -0.0 into +0.0, so both are welded together
+            float32bit normalized = value + 0.0f;
+            uint32bit bits;
+            memcpy(&bits, &normalized, sizeof(bits));
+            return bits;
+        }
+
+        static inline uint32bit hashVertex(const uint32bit x, const uint32bit y, const uint32bit z)
+        {
+            uint32bit hash = x * 0x8DA6B343u ^ y * 0xD8163841u ^ z * 0xCB1AB31Fu;
+
+            hash ^= hash >> 16;
+            hash *= 0x85EBCA6Bu;
+            hash ^= hash >> 13;
+            hash *= 0xC2B2AE35u;
+            hash ^= hash >> 16;
+
+            return hash;
+        }
+
+        static FILE * openForWriting(const char * path)
+        {
+#ifdef _MSC_VER
+            FILE * file = 0;
+            return fopen_s(&file, path, "wb") == 0 ? file : 0;
+#else
+            return fopen(path, "wb");
+#endif
+        }
+
+        // ================= BinaryStlView methods ================= //
+
+        BinaryStlView::BinaryStlView()
+            : triangleCount(0)
+        {
+        }
+
+        BinaryStlView::~BinaryStlView()
+        {
+        }
+
+        bool BinaryStlView::open(const char * path)
+        {
+            this->close();
+
+            if (!this->file.open(path)) {
+                return false;
+            }
+
+            if (this->file.size() < HEADER_SIZE + sizeof(uint32bit)) {
+                this->close();
+                return false;
+            }
+
+            uint32bit count;
+            memcpy(&count, this->file.data() + HEADER_SIZE, sizeof(count));
+
+            if (this->file.size() < HEADER_SIZE + sizeof(uint32bit) + (size_t)count * FACET_SIZE) {
+                this->close();
+                return false;
+            }
+
+            this->triangleCount = count;
+            this->file.adviseSequential();
+
+            return true;
+        }
+
+        void BinaryStlView::close()
+        {
+            this->file.close();
+            this->triangleCount = 0;
+        }
+
+        bool BinaryStlView::toIndexedMesh(stereometry::IndexedMesh3F & mesh, const bool weldVertices, const uint32bit threadCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("stl.to_indexed_mesh");
+
+            mesh.clear();
+
+            if (!this->isOpen()) {
+                return false;
+            }
+
+            const StlFacet * facets = this->facets();
+            const size_t cornerCount = (size_t)this->triangleCount * 3;
+
+            if (cornerCount >= EMPTY_SLOT) {
+                return false;
+            }
+
+            mesh.indices.resize(cornerCount);
+
+            if (!weldVertices) {
+                mesh.vertices.resize(cornerCount);
+
+                parallelFor(0, this->triangleCount, DEFAULT_PARALLEL_GRAIN, [&](const size_t begin, const size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        const float32bit * vertex = facets[i].vertices;
+
+                        for (size_t corner = 0; corner < 3; corner++) {
+                            mesh.vertices[i * 3 + corner].setValues(vertex[corner * 3], vertex[corner * 3 + 1], vertex[corner * 3 + 2]);
+                            mesh.indices[i * 3 + corner] = (uint32bit)(i * 3 + corner);
+                        }
+                    }
+                }, threadCount);
+
+                return true;
+            }
+
+            // The hashes are computed in parallel, the table is filled in the
+            // order of the corners, so the vertex order does not depend on threads
+            std::vector<uint32bit> hashes(cornerCount);
+
+            parallelFor(0, this->triangleCount, DEFAULT_PARALLEL_GRAIN, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const float32bit * vertex = facets[i].vertices;
+
+                    for (size_t corner = 0; corner < 3; corner++) {
+                        hashes[i * 3 + corner] = hashVertex(
+                            readCoordinateBits(vertex[corner * 3]),
+                            readCoordinateBits(vertex[corner * 3 + 1]),
+                            readCoordinateBits(vertex[corner * 3 + 2])
+                        );
+                    }
+                }
+            }, threadCount);
+
+            size_t capacity = 16;
+
+            while (capacity < cornerCount * 2) {
+                capacity <<= 1;
+            }
+
+            const size_t mask = capacity - 1;
+
+            std::vector<uint32bit> table(capacity, EMPTY_SLOT);
+            std::vector<uint32bit> firstCorners;
+            firstCorners.reserve(cornerCount / 4 + 16);
+
+            for (size_t corner = 0; corner < cornerCount; corner++) {
+                const float32bit * vertex = facets[corner / 3].vertices + (corner % 3) * 3;
+
+                uint32bit x = readCoordinateBits(vertex[0]);
+                uint32bit y = readCoordinateBits(vertex[1]);
+                uint32bit z = readCoordinateBits(vertex[2]);
+
+                size_t slot = hashes[corner] & mask;
+
+                while (true) {
+                    uint32bit candidate = table[slot];
+
+                    if (candidate == EMPTY_SLOT) {
+                        table[slot] = (uint32bit)firstCorners.size();
+                        mesh.indices[corner] = (uint32bit)firstCorners.size();
+                        firstCorners.push_back((uint32bit)corner);
+                        break;
+                    }
+
+                    uint32bit first = firstCorners[candidate];
+
+                    if (hashes[first] == hashes[corner]) {
+                        const float32bit * other = facets[first / 3].vertices + (first % 3) * 3;
+
+                        if (readCoordinateBits(other[0]) == x && readCoordinateBits(other[1]) == y && readCoordinateBits(other[2]) == z) {
+                            mesh.indices[corner] = candidate;
+                            break;
+                        }
+                    }
+
+                    slot = (slot + 1) & mask;
+                }
+            }
+
+            mesh.vertices.resize(firstCorners.size());
+
+            parallelFor(0, firstCorners.size(), DEFAULT_PARALLEL_GRAIN, [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const float32bit * vertex = facets[firstCorners[i] / 3].vertices + (firstCorners[i] % 3) * 3;
+                    mesh.vertices[i].setValues(vertex[0] + 0.0f, vertex[1] + 0.0f, vertex[2] + 0.0f);
+                }
+            }, threadCount);
+
+            return true;
+        }
+
+        // ================= STL writer ================= //
+
+        bool writeBinaryStl(const char * path, const stereometry::IndexedMesh3F & mesh)
+        {
+            GEOMETRY_PROFILE_SCOPE("stl.write");
+
+            const size_t count = mesh.getTriangleCount();
+
+            if (count > 0xFFFFFFFFu) {
+                return false;
+            }
+
+            FILE * file = openForWriting(path);
+
+            if (file == 0) {
+                return false;
+            }
+
+            char8bit header[BinaryStlView::HEADER_SIZE];
+            memset(header, 0, sizeof(header));
+            memcpy(header, "binary STL", 10);
+
+            uint32bit triangleCount = (uint32bit)count;
+
+            bool success = fwrite(header, sizeof(header), 1, file) == 1
+                        && fwrite(&triangleCount, sizeof(triangleCount), 1, file) == 1;
+
+            std::vector<StlFacet> block(WRITE_BLOCK_FACETS);
+
+            for (size_t begin = 0; success && begin < count; begin += WRITE_BLOCK_FACETS) {
+                size_t end = begin + WRITE_BLOCK_FACETS < count ? begin + WRITE_BLOCK_FACETS : count;
+
+                for (size_t i = begin; i < end; i++) {
+                    StlFacet & facet = block[i - begin];
+                    stereometry::Vector3F normal = mesh.getNormal(i);
+
+                    facet.normal[0] = normal.x;
+                    facet.normal[1] = normal.y;
+                    facet.normal[2] = normal.z;
+
+                    for (size_t corner = 0; corner < 3; corner++) {
+                        const stereometry::Vector3F & vertex = mesh.vertices[mesh.indices[i * 3 + corner]];
+
+                        facet.vertices[corner * 3] = vertex.x;
+                        facet.vertices[corner * 3 + 1] = vertex.y;
+                        facet.vertices[corner * 3 + 2] = vertex.z;
+                    }
+
+                    facet.attribute = 0;
+                }
+
+                success = fwrite(&block[0], sizeof(StlFacet), end - begin, file) == end - begin;
+            }
+
+            return fclose(file) == 0 && success;
+        }
+    } /* namespace io */
+} /* namespace geometry */
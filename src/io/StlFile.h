@@ -0,0 +1,132 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_IO_STL_FILE_H_
+#define _GEOMETRY_IO_STL_FILE_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "../stereometry/Vector3.h"
+#include "../stereometry/Triangle3.h"
+#include "../stereometry/IndexedMesh3F.h"
+#include "MappedFile.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        // One facet record of a binary STL file exactly as it is stored on disk:
+        // 50 bytes, little-endian, without any alignment.
+#pragma pack(push, 1)
+        struct StlFacet
+        {
+            float32bit normal[3];
+            float32bit vertices[9];
+            uint16bit attribute;
+        };
+#pragma pack(pop)
+
+        // ===================== BinaryStlView header ==================== //
+
+        // Zero-copy view of a memory mapped binary STL file. Facets are read
+        // straight from the mapping, nothing is parsed until it is requested.
+        class BinaryStlView
+        {
+        public:
+            static const size_t HEADER_SIZE = 80;
+            static const size_t FACET_SIZE = 50;
+
+            BinaryStlView();
+            virtual ~BinaryStlView();
+
+            bool open(const char * path);
+            void close();
+
+            inline bool isOpen() const;
+
+            inline const char8bit * header() const;
+
+            inline uint32bit getTriangleCount() const;
+
+            inline const StlFacet * facets() const;
+            inline const StlFacet & getFacet(const uint32bit index) const;
+
+            inline stereometry::Vector3F getNormal(const uint32bit index) const;
+            inline stereometry::Vector3F getVertex(const uint32bit index, const uint32bit corner) const;
+            inline stereometry::Triangle3F getTriangle(const uint32bit index) const;
+
+            // Converts the facets into an indexed mesh. Equal vertices are merged
+            // when weldVertices is set; threadCount limits the threads of the shared pool, 0 uses all of them.
+            bool toIndexedMesh(stereometry::IndexedMesh3F & mesh, const bool weldVertices = true, const uint32bit threadCount = 0) const;
+
+        private:
+            MappedFile file;
+            uint32bit triangleCount;
+        };
+
+        // Streams the mesh into a binary STL file, facet normals are recomputed
+        bool writeBinaryStl(const char * path, const stereometry::IndexedMesh3F & mesh);
+
+        // ================= BinaryStlView inline methods ================ //
+
+        bool BinaryStlView::isOpen() const
+        {
+            return this->file.isOpen();
+        }
+
+        const char8bit * BinaryStlView::header() const
+        {
+            return (const char8bit *)this->file.data();
+        }
+
+        uint32bit BinaryStlView::getTriangleCount() const
+        {
+            return this->triangleCount;
+        }
+
+        const StlFacet * BinaryStlView::facets() const
+        {
+            return (const StlFacet *)(this->file.data() + HEADER_SIZE + sizeof(uint32bit));
+        }
+
+        const StlFacet & BinaryStlView::getFacet(const uint32bit index) const
+        {
+            return this->facets()[index];
+        }
+
+        stereometry::Vector3F BinaryStlView::getNormal(const uint32bit index) const
+        {
+            const StlFacet & facet = this->facets()[index];
+
+            return stereometry::Vector3F(facet.normal[0], facet.normal[1], facet.normal[2]);
+        }
+
+        stereometry::Vector3F BinaryStlView::getVertex(const uint32bit index, const uint32bit corner) const
+        {
+            const float32bit * vertex = this->facets()[index].vertices + corner * 3;
+
+            return stereometry::Vector3F(vertex[0], vertex[1], vertex[2]);
+        }
+
+        stereometry::Triangle3F BinaryStlView::getTriangle(const uint32bit index) const
+        {
+            return stereometry::Triangle3F(this->getVertex(index, 0), this->getVertex(index, 1), this->getVertex(index, 2));
+        }
+    } /* namespace io */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_IO_STL_FILE_H_ */
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_IO_TEXT_PARSER_H_
+#define _GEOMETRY_IO_TEXT_PARSER_H_
+
+#include <math.h>
+
+#include "../types.h"
+
+namespace geometry
+{
+    namespace io
+    {
+        // Locale independent number parsing over a [position, end) character
+        // range without allocations. Every parse function returns the position
+        // right after the parsed value or 0 if there is no valid value.
+
+        inline bool isSpace(const char8bit symbol)
+        {
+            return symbol == ' ' || symbol == '\t' || symbol == '\r';
+        }
+
+        inline bool isDigit(const char8bit symbol)
+        {
+            return (uint8bit)(symbol - '0') < 10;
+        }
+
+        inline const char8bit * skipSpaces(const char8bit * position, const char8bit * end)
+        {
+            while (position < end && isSpace(*position)) {
+                position++;
+            }
+
+            return position;
+        }
+
+        inline const char8bit * skipToken(const char8bit * position, const char8bit * end)
+        {
+            while (position < end && !isSpace(*position) && *position != '\n') {
+                position++;
+            }
+
+            return position;
+        }
+
+        // Returns the position after the end of the current line
+        inline const char8bit * skipLine(const char8bit * position, const char8bit * end)
+        {
+            while (position < end && *position != '\n') {
+                position++;
+            }
+
+            return position < end ? position + 1 : end;
+        }
+
+        inline const char8bit * parseInteger(const char8bit * position, const char8bit * end, int64bit & value)
+        {
+            bool negative = false;
+
+            if (position < end && (*position == '-' || *position == '+')) {
+                negative = *position == '-';
+                position++;
+            }
+
+            if (position == end || !isDigit(*position)) {
+                return 0;
+            }
+
+            // Values out of the int64bit range are rejected, not wrapped around
+            const uint64bit limit = negative ? (uint64bit)INT64_MAX + 1 : (uint64bit)INT64_MAX;
+
+            uint64bit result = 0;
+
+            while (position < end && isDigit(*position)) {
+                const uint64bit digit = (uint64bit)(*position - '0');
+
+                if (result > (limit - digit) / 10) {
+                    return 0;
+                }
+
+                result = result * 10 + digit;
+                position++;
+            }
+
+            value = negative && result > 0 ? -(int64bit)(result - 1) - 1 : (int64bit)result;
+
+            return position;
+        }
+
+        inline const char8bit * parseDouble(const char8bit * position, const char8bit * end, double & value)
+        {
+            static const double POWERS_OF_TEN[] = {
+                1E0, 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8, 1E9, 1E10, 1E11,
+                1E12, 1E13, 1E14, 1E15, 1E16, 1E17, 1E18, 1E19, 1E20, 1E21, 1E22
+            };
+
+            bool negative = false;
+
+            if (position < end && (*position == '-' || *position == '+')) {
+                negative = *position == '-';
+                position++;
+            }
+
+            uint64bit mantissa = 0;
+            int32bit exponent = 0;
+            int32bit digits = 0;
+            bool hasDigits = false;
+
+            while (position < end && isDigit(*position)) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + (uint64bit)(*position - '0');
+                    digits += mantissa != 0;
+                }
+                else {
+                    exponent++;
+                }
+
+                hasDigits = true;
+                position++;
+            }
+
+            if (position < end && *position == '.') {
+                position++;
+
+                while (position < end && isDigit(*position)) {
+                    if (digits < 19) {
+                        mantissa = mantissa * 10 + (uint64bit)(*position - '0');
+                        digits += mantissa != 0;
+                        exponent--;
+                    }
+
+                    hasDigits = true;
+                    position++;
+                }
+            }
+
+            if (!hasDigits) {
+                return 0;
+            }
+
+            if (position < end && (*position == 'e' || *position == 'E')) {
+                const char8bit * next = position + 1;
+                bool negativePower = false;
+
+                if (next < end && (*next == '-' || *next == '+')) {
+                    negativePower = *next == '-';
+                    next++;
+                }
+
+                if (next < end && isDigit(*next)) {
+                    // Any power beyond 1000 gives zero or infinity, longer
+                    // digit runs saturate instead of overflowing
+                    int32bit power = 0;
+
+                    while (next < end && isDigit(*next)) {
+                        if (power < 1000) {
+                            power = power * 10 + (int32bit)(*next - '0');
+                        }
+
+                        next++;
+                    }
+
+                    if (power > 1000) {
+                        power = 1000;
+                    }
+
+                    exponent += negativePower ? -power : power;
+                    position = next;
+                }
+            }
+
+            double result = (double)mantissa;
+
+            if (exponent < 0 && exponent >= -22) {
+                result /= POWERS_OF_TEN[-exponent];
+            }
+            else if (exponent > 0 && exponent <= 22) {
+                result *= POWERS_OF_TEN[exponent];
+            }
+            else if (exponent != 0 && mantissa != 0) {
+                result *= pow(10.0, exponent);
+            }
+
+            value = negative ? -result : result;
+
+            return position;
+        }
+
+        inline const char8bit * parseFloat(const char8bit * position, const char8bit * end, float32bit & value)
+        {
+            double result;
+            position = parseDouble(position, end, result);
+            value = (float32bit)result;
+            return position;
+        }
+    } /* namespace io */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_IO_TEXT_PARSER_H_ */
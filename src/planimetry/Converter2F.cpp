@@ -18,18 +18,31 @@
 
 #include <math.h>
 
+#include "../ThreadPool.h"
+
 namespace geometry
 {
     namespace planimetry
     {
-        Converter2F::~Converter2F()
+        // Conversions are literal types, tables of them may be built at compile time
+        static constexpr Converter2F LIFT(Matrix2x2F(), Vector2F(0.0f, 1.0f));
+
+        static_assert(LIFT.convert(Vector2F(1.0f, 2.0f)).y == 3.0f, "Converter2F is expected to be usable in constant expressions");
+
+        void Converter2F::convert(const Vector2F * source, Vector2F * target, const size_t count, const uint32bit threadCount) const
         {
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    target[i] = this->convert(source[i]);
+                }
+            }, threadCount);
         }
 
         void Converter2F::buildConvesion(const AngleF & turn, const Vector2F & shift)
         {
-            float cos = cosf(turn.radians());
-            float sin = sinf(turn.radians());
+            float cos, sin;
+
+            turn.sincos(sin, cos);
 
             this->warp.r1c1 = cos;
             this->warp.r1c2 = -sin;
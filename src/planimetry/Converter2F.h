@@ -17,6 +17,9 @@
 #ifndef _GEOMETRY_FLOAT32_PLANIMETRY_TRANSITION_H_
 #define _GEOMETRY_FLOAT32_PLANIMETRY_TRANSITION_H_
 
+#include <stddef.h>
+
+#include "../types.h"
 #include "../Angle.h"
 #include "Matrix2x2.h"
 #include "Vector2.h"
@@ -31,28 +34,38 @@ namespace geometry
             Matrix2x2F warp;
             Vector2F shift;
 
+            // The identity conversion
+            constexpr Converter2F();
+            constexpr Converter2F(const Matrix2x2F & warp, const Vector2F & shift);
 
-            inline Converter2F();
-            virtual ~Converter2F();
-
-            inline void setToIdentity();
+            constexpr void setToIdentity();
 
             void buildConvesion(const AngleF & turn, const Vector2F & shift);
 
-            inline Vector2F convert(const Vector2F & vector) const;
+            constexpr Vector2F convert(const Vector2F & vector) const;
+
+            // Converts count vectors on the threads of the shared pool, the
+            // source and the target may be the same array
+            void convert(const Vector2F * source, Vector2F * target, const size_t count, const uint32bit threadCount = 0) const;
         };
 
-        Converter2F::Converter2F()
+        constexpr Converter2F::Converter2F()
+            : warp(), shift()
+        {
+        }
+
+        constexpr Converter2F::Converter2F(const Matrix2x2F & warp, const Vector2F & shift)
+            : warp(warp), shift(shift)
         {
         }
 
-        void Converter2F::setToIdentity()
+        constexpr void Converter2F::setToIdentity()
         {
             this->warp.setToIdentity();
             this->shift.setToZero();
         }
 
-        Vector2F Converter2F::convert(const Vector2F & vector) const
+        constexpr Vector2F Converter2F::convert(const Vector2F & vector) const
         {
             return Vector2F(
                     this->warp.r1c1 * vector.x + this->warp.r1c2 * vector.y + this->shift.x,
@@ -29,57 +29,59 @@ namespace geometry
         template <typename FloatType, class VectorType> class Matrix2x2Template
         {
         public:
-            static const int32bit ZERO_MATRIX = 0x0;
-            static const int32bit IDENTITY_MATRIX = 0x1;
+            static constexpr int32bit ZERO_MATRIX = 0x0;
+            static constexpr int32bit IDENTITY_MATRIX = 0x1;
 
-            static const FloatType ZERO;
-            static const FloatType UNIT;
+            static constexpr FloatType ZERO = FloatConstants<FloatType>::ZERO;
+            static constexpr FloatType UNIT = FloatConstants<FloatType>::UNIT;
 
             FloatType r1c1;
             FloatType r1c2;
             FloatType r2c1;
             FloatType r2c2;
 
-            inline Matrix2x2Template();
-            inline Matrix2x2Template(const int32bit matrixType);
-            virtual ~Matrix2x2Template();
+            constexpr Matrix2x2Template();
+            constexpr Matrix2x2Template(const int32bit matrixType);
+            constexpr Matrix2x2Template(const FloatType r1c1, const FloatType r1c2, const FloatType r2c1, const FloatType r2c2);
 
-            inline void setToIdentity();
-            inline void setToZero();
+            constexpr void setToIdentity();
+            constexpr void setToZero();
 
-            inline FloatType determinant() const;
+            constexpr FloatType determinant() const;
 
-            inline VectorType row1() const;
-            inline VectorType row2() const;
+            constexpr VectorType row1() const;
+            constexpr VectorType row2() const;
 
-            inline VectorType column1() const;
-            inline VectorType column2() const;
+            constexpr VectorType column1() const;
+            constexpr VectorType column2() const;
 
-            inline VectorType operator* (const VectorType & vector) const;
+            constexpr VectorType operator* (const VectorType & vector) const;
         };
 
         // ================= Matrix2x2 Template methods ================== //
 
-        template <typename FloatType, class VectorType> Matrix2x2Template<FloatType, VectorType>::Matrix2x2Template()
+        template <typename FloatType, class VectorType> constexpr int32bit Matrix2x2Template<FloatType, VectorType>::ZERO_MATRIX;
+        template <typename FloatType, class VectorType> constexpr int32bit Matrix2x2Template<FloatType, VectorType>::IDENTITY_MATRIX;
+
+        template <typename FloatType, class VectorType> constexpr FloatType Matrix2x2Template<FloatType, VectorType>::ZERO;
+        template <typename FloatType, class VectorType> constexpr FloatType Matrix2x2Template<FloatType, VectorType>::UNIT;
+
+        template <typename FloatType, class VectorType> constexpr Matrix2x2Template<FloatType, VectorType>::Matrix2x2Template()
+            : r1c1(UNIT), r1c2(ZERO), r2c1(ZERO), r2c2(UNIT)
         {
-            this->setToIdentity();
         }
 
-        template <typename FloatType, class VectorType> Matrix2x2Template<FloatType, VectorType>::Matrix2x2Template(const int32bit matrixType)
+        template <typename FloatType, class VectorType> constexpr Matrix2x2Template<FloatType, VectorType>::Matrix2x2Template(const int32bit matrixType)
+            : r1c1(matrixType == ZERO_MATRIX ? ZERO : UNIT), r1c2(ZERO), r2c1(ZERO), r2c2(matrixType == ZERO_MATRIX ? ZERO : UNIT)
         {
-            if (matrixType == ZERO_MATRIX) {
-                this->setToZero();
-            }
-            else {
-                this->setToIdentity();
-            }
         }
 
-        template <typename FloatType, class VectorType> Matrix2x2Template<FloatType, VectorType>::~Matrix2x2Template()
+        template <typename FloatType, class VectorType> constexpr Matrix2x2Template<FloatType, VectorType>::Matrix2x2Template(const FloatType r1c1, const FloatType r1c2, const FloatType r2c1, const FloatType r2c2)
+            : r1c1(r1c1), r1c2(r1c2), r2c1(r2c1), r2c2(r2c2)
         {
         }
 
-        template <typename FloatType, class VectorType> void Matrix2x2Template<FloatType, VectorType>::setToIdentity()
+        template <typename FloatType, class VectorType> constexpr void Matrix2x2Template<FloatType, VectorType>::setToIdentity()
         {
             this->r1c1 = UNIT;
             this->r1c2 = ZERO;
@@ -87,7 +89,7 @@ namespace geometry
             this->r2c2 = UNIT;
         }
 
-        template <typename FloatType, class VectorType> void Matrix2x2Template<FloatType, VectorType>::setToZero()
+        template <typename FloatType, class VectorType> constexpr void Matrix2x2Template<FloatType, VectorType>::setToZero()
         {
             this->r1c1 = ZERO;
             this->r1c2 = ZERO;
@@ -95,32 +97,32 @@ namespace geometry
             this->r2c2 = ZERO;
         }
 
-        template <typename FloatType, class VectorType> FloatType Matrix2x2Template<FloatType, VectorType>::determinant() const
+        template <typename FloatType, class VectorType> constexpr FloatType Matrix2x2Template<FloatType, VectorType>::determinant() const
         {
             return this->r1c1 * this->r2c2 - this->r1c2 * this->r2c1;
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix2x2Template<FloatType, VectorType>::row1() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix2x2Template<FloatType, VectorType>::row1() const
         {
             return VectorType(this->r1c1, this->r1c2);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix2x2Template<FloatType, VectorType>::row2() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix2x2Template<FloatType, VectorType>::row2() const
         {
             return VectorType(this->r2c1, this->r2c2);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix2x2Template<FloatType, VectorType>::column1() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix2x2Template<FloatType, VectorType>::column1() const
         {
             return VectorType(this->r1c1, this->r2c1);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix2x2Template<FloatType, VectorType>::column2() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix2x2Template<FloatType, VectorType>::column2() const
         {
             return VectorType(this->r1c2, this->r2c2);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix2x2Template<FloatType, VectorType>::operator* (const VectorType & vector) const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix2x2Template<FloatType, VectorType>::operator* (const VectorType & vector) const
         {
             return VectorType(this->r1c1 * vector.x + this->r1c2 * vector.y, this->r2c1 * vector.x + this->r2c2 * vector.y);
         }
@@ -132,21 +134,20 @@ namespace geometry
         class Matrix2x2F : public Matrix2x2Template<float, Vector2F>
         {
         public:
-            inline Matrix2x2F();
-            inline Matrix2x2F(const int matrixType);
-            inline Matrix2x2F(const float r1c1, const float r1c2, const float r2c1, const float r2c2);
-            inline Matrix2x2F(const Matrix2x2 & matrix);
-            virtual ~Matrix2x2F();
+            constexpr Matrix2x2F();
+            constexpr Matrix2x2F(const int matrixType);
+            constexpr Matrix2x2F(const float r1c1, const float r1c2, const float r2c1, const float r2c2);
+            constexpr Matrix2x2F(const Matrix2x2 & matrix);
 
-            inline Matrix2x2 toDouble() const;
+            constexpr Matrix2x2 toDouble() const;
 
-            Matrix2x2F operator* (const Matrix2x2F & matrix) const;
-            inline Matrix2x2F operator* (const float value) const;
-            inline Matrix2x2F operator/ (const float value) const;
+            constexpr Matrix2x2F operator* (const Matrix2x2F & matrix) const;
+            constexpr Matrix2x2F operator* (const float value) const;
+            constexpr Matrix2x2F operator/ (const float value) const;
 
-            Matrix2x2F & operator*= (const Matrix2x2F & matrix);
-            inline Matrix2x2F & operator*= (const float value);
-            inline Matrix2x2F & operator/= (const float value);
+            constexpr Matrix2x2F & operator*= (const Matrix2x2F & matrix);
+            constexpr Matrix2x2F & operator*= (const float value);
+            constexpr Matrix2x2F & operator/= (const float value);
         };
 
         // =================== Matrix2x2<double> header ================== //
@@ -154,67 +155,85 @@ namespace geometry
         class Matrix2x2 : public Matrix2x2Template<double, Vector2>
         {
         public:
-            inline Matrix2x2();
-            inline Matrix2x2(const int matrixType);
-            inline Matrix2x2(const double r1c1, const double r1c2, const double r2c1, const double r2c2);
-            inline Matrix2x2(const Matrix2x2F & matrix);
-            virtual ~Matrix2x2();
+            constexpr Matrix2x2();
+            constexpr Matrix2x2(const int matrixType);
+            constexpr Matrix2x2(const double r1c1, const double r1c2, const double r2c1, const double r2c2);
+            constexpr Matrix2x2(const Matrix2x2F & matrix);
 
-            inline Matrix2x2F toFloat() const;
+            constexpr Matrix2x2F toFloat() const;
 
-            Matrix2x2 operator* (const Matrix2x2 & matrix) const;
-            inline Matrix2x2 operator* (const double value) const;
-            inline Matrix2x2 operator/ (const double value) const;
+            constexpr Matrix2x2 operator* (const Matrix2x2 & matrix) const;
+            constexpr Matrix2x2 operator* (const double value) const;
+            constexpr Matrix2x2 operator/ (const double value) const;
 
-            Matrix2x2 & operator*= (const Matrix2x2 & matrix);
-            inline Matrix2x2 & operator*= (const double value);
-            inline Matrix2x2 & operator/= (const double value);
+            constexpr Matrix2x2 & operator*= (const Matrix2x2 & matrix);
+            constexpr Matrix2x2 & operator*= (const double value);
+            constexpr Matrix2x2 & operator/= (const double value);
         };
 
         // =================== Matrix2x2<float> methods ================== //
 
-        Matrix2x2F::Matrix2x2F()
+        constexpr Matrix2x2F::Matrix2x2F()
             : Matrix2x2Template<float, Vector2F>()
         {
         }
 
-        Matrix2x2F::Matrix2x2F(const int matrixType)
+        constexpr Matrix2x2F::Matrix2x2F(const int matrixType)
             : Matrix2x2Template<float, Vector2F>(matrixType)
         {
         }
 
-        Matrix2x2F::Matrix2x2F(const float r1c1, const float r1c2, const float r2c1, const float r2c2)
+        constexpr Matrix2x2F::Matrix2x2F(const float r1c1, const float r1c2, const float r2c1, const float r2c2)
+            : Matrix2x2Template<float, Vector2F>(r1c1, r1c2, r2c1, r2c2)
         {
-            this->r1c1 = r1c1;
-            this->r1c2 = r1c2;
-            this->r2c1 = r2c1;
-            this->r2c2 = r2c2;
         }
 
-        Matrix2x2F::Matrix2x2F(const Matrix2x2 & matrix)
+        constexpr Matrix2x2F::Matrix2x2F(const Matrix2x2 & matrix)
+            : Matrix2x2Template<float, Vector2F>((float)matrix.r1c1, (float)matrix.r1c2, (float)matrix.r2c1, (float)matrix.r2c2)
         {
-            this->r1c1 = (float)matrix.r1c1;
-            this->r1c2 = (float)matrix.r1c2;
-            this->r2c1 = (float)matrix.r2c1;
-            this->r2c2 = (float)matrix.r2c2;
         }
 
-        Matrix2x2 Matrix2x2F::toDouble() const
+        constexpr Matrix2x2 Matrix2x2F::toDouble() const
         {
             return Matrix2x2(*this);
         }
 
-        Matrix2x2F Matrix2x2F::operator* (const float value) const
+        constexpr Matrix2x2F Matrix2x2F::operator* (const Matrix2x2F & matrix) const
+        {
+            return Matrix2x2F(
+                this->r1c1 * matrix.r1c1 + this->r1c2 * matrix.r2c1,
+                this->r1c1 * matrix.r1c2 + this->r1c2 * matrix.r2c2,
+                this->r2c1 * matrix.r1c1 + this->r2c2 * matrix.r2c1,
+                this->r2c1 * matrix.r1c2 + this->r2c2 * matrix.r2c2
+            );
+        }
+
+        constexpr Matrix2x2F Matrix2x2F::operator* (const float value) const
         {
             return Matrix2x2F(this->r1c1 * value, this->r1c2 * value, this->r2c1 * value, this->r2c2 * value);
         }
 
-        Matrix2x2F Matrix2x2F::operator/ (const float value) const
+        constexpr Matrix2x2F Matrix2x2F::operator/ (const float value) const
         {
             return Matrix2x2F(this->r1c1 / value, this->r1c2 / value, this->r2c1 / value, this->r2c2 / value);
         }
 
-        Matrix2x2F & Matrix2x2F::operator*= (const float value)
+        constexpr Matrix2x2F & Matrix2x2F::operator*= (const Matrix2x2F & matrix)
+        {
+            const float r1c1 = this->r1c1 * matrix.r1c1 + this->r1c2 * matrix.r2c1;
+            const float r1c2 = this->r1c1 * matrix.r1c2 + this->r1c2 * matrix.r2c2;
+            const float r2c1 = this->r2c1 * matrix.r1c1 + this->r2c2 * matrix.r2c1;
+            const float r2c2 = this->r2c1 * matrix.r1c2 + this->r2c2 * matrix.r2c2;
+
+            this->r1c1 = r1c1;
+            this->r1c2 = r1c2;
+            this->r2c1 = r2c1;
+            this->r2c2 = r2c2;
+
+            return (*this);
+        }
+
+        constexpr Matrix2x2F & Matrix2x2F::operator*= (const float value)
         {
             this->r1c1 *= value;
             this->r1c2 *= value;
@@ -224,7 +243,7 @@ namespace geometry
             return (*this);
         }
 
-        Matrix2x2F & Matrix2x2F::operator/= (const float value)
+        constexpr Matrix2x2F & Matrix2x2F::operator/= (const float value)
         {
             this->r1c1 /= value;
             this->r1c2 /= value;
@@ -236,48 +255,67 @@ namespace geometry
 
         // ================== Matrix2x2<double> methods ================== //
 
-        Matrix2x2::Matrix2x2()
+        constexpr Matrix2x2::Matrix2x2()
             : Matrix2x2Template<double, Vector2>()
         {
         }
 
-        Matrix2x2::Matrix2x2(const int matrixType)
+        constexpr Matrix2x2::Matrix2x2(const int matrixType)
             : Matrix2x2Template<double, Vector2>(matrixType)
         {
         }
 
-        Matrix2x2::Matrix2x2(const double r1c1, const double r1c2, const double r2c1, const double r2c2)
+        constexpr Matrix2x2::Matrix2x2(const double r1c1, const double r1c2, const double r2c1, const double r2c2)
+            : Matrix2x2Template<double, Vector2>(r1c1, r1c2, r2c1, r2c2)
         {
-            this->r1c1 = r1c1;
-            this->r1c2 = r1c2;
-            this->r2c1 = r2c1;
-            this->r2c2 = r2c2;
         }
 
-        Matrix2x2::Matrix2x2(const Matrix2x2F & matrix)
+        constexpr Matrix2x2::Matrix2x2(const Matrix2x2F & matrix)
+            : Matrix2x2Template<double, Vector2>(matrix.r1c1, matrix.r1c2, matrix.r2c1, matrix.r2c2)
         {
-            this->r1c1 = matrix.r1c1;
-            this->r1c2 = matrix.r1c2;
-            this->r2c1 = matrix.r2c1;
-            this->r2c2 = matrix.r2c2;
         }
 
-        Matrix2x2F Matrix2x2::toFloat() const
+        constexpr Matrix2x2F Matrix2x2::toFloat() const
         {
             return Matrix2x2F(*this);
         }
 
-        Matrix2x2 Matrix2x2::operator* (const double value) const
+        constexpr Matrix2x2 Matrix2x2::operator* (const Matrix2x2 & matrix) const
+        {
+            return Matrix2x2(
+                this->r1c1 * matrix.r1c1 + this->r1c2 * matrix.r2c1,
+                this->r1c1 * matrix.r1c2 + this->r1c2 * matrix.r2c2,
+                this->r2c1 * matrix.r1c1 + this->r2c2 * matrix.r2c1,
+                this->r2c1 * matrix.r1c2 + this->r2c2 * matrix.r2c2
+            );
+        }
+
+        constexpr Matrix2x2 Matrix2x2::operator* (const double value) const
         {
             return Matrix2x2(this->r1c1 * value, this->r1c2 * value, this->r2c1 * value, this->r2c2 * value);
         }
 
-        Matrix2x2 Matrix2x2::operator/ (const double value) const
+        constexpr Matrix2x2 Matrix2x2::operator/ (const double value) const
         {
             return Matrix2x2(this->r1c1 / value, this->r1c2 / value, this->r2c1 / value, this->r2c2 / value);
         }
 
-        Matrix2x2 & Matrix2x2::operator*= (const double value)
+        constexpr Matrix2x2 & Matrix2x2::operator*= (const Matrix2x2 & matrix)
+        {
+            const double r1c1 = this->r1c1 * matrix.r1c1 + this->r1c2 * matrix.r2c1;
+            const double r1c2 = this->r1c1 * matrix.r1c2 + this->r1c2 * matrix.r2c2;
+            const double r2c1 = this->r2c1 * matrix.r1c1 + this->r2c2 * matrix.r2c1;
+            const double r2c2 = this->r2c1 * matrix.r1c2 + this->r2c2 * matrix.r2c2;
+
+            this->r1c1 = r1c1;
+            this->r1c2 = r1c2;
+            this->r2c1 = r2c1;
+            this->r2c2 = r2c2;
+
+            return (*this);
+        }
+
+        constexpr Matrix2x2 & Matrix2x2::operator*= (const double value)
         {
             this->r1c1 *= value;
             this->r1c2 *= value;
@@ -287,7 +325,7 @@ namespace geometry
             return (*this);
         }
 
-        Matrix2x2 & Matrix2x2::operator/= (const double value)
+        constexpr Matrix2x2 & Matrix2x2::operator/= (const double value)
         {
             this->r1c1 /= value;
             this->r1c2 /= value;
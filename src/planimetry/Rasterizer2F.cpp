@@ -0,0 +1,567 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Rasterizer2F.h"
+
+#include <algorithm>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+#include "TriangleEdges2.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_RASTERIZER
+#endif
+
+namespace geometry
+{
+    namespace planimetry
+    {
+        const uint32bit Rasterizer2F::SUBPIXEL_STEPS;
+        const uint32bit Rasterizer2F::TILE_SIZE;
+        const uint32bit Rasterizer2F::BIN_SIZE;
+        const uint32bit Rasterizer2F::SIZE_LIMIT;
+
+        // Triangles narrower and lower than this many subpixel steps keep
+        // their edge functions within 30 bits over every tile they touch
+        static const int64bit SMALL_TRIANGLE_LIMIT = (int64bit)1 << 14;
+
+        static const size_t BINNING_CHUNK = 4096;
+
+        static const int64bit HALF_PIXEL = Rasterizer2F::SUBPIXEL_STEPS / 2;
+
+        // Rounds down also below zero, the steps are a power of two
+        static inline int64bit toPixel(const int64bit subpixels)
+        {
+            return subpixels >= 0 ? subpixels / Rasterizer2F::SUBPIXEL_STEPS : -((Rasterizer2F::SUBPIXEL_STEPS - 1 - subpixels) / Rasterizer2F::SUBPIXEL_STEPS);
+        }
+
+        static inline uint32bit roundUp(const uint32bit value, const uint32bit step)
+        {
+            return (value + step - 1) / step * step;
+        }
+
+        // ======================= Raster buffer ======================== //
+
+        RasterBuffer2F::RasterBuffer2F() : width(0), height(0), stride(0), paddedHeight(0), attributeCount(0)
+        {
+        }
+
+        RasterBuffer2F::~RasterBuffer2F()
+        {
+        }
+
+        bool RasterBuffer2F::setSize(const uint32bit width, const uint32bit height, const uint32bit attributeCount)
+        {
+            if (width == 0 || height == 0 || width > Rasterizer2F::SIZE_LIMIT || height > Rasterizer2F::SIZE_LIMIT) {
+                return false;
+            }
+
+            this->width = width;
+            this->height = height;
+            this->stride = roundUp(width, Rasterizer2F::TILE_SIZE);
+            this->paddedHeight = roundUp(height, Rasterizer2F::TILE_SIZE);
+            this->attributeCount = attributeCount;
+
+            this->coverage.resize(this->getPlaneSize());
+            this->depth.resize(this->getPlaneSize());
+            this->attributes.resize(this->getPlaneSize() * attributeCount);
+
+            this->clear();
+
+            return true;
+        }
+
+        void RasterBuffer2F::clear(const float farDepth)
+        {
+            std::fill(this->coverage.begin(), this->coverage.end(), (uint8bit)0);
+            std::fill(this->depth.begin(), this->depth.end(), farDepth);
+            std::fill(this->attributes.begin(), this->attributes.end(), 0.0f);
+        }
+
+        // ======================== Pixel writes ======================== //
+
+        // What a triangle writes: the depth and the attributes of a pixel are
+        // v0 + (v1 - v0) * w1 + (v2 - v0) * w2, the weights being the edge
+        // functions opposite to the corners divided by the double area
+        struct RasterTarget
+        {
+            uint8bit * coverage;
+            float * depth;
+            float * attributes;
+            size_t planeSize;
+            uint32bit attributeCount;
+
+            bool hasDepth;
+            float depth0;
+            float depthStep1;
+            float depthStep2;
+
+            // The attributes of the corners in counterclockwise order, 0 without attributes
+            const float * corners[3];
+            float inverseDoubleArea;
+        };
+
+        static inline void writePixel(const RasterTarget & target, const size_t index, const float edge0, const float edge2)
+        {
+            if (target.hasDepth) {
+                const float depth = target.depth0 + target.depthStep1 * edge2 + target.depthStep2 * edge0;
+
+                if (!(depth < target.depth[index])) {
+                    return;
+                }
+
+                target.depth[index] = depth;
+            }
+
+            target.coverage[index] = 1;
+
+            if (target.corners[0] == 0) {
+                return;
+            }
+
+            const float weight1 = edge2 * target.inverseDoubleArea;
+            const float weight2 = edge0 * target.inverseDoubleArea;
+
+            for (uint32bit channel = 0; channel < target.attributeCount; channel++) {
+                const float value0 = target.corners[0][channel];
+
+                target.attributes[channel * target.planeSize + index] = value0 + (target.corners[1][channel] - value0) * weight1 + (target.corners[2][channel] - value0) * weight2;
+            }
+        }
+
+        // ======================== Tile kernels ======================== //
+
+        static inline int64bit evaluateEdge(const RasterSetup2F & setup, const int edge, const int64bit x, const int64bit y)
+        {
+            const int next = edge == 2 ? 0 : edge + 1;
+
+            return ((int64bit)setup.x[next] - setup.x[edge]) * (y - setup.y[edge]) - ((int64bit)setup.y[next] - setup.y[edge]) * (x - setup.x[edge]);
+        }
+
+        // Exact for every triangle within the coordinate limit, used for the
+        // large triangles and where SSE2 is missing
+        static void rasterizeTileScalar(const RasterSetup2F & setup, const RasterTarget & target, const uint32bit stride, const int32bit x0, const int32bit y0, const int32bit x1, const int32bit y1)
+        {
+            for (int32bit y = y0; y < y1; y++) {
+                const int64bit centreY = (int64bit)y * Rasterizer2F::SUBPIXEL_STEPS + HALF_PIXEL;
+
+                for (int32bit x = x0; x < x1; x++) {
+                    const int64bit centreX = (int64bit)x * Rasterizer2F::SUBPIXEL_STEPS + HALF_PIXEL;
+
+                    const int64bit edge0 = evaluateEdge(setup, 0, centreX, centreY);
+                    const int64bit edge1 = evaluateEdge(setup, 1, centreX, centreY);
+                    const int64bit edge2 = evaluateEdge(setup, 2, centreX, centreY);
+
+                    if (edge0 + setup.bias[0] > 0 && edge1 + setup.bias[1] > 0 && edge2 + setup.bias[2] > 0) {
+                        writePixel(target, (size_t)y * stride + x, (float)edge0, (float)edge2);
+                    }
+                }
+            }
+        }
+
+#ifdef GEOMETRY_SSE_RASTERIZER
+
+        static const uint8bit LANE_BYTES[16][4] = {
+            { 0, 0, 0, 0 }, { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 1, 1, 0, 0 },
+            { 0, 0, 1, 0 }, { 1, 0, 1, 0 }, { 0, 1, 1, 0 }, { 1, 1, 1, 0 },
+            { 0, 0, 0, 1 }, { 1, 0, 0, 1 }, { 0, 1, 0, 1 }, { 1, 1, 0, 1 },
+            { 0, 0, 1, 1 }, { 1, 0, 1, 1 }, { 0, 1, 1, 1 }, { 1, 1, 1, 1 }
+        };
+
+        static inline __m128 select(const __m128 mask, const __m128 whenSet, const __m128 otherwise)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, otherwise));
+        }
+
+        // Four pixels starting at index, inside the triangle where the mask is set
+        static inline void writeLanes(const RasterTarget & target, const size_t index, __m128 mask, const __m128i edge0, const __m128i edge2)
+        {
+            if (_mm_movemask_ps(mask) == 0) {
+                return;
+            }
+
+            const __m128 edge0Float = _mm_cvtepi32_ps(edge0);
+            const __m128 edge2Float = _mm_cvtepi32_ps(edge2);
+
+            if (target.hasDepth) {
+                const __m128 depth = _mm_add_ps(_mm_set1_ps(target.depth0),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(target.depthStep1), edge2Float), _mm_mul_ps(_mm_set1_ps(target.depthStep2), edge0Float)));
+
+                const __m128 stored = _mm_loadu_ps(target.depth + index);
+
+                mask = _mm_and_ps(mask, _mm_cmplt_ps(depth, stored));
+
+                if (_mm_movemask_ps(mask) == 0) {
+                    return;
+                }
+
+                _mm_storeu_ps(target.depth + index, select(mask, depth, stored));
+            }
+
+            const uint8bit * lanes = LANE_BYTES[_mm_movemask_ps(mask)];
+
+            for (int i = 0; i < 4; i++) {
+                target.coverage[index + i] |= lanes[i];
+            }
+
+            if (target.corners[0] == 0) {
+                return;
+            }
+
+            const __m128 weight1 = _mm_mul_ps(edge2Float, _mm_set1_ps(target.inverseDoubleArea));
+            const __m128 weight2 = _mm_mul_ps(edge0Float, _mm_set1_ps(target.inverseDoubleArea));
+
+            for (uint32bit channel = 0; channel < target.attributeCount; channel++) {
+                const float value0 = target.corners[0][channel];
+
+                const __m128 value = _mm_add_ps(_mm_set1_ps(value0),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(target.corners[1][channel] - value0), weight1), _mm_mul_ps(_mm_set1_ps(target.corners[2][channel] - value0), weight2)));
+
+                float * plane = target.attributes + channel * target.planeSize + index;
+
+                _mm_storeu_ps(plane, select(mask, value, _mm_loadu_ps(plane)));
+            }
+        }
+
+        // The rows y0 to y1 - 1 of a tile of a small triangle in groups of
+        // four columns, the groups outside of the columns x0 to x1 - 1 are
+        // skipped. The edge functions are stepped in 32-bit lanes from their
+        // values at the centre of the first pixel.
+        static void rasterizeTileSse(const RasterSetup2F & setup, const RasterTarget & target, const uint32bit stride, const int32bit tileX, const int32bit x0, const int32bit x1, const int32bit y0, const int32bit y1)
+        {
+            const int64bit centreX = (int64bit)tileX * Rasterizer2F::SUBPIXEL_STEPS + HALF_PIXEL;
+            const int64bit centreY = (int64bit)y0 * Rasterizer2F::SUBPIXEL_STEPS + HALF_PIXEL;
+
+            const bool hasLeft = x0 < tileX + 4;
+            const bool hasRight = x1 > tileX + 4;
+
+            __m128i rows[3], stepsX[3], stepsY[3], thresholds[3];
+
+            for (int edge = 0; edge < 3; edge++) {
+                const int next = edge == 2 ? 0 : edge + 1;
+
+                const int32bit stepX = (setup.y[edge] - setup.y[next]) * (int32bit)Rasterizer2F::SUBPIXEL_STEPS;
+                const int32bit stepY = (setup.x[next] - setup.x[edge]) * (int32bit)Rasterizer2F::SUBPIXEL_STEPS;
+
+                rows[edge] = _mm_add_epi32(_mm_set1_epi32((int32bit)evaluateEdge(setup, edge, centreX, centreY)), _mm_setr_epi32(0, stepX, stepX * 2, stepX * 3));
+                stepsX[edge] = _mm_set1_epi32(stepX * 4);
+                stepsY[edge] = _mm_set1_epi32(stepY);
+                thresholds[edge] = _mm_set1_epi32((int32bit)-setup.bias[edge]);
+            }
+
+            for (int32bit row = y0; row < y1; row++) {
+                const size_t index = (size_t)row * stride + tileX;
+
+                for (uint32bit column = hasLeft ? 0 : 4; column < (hasRight ? 8u : 4u); column += 4) {
+                    __m128i edges[3];
+
+                    for (int edge = 0; edge < 3; edge++) {
+                        edges[edge] = column == 0 ? rows[edge] : _mm_add_epi32(rows[edge], stepsX[edge]);
+                    }
+
+                    const __m128i inside = _mm_and_si128(_mm_and_si128(
+                        _mm_cmpgt_epi32(edges[0], thresholds[0]),
+                        _mm_cmpgt_epi32(edges[1], thresholds[1])),
+                        _mm_cmpgt_epi32(edges[2], thresholds[2]));
+
+                    writeLanes(target, index + column, _mm_castsi128_ps(inside), edges[0], edges[2]);
+                }
+
+                for (int edge = 0; edge < 3; edge++) {
+                    rows[edge] = _mm_add_epi32(rows[edge], stepsY[edge]);
+                }
+            }
+        }
+
+#endif
+
+        // Whether an edge leaves the whole tile outside: the edge function is
+        // linear, so its largest value over the tile is at one of the corners
+        static inline bool isTileOutside(const RasterSetup2F & setup, const int32bit x0, const int32bit y0)
+        {
+            const int64bit span = (int64bit)(Rasterizer2F::TILE_SIZE - 1) * Rasterizer2F::SUBPIXEL_STEPS;
+
+            const int64bit centreX = (int64bit)x0 * Rasterizer2F::SUBPIXEL_STEPS + HALF_PIXEL;
+            const int64bit centreY = (int64bit)y0 * Rasterizer2F::SUBPIXEL_STEPS + HALF_PIXEL;
+
+            for (int edge = 0; edge < 3; edge++) {
+                const int next = edge == 2 ? 0 : edge + 1;
+
+                const int64bit stepX = ((int64bit)setup.y[edge] - setup.y[next]) * span;
+                const int64bit stepY = ((int64bit)setup.x[next] - setup.x[edge]) * span;
+
+                const int64bit largest = evaluateEdge(setup, edge, centreX, centreY) + (stepX > 0 ? stepX : 0) + (stepY > 0 ? stepY : 0);
+
+                if (largest + setup.bias[edge] <= 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // ======================== Rasterizer ========================== //
+
+        Rasterizer2F::Rasterizer2F()
+        {
+        }
+
+        Rasterizer2F::~Rasterizer2F()
+        {
+        }
+
+        static void setUpTriangle(const Triangle2F & triangle, const uint32bit index, const RasterBuffer2F & buffer, RasterSetup2F & setup)
+        {
+            setup.triangle = index;
+
+            // An empty box marks a skipped triangle
+            setup.minX = 0;
+            setup.maxX = -1;
+            setup.minY = 0;
+            setup.maxY = -1;
+
+            const Vector2F * vertices[3] = { &triangle.A, &triangle.B, &triangle.C };
+
+            int64bit x[3], y[3];
+
+            for (int i = 0; i < 3; i++) {
+                if (!TriangleEdges2Fixed::toGrid(vertices[i]->x, Rasterizer2F::SUBPIXEL_STEPS, x[i])
+                    || !TriangleEdges2Fixed::toGrid(vertices[i]->y, Rasterizer2F::SUBPIXEL_STEPS, y[i])) {
+                    return;
+                }
+            }
+
+            const int64bit doubleArea = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+
+            if (doubleArea == 0) {
+                return;
+            }
+
+            setup.order[0] = 0;
+            setup.order[1] = doubleArea > 0 ? 1 : 2;
+            setup.order[2] = doubleArea > 0 ? 2 : 1;
+
+            for (int i = 0; i < 3; i++) {
+                setup.x[i] = (int32bit)x[setup.order[i]];
+                setup.y[i] = (int32bit)y[setup.order[i]];
+            }
+
+            // The rule of TriangleEdges2Fixed: left and top edges are inclusive
+            for (int i = 0; i < 3; i++) {
+                const int next = i == 2 ? 0 : i + 1;
+
+                const int64bit dx = setup.x[next] - setup.x[i];
+                const int64bit dy = setup.y[next] - setup.y[i];
+
+                setup.bias[i] = dy < 0 || (dy == 0 && dx < 0) ? 1 : 0;
+            }
+
+            int64bit minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+
+            for (int i = 1; i < 3; i++) {
+                minX = x[i] < minX ? x[i] : minX;
+                maxX = x[i] > maxX ? x[i] : maxX;
+                minY = y[i] < minY ? y[i] : minY;
+                maxY = y[i] > maxY ? y[i] : maxY;
+            }
+
+            setup.small = maxX - minX < SMALL_TRIANGLE_LIMIT && maxY - minY < SMALL_TRIANGLE_LIMIT;
+            setup.inverseDoubleArea = 1.0f / (float)(doubleArea > 0 ? doubleArea : -doubleArea);
+
+            // The pixels whose centres are within the box
+            int64bit firstX = toPixel(minX - HALF_PIXEL + Rasterizer2F::SUBPIXEL_STEPS - 1);
+            int64bit lastX = toPixel(maxX - HALF_PIXEL);
+            int64bit firstY = toPixel(minY - HALF_PIXEL + Rasterizer2F::SUBPIXEL_STEPS - 1);
+            int64bit lastY = toPixel(maxY - HALF_PIXEL);
+
+            firstX = firstX > 0 ? firstX : 0;
+            firstY = firstY > 0 ? firstY : 0;
+            lastX = lastX < (int64bit)buffer.getWidth() - 1 ? lastX : (int64bit)buffer.getWidth() - 1;
+            lastY = lastY < (int64bit)buffer.getHeight() - 1 ? lastY : (int64bit)buffer.getHeight() - 1;
+
+            if (firstX > lastX || firstY > lastY) {
+                return;
+            }
+
+            setup.minX = (int32bit)firstX;
+            setup.maxX = (int32bit)lastX;
+            setup.minY = (int32bit)firstY;
+            setup.maxY = (int32bit)lastY;
+        }
+
+        void Rasterizer2F::rasterize(const Triangle2F * triangles, const float * depths, const float * attributes, const size_t count, RasterBuffer2F & target, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("rasterizer.rasterize");
+
+            if (target.getWidth() == 0 || count == 0 || count > 0xFFFFFFFFu) {
+                return;
+            }
+
+            this->setups.resize(count);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    setUpTriangle(triangles[i], (uint32bit)i, target, this->setups[i]);
+                }
+            }, threadCount);
+
+            // Binning: every chunk of triangles counts its triangles per bin,
+            // the counts become write positions ordered by bin and chunk, so
+            // every bin lists its triangles in the order they were given
+            const uint32bit binsX = (target.getWidth() + BIN_SIZE - 1) / BIN_SIZE;
+            const uint32bit binsY = (target.getHeight() + BIN_SIZE - 1) / BIN_SIZE;
+            const size_t binCount = (size_t)binsX * binsY;
+            const size_t chunkCount = (count + BINNING_CHUNK - 1) / BINNING_CHUNK;
+
+            this->binCounts.assign(chunkCount * binCount, 0);
+
+            auto forEachBin = [&](const RasterSetup2F & setup, const size_t chunk, const bool fill) {
+                for (int32bit binY = setup.minY / (int32bit)BIN_SIZE; binY <= setup.maxY / (int32bit)BIN_SIZE; binY++) {
+                    for (int32bit binX = setup.minX / (int32bit)BIN_SIZE; binX <= setup.maxX / (int32bit)BIN_SIZE; binX++) {
+                        uint32bit & slot = this->binCounts[chunk * binCount + (size_t)binY * binsX + binX];
+
+                        if (fill) {
+                            this->binnedSetups[slot++] = setup;
+                        }
+                        else {
+                            slot++;
+                        }
+                    }
+                }
+            };
+
+            parallelFor(0, chunkCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t chunk = first; chunk < last; chunk++) {
+                    const size_t end = (chunk + 1) * BINNING_CHUNK < count ? (chunk + 1) * BINNING_CHUNK : count;
+
+                    for (size_t i = chunk * BINNING_CHUNK; i < end; i++) {
+                        forEachBin(this->setups[i], chunk, false);
+                    }
+                }
+            }, threadCount);
+
+            this->binOffsets.resize(binCount + 1);
+
+            size_t total = 0;
+
+            for (size_t bin = 0; bin < binCount; bin++) {
+                this->binOffsets[bin] = (uint32bit)total;
+
+                for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+                    uint32bit & slot = this->binCounts[chunk * binCount + bin];
+                    const uint32bit binned = slot;
+
+                    slot = (uint32bit)total;
+                    total += binned;
+                }
+            }
+
+            // A triangle covering many bins may overflow the 32-bit positions
+            if (total > 0xFFFFFFFFu) {
+                return;
+            }
+
+            this->binOffsets[binCount] = (uint32bit)total;
+            this->binnedSetups.resize(total);
+
+            parallelFor(0, chunkCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t chunk = first; chunk < last; chunk++) {
+                    const size_t end = (chunk + 1) * BINNING_CHUNK < count ? (chunk + 1) * BINNING_CHUNK : count;
+
+                    for (size_t i = chunk * BINNING_CHUNK; i < end; i++) {
+                        forEachBin(this->setups[i], chunk, true);
+                    }
+                }
+            }, threadCount);
+
+            // Every bin is owned by one thread, no pixel is written twice at once
+            const uint32bit attributeCount = target.getAttributeCount();
+            const uint32bit stride = target.getStride();
+            const int32bit width = (int32bit)target.getWidth();
+
+            parallelFor(0, binCount, 1, [&](const size_t first, const size_t last) {
+                RasterTarget pixels;
+
+                pixels.coverage = &target.coverage[0];
+                pixels.depth = &target.depth[0];
+                pixels.attributes = attributeCount > 0 ? &target.attributes[0] : 0;
+                pixels.planeSize = target.getPlaneSize();
+                pixels.attributeCount = attributeCount;
+                pixels.hasDepth = depths != 0;
+                pixels.depth0 = 0.0f;
+                pixels.depthStep1 = 0.0f;
+                pixels.depthStep2 = 0.0f;
+
+                for (size_t bin = first; bin < last; bin++) {
+                    const int32bit binX0 = (int32bit)((bin % binsX) * BIN_SIZE);
+                    const int32bit binY0 = (int32bit)((bin / binsX) * BIN_SIZE);
+
+                    for (uint32bit i = this->binOffsets[bin]; i < this->binOffsets[bin + 1]; i++) {
+                        const RasterSetup2F & setup = this->binnedSetups[i];
+                        const uint32bit triangle = setup.triangle;
+
+                        const int32bit x0 = setup.minX > binX0 ? setup.minX : binX0;
+                        const int32bit y0 = setup.minY > binY0 ? setup.minY : binY0;
+                        const int32bit x1 = setup.maxX < binX0 + (int32bit)BIN_SIZE - 1 ? setup.maxX + 1 : binX0 + (int32bit)BIN_SIZE;
+                        const int32bit y1 = setup.maxY < binY0 + (int32bit)BIN_SIZE - 1 ? setup.maxY + 1 : binY0 + (int32bit)BIN_SIZE;
+
+                        if (depths != 0) {
+                            const float * corners = depths + (size_t)triangle * 3;
+
+                            pixels.depth0 = corners[setup.order[0]];
+                            pixels.depthStep1 = (corners[setup.order[1]] - pixels.depth0) * setup.inverseDoubleArea;
+                            pixels.depthStep2 = (corners[setup.order[2]] - pixels.depth0) * setup.inverseDoubleArea;
+                        }
+
+                        for (int corner = 0; corner < 3; corner++) {
+                            pixels.corners[corner] = attributes != 0 && attributeCount > 0 ? attributes + ((size_t)triangle * 3 + setup.order[corner]) * attributeCount : 0;
+                        }
+
+                        pixels.inverseDoubleArea = setup.inverseDoubleArea;
+
+                        const int32bit tileX0 = x0 / (int32bit)TILE_SIZE * (int32bit)TILE_SIZE;
+                        const int32bit tileY0 = y0 / (int32bit)TILE_SIZE * (int32bit)TILE_SIZE;
+
+                        for (int32bit tileY = tileY0; tileY < y1; tileY += TILE_SIZE) {
+                            for (int32bit tileX = tileX0; tileX < x1; tileX += TILE_SIZE) {
+                                if (isTileOutside(setup, tileX, tileY)) {
+                                    continue;
+                                }
+
+                                const int32bit columnBegin = tileX > x0 ? tileX : x0;
+                                const int32bit columnEnd = tileX + (int32bit)TILE_SIZE < x1 ? tileX + (int32bit)TILE_SIZE : x1;
+                                const int32bit rowBegin = tileY > y0 ? tileY : y0;
+                                const int32bit rowEnd = tileY + (int32bit)TILE_SIZE < y1 ? tileY + (int32bit)TILE_SIZE : y1;
+
+#ifdef GEOMETRY_SSE_RASTERIZER
+                                // The column groups must not cross the right edge of the buffer
+                                if (setup.small && tileX + (int32bit)TILE_SIZE <= width) {
+                                    rasterizeTileSse(setup, pixels, stride, tileX, columnBegin, columnEnd, rowBegin, rowEnd);
+                                    continue;
+                                }
+#endif
+
+                                rasterizeTileScalar(setup, pixels, stride, columnBegin, rowBegin, columnEnd, rowEnd);
+                            }
+                        }
+                    }
+                }
+            }, threadCount);
+        }
+    } /* namespace planimetry */
+} /* namespace geometry */
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_PLANIMETRY_RASTERIZER2F_H_
+#define _GEOMETRY_PLANIMETRY_RASTERIZER2F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "Triangle2.h"
+
+namespace geometry
+{
+    namespace planimetry
+    {
+        // ======================= Raster buffer ======================== //
+
+        // Coverage, depth and interpolated attributes of a pixel grid. The
+        // rows are stride pixels long and the grid is padded to whole tiles,
+        // the pixel (x, y) is at y * stride + x in every plane. Attribute
+        // channel c starts at c * getPlaneSize() of the attributes vector.
+        class RasterBuffer2F
+        {
+        public:
+            std::vector<uint8bit> coverage;
+            std::vector<float> depth;
+            std::vector<float> attributes;
+
+            RasterBuffer2F();
+            virtual ~RasterBuffer2F();
+
+            // Returns false when the size is zero or too large for the rasterizer
+            bool setSize(const uint32bit width, const uint32bit height, const uint32bit attributeCount = 0);
+
+            // Clears the coverage and the attributes to zero and the depth to farDepth
+            void clear(const float farDepth = 3.402823466E+38f);
+
+            inline uint32bit getWidth() const;
+            inline uint32bit getHeight() const;
+            inline uint32bit getStride() const;
+            inline uint32bit getPaddedHeight() const;
+            inline uint32bit getAttributeCount() const;
+            inline size_t getPlaneSize() const;
+
+            inline bool isCovered(const uint32bit x, const uint32bit y) const;
+            inline float getDepth(const uint32bit x, const uint32bit y) const;
+            inline float getAttribute(const uint32bit x, const uint32bit y, const uint32bit channel) const;
+
+        private:
+            uint32bit width;
+            uint32bit height;
+            uint32bit stride;
+            uint32bit paddedHeight;
+            uint32bit attributeCount;
+        };
+
+        // ======================== Rasterizer ========================== //
+
+        // A triangle prepared by the rasterizer: snapped to the subpixel grid
+        // in counterclockwise order, with its pixel bounds clipped to the buffer
+        struct RasterSetup2F
+        {
+            // The grid coordinates stay within the coordinate limit of
+            // TriangleEdges2Fixed, the edge functions need 64 bits though
+            int32bit x[3];
+            int32bit y[3];
+            uint8bit bias[3];
+
+            int32bit minX, minY, maxX, maxY;
+
+            // The index of the triangle and the original vertex of every corner
+            uint32bit triangle;
+            uint8bit order[3];
+
+            // Fits the 32-bit tile kernel
+            bool small;
+
+            float inverseDoubleArea;
+        };
+
+        // Half-space rasterizer for triangles given in pixel units. A pixel is
+        // covered when its centre (x + 0.5, y + 0.5) is inside the triangle by
+        // the fixed point top-left rule of TriangleEdges2Fixed with
+        // 1 / SUBPIXEL_STEPS pixel precision, so the triangles of a watertight
+        // mesh cover every pixel once. Both windings are rasterized.
+        //
+        // The triangles are binned into BIN_SIZE squares in parallel, copied
+        // next to the other triangles of the bin. Every bin is rasterized by
+        // one thread in the order of the triangles, tile by tile with whole
+        // tiles outside an edge skipped. The result does
+        // not depend on the number of threads.
+        class Rasterizer2F
+        {
+        public:
+            static const uint32bit SUBPIXEL_STEPS = 16;
+            static const uint32bit TILE_SIZE = 8;
+            static const uint32bit BIN_SIZE = 64;
+
+            // Largest buffer side, so the subpixel coordinates fit 32 bits
+            static const uint32bit SIZE_LIMIT = 1 << 16;
+
+            Rasterizer2F();
+            virtual ~Rasterizer2F();
+
+            // depths holds three values per triangle: pixels pass when the
+            // interpolated depth is less than the one in the buffer, which is
+            // then replaced. Without depths (0) every covered pixel passes and
+            // the depth plane is left alone. attributes holds
+            // getAttributeCount() values per vertex, vertex after vertex, and
+            // may be 0 as well. Triangles with a vertex beyond the coordinate
+            // limit of TriangleEdges2Fixed are skipped.
+            void rasterize(const Triangle2F * triangles, const float * depths, const float * attributes, const size_t count, RasterBuffer2F & target, const uint32bit threadCount = 0);
+
+        private:
+            // Kept between the calls, so rasterizing frames of a similar size
+            // does not allocate
+            std::vector<RasterSetup2F> setups;
+            std::vector<uint32bit> binCounts;
+            std::vector<uint32bit> binOffsets;
+            std::vector<RasterSetup2F> binnedSetups;
+
+            Rasterizer2F(const Rasterizer2F &);
+            Rasterizer2F & operator=(const Rasterizer2F &);
+        };
+
+        // ================= Raster buffer inline methods ================= //
+
+        uint32bit RasterBuffer2F::getWidth() const
+        {
+            return this->width;
+        }
+
+        uint32bit RasterBuffer2F::getHeight() const
+        {
+            return this->height;
+        }
+
+        uint32bit RasterBuffer2F::getStride() const
+        {
+            return this->stride;
+        }
+
+        uint32bit RasterBuffer2F::getPaddedHeight() const
+        {
+            return this->paddedHeight;
+        }
+
+        uint32bit RasterBuffer2F::getAttributeCount() const
+        {
+            return this->attributeCount;
+        }
+
+        size_t RasterBuffer2F::getPlaneSize() const
+        {
+            return (size_t)this->stride * this->paddedHeight;
+        }
+
+        bool RasterBuffer2F::isCovered(const uint32bit x, const uint32bit y) const
+        {
+            return this->coverage[(size_t)y * this->stride + x] != 0;
+        }
+
+        float RasterBuffer2F::getDepth(const uint32bit x, const uint32bit y) const
+        {
+            return this->depth[(size_t)y * this->stride + x];
+        }
+
+        float RasterBuffer2F::getAttribute(const uint32bit x, const uint32bit y, const uint32bit channel) const
+        {
+            return this->attributes[channel * this->getPlaneSize() + (size_t)y * this->stride + x];
+        }
+    } /* namespace planimetry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_PLANIMETRY_RASTERIZER2F_H_ */
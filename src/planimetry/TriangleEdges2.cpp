@@ -0,0 +1,437 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TriangleEdges2.h"
+
+#include <string.h>
+
+#include "../Profiler.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_TRIANGLE_EDGES
+#endif
+
+namespace geometry
+{
+    namespace planimetry
+    {
+        // ================= Fixed point edge functions ================= //
+
+        const int64bit TriangleEdges2Fixed::COORDINATE_LIMIT;
+
+        TriangleEdges2Fixed::TriangleEdges2Fixed()
+        {
+            this->setToEmpty();
+        }
+
+        bool TriangleEdges2Fixed::setTriangle(const Triangle2F & triangle, const double scale)
+        {
+            const double xs[3] = { triangle.A.x, triangle.B.x, triangle.C.x };
+            const double ys[3] = { triangle.A.y, triangle.B.y, triangle.C.y };
+
+            return this->setVertices(xs, ys, scale);
+        }
+
+        bool TriangleEdges2Fixed::setTriangle(const Triangle2 & triangle, const double scale)
+        {
+            const double xs[3] = { triangle.A.x, triangle.B.x, triangle.C.x };
+            const double ys[3] = { triangle.A.y, triangle.B.y, triangle.C.y };
+
+            return this->setVertices(xs, ys, scale);
+        }
+
+        void TriangleEdges2Fixed::setToEmpty()
+        {
+            for (int i = 0; i < 3; i++) {
+                this->x[i] = 0;
+                this->y[i] = 0;
+                this->bias[i] = 0;
+            }
+
+            this->scale = 1.0;
+        }
+
+        bool TriangleEdges2Fixed::setVertices(const double * xs, const double * ys, const double scale)
+        {
+            this->setToEmpty();
+
+            int64bit gridX[3], gridY[3];
+
+            for (int i = 0; i < 3; i++) {
+                if (!toGrid(xs[i], scale, gridX[i]) || !toGrid(ys[i], scale, gridY[i])) {
+                    return false;
+                }
+            }
+
+            const int64bit doubleArea = (gridX[1] - gridX[0]) * (gridY[2] - gridY[0]) - (gridY[1] - gridY[0]) * (gridX[2] - gridX[0]);
+
+            if (doubleArea == 0) {
+                return false;
+            }
+
+            // Clockwise triangles are turned around, so the inside is on the
+            // left of every edge
+            const int order[3] = { 0, doubleArea > 0 ? 1 : 2, doubleArea > 0 ? 2 : 1 };
+
+            for (int i = 0; i < 3; i++) {
+                this->x[i] = gridX[order[i]];
+                this->y[i] = gridY[order[i]];
+            }
+
+            // With the inside on the left an edge going down is a left edge
+            // and a horizontal edge going in the negative direction is a top one
+            for (int i = 0; i < 3; i++) {
+                const int next = i == 2 ? 0 : i + 1;
+
+                const int64bit dx = this->x[next] - this->x[i];
+                const int64bit dy = this->y[next] - this->y[i];
+
+                this->bias[i] = dy < 0 || (dy == 0 && dx < 0) ? 1 : 0;
+            }
+
+            this->scale = scale;
+
+            return true;
+        }
+
+        // ======================== Scalar kernels ======================== //
+
+        template<typename FloatType, class VectorType> static size_t containPointsFrom(const TriangleEdges2Template<FloatType> & triangle, const VectorType * points, uint8bit * inside, const size_t first, const size_t count)
+        {
+            size_t found = 0;
+
+            for (size_t i = first; i < count; i++) {
+                const uint8bit contains = triangle.contains(points[i].x, points[i].y) ? 1 : 0;
+
+                inside[i] = contains;
+                found += contains;
+            }
+
+            return found;
+        }
+
+        template<typename FloatType, class VectorType> static size_t getBarycentricFrom(const TriangleEdges2Template<FloatType> & triangle, const VectorType * points, FloatType * weightsA, FloatType * weightsB, FloatType * weightsC, uint8bit * inside, const size_t first, const size_t count)
+        {
+            size_t found = 0;
+
+            for (size_t i = first; i < count; i++) {
+                const uint8bit contains = triangle.getBarycentric(points[i].x, points[i].y, weightsA[i], weightsB[i], weightsC[i]) ? 1 : 0;
+
+                if (inside != 0) {
+                    inside[i] = contains;
+                }
+
+                found += contains;
+            }
+
+            return found;
+        }
+
+        template<typename FloatType> static inline bool isInsideOf(const TriangleEdgesSet2Template<FloatType> & triangles, const size_t index, const FloatType x, const FloatType y)
+        {
+            return triangles.a[0][index] * x + triangles.b[0][index] * y + triangles.c[0][index] >= 0
+                && triangles.a[1][index] * x + triangles.b[1][index] * y + triangles.c[1][index] >= 0
+                && triangles.a[2][index] * x + triangles.b[2][index] * y + triangles.c[2][index] >= 0;
+        }
+
+        template<typename FloatType> static size_t findContainingTrianglesFrom(const TriangleEdgesSet2Template<FloatType> & triangles, const FloatType x, const FloatType y, uint8bit * inside, const size_t first)
+        {
+            const size_t count = triangles.getCount();
+
+            size_t found = 0;
+
+            for (size_t i = first; i < count; i++) {
+                const uint8bit contains = isInsideOf(triangles, i, x, y) ? 1 : 0;
+
+                inside[i] = contains;
+                found += contains;
+            }
+
+            return found;
+        }
+
+        template<typename FloatType> static size_t findContainingTriangleFrom(const TriangleEdgesSet2Template<FloatType> & triangles, const FloatType x, const FloatType y, const size_t first)
+        {
+            const size_t count = triangles.getCount();
+
+            for (size_t i = first; i < count; i++) {
+                if (isInsideOf(triangles, i, x, y)) {
+                    return i;
+                }
+            }
+
+            return TriangleEdgesSet2Template<FloatType>::NOT_FOUND;
+        }
+
+        template<class VectorType> static size_t containPointsOnGrid(const TriangleEdges2Fixed & triangle, const VectorType * points, uint8bit * inside, const size_t count)
+        {
+            size_t found = 0;
+
+            for (size_t i = 0; i < count; i++) {
+                const uint8bit contains = triangle.contains(points[i].x, points[i].y) ? 1 : 0;
+
+                inside[i] = contains;
+                found += contains;
+            }
+
+            return found;
+        }
+
+        // ========================= SSE kernels ========================== //
+
+#ifdef GEOMETRY_SSE_TRIANGLE_EDGES
+
+        static_assert(sizeof(Vector2F) == 2 * sizeof(float), "Vector2F is expected to be two packed floats");
+
+        // The bytes of the four lane masks and the number of their set bits
+        static const uint8bit LANE_BYTES[16][4] = {
+            { 0, 0, 0, 0 },
+            { 1, 0, 0, 0 },
+            { 0, 1, 0, 0 },
+            { 1, 1, 0, 0 },
+            { 0, 0, 1, 0 },
+            { 1, 0, 1, 0 },
+            { 0, 1, 1, 0 },
+            { 1, 1, 1, 0 },
+            { 0, 0, 0, 1 },
+            { 1, 0, 0, 1 },
+            { 0, 1, 0, 1 },
+            { 1, 1, 0, 1 },
+            { 0, 0, 1, 1 },
+            { 1, 0, 1, 1 },
+            { 0, 1, 1, 1 },
+            { 1, 1, 1, 1 }
+        };
+
+        static const uint8bit LANE_COUNTS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+        // Writes one byte per lane of a four bit mask, returns the number of set bits
+        static inline size_t storeMask(const int mask, uint8bit * target)
+        {
+            memcpy(target, LANE_BYTES[mask], 4);
+
+            return LANE_COUNTS[mask];
+        }
+
+        // The x and y coordinates of four consecutive points
+        static inline void loadPoints(const Vector2F * points, __m128 & x, __m128 & y)
+        {
+            const __m128 first = _mm_loadu_ps(&points[0].x);
+            const __m128 second = _mm_loadu_ps(&points[2].x);
+
+            x = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+            y = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+
+        static inline __m128 evaluateEdge(const __m128 a, const __m128 b, const __m128 c, const __m128 x, const __m128 y)
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), c);
+        }
+
+        static size_t containPointsSse(const TriangleEdges2F & triangle, const Vector2F * points, uint8bit * inside, const size_t count, size_t & found)
+        {
+            const __m128 zero = _mm_setzero_ps();
+
+            __m128 a[3], b[3], c[3];
+
+            for (int i = 0; i < 3; i++) {
+                a[i] = _mm_set1_ps(triangle.a[i]);
+                b[i] = _mm_set1_ps(triangle.b[i]);
+                c[i] = _mm_set1_ps(triangle.c[i]);
+            }
+
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                __m128 x, y;
+                loadPoints(points + i, x, y);
+
+                const __m128 inside0 = _mm_cmpge_ps(evaluateEdge(a[0], b[0], c[0], x, y), zero);
+                const __m128 inside1 = _mm_cmpge_ps(evaluateEdge(a[1], b[1], c[1], x, y), zero);
+                const __m128 inside2 = _mm_cmpge_ps(evaluateEdge(a[2], b[2], c[2], x, y), zero);
+
+                found += storeMask(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(inside0, inside1), inside2)), inside + i);
+            }
+
+            return i;
+        }
+
+        static size_t getBarycentricSse(const TriangleEdges2F & triangle, const Vector2F * points, float * weightsA, float * weightsB, float * weightsC, uint8bit * inside, const size_t count, size_t & found)
+        {
+            const __m128 zero = _mm_setzero_ps();
+
+            __m128 a[3], b[3], c[3];
+
+            for (int i = 0; i < 3; i++) {
+                a[i] = _mm_set1_ps(triangle.a[i]);
+                b[i] = _mm_set1_ps(triangle.b[i]);
+                c[i] = _mm_set1_ps(triangle.c[i]);
+            }
+
+            uint8bit mask[4];
+
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                __m128 x, y;
+                loadPoints(points + i, x, y);
+
+                const __m128 weightA = evaluateEdge(a[0], b[0], c[0], x, y);
+                const __m128 weightB = evaluateEdge(a[1], b[1], c[1], x, y);
+                const __m128 weightC = evaluateEdge(a[2], b[2], c[2], x, y);
+
+                _mm_storeu_ps(weightsA + i, weightA);
+                _mm_storeu_ps(weightsB + i, weightB);
+                _mm_storeu_ps(weightsC + i, weightC);
+
+                const __m128 contains = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(weightA, zero), _mm_cmpge_ps(weightB, zero)), _mm_cmpge_ps(weightC, zero));
+
+                found += storeMask(_mm_movemask_ps(contains), inside != 0 ? inside + i : mask);
+            }
+
+            return i;
+        }
+
+        static inline int testTrianglesSse(const TriangleEdgesSet2F & triangles, const size_t index, const __m128 x, const __m128 y)
+        {
+            const __m128 zero = _mm_setzero_ps();
+
+            __m128 contains = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (int i = 0; i < 3; i++) {
+                const __m128 a = _mm_loadu_ps(&triangles.a[i][index]);
+                const __m128 b = _mm_loadu_ps(&triangles.b[i][index]);
+                const __m128 c = _mm_loadu_ps(&triangles.c[i][index]);
+
+                contains = _mm_and_ps(contains, _mm_cmpge_ps(evaluateEdge(a, b, c, x, y), zero));
+            }
+
+            return _mm_movemask_ps(contains);
+        }
+
+#endif
+
+        // ===================== Batch point tests ====================== //
+
+        size_t containPoints(const TriangleEdges2F & triangle, const Vector2F * points, uint8bit * inside, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.contain_points.float");
+
+            size_t found = 0;
+            size_t first = 0;
+
+#ifdef GEOMETRY_SSE_TRIANGLE_EDGES
+            first = containPointsSse(triangle, points, inside, count, found);
+#endif
+
+            return found + containPointsFrom(triangle, points, inside, first, count);
+        }
+
+        size_t containPoints(const TriangleEdges2 & triangle, const Vector2 * points, uint8bit * inside, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.contain_points.double");
+
+            return containPointsFrom(triangle, points, inside, 0, count);
+        }
+
+        size_t containPoints(const TriangleEdges2Fixed & triangle, const Vector2F * points, uint8bit * inside, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.contain_points.fixed");
+
+            return containPointsOnGrid(triangle, points, inside, count);
+        }
+
+        size_t containPoints(const TriangleEdges2Fixed & triangle, const Vector2 * points, uint8bit * inside, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.contain_points.fixed");
+
+            return containPointsOnGrid(triangle, points, inside, count);
+        }
+
+        size_t getBarycentric(const TriangleEdges2F & triangle, const Vector2F * points, float * weightsA, float * weightsB, float * weightsC, uint8bit * inside, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.barycentric.float");
+
+            size_t found = 0;
+            size_t first = 0;
+
+#ifdef GEOMETRY_SSE_TRIANGLE_EDGES
+            first = getBarycentricSse(triangle, points, weightsA, weightsB, weightsC, inside, count, found);
+#endif
+
+            return found + getBarycentricFrom(triangle, points, weightsA, weightsB, weightsC, inside, first, count);
+        }
+
+        size_t getBarycentric(const TriangleEdges2 & triangle, const Vector2 * points, double * weightsA, double * weightsB, double * weightsC, uint8bit * inside, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.barycentric.double");
+
+            return getBarycentricFrom(triangle, points, weightsA, weightsB, weightsC, inside, 0, count);
+        }
+
+        size_t findContainingTriangles(const TriangleEdgesSet2F & triangles, const Vector2F & point, uint8bit * inside)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.find_containing.float");
+
+            size_t found = 0;
+            size_t first = 0;
+
+#ifdef GEOMETRY_SSE_TRIANGLE_EDGES
+            const __m128 x = _mm_set1_ps(point.x);
+            const __m128 y = _mm_set1_ps(point.y);
+
+            for (; first + 4 <= triangles.getCount(); first += 4) {
+                found += storeMask(testTrianglesSse(triangles, first, x, y), inside + first);
+            }
+#endif
+
+            return found + findContainingTrianglesFrom(triangles, point.x, point.y, inside, first);
+        }
+
+        size_t findContainingTriangles(const TriangleEdgesSet2 & triangles, const Vector2 & point, uint8bit * inside)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle2.find_containing.double");
+
+            return findContainingTrianglesFrom(triangles, point.x, point.y, inside, 0);
+        }
+
+        size_t findContainingTriangle(const TriangleEdgesSet2F & triangles, const Vector2F & point)
+        {
+            size_t first = 0;
+
+#ifdef GEOMETRY_SSE_TRIANGLE_EDGES
+            const __m128 x = _mm_set1_ps(point.x);
+            const __m128 y = _mm_set1_ps(point.y);
+
+            for (; first + 4 <= triangles.getCount(); first += 4) {
+                const int mask = testTrianglesSse(triangles, first, x, y);
+
+                if (mask != 0) {
+                    return first + ((mask & 1) != 0 ? 0 : (mask & 2) != 0 ? 1 : (mask & 4) != 0 ? 2 : 3);
+                }
+            }
+#endif
+
+            return findContainingTriangleFrom(triangles, point.x, point.y, first);
+        }
+
+        size_t findContainingTriangle(const TriangleEdgesSet2 & triangles, const Vector2 & point)
+        {
+            return findContainingTriangleFrom(triangles, point.x, point.y, 0);
+        }
+    } /* namespace planimetry */
+} /* namespace geometry */
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_PLANIMETRY_TRIANGLE_EDGES2_H_
+#define _GEOMETRY_PLANIMETRY_TRIANGLE_EDGES2_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "../constants.h"
+#include "Vector2.h"
+#include "Triangle2.h"
+
+namespace geometry
+{
+    namespace planimetry
+    {
+        // ================= Edge function form header ================== //
+
+        // A triangle prepared for point tests: the barycentric weight of
+        // every vertex is a linear function of the point,
+        //
+        //     weight[i] = a[i] * x + b[i] * y + c[i],
+        //
+        // so a test takes six multiplications and no division. Points on the
+        // border are inside. A degenerate triangle contains no points.
+        template<typename FloatType> class TriangleEdges2Template
+        {
+        public:
+            FloatType a[3];
+            FloatType b[3];
+            FloatType c[3];
+
+            inline TriangleEdges2Template();
+
+            template<class VectorType> inline explicit TriangleEdges2Template(const BasicTriangle2Template<FloatType, VectorType> & triangle);
+
+            // Returns false for a degenerate triangle
+            template<class VectorType> inline bool setTriangle(const BasicTriangle2Template<FloatType, VectorType> & triangle);
+
+            inline void setToEmpty();
+
+            inline bool contains(const FloatType x, const FloatType y) const;
+
+            // Returns whether the point is inside, the weights are set anyway
+            inline bool getBarycentric(const FloatType x, const FloatType y, FloatType & weightA, FloatType & weightB, FloatType & weightC) const;
+        };
+
+        typedef TriangleEdges2Template<float> TriangleEdges2F;
+        typedef TriangleEdges2Template<double> TriangleEdges2;
+
+        // ================= Set of triangles header ==================== //
+
+        // The edge functions of many triangles, every coefficient in its own
+        // array, for testing one point against all of them at once
+        template<typename FloatType> class TriangleEdgesSet2Template
+        {
+        public:
+            static const size_t NOT_FOUND = (size_t)-1;
+
+            std::vector<FloatType> a[3];
+            std::vector<FloatType> b[3];
+            std::vector<FloatType> c[3];
+
+            inline size_t getCount() const;
+
+            inline void clear();
+            inline void add(const TriangleEdges2Template<FloatType> & edges);
+
+            template<class TriangleType> inline void setTriangles(const TriangleType * triangles, const size_t count);
+        };
+
+        template<typename FloatType> const size_t TriangleEdgesSet2Template<FloatType>::NOT_FOUND;
+
+        typedef TriangleEdgesSet2Template<float> TriangleEdgesSet2F;
+        typedef TriangleEdgesSet2Template<double> TriangleEdgesSet2;
+
+        // ================= Fixed point edge functions ================= //
+
+        // Exact point tests on a grid of 1 / scale steps. The vertices and the
+        // points are rounded to the grid and the edge functions are evaluated
+        // in 64-bit integers. A point on an edge belongs to the triangle only
+        // when the edge is a top or a left one, so every point of a watertight
+        // mesh is inside exactly one triangle, on the shared edges too.
+        class TriangleEdges2Fixed
+        {
+        public:
+            // Grid coordinates must stay below this magnitude, so no edge
+            // function overflows 64 bits
+            static const int64bit COORDINATE_LIMIT = (int64bit)1 << 29;
+
+            // The vertices on the grid in counterclockwise order
+            int64bit x[3];
+            int64bit y[3];
+
+            // 1 for the top and left edges, 0 for the others: a point is
+            // inside when every edge function plus its bias is positive
+            int64bit bias[3];
+
+            double scale;
+
+            TriangleEdges2Fixed();
+
+            // Returns false for a triangle degenerate on the grid or outside
+            // of the coordinate limit, it contains no points then
+            bool setTriangle(const Triangle2F & triangle, const double scale);
+            bool setTriangle(const Triangle2 & triangle, const double scale);
+
+            void setToEmpty();
+
+            inline bool contains(const double x, const double y) const;
+            inline bool containsGridPoint(const int64bit x, const int64bit y) const;
+
+            // Rounds a coordinate to the grid, false when it is off the limit
+            static inline bool toGrid(const double value, const double scale, int64bit & result);
+
+        private:
+            bool setVertices(const double * xs, const double * ys, const double scale);
+        };
+
+        // ===================== Batch point tests ====================== //
+
+        // One triangle, many points: inside[i] is set to 1 for the points
+        // inside the triangle and to 0 for the others. Returns the number
+        // of points inside.
+        size_t containPoints(const TriangleEdges2F & triangle, const Vector2F * points, uint8bit * inside, const size_t count);
+        size_t containPoints(const TriangleEdges2 & triangle, const Vector2 * points, uint8bit * inside, const size_t count);
+        size_t containPoints(const TriangleEdges2Fixed & triangle, const Vector2F * points, uint8bit * inside, const size_t count);
+        size_t containPoints(const TriangleEdges2Fixed & triangle, const Vector2 * points, uint8bit * inside, const size_t count);
+
+        // The barycentric weights of many points in one triangle, the mask
+        // may be 0 when it is not needed
+        size_t getBarycentric(const TriangleEdges2F & triangle, const Vector2F * points, float * weightsA, float * weightsB, float * weightsC, uint8bit * inside, const size_t count);
+        size_t getBarycentric(const TriangleEdges2 & triangle, const Vector2 * points, double * weightsA, double * weightsB, double * weightsC, uint8bit * inside, const size_t count);
+
+        // One point, many triangles: the same mask over the triangles of the set
+        size_t findContainingTriangles(const TriangleEdgesSet2F & triangles, const Vector2F & point, uint8bit * inside);
+        size_t findContainingTriangles(const TriangleEdgesSet2 & triangles, const Vector2 & point, uint8bit * inside);
+
+        // The index of the first triangle of the set containing the point or NOT_FOUND
+        size_t findContainingTriangle(const TriangleEdgesSet2F & triangles, const Vector2F & point);
+        size_t findContainingTriangle(const TriangleEdgesSet2 & triangles, const Vector2 & point);
+
+        // ============= Edge function form inline methods ============== //
+
+        template<typename FloatType> TriangleEdges2Template<FloatType>::TriangleEdges2Template()
+        {
+            this->setToEmpty();
+        }
+
+        template<typename FloatType> template<class VectorType> TriangleEdges2Template<FloatType>::TriangleEdges2Template(const BasicTriangle2Template<FloatType, VectorType> & triangle)
+        {
+            this->setTriangle(triangle);
+        }
+
+        template<typename FloatType> template<class VectorType> bool TriangleEdges2Template<FloatType>::setTriangle(const BasicTriangle2Template<FloatType, VectorType> & triangle)
+        {
+            const VectorType * vertices[3] = { &triangle.A, &triangle.B, &triangle.C };
+
+            const FloatType doubleArea = (triangle.B.x - triangle.A.x) * (triangle.C.y - triangle.A.y) - (triangle.B.y - triangle.A.y) * (triangle.C.x - triangle.A.x);
+
+            if (-FloatConstants<FloatType>::SQUARE_EPSYLON <= doubleArea && doubleArea <= FloatConstants<FloatType>::SQUARE_EPSYLON) {
+                this->setToEmpty();
+                return false;
+            }
+
+            // The weight of a vertex is the area of the triangle made by the
+            // point and the opposite edge, relative to the whole area
+            for (int i = 0; i < 3; i++) {
+                const VectorType & from = *vertices[(i + 1) % 3];
+                const VectorType & to = *vertices[(i + 2) % 3];
+
+                this->a[i] = (from.y - to.y) / doubleArea;
+                this->b[i] = (to.x - from.x) / doubleArea;
+                this->c[i] = (from.x * to.y - from.y * to.x) / doubleArea;
+            }
+
+            return true;
+        }
+
+        template<typename FloatType> void TriangleEdges2Template<FloatType>::setToEmpty()
+        {
+            for (int i = 0; i < 3; i++) {
+                this->a[i] = 0;
+                this->b[i] = 0;
+                this->c[i] = -1;
+            }
+        }
+
+        template<typename FloatType> bool TriangleEdges2Template<FloatType>::contains(const FloatType x, const FloatType y) const
+        {
+            return this->a[0] * x + this->b[0] * y + this->c[0] >= 0
+                && this->a[1] * x + this->b[1] * y + this->c[1] >= 0
+                && this->a[2] * x + this->b[2] * y + this->c[2] >= 0;
+        }
+
+        template<typename FloatType> bool TriangleEdges2Template<FloatType>::getBarycentric(const FloatType x, const FloatType y, FloatType & weightA, FloatType & weightB, FloatType & weightC) const
+        {
+            weightA = this->a[0] * x + this->b[0] * y + this->c[0];
+            weightB = this->a[1] * x + this->b[1] * y + this->c[1];
+            weightC = this->a[2] * x + this->b[2] * y + this->c[2];
+
+            return weightA >= 0 && weightB >= 0 && weightC >= 0;
+        }
+
+        // ============== Set of triangles inline methods =============== //
+
+        template<typename FloatType> size_t TriangleEdgesSet2Template<FloatType>::getCount() const
+        {
+            return this->c[0].size();
+        }
+
+        template<typename FloatType> void TriangleEdgesSet2Template<FloatType>::clear()
+        {
+            for (int i = 0; i < 3; i++) {
+                this->a[i].clear();
+                this->b[i].clear();
+                this->c[i].clear();
+            }
+        }
+
+        template<typename FloatType> void TriangleEdgesSet2Template<FloatType>::add(const TriangleEdges2Template<FloatType> & edges)
+        {
+            for (int i = 0; i < 3; i++) {
+                this->a[i].push_back(edges.a[i]);
+                this->b[i].push_back(edges.b[i]);
+                this->c[i].push_back(edges.c[i]);
+            }
+        }
+
+        template<typename FloatType> template<class TriangleType> void TriangleEdgesSet2Template<FloatType>::setTriangles(const TriangleType * triangles, const size_t count)
+        {
+            this->clear();
+
+            for (int i = 0; i < 3; i++) {
+                this->a[i].reserve(count);
+                this->b[i].reserve(count);
+                this->c[i].reserve(count);
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                this->add(TriangleEdges2Template<FloatType>(triangles[i]));
+            }
+        }
+
+        // ============ Fixed point edge functions inline methods ============ //
+
+        bool TriangleEdges2Fixed::toGrid(const double value, const double scale, int64bit & result)
+        {
+            const double scaled = value * scale;
+
+            // Also false for NaN
+            if (!(-(double)COORDINATE_LIMIT < scaled && scaled < (double)COORDINATE_LIMIT)) {
+                return false;
+            }
+
+            result = (int64bit)(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+            return true;
+        }
+
+        bool TriangleEdges2Fixed::containsGridPoint(const int64bit x, const int64bit y) const
+        {
+            for (int i = 0; i < 3; i++) {
+                const int next = i == 2 ? 0 : i + 1;
+
+                if ((this->x[next] - this->x[i]) * (y - this->y[i]) - (this->y[next] - this->y[i]) * (x - this->x[i]) + this->bias[i] <= 0) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool TriangleEdges2Fixed::contains(const double x, const double y) const
+        {
+            int64bit gridX, gridY;
+
+            return toGrid(x, this->scale, gridX) && toGrid(y, this->scale, gridY) && this->containsGridPoint(gridX, gridY);
+        }
+    } /* namespace planimetry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_PLANIMETRY_TRIANGLE_EDGES2_H_ */
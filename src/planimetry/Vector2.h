@@ -30,32 +30,31 @@ namespace geometry
         template<typename FloatType> class BasicVector2Template
         {
         public:
-            static const FloatType ZERO;
-            static const FloatType UNIT;
-            static const FloatType EPSYLON;
-            static const FloatType NEGATIVE_EPSYLON;
-            static const FloatType SQUARE_EPSYLON;
+            static constexpr FloatType ZERO = FloatConstants<FloatType>::ZERO;
+            static constexpr FloatType UNIT = FloatConstants<FloatType>::UNIT;
+            static constexpr FloatType EPSYLON = FloatConstants<FloatType>::EPSYLON;
+            static constexpr FloatType NEGATIVE_EPSYLON = FloatConstants<FloatType>::NEGATIVE_EPSYLON;
+            static constexpr FloatType SQUARE_EPSYLON = FloatConstants<FloatType>::SQUARE_EPSYLON;
 
             FloatType x, y;
 
-            virtual ~BasicVector2Template()
-            {
-            }
+            constexpr BasicVector2Template();
+            constexpr BasicVector2Template(const FloatType x, const FloatType y);
 
-            inline void setToZero();
+            constexpr void setToZero();
 
-            inline bool isZero() const;
-            inline bool isUnit() const;
-            inline bool isCloseTo(const FloatType x, const FloatType y) const;
-            inline bool isCloseTo(const BasicVector2Template<FloatType>& vector) const;
+            constexpr bool isZero() const;
+            constexpr bool isUnit() const;
+            constexpr bool isCloseTo(const FloatType x, const FloatType y) const;
+            constexpr bool isCloseTo(const BasicVector2Template<FloatType>& vector) const;
 
-            inline void setValues(const FloatType x, const FloatType y);
-            inline void setValuesOf(const BasicVector2Template<FloatType> & vector);
+            constexpr void setValues(const FloatType x, const FloatType y);
+            constexpr void setValuesOf(const BasicVector2Template<FloatType> & vector);
 
-            inline FloatType scalar(const FloatType x, const FloatType y) const;
-            inline FloatType scalar(const BasicVector2Template<FloatType> & vector) const;
+            constexpr FloatType scalar(const FloatType x, const FloatType y) const;
+            constexpr FloatType scalar(const BasicVector2Template<FloatType> & vector) const;
 
-            inline FloatType operator*(const BasicVector2Template<FloatType> & vector) const;
+            constexpr FloatType operator*(const BasicVector2Template<FloatType> & vector) const;
         };
 
         // ==================== Vector2<double> header =================== //
@@ -66,29 +65,27 @@ namespace geometry
         {
         public:
 
-            inline Vector2();
-            inline Vector2(const Vector2F & vector);
-            inline Vector2(const double x, const double y);
-
-            virtual ~Vector2();
+            constexpr Vector2();
+            constexpr Vector2(const Vector2F & vector);
+            constexpr Vector2(const double x, const double y);
 
             inline double module() const;
 
             inline bool normalize();
 
-            inline void setValuesOf(const Vector2F & vector);
+            constexpr void setValuesOf(const Vector2F & vector);
 
-            inline Vector2F toFloat() const;
+            constexpr Vector2F toFloat() const;
 
-            inline Vector2 operator+(const Vector2 & vector) const;
-            inline Vector2 operator-(const Vector2 & vector) const;
-            inline Vector2 operator*(const double value) const;
-            inline Vector2 operator/(const double value) const;
+            constexpr Vector2 operator+(const Vector2 & vector) const;
+            constexpr Vector2 operator-(const Vector2 & vector) const;
+            constexpr Vector2 operator*(const double value) const;
+            constexpr Vector2 operator/(const double value) const;
 
-            inline Vector2 & operator+=(const Vector2 & vector);
-            inline Vector2 & operator-=(const Vector2 & vector);
-            inline Vector2 & operator*=(const double value);
-            inline Vector2 & operator/=(const double value);
+            constexpr Vector2 & operator+=(const Vector2 & vector);
+            constexpr Vector2 & operator-=(const Vector2 & vector);
+            constexpr Vector2 & operator*=(const double value);
+            constexpr Vector2 & operator/=(const double value);
         };
 
         // ==================== Vector2<float> header ==================== //
@@ -96,51 +93,65 @@ namespace geometry
         class Vector2F : public BasicVector2Template<float>
         {
         public:
-            inline Vector2F();
-            inline Vector2F(const Vector2 & vector);
-            inline Vector2F(const float x, const float y);
-
-            virtual ~Vector2F();
+            constexpr Vector2F();
+            constexpr Vector2F(const Vector2 & vector);
+            constexpr Vector2F(const float x, const float y);
 
             inline float module() const;
 
             inline bool normalize();
 
-            inline void setValuesOf(const Vector2 & vector);
+            constexpr void setValuesOf(const Vector2 & vector);
 
-            inline Vector2 toDouble() const;
+            constexpr Vector2 toDouble() const;
 
-            inline Vector2F operator+(const Vector2F & vector) const;
-            inline Vector2F operator-(const Vector2F & vector) const;
-            inline Vector2F operator*(const float value) const;
-            inline Vector2F operator/(const float value) const;
+            constexpr Vector2F operator+(const Vector2F & vector) const;
+            constexpr Vector2F operator-(const Vector2F & vector) const;
+            constexpr Vector2F operator*(const float value) const;
+            constexpr Vector2F operator/(const float value) const;
 
-            inline Vector2F & operator+=(const Vector2F & vector);
-            inline Vector2F & operator-=(const Vector2F & vector);
-            inline Vector2F & operator*=(const float value);
-            inline Vector2F & operator/=(const float value);
+            constexpr Vector2F & operator+=(const Vector2F & vector);
+            constexpr Vector2F & operator-=(const Vector2F & vector);
+            constexpr Vector2F & operator*=(const float value);
+            constexpr Vector2F & operator/=(const float value);
         };
 
         // =============== Vector2 Template inline methods =============== //
 
-        template<typename FloatType> void BasicVector2Template<FloatType>::setToZero()
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::ZERO;
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::UNIT;
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::EPSYLON;
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::NEGATIVE_EPSYLON;
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::SQUARE_EPSYLON;
+
+        template<typename FloatType> constexpr BasicVector2Template<FloatType>::BasicVector2Template()
+            : x(ZERO), y(ZERO)
+        {
+        }
+
+        template<typename FloatType> constexpr BasicVector2Template<FloatType>::BasicVector2Template(const FloatType x, const FloatType y)
+            : x(x), y(y)
+        {
+        }
+
+        template<typename FloatType> constexpr void BasicVector2Template<FloatType>::setToZero()
         {
             this->x = ZERO;
             this->y = ZERO;
         }
 
-        template<typename FloatType> bool BasicVector2Template<FloatType>::isZero() const
+        template<typename FloatType> constexpr bool BasicVector2Template<FloatType>::isZero() const
         {
             return this->x * this->x + this->y * this->y <= SQUARE_EPSYLON;
         }
 
-        template<typename FloatType> bool BasicVector2Template<FloatType>::isUnit() const
+        template<typename FloatType> constexpr bool BasicVector2Template<FloatType>::isUnit() const
         {
             FloatType difference = this->x * this->x + this->y * this->y - UNIT;
             return NEGATIVE_EPSYLON <= difference && difference <= EPSYLON;
         }
 
-        template<typename FloatType> bool BasicVector2Template<FloatType>::isCloseTo(const FloatType x, const FloatType y) const
+        template<typename FloatType> constexpr bool BasicVector2Template<FloatType>::isCloseTo(const FloatType x, const FloatType y) const
         {
             FloatType dx = this->x - x;
             FloatType dy = this->y - y;
@@ -148,7 +159,7 @@ namespace geometry
             return dx * dx + dy * dy <= SQUARE_EPSYLON;
         }
 
-        template<typename FloatType> bool BasicVector2Template<FloatType>::isCloseTo(const BasicVector2Template<FloatType>& vector) const
+        template<typename FloatType> constexpr bool BasicVector2Template<FloatType>::isCloseTo(const BasicVector2Template<FloatType>& vector) const
         {
             FloatType dx = this->x - vector.x;
             FloatType dy = this->y - vector.y;
@@ -156,51 +167,48 @@ namespace geometry
             return dx * dx + dy * dy <= SQUARE_EPSYLON;
         }
 
-        template<typename FloatType> void BasicVector2Template<FloatType>::setValues(const FloatType x, const FloatType y)
+        template<typename FloatType> constexpr void BasicVector2Template<FloatType>::setValues(const FloatType x, const FloatType y)
         {
             this->x = x;
             this->y = y;
         }
 
-        template<typename FloatType> void BasicVector2Template<FloatType>::setValuesOf(const BasicVector2Template<FloatType> & vector)
+        template<typename FloatType> constexpr void BasicVector2Template<FloatType>::setValuesOf(const BasicVector2Template<FloatType> & vector)
         {
             this->x = vector.x;
             this->y = vector.y;
         }
 
-        template<typename FloatType> FloatType BasicVector2Template<FloatType>::scalar(const FloatType x, const FloatType y) const
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::scalar(const FloatType x, const FloatType y) const
         {
             return this->x * x + this->y * y;
         }
 
-        template<typename FloatType> FloatType BasicVector2Template<FloatType>::scalar(const BasicVector2Template<FloatType> & vector) const
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::scalar(const BasicVector2Template<FloatType> & vector) const
         {
             return this->x * vector.x + this->y * vector.y;
         }
 
-        template<typename FloatType> FloatType BasicVector2Template<FloatType>::operator*(const BasicVector2Template<FloatType> & vector) const
+        template<typename FloatType> constexpr FloatType BasicVector2Template<FloatType>::operator*(const BasicVector2Template<FloatType> & vector) const
         {
             return this->x * vector.x + this->y * vector.y;
         }
 
         // ================ Vector2<double> inline methods =============== //
 
-        Vector2::Vector2()
+        constexpr Vector2::Vector2()
+            : BasicVector2Template<double>()
         {
-            this->x = ZERO;
-            this->y = ZERO;
         }
 
-        Vector2::Vector2(const Vector2F & vector)
+        constexpr Vector2::Vector2(const Vector2F & vector)
+            : BasicVector2Template<double>(vector.x, vector.y)
         {
-            this->x = vector.x;
-            this->y = vector.y;
         }
 
-        Vector2::Vector2(const double x, const double y)
+        constexpr Vector2::Vector2(const double x, const double y)
+            : BasicVector2Template<double>(x, y)
         {
-            this->x = x;
-            this->y = y;
         }
 
         double Vector2::module() const
@@ -226,38 +234,38 @@ namespace geometry
             return true;
         }
 
-        void Vector2::setValuesOf(const Vector2F & vector)
+        constexpr void Vector2::setValuesOf(const Vector2F & vector)
         {
             this->x = vector.x;
             this->y = vector.y;
         }
 
-        Vector2F Vector2::toFloat() const
+        constexpr Vector2F Vector2::toFloat() const
         {
             return Vector2F((float)this->x, (float)this->y);
         }
 
-        Vector2 Vector2::operator+(const Vector2 & vector) const
+        constexpr Vector2 Vector2::operator+(const Vector2 & vector) const
         {
             return Vector2(this->x + vector.x, this->y + vector.y);
         }
 
-        Vector2 Vector2::operator-(const Vector2 & vector) const
+        constexpr Vector2 Vector2::operator-(const Vector2 & vector) const
         {
             return Vector2(this->x - vector.x, this->y - vector.y);
         }
 
-        Vector2 Vector2::operator*(const double value) const
+        constexpr Vector2 Vector2::operator*(const double value) const
         {
             return Vector2(this->x * value, this->y * value);
         }
 
-        Vector2 Vector2::operator/(const double value) const
+        constexpr Vector2 Vector2::operator/(const double value) const
         {
             return Vector2(this->x / value, this->y / value);
         }
 
-        Vector2 & Vector2::operator+=(const Vector2 & vector)
+        constexpr Vector2 & Vector2::operator+=(const Vector2 & vector)
         {
             this->x += vector.x;
             this->y += vector.y;
@@ -265,7 +273,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector2 & Vector2::operator-=(const Vector2 & vector)
+        constexpr Vector2 & Vector2::operator-=(const Vector2 & vector)
         {
             this->x -= vector.x;
             this->y -= vector.y;
@@ -273,7 +281,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector2 & Vector2::operator*=(const double value)
+        constexpr Vector2 & Vector2::operator*=(const double value)
         {
             this->x *= value;
             this->y *= value;
@@ -281,7 +289,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector2 & Vector2::operator/=(const double value)
+        constexpr Vector2 & Vector2::operator/=(const double value)
         {
             this->x /= value;
             this->y /= value;
@@ -289,29 +297,26 @@ namespace geometry
             return (*this);
         }
 
-        inline Vector2 operator*(const double value, const Vector2 & vector)
+        constexpr Vector2 operator*(const double value, const Vector2 & vector)
         {
             return Vector2(vector.x * value, vector.y * value);
         }
 
         // ================ Vector2<float> inline methods ================ //
 
-        Vector2F::Vector2F()
+        constexpr Vector2F::Vector2F()
+            : BasicVector2Template<float>()
         {
-            this->x = ZERO;
-            this->y = ZERO;
         }
 
-        Vector2F::Vector2F(const Vector2& vector)
+        constexpr Vector2F::Vector2F(const Vector2 & vector)
+            : BasicVector2Template<float>((float)vector.x, (float)vector.y)
         {
-            this->x = (float)vector.x;
-            this->y = (float)vector.y;
         }
 
-        Vector2F::Vector2F(const float x, const float y)
+        constexpr Vector2F::Vector2F(const float x, const float y)
+            : BasicVector2Template<float>(x, y)
         {
-            this->x = x;
-            this->y = y;
         }
 
         float Vector2F::module() const
@@ -337,38 +342,38 @@ namespace geometry
             return true;
         }
 
-        void Vector2F::setValuesOf(const Vector2 & vector)
+        constexpr void Vector2F::setValuesOf(const Vector2 & vector)
         {
             this->x = (float)vector.x;
             this->y = (float)vector.y;
         }
 
-        Vector2 Vector2F::toDouble() const
+        constexpr Vector2 Vector2F::toDouble() const
         {
             return Vector2(this->x, this->y);
         }
 
-        Vector2F Vector2F::operator+(const Vector2F & vector) const
+        constexpr Vector2F Vector2F::operator+(const Vector2F & vector) const
         {
             return Vector2F(this->x + vector.x, this->y + vector.y);
         }
 
-        Vector2F Vector2F::operator-(const Vector2F & vector) const
+        constexpr Vector2F Vector2F::operator-(const Vector2F & vector) const
         {
             return Vector2F(this->x - vector.x, this->y - vector.y);
         }
 
-        Vector2F Vector2F::operator*(const float value) const
+        constexpr Vector2F Vector2F::operator*(const float value) const
         {
             return Vector2F(this->x * value, this->y * value);
         }
 
-        Vector2F Vector2F::operator/(const float value) const
+        constexpr Vector2F Vector2F::operator/(const float value) const
         {
             return Vector2F(this->x / value, this->y / value);
         }
 
-        Vector2F & Vector2F::operator+=(const Vector2F & vector)
+        constexpr Vector2F & Vector2F::operator+=(const Vector2F & vector)
         {
             this->x += vector.x;
             this->y += vector.y;
@@ -376,7 +381,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector2F & Vector2F::operator-=(const Vector2F & vector)
+        constexpr Vector2F & Vector2F::operator-=(const Vector2F & vector)
         {
             this->x -= vector.x;
             this->y -= vector.y;
@@ -384,7 +389,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector2F & Vector2F::operator*=(const float value)
+        constexpr Vector2F & Vector2F::operator*=(const float value)
         {
             this->x *= value;
             this->y *= value;
@@ -392,7 +397,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector2F & Vector2F::operator/=(const float value)
+        constexpr Vector2F & Vector2F::operator/=(const float value)
         {
             this->x /= value;
             this->y /= value;
@@ -400,12 +405,12 @@ namespace geometry
             return (*this);
         }
 
-        inline Vector2F operator*(const float value, const Vector2F & vector)
+        constexpr Vector2F operator*(const float value, const Vector2F & vector)
         {
             return Vector2F(vector.x * value, vector.y * value);
         }
 
-        inline Vector2F operator*(const double value, const Vector2F & vector)
+        constexpr Vector2F operator*(const double value, const Vector2F & vector)
         {
             return Vector2F((float)(vector.x * value), (float)(vector.y * value));
         }
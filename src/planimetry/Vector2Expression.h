@@ -0,0 +1,311 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_PLANIMETRY_VECTOR2_EXPRESSION_H_
+#define _GEOMETRY_PLANIMETRY_VECTOR2_EXPRESSION_H_
+
+#include <stddef.h>
+#include <math.h>
+
+#include "Vector2.h"
+
+// Opt-in expression templates for the vector arithmetic. An expression is
+// started with expression() and is evaluated component-wise in one pass
+// without intermediate vectors:
+//
+//     Vector2F result = evaluate(expression(a) * s + b - c);
+//
+// The same expressions work over structure-of-arrays storage, where the
+// whole chain becomes a single loop the compiler can vectorize:
+//
+//     assign(target, expression(a) * s + b - c, count);
+//
+// The terms keep references to the vectors and arrays, so an expression
+// must not outlive the operands it was built from.
+
+namespace geometry
+{
+    namespace planimetry
+    {
+        // ================ Structure of arrays storage ================= //
+
+        // Non-owning view of vectors stored as two separate component arrays
+        template<typename FloatType> class Vector2Array
+        {
+        public:
+            FloatType * x;
+            FloatType * y;
+
+            Vector2Array() : x(0), y(0)
+            {
+            }
+
+            Vector2Array(FloatType * x, FloatType * y) : x(x), y(y)
+            {
+            }
+        };
+
+        template<typename FloatType> struct Vector2Of;
+
+        template<> struct Vector2Of<float>
+        {
+            typedef Vector2F Type;
+        };
+
+        template<> struct Vector2Of<double>
+        {
+            typedef Vector2 Type;
+        };
+
+        // ===================== Expression nodes ====================== //
+
+        // Every node gives the components of the i-th vector of the
+        // expression, a single vector term ignores the index.
+        template<class ExpressionType> class Vector2Expression
+        {
+        public:
+            inline const ExpressionType & get() const
+            {
+                return static_cast<const ExpressionType &>(*this);
+            }
+        };
+
+        template<typename FloatType> class Vector2Term : public Vector2Expression<Vector2Term<FloatType> >
+        {
+        public:
+            typedef FloatType Float;
+
+            explicit Vector2Term(const BasicVector2Template<FloatType> & vector) : vector(vector)
+            {
+            }
+
+            inline FloatType x(const size_t) const { return this->vector.x; }
+            inline FloatType y(const size_t) const { return this->vector.y; }
+
+        private:
+            const BasicVector2Template<FloatType> & vector;
+        };
+
+        template<typename FloatType> class Vector2ArrayTerm : public Vector2Expression<Vector2ArrayTerm<FloatType> >
+        {
+        public:
+            typedef FloatType Float;
+
+            explicit Vector2ArrayTerm(const Vector2Array<FloatType> & array) : xs(array.x), ys(array.y)
+            {
+            }
+
+            inline FloatType x(const size_t index) const { return this->xs[index]; }
+            inline FloatType y(const size_t index) const { return this->ys[index]; }
+
+        private:
+            const FloatType * xs;
+            const FloatType * ys;
+        };
+
+        template<class Left, class Right> class Vector2Sum : public Vector2Expression<Vector2Sum<Left, Right> >
+        {
+        public:
+            typedef typename Left::Float Float;
+
+            Vector2Sum(const Left & left, const Right & right) : left(left), right(right)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->left.x(index) + this->right.x(index); }
+            inline Float y(const size_t index) const { return this->left.y(index) + this->right.y(index); }
+
+        private:
+            const Left left;
+            const Right right;
+        };
+
+        template<class Left, class Right> class Vector2Difference : public Vector2Expression<Vector2Difference<Left, Right> >
+        {
+        public:
+            typedef typename Left::Float Float;
+
+            Vector2Difference(const Left & left, const Right & right) : left(left), right(right)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->left.x(index) - this->right.x(index); }
+            inline Float y(const size_t index) const { return this->left.y(index) - this->right.y(index); }
+
+        private:
+            const Left left;
+            const Right right;
+        };
+
+        template<class Operand> class Vector2Scaled : public Vector2Expression<Vector2Scaled<Operand> >
+        {
+        public:
+            typedef typename Operand::Float Float;
+
+            Vector2Scaled(const Operand & operand, const Float factor) : operand(operand), factor(factor)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->operand.x(index) * this->factor; }
+            inline Float y(const size_t index) const { return this->operand.y(index) * this->factor; }
+
+        private:
+            const Operand operand;
+            const Float factor;
+        };
+
+        // ========================= Builders ========================== //
+
+        template<typename FloatType> inline Vector2Term<FloatType> expression(const BasicVector2Template<FloatType> & vector)
+        {
+            return Vector2Term<FloatType>(vector);
+        }
+
+        template<typename FloatType> inline Vector2ArrayTerm<FloatType> expression(const Vector2Array<FloatType> & array)
+        {
+            return Vector2ArrayTerm<FloatType>(array);
+        }
+
+        template<class Left, class Right> inline Vector2Sum<Left, Right> operator+(const Vector2Expression<Left> & left, const Vector2Expression<Right> & right)
+        {
+            return Vector2Sum<Left, Right>(left.get(), right.get());
+        }
+
+        template<class Left, typename FloatType> inline Vector2Sum<Left, Vector2Term<FloatType> > operator+(const Vector2Expression<Left> & left, const BasicVector2Template<FloatType> & right)
+        {
+            return Vector2Sum<Left, Vector2Term<FloatType> >(left.get(), Vector2Term<FloatType>(right));
+        }
+
+        template<typename FloatType, class Right> inline Vector2Sum<Vector2Term<FloatType>, Right> operator+(const BasicVector2Template<FloatType> & left, const Vector2Expression<Right> & right)
+        {
+            return Vector2Sum<Vector2Term<FloatType>, Right>(Vector2Term<FloatType>(left), right.get());
+        }
+
+        template<class Left, class Right> inline Vector2Difference<Left, Right> operator-(const Vector2Expression<Left> & left, const Vector2Expression<Right> & right)
+        {
+            return Vector2Difference<Left, Right>(left.get(), right.get());
+        }
+
+        template<class Left, typename FloatType> inline Vector2Difference<Left, Vector2Term<FloatType> > operator-(const Vector2Expression<Left> & left, const BasicVector2Template<FloatType> & right)
+        {
+            return Vector2Difference<Left, Vector2Term<FloatType> >(left.get(), Vector2Term<FloatType>(right));
+        }
+
+        template<typename FloatType, class Right> inline Vector2Difference<Vector2Term<FloatType>, Right> operator-(const BasicVector2Template<FloatType> & left, const Vector2Expression<Right> & right)
+        {
+            return Vector2Difference<Vector2Term<FloatType>, Right>(Vector2Term<FloatType>(left), right.get());
+        }
+
+        template<class Operand> inline Vector2Scaled<Operand> operator*(const Vector2Expression<Operand> & operand, const typename Operand::Float factor)
+        {
+            return Vector2Scaled<Operand>(operand.get(), factor);
+        }
+
+        template<class Operand> inline Vector2Scaled<Operand> operator*(const typename Operand::Float factor, const Vector2Expression<Operand> & operand)
+        {
+            return Vector2Scaled<Operand>(operand.get(), factor);
+        }
+
+        template<class Operand> inline Vector2Scaled<Operand> operator/(const Vector2Expression<Operand> & operand, const typename Operand::Float divisor)
+        {
+            return Vector2Scaled<Operand>(operand.get(), 1 / divisor);
+        }
+
+        template<class Operand> inline Vector2Scaled<Operand> operator-(const Vector2Expression<Operand> & operand)
+        {
+            return Vector2Scaled<Operand>(operand.get(), -1);
+        }
+
+        // ================ Evaluation of single vectors =============== //
+
+        template<class ExpressionType> inline typename Vector2Of<typename ExpressionType::Float>::Type evaluate(const Vector2Expression<ExpressionType> & expression)
+        {
+            const ExpressionType & value = expression.get();
+            return typename Vector2Of<typename ExpressionType::Float>::Type(value.x(0), value.y(0));
+        }
+
+        template<typename FloatType, class ExpressionType> inline void assign(BasicVector2Template<FloatType> & target, const Vector2Expression<ExpressionType> & expression)
+        {
+            const ExpressionType & value = expression.get();
+
+            // Computed before the assignment since the target may be an operand
+            const FloatType x = value.x(0);
+            const FloatType y = value.y(0);
+
+            target.setValues(x, y);
+        }
+
+        template<class Left, class Right> inline typename Left::Float scalar(const Vector2Expression<Left> & left, const Vector2Expression<Right> & right)
+        {
+            return left.get().x(0) * right.get().x(0) + left.get().y(0) * right.get().y(0);
+        }
+
+        template<class ExpressionType> inline typename ExpressionType::Float module(const Vector2Expression<ExpressionType> & expression)
+        {
+            const ExpressionType & value = expression.get();
+
+            const typename ExpressionType::Float x = value.x(0);
+            const typename ExpressionType::Float y = value.y(0);
+
+            return sqrt(x * x + y * y);
+        }
+
+        // =================== Evaluation over arrays ================== //
+
+        // The target may be one of the operands: each vector is read only
+        // at its own index before it is written.
+        template<typename FloatType, class ExpressionType> inline void assign(const Vector2Array<FloatType> & target, const Vector2Expression<ExpressionType> & expression, const size_t count)
+        {
+            const ExpressionType & value = expression.get();
+
+            FloatType * const x = target.x;
+            FloatType * const y = target.y;
+
+            for (size_t i = 0; i < count; i++) {
+                const FloatType vx = value.x(i);
+                const FloatType vy = value.y(i);
+
+                x[i] = vx;
+                y[i] = vy;
+            }
+        }
+
+        template<typename FloatType, class Left, class Right> inline void scalar(FloatType * target, const Vector2Expression<Left> & left, const Vector2Expression<Right> & right, const size_t count)
+        {
+            const Left & a = left.get();
+            const Right & b = right.get();
+
+            for (size_t i = 0; i < count; i++) {
+                target[i] = a.x(i) * b.x(i) + a.y(i) * b.y(i);
+            }
+        }
+
+        template<typename FloatType, class ExpressionType> inline void module(FloatType * target, const Vector2Expression<ExpressionType> & expression, const size_t count)
+        {
+            const ExpressionType & value = expression.get();
+
+            for (size_t i = 0; i < count; i++) {
+                const FloatType x = value.x(i);
+                const FloatType y = value.y(i);
+
+                target[i] = sqrt(x * x + y * y);
+            }
+        }
+    } /* namespace planimetry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_PLANIMETRY_VECTOR2_EXPRESSION_H_ */
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_AXIS_BOX3_H_
+#define _GEOMETRY_STEREOMETRY_AXIS_BOX3_H_
+
+#include <stddef.h>
+
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // ================= Axis aligned box header ================= //
+
+        // A box with the faces parallel to the coordinate planes. An empty
+        // box has its minimum above its maximum, adding the first point
+        // makes it that point.
+        template<typename FloatType, class VectorType> class AxisBox3Template
+        {
+        public:
+            VectorType minimum;
+            VectorType maximum;
+
+            inline AxisBox3Template();
+            inline AxisBox3Template(const VectorType & minimum, const VectorType & maximum);
+
+            inline void setToEmpty();
+            inline bool isEmpty() const;
+
+            inline void add(const VectorType & point);
+            inline void add(const AxisBox3Template<FloatType, VectorType> & box);
+
+            template<class TriangleType> inline void addTriangle(const TriangleType & triangle);
+
+            inline void setToPoints(const VectorType * points, const size_t count);
+            template<class TriangleType> inline void setToTriangles(const TriangleType * triangles, const size_t count);
+
+            inline bool contains(const VectorType & point) const;
+
+            // Boxes touching by a face intersect
+            inline bool intersects(const AxisBox3Template<FloatType, VectorType> & box) const;
+
+            inline VectorType getCentre() const;
+            inline VectorType getHalfSize() const;
+        };
+
+        typedef AxisBox3Template<float, Vector3F> AxisBox3F;
+        typedef AxisBox3Template<double, Vector3> AxisBox3;
+
+        // ============= Axis aligned box inline methods ============= //
+
+        template<typename FloatType, class VectorType> AxisBox3Template<FloatType, VectorType>::AxisBox3Template()
+        {
+            this->setToEmpty();
+        }
+
+        template<typename FloatType, class VectorType> AxisBox3Template<FloatType, VectorType>::AxisBox3Template(const VectorType & minimum, const VectorType & maximum)
+            : minimum(minimum), maximum(maximum)
+        {
+        }
+
+        template<typename FloatType, class VectorType> void AxisBox3Template<FloatType, VectorType>::setToEmpty()
+        {
+            this->minimum.setValues(1, 1, 1);
+            this->maximum.setValues(-1, -1, -1);
+        }
+
+        template<typename FloatType, class VectorType> bool AxisBox3Template<FloatType, VectorType>::isEmpty() const
+        {
+            return this->minimum.x > this->maximum.x || this->minimum.y > this->maximum.y || this->minimum.z > this->maximum.z;
+        }
+
+        template<typename FloatType, class VectorType> void AxisBox3Template<FloatType, VectorType>::add(const VectorType & point)
+        {
+            if (this->isEmpty()) {
+                this->minimum = point;
+                this->maximum = point;
+                return;
+            }
+
+            this->minimum.x = point.x < this->minimum.x ? point.x : this->minimum.x;
+            this->minimum.y = point.y < this->minimum.y ? point.y : this->minimum.y;
+            this->minimum.z = point.z < this->minimum.z ? point.z : this->minimum.z;
+
+            this->maximum.x = point.x > this->maximum.x ? point.x : this->maximum.x;
+            this->maximum.y = point.y > this->maximum.y ? point.y : this->maximum.y;
+            this->maximum.z = point.z > this->maximum.z ? point.z : this->maximum.z;
+        }
+
+        template<typename FloatType, class VectorType> void AxisBox3Template<FloatType, VectorType>::add(const AxisBox3Template<FloatType, VectorType> & box)
+        {
+            if (!box.isEmpty()) {
+                this->add(box.minimum);
+                this->add(box.maximum);
+            }
+        }
+
+        template<typename FloatType, class VectorType> template<class TriangleType> void AxisBox3Template<FloatType, VectorType>::addTriangle(const TriangleType & triangle)
+        {
+            this->add(triangle.A);
+            this->add(triangle.B);
+            this->add(triangle.C);
+        }
+
+        template<typename FloatType, class VectorType> void AxisBox3Template<FloatType, VectorType>::setToPoints(const VectorType * points, const size_t count)
+        {
+            this->setToEmpty();
+
+            for (size_t i = 0; i < count; i++) {
+                this->add(points[i]);
+            }
+        }
+
+        template<typename FloatType, class VectorType> template<class TriangleType> void AxisBox3Template<FloatType, VectorType>::setToTriangles(const TriangleType * triangles, const size_t count)
+        {
+            this->setToEmpty();
+
+            for (size_t i = 0; i < count; i++) {
+                this->addTriangle(triangles[i]);
+            }
+        }
+
+        template<typename FloatType, class VectorType> bool AxisBox3Template<FloatType, VectorType>::contains(const VectorType & point) const
+        {
+            return this->minimum.x <= point.x && point.x <= this->maximum.x
+                && this->minimum.y <= point.y && point.y <= this->maximum.y
+                && this->minimum.z <= point.z && point.z <= this->maximum.z;
+        }
+
+        template<typename FloatType, class VectorType> bool AxisBox3Template<FloatType, VectorType>::intersects(const AxisBox3Template<FloatType, VectorType> & box) const
+        {
+            return this->minimum.x <= box.maximum.x && box.minimum.x <= this->maximum.x
+                && this->minimum.y <= box.maximum.y && box.minimum.y <= this->maximum.y
+                && this->minimum.z <= box.maximum.z && box.minimum.z <= this->maximum.z;
+        }
+
+        template<typename FloatType, class VectorType> VectorType AxisBox3Template<FloatType, VectorType>::getCentre() const
+        {
+            return VectorType((this->minimum.x + this->maximum.x) / 2, (this->minimum.y + this->maximum.y) / 2, (this->minimum.z + this->maximum.z) / 2);
+        }
+
+        template<typename FloatType, class VectorType> VectorType AxisBox3Template<FloatType, VectorType>::getHalfSize() const
+        {
+            return VectorType((this->maximum.x - this->minimum.x) / 2, (this->maximum.y - this->minimum.y) / 2, (this->maximum.z - this->minimum.z) / 2);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_AXIS_BOX3_H_ */
@@ -0,0 +1,341 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ClosestPoint3.h"
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_CLOSEST_POINT
+#endif
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        static_assert(sizeof(Vector3F) == 3 * sizeof(float), "the points are read as packed floats");
+
+#ifdef GEOMETRY_SSE_CLOSEST_POINT
+        // Four packed points are three registers: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+        static inline void loadPoints(const float * data, __m128 & x, __m128 & y, __m128 & z)
+        {
+            const __m128 first = _mm_loadu_ps(data);
+            const __m128 second = _mm_loadu_ps(data + 4);
+            const __m128 third = _mm_loadu_ps(data + 8);
+
+            x = _mm_shuffle_ps(first, _mm_shuffle_ps(second, third, _MM_SHUFFLE(1, 0, 3, 2)), _MM_SHUFFLE(3, 0, 3, 0));
+
+            y = _mm_shuffle_ps(
+                _mm_shuffle_ps(first, second, _MM_SHUFFLE(0, 0, 1, 1)),
+                _mm_shuffle_ps(second, third, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+            z = _mm_shuffle_ps(
+                _mm_shuffle_ps(first, second, _MM_SHUFFLE(1, 1, 2, 2)),
+                _mm_shuffle_ps(third, third, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+        }
+
+        static inline void storePoints(float * data, const __m128 x, const __m128 y, const __m128 z)
+        {
+            const __m128 low = _mm_unpacklo_ps(x, y);
+            const __m128 high = _mm_unpackhi_ps(x, y);
+
+            const __m128 third = _mm_shuffle_ps(z, high, _MM_SHUFFLE(3, 2, 3, 2));
+
+            _mm_storeu_ps(data, _mm_shuffle_ps(low, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(data + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), high, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(data + 8, _mm_shuffle_ps(third, third, _MM_SHUFFLE(1, 3, 2, 0)));
+        }
+
+        static inline __m128 select(const __m128 mask, const __m128 chosen, const __m128 other)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, chosen), _mm_andnot_ps(mask, other));
+        }
+
+        static inline __m128 dot(const __m128 ax, const __m128 ay, const __m128 az, const __m128 bx, const __m128 by, const __m128 bz)
+        {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+        }
+#endif
+
+        // ========================== Kernels ========================== //
+
+        // The point origin + direction * t nearest to the given one, with t
+        // scaled and clamped: lines, rays and segments
+        struct LinearKernel
+        {
+            Vector3F origin;
+            Vector3F direction;
+            float scale;
+            float minimum;
+            float maximum;
+
+            inline Vector3F operator()(const Vector3F & point) const
+            {
+                float position = (point - this->origin).scalar(this->direction) * this->scale;
+
+                position = position < this->minimum ? this->minimum : (position > this->maximum ? this->maximum : position);
+
+                return this->origin + this->direction * position;
+            }
+
+#ifdef GEOMETRY_SSE_CLOSEST_POINT
+            inline void operator()(__m128 & x, __m128 & y, __m128 & z) const
+            {
+                const __m128 originX = _mm_set1_ps(this->origin.x);
+                const __m128 originY = _mm_set1_ps(this->origin.y);
+                const __m128 originZ = _mm_set1_ps(this->origin.z);
+                const __m128 directionX = _mm_set1_ps(this->direction.x);
+                const __m128 directionY = _mm_set1_ps(this->direction.y);
+                const __m128 directionZ = _mm_set1_ps(this->direction.z);
+
+                __m128 position = _mm_mul_ps(dot(_mm_sub_ps(x, originX), _mm_sub_ps(y, originY), _mm_sub_ps(z, originZ), directionX, directionY, directionZ), _mm_set1_ps(this->scale));
+                position = _mm_min_ps(_mm_max_ps(position, _mm_set1_ps(this->minimum)), _mm_set1_ps(this->maximum));
+
+                x = _mm_add_ps(originX, _mm_mul_ps(directionX, position));
+                y = _mm_add_ps(originY, _mm_mul_ps(directionY, position));
+                z = _mm_add_ps(originZ, _mm_mul_ps(directionZ, position));
+            }
+#endif
+        };
+
+        static inline LinearKernel makeLinearKernel(const Vector3F & origin, const Vector3F & direction, const float scale, const float minimum, const float maximum)
+        {
+            LinearKernel kernel;
+            kernel.origin = origin;
+            kernel.direction = direction;
+            kernel.scale = scale;
+            kernel.minimum = minimum;
+            kernel.maximum = maximum;
+
+            return kernel;
+        }
+
+        // Triangle3::closestPoint() with every region computed and the one
+        // of the point selected, in the order of its tests
+        struct TriangleKernel
+        {
+            Triangle3F triangle;
+
+            inline Vector3F operator()(const Vector3F & point) const
+            {
+                return this->triangle.closestPoint(point);
+            }
+
+#ifdef GEOMETRY_SSE_CLOSEST_POINT
+            inline void operator()(__m128 & x, __m128 & y, __m128 & z) const
+            {
+                const Vector3F & A = this->triangle.A;
+                const Vector3F & B = this->triangle.B;
+                const Vector3F & C = this->triangle.C;
+
+                const Vector3F ab = B - A;
+                const Vector3F ac = C - A;
+                const Vector3F bc = C - B;
+
+                const __m128 zero = _mm_setzero_ps();
+
+                const __m128 abX = _mm_set1_ps(ab.x);
+                const __m128 abY = _mm_set1_ps(ab.y);
+                const __m128 abZ = _mm_set1_ps(ab.z);
+                const __m128 acX = _mm_set1_ps(ac.x);
+                const __m128 acY = _mm_set1_ps(ac.y);
+                const __m128 acZ = _mm_set1_ps(ac.z);
+
+                const __m128 aX = _mm_set1_ps(A.x);
+                const __m128 aY = _mm_set1_ps(A.y);
+                const __m128 aZ = _mm_set1_ps(A.z);
+                const __m128 bX = _mm_set1_ps(B.x);
+                const __m128 bY = _mm_set1_ps(B.y);
+                const __m128 bZ = _mm_set1_ps(B.z);
+                const __m128 cX = _mm_set1_ps(C.x);
+                const __m128 cY = _mm_set1_ps(C.y);
+                const __m128 cZ = _mm_set1_ps(C.z);
+
+                const __m128 apX = _mm_sub_ps(x, aX);
+                const __m128 apY = _mm_sub_ps(y, aY);
+                const __m128 apZ = _mm_sub_ps(z, aZ);
+                const __m128 d1 = dot(abX, abY, abZ, apX, apY, apZ);
+                const __m128 d2 = dot(acX, acY, acZ, apX, apY, apZ);
+
+                const __m128 bpX = _mm_sub_ps(x, bX);
+                const __m128 bpY = _mm_sub_ps(y, bY);
+                const __m128 bpZ = _mm_sub_ps(z, bZ);
+                const __m128 d3 = dot(abX, abY, abZ, bpX, bpY, bpZ);
+                const __m128 d4 = dot(acX, acY, acZ, bpX, bpY, bpZ);
+
+                const __m128 cpX = _mm_sub_ps(x, cX);
+                const __m128 cpY = _mm_sub_ps(y, cY);
+                const __m128 cpZ = _mm_sub_ps(z, cZ);
+                const __m128 d5 = dot(abX, abY, abZ, cpX, cpY, cpZ);
+                const __m128 d6 = dot(acX, acY, acZ, cpX, cpY, cpZ);
+
+                const __m128 vc = _mm_sub_ps(_mm_mul_ps(d1, d4), _mm_mul_ps(d3, d2));
+                const __m128 vb = _mm_sub_ps(_mm_mul_ps(d5, d2), _mm_mul_ps(d1, d6));
+                const __m128 va = _mm_sub_ps(_mm_mul_ps(d3, d6), _mm_mul_ps(d5, d4));
+
+                // The face
+                const __m128 denominator = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(va, vb), vc));
+                const __m128 v = _mm_mul_ps(vb, denominator);
+                const __m128 w = _mm_mul_ps(vc, denominator);
+
+                __m128 resultX = _mm_add_ps(_mm_add_ps(aX, _mm_mul_ps(abX, v)), _mm_mul_ps(acX, w));
+                __m128 resultY = _mm_add_ps(_mm_add_ps(aY, _mm_mul_ps(abY, v)), _mm_mul_ps(acY, w));
+                __m128 resultZ = _mm_add_ps(_mm_add_ps(aZ, _mm_mul_ps(abZ, v)), _mm_mul_ps(acZ, w));
+
+                // The edge BC
+                const __m128 d43 = _mm_sub_ps(d4, d3);
+                const __m128 d56 = _mm_sub_ps(d5, d6);
+                const __m128 onBC = _mm_and_ps(_mm_cmple_ps(va, zero), _mm_and_ps(_mm_cmpge_ps(d43, zero), _mm_cmpge_ps(d56, zero)));
+                const __m128 positionBC = _mm_div_ps(d43, _mm_add_ps(d43, d56));
+
+                resultX = select(onBC, _mm_add_ps(bX, _mm_mul_ps(_mm_set1_ps(bc.x), positionBC)), resultX);
+                resultY = select(onBC, _mm_add_ps(bY, _mm_mul_ps(_mm_set1_ps(bc.y), positionBC)), resultY);
+                resultZ = select(onBC, _mm_add_ps(bZ, _mm_mul_ps(_mm_set1_ps(bc.z), positionBC)), resultZ);
+
+                // The edge AC
+                const __m128 onAC = _mm_and_ps(_mm_cmple_ps(vb, zero), _mm_and_ps(_mm_cmpge_ps(d2, zero), _mm_cmple_ps(d6, zero)));
+                const __m128 positionAC = _mm_div_ps(d2, _mm_sub_ps(d2, d6));
+
+                resultX = select(onAC, _mm_add_ps(aX, _mm_mul_ps(acX, positionAC)), resultX);
+                resultY = select(onAC, _mm_add_ps(aY, _mm_mul_ps(acY, positionAC)), resultY);
+                resultZ = select(onAC, _mm_add_ps(aZ, _mm_mul_ps(acZ, positionAC)), resultZ);
+
+                // The vertex C
+                const __m128 atC = _mm_and_ps(_mm_cmpge_ps(d6, zero), _mm_cmple_ps(d5, d6));
+
+                resultX = select(atC, cX, resultX);
+                resultY = select(atC, cY, resultY);
+                resultZ = select(atC, cZ, resultZ);
+
+                // The edge AB
+                const __m128 onAB = _mm_and_ps(_mm_cmple_ps(vc, zero), _mm_and_ps(_mm_cmpge_ps(d1, zero), _mm_cmple_ps(d3, zero)));
+                const __m128 positionAB = _mm_div_ps(d1, _mm_sub_ps(d1, d3));
+
+                resultX = select(onAB, _mm_add_ps(aX, _mm_mul_ps(abX, positionAB)), resultX);
+                resultY = select(onAB, _mm_add_ps(aY, _mm_mul_ps(abY, positionAB)), resultY);
+                resultZ = select(onAB, _mm_add_ps(aZ, _mm_mul_ps(abZ, positionAB)), resultZ);
+
+                // The vertices B and A
+                const __m128 atB = _mm_and_ps(_mm_cmpge_ps(d3, zero), _mm_cmple_ps(d4, d3));
+
+                resultX = select(atB, bX, resultX);
+                resultY = select(atB, bY, resultY);
+                resultZ = select(atB, bZ, resultZ);
+
+                const __m128 atA = _mm_and_ps(_mm_cmple_ps(d1, zero), _mm_cmple_ps(d2, zero));
+
+                x = select(atA, aX, resultX);
+                y = select(atA, aY, resultY);
+                z = select(atA, aZ, resultZ);
+            }
+#endif
+        };
+
+        template<class Kernel> static void runKernel(const Kernel & kernel, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount)
+        {
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                size_t i = first;
+
+#ifdef GEOMETRY_SSE_CLOSEST_POINT
+                for (; i + 4 <= last; i += 4) {
+                    __m128 x, y, z;
+                    loadPoints(&points[i].x, x, y, z);
+                    kernel(x, y, z);
+                    storePoints(&results[i].x, x, y, z);
+                }
+#endif
+
+                for (; i < last; i++) {
+                    results[i] = kernel(points[i]);
+                }
+            }, threadCount);
+        }
+
+        template<class Primitive> static void runScalar(const Primitive & primitive, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount)
+        {
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    results[i] = primitive.closestPoint(points[i]);
+                }
+            }, threadCount);
+        }
+
+        // ======================= Batch queries ======================= //
+
+        void findClosestPoints(const Line3F & line, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.line.float");
+            runKernel(makeLinearKernel(line.constPoint(), line.constDirection(), 1.0f, -3.402823466E+38f, 3.402823466E+38f), points, results, count, threadCount);
+        }
+
+        void findClosestPoints(const Line3 & line, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.line.double");
+            runScalar(line, points, results, count, threadCount);
+        }
+
+        void findClosestPoints(const Ray3F & ray, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.ray.float");
+            runKernel(makeLinearKernel(ray.constPoint(), ray.constDirection(), 1.0f, 0.0f, 3.402823466E+38f), points, results, count, threadCount);
+        }
+
+        void findClosestPoints(const Ray3 & ray, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.ray.double");
+            runScalar(ray, points, results, count, threadCount);
+        }
+
+        void findClosestPoints(const Vector3F & start, const Vector3F & end, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.segment.float");
+
+            const Vector3F segment = end - start;
+            const float squareLength = segment.scalar(segment);
+
+            runKernel(makeLinearKernel(start, segment, squareLength > 0.0f ? 1.0f / squareLength : 0.0f, 0.0f, 1.0f), points, results, count, threadCount);
+        }
+
+        void findClosestPoints(const Vector3 & start, const Vector3 & end, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.segment.double");
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    results[i] = closestPointOnSegment(start, end, points[i]);
+                }
+            }, threadCount);
+        }
+
+        void findClosestPoints(const Triangle3F & triangle, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.triangle.float");
+
+            TriangleKernel kernel;
+            kernel.triangle = triangle;
+
+            runKernel(kernel, points, results, count, threadCount);
+        }
+
+        void findClosestPoints(const Triangle3 & triangle, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("closest_point.triangle.double");
+            runScalar(triangle, points, results, count, threadCount);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_CLOSEST_POINT3_H_
+#define _GEOMETRY_STEREOMETRY_CLOSEST_POINT3_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "Line3.h"
+#include "Triangle3.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // The point of the segment from start to end nearest to the given one
+        template<class VectorType> inline VectorType closestPointOnSegment(const VectorType & start, const VectorType & end, const VectorType & point);
+
+        // ======================= Batch queries ======================= //
+
+        // results[i] gets the point of the line, the ray, the segment or the
+        // triangle nearest to points[i], results may be points. The float
+        // versions take four points at a time in SSE lanes, all of them run
+        // on the threads of the shared pool.
+        void findClosestPoints(const Line3F & line, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount = 0);
+        void findClosestPoints(const Line3 & line, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount = 0);
+
+        void findClosestPoints(const Ray3F & ray, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount = 0);
+        void findClosestPoints(const Ray3 & ray, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount = 0);
+
+        void findClosestPoints(const Vector3F & start, const Vector3F & end, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount = 0);
+        void findClosestPoints(const Vector3 & start, const Vector3 & end, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount = 0);
+
+        void findClosestPoints(const Triangle3F & triangle, const Vector3F * points, Vector3F * results, const size_t count, const uint32bit threadCount = 0);
+        void findClosestPoints(const Triangle3 & triangle, const Vector3 * points, Vector3 * results, const size_t count, const uint32bit threadCount = 0);
+
+        // ======================= Inline functions ======================= //
+
+        template<class VectorType> VectorType closestPointOnSegment(const VectorType & start, const VectorType & end, const VectorType & point)
+        {
+            const VectorType segment = end - start;
+            const auto squareLength = segment.scalar(segment);
+
+            if (squareLength <= 0) {
+                return start;
+            }
+
+            const auto position = (point - start).scalar(segment) / squareLength;
+
+            if (position <= 0) {
+                return start;
+            }
+
+            return position >= 1 ? end : start + segment * position;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_CLOSEST_POINT3_H_ */
@@ -18,12 +18,24 @@
 
 #include <math.h>
 
+#include "../ThreadPool.h"
+
 namespace geometry
 {
     namespace stereometry
     {
-        Converter3F::~Converter3F()
+        // Conversions are literal types, tables of them may be built at compile time
+        static constexpr Converter3F LIFT(Matrix3x3F(), Vector3F(0.0f, 0.0f, 1.0f));
+
+        static_assert(LIFT.convert(Vector3F(1.0f, 2.0f, 3.0f)).z == 4.0f, "Converter3F is expected to be usable in constant expressions");
+
+        void Converter3F::convert(const Vector3F * source, Vector3F * target, const size_t count, const uint32bit threadCount) const
         {
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    target[i] = this->convert(source[i]);
+                }
+            }, threadCount);
         }
     } /* namespace stereometry */
 } /* namespace geometry */
@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
-#ifndef _GEOMETRY_FLOAT32_PLANIMETRY_TRANSITION_H_
-#define _GEOMETRY_FLOAT32_PLANIMETRY_TRANSITION_H_
+#ifndef _GEOMETRY_STEREOMETRY_CONVERTER3F_H_
+#define _GEOMETRY_STEREOMETRY_CONVERTER3F_H_
 
+#include <stddef.h>
+
+#include "../types.h"
 #include "../Angle.h"
 #include "Matrix3x3.h"
 #include "Vector3.h"
@@ -31,26 +34,36 @@ namespace geometry
             Matrix3x3F warp;
             Vector3F shift;
 
+            // The identity conversion
+            constexpr Converter3F();
+            constexpr Converter3F(const Matrix3x3F & warp, const Vector3F & shift);
 
-            inline Converter3F();
-            virtual ~Converter3F();
+            constexpr void setToIdentity();
 
-            inline void setToIdentity();
+            constexpr Vector3F convert(const Vector3F & vector) const;
 
-            inline Vector3F convert(const Vector3F & vector) const;
+            // Converts count vectors on the threads of the shared pool, the
+            // source and the target may be the same array
+            void convert(const Vector3F * source, Vector3F * target, const size_t count, const uint32bit threadCount = 0) const;
         };
 
-        Converter3F::Converter3F()
+        constexpr Converter3F::Converter3F()
+            : warp(), shift()
+        {
+        }
+
+        constexpr Converter3F::Converter3F(const Matrix3x3F & warp, const Vector3F & shift)
+            : warp(warp), shift(shift)
         {
         }
 
-        void Converter3F::setToIdentity()
+        constexpr void Converter3F::setToIdentity()
         {
             this->warp.setToIdentity();
             this->shift.setToZero();
         }
 
-        Vector3F Converter3F::convert(const Vector3F & vector) const
+        constexpr Vector3F Converter3F::convert(const Vector3F & vector) const
         {
             return Vector3F(
                     this->warp.r1c1 * vector.x + this->warp.r1c2 * vector.y + this->warp.r1c3 * vector.z + this->shift.x,
@@ -61,4 +74,4 @@ namespace geometry
     } /* namespace stereometry */
 } /* namespace geometry */
 
-#endif /* _GEOMETRY_FLOAT32_PLANIMETRY_TRANSITION_H_ */
+#endif /* _GEOMETRY_STEREOMETRY_CONVERTER3F_H_ */
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ConvexShape3.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_CONVEX_SHAPE
+#endif
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        static_assert(sizeof(Vector3F) == 3 * sizeof(float), "the points are read as packed floats");
+
+        uint32bit findSupportPoint(const Vector3F * points, const uint32bit count, const Vector3F & direction)
+        {
+            uint32bit best = 0;
+            float bestProjection = -3.402823466E+38f;
+            uint32bit i = 0;
+
+#ifdef GEOMETRY_SSE_CONVEX_SHAPE
+            if (count >= 8) {
+                // Four packed points are three registers, the products are
+                // regrouped by coordinates: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+                const __m128 direction0 = _mm_setr_ps(direction.x, direction.y, direction.z, direction.x);
+                const __m128 direction1 = _mm_setr_ps(direction.y, direction.z, direction.x, direction.y);
+                const __m128 direction2 = _mm_setr_ps(direction.z, direction.x, direction.y, direction.z);
+
+                const float * data = &points[0].x;
+
+                __m128 bestProjections = _mm_set1_ps(-3.402823466E+38f);
+                __m128i bestIndices = _mm_setzero_si128();
+                __m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+                const __m128i step = _mm_set1_epi32(4);
+
+                for (; i + 4 <= count; i += 4) {
+                    const __m128 products0 = _mm_mul_ps(_mm_loadu_ps(data + i * 3), direction0);
+                    const __m128 products1 = _mm_mul_ps(_mm_loadu_ps(data + i * 3 + 4), direction1);
+                    const __m128 products2 = _mm_mul_ps(_mm_loadu_ps(data + i * 3 + 8), direction2);
+
+                    const __m128 tail = _mm_shuffle_ps(products1, products2, _MM_SHUFFLE(1, 0, 3, 2));
+                    const __m128 x = _mm_shuffle_ps(products0, tail, _MM_SHUFFLE(3, 0, 3, 0));
+
+                    const __m128 y = _mm_shuffle_ps(
+                        _mm_shuffle_ps(products0, products1, _MM_SHUFFLE(0, 0, 1, 1)),
+                        _mm_shuffle_ps(products1, products2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+                    const __m128 z = _mm_shuffle_ps(
+                        _mm_shuffle_ps(products0, products1, _MM_SHUFFLE(1, 1, 2, 2)),
+                        _mm_shuffle_ps(products2, products2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+                    const __m128 projections = _mm_add_ps(_mm_add_ps(x, y), z);
+                    const __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(projections, bestProjections));
+
+                    bestProjections = _mm_max_ps(projections, bestProjections);
+                    bestIndices = _mm_or_si128(_mm_and_si128(greater, indices), _mm_andnot_si128(greater, bestIndices));
+                    indices = _mm_add_epi32(indices, step);
+                }
+
+                float laneProjections[4];
+                uint32bit laneIndices[4];
+
+                _mm_storeu_ps(laneProjections, bestProjections);
+                _mm_storeu_si128((__m128i *)laneIndices, bestIndices);
+
+                best = laneIndices[0];
+                bestProjection = laneProjections[0];
+
+                for (uint32bit lane = 1; lane < 4; lane++) {
+                    if (laneProjections[lane] > bestProjection || (laneProjections[lane] == bestProjection && laneIndices[lane] < best)) {
+                        best = laneIndices[lane];
+                        bestProjection = laneProjections[lane];
+                    }
+                }
+            }
+#endif
+
+            for (; i < count; i++) {
+                const float projection = direction.x * points[i].x + direction.y * points[i].y + direction.z * points[i].z;
+
+                if (projection > bestProjection) {
+                    best = i;
+                    bestProjection = projection;
+                }
+            }
+
+            return best;
+        }
+
+        uint32bit findSupportPoint(const Vector3 * points, const uint32bit count, const Vector3 & direction)
+        {
+            uint32bit best = 0;
+            double bestProjection = -1.7976931348623157E+308;
+
+            for (uint32bit i = 0; i < count; i++) {
+                const double projection = direction.x * points[i].x + direction.y * points[i].y + direction.z * points[i].z;
+
+                if (projection > bestProjection) {
+                    best = i;
+                    bestProjection = projection;
+                }
+            }
+
+            return best;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
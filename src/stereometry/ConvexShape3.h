@@ -0,0 +1,181 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_CONVEX_SHAPE3_H_
+#define _GEOMETRY_STEREOMETRY_CONVEX_SHAPE3_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "AxisBox3.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // The index of the point with the largest projection onto the
+        // direction, the first one of equal points. The float version
+        // projects four points at once.
+        uint32bit findSupportPoint(const Vector3F * points, const uint32bit count, const Vector3F & direction);
+        uint32bit findSupportPoint(const Vector3 * points, const uint32bit count, const Vector3 & direction);
+
+        // ================== Convex shape header ================== //
+
+        // A convex shape given by its support mapping: the point of the
+        // shape farthest along a direction. The shape is a core, the convex
+        // hull of points, a single point or a box, grown by radius in every
+        // direction: a sphere is a point with a radius, a capsule two
+        // points with one. The points are referenced, not copied.
+        template<typename FloatType, class VectorType> class ConvexShape3Template
+        {
+        public:
+            enum CoreType
+            {
+                HULL,
+                POINT,
+                BOX
+            };
+
+            CoreType type;
+
+            const VectorType * points;
+            uint32bit pointCount;
+
+            // The point, the centre of the box
+            VectorType centre;
+
+            // Unit axes of the box and the half sizes along them
+            VectorType axes[3];
+            VectorType halfSize;
+
+            FloatType radius;
+
+            inline ConvexShape3Template();
+
+            static inline ConvexShape3Template<FloatType, VectorType> makeHull(const VectorType * points, const uint32bit count, const FloatType radius = 0);
+            static inline ConvexShape3Template<FloatType, VectorType> makeSphere(const VectorType & centre, const FloatType radius);
+            static inline ConvexShape3Template<FloatType, VectorType> makeBox(const AxisBox3Template<FloatType, VectorType> & box);
+            static inline ConvexShape3Template<FloatType, VectorType> makeBox(const VectorType & centre, const VectorType & axisX, const VectorType & axisY, const VectorType & axisZ, const VectorType & halfSize);
+
+            // The support of the core, the direction need not be unit
+            inline VectorType getCoreSupport(const VectorType & direction) const;
+
+            inline VectorType getSupport(const VectorType & direction) const;
+
+            // A point inside the core
+            inline VectorType getInnerPoint() const;
+        };
+
+        typedef ConvexShape3Template<float, Vector3F> ConvexShape3F;
+        typedef ConvexShape3Template<double, Vector3> ConvexShape3;
+
+        // ============== Convex shape inline methods ============== //
+
+        template<typename FloatType, class VectorType> ConvexShape3Template<FloatType, VectorType>::ConvexShape3Template()
+            : type(POINT), points(0), pointCount(0), radius(0)
+        {
+            this->axes[0].setValues(1, 0, 0);
+            this->axes[1].setValues(0, 1, 0);
+            this->axes[2].setValues(0, 0, 1);
+        }
+
+        template<typename FloatType, class VectorType> ConvexShape3Template<FloatType, VectorType> ConvexShape3Template<FloatType, VectorType>::makeHull(const VectorType * points, const uint32bit count, const FloatType radius)
+        {
+            ConvexShape3Template<FloatType, VectorType> shape;
+
+            shape.type = HULL;
+            shape.points = points;
+            shape.pointCount = count;
+            shape.radius = radius;
+
+            return shape;
+        }
+
+        template<typename FloatType, class VectorType> ConvexShape3Template<FloatType, VectorType> ConvexShape3Template<FloatType, VectorType>::makeSphere(const VectorType & centre, const FloatType radius)
+        {
+            ConvexShape3Template<FloatType, VectorType> shape;
+
+            shape.type = POINT;
+            shape.centre = centre;
+            shape.radius = radius;
+
+            return shape;
+        }
+
+        template<typename FloatType, class VectorType> ConvexShape3Template<FloatType, VectorType> ConvexShape3Template<FloatType, VectorType>::makeBox(const AxisBox3Template<FloatType, VectorType> & box)
+        {
+            ConvexShape3Template<FloatType, VectorType> shape;
+
+            shape.type = BOX;
+            shape.centre = box.getCentre();
+            shape.halfSize = box.getHalfSize();
+
+            return shape;
+        }
+
+        template<typename FloatType, class VectorType> ConvexShape3Template<FloatType, VectorType> ConvexShape3Template<FloatType, VectorType>::makeBox(const VectorType & centre, const VectorType & axisX, const VectorType & axisY, const VectorType & axisZ, const VectorType & halfSize)
+        {
+            ConvexShape3Template<FloatType, VectorType> shape;
+
+            shape.type = BOX;
+            shape.centre = centre;
+            shape.axes[0] = axisX;
+            shape.axes[1] = axisY;
+            shape.axes[2] = axisZ;
+            shape.halfSize = halfSize;
+
+            return shape;
+        }
+
+        template<typename FloatType, class VectorType> VectorType ConvexShape3Template<FloatType, VectorType>::getCoreSupport(const VectorType & direction) const
+        {
+            if (this->type == HULL) {
+                return this->points[findSupportPoint(this->points, this->pointCount, direction)];
+            }
+
+            if (this->type == BOX) {
+                const FloatType x = this->axes[0].scalar(direction) < 0 ? -this->halfSize.x : this->halfSize.x;
+                const FloatType y = this->axes[1].scalar(direction) < 0 ? -this->halfSize.y : this->halfSize.y;
+                const FloatType z = this->axes[2].scalar(direction) < 0 ? -this->halfSize.z : this->halfSize.z;
+
+                return this->centre + this->axes[0] * x + this->axes[1] * y + this->axes[2] * z;
+            }
+
+            return this->centre;
+        }
+
+        template<typename FloatType, class VectorType> VectorType ConvexShape3Template<FloatType, VectorType>::getSupport(const VectorType & direction) const
+        {
+            const VectorType core = this->getCoreSupport(direction);
+
+            if (this->radius <= 0) {
+                return core;
+            }
+
+            const FloatType length = direction.module();
+
+            return length > 0 ? core + direction * (this->radius / length) : core;
+        }
+
+        template<typename FloatType, class VectorType> VectorType ConvexShape3Template<FloatType, VectorType>::getInnerPoint() const
+        {
+            return this->type == HULL && this->pointCount > 0 ? this->points[0] : this->centre;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_CONVEX_SHAPE3_H_ */
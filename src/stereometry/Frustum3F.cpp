@@ -0,0 +1,438 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Frustum3F.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define GEOMETRY_AVX512_FRUSTUM
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GEOMETRY_AVX_FRUSTUM
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_FRUSTUM
+#endif
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        const uint32bit Frustum3F::LEFT_PLANE;
+        const uint32bit Frustum3F::RIGHT_PLANE;
+        const uint32bit Frustum3F::BOTTOM_PLANE;
+        const uint32bit Frustum3F::TOP_PLANE;
+        const uint32bit Frustum3F::NEAR_PLANE;
+        const uint32bit Frustum3F::FAR_PLANE;
+        const uint32bit Frustum3F::PLANE_COUNT;
+        const uint8bit Frustum3F::ALL_PLANES;
+        const uint8bit Frustum3F::OUTSIDE;
+        const uint8bit Frustum3F::INTERSECTS;
+        const uint8bit Frustum3F::INSIDE;
+
+        Frustum3F::Frustum3F()
+        {
+            this->setViewProjection(Matrix4x4F());
+        }
+
+        Frustum3F::Frustum3F(const Matrix4x4F & viewProjection)
+        {
+            this->setViewProjection(viewProjection);
+        }
+
+        void Frustum3F::setViewProjection(const Matrix4x4F & viewProjection)
+        {
+            const float (&m)[4][4] = viewProjection.values;
+
+            // The clip space bounds -W <= X <= W, -W <= Y <= W and
+            // 0 <= Z <= W as combinations of the rows
+            const float signs[PLANE_COUNT][4] = {
+                {  1.0f,  0.0f, 0.0f, 1.0f },
+                { -1.0f,  0.0f, 0.0f, 1.0f },
+                {  0.0f,  1.0f, 0.0f, 1.0f },
+                {  0.0f, -1.0f, 0.0f, 1.0f },
+                {  0.0f,  0.0f, 1.0f, 0.0f },
+                {  0.0f,  0.0f, -1.0f, 1.0f }
+            };
+
+            for (uint32bit plane = 0; plane < PLANE_COUNT; plane++) {
+                float coefficients[4];
+
+                for (uint32bit column = 0; column < 4; column++) {
+                    coefficients[column] = signs[plane][0] * m[0][column] + signs[plane][1] * m[1][column] + signs[plane][2] * m[2][column] + signs[plane][3] * m[3][column];
+                }
+
+                const float length = sqrtf(coefficients[0] * coefficients[0] + coefficients[1] * coefficients[1] + coefficients[2] * coefficients[2]);
+                const float factor = length > 0.0f ? 1.0f / length : 0.0f;
+
+                this->planeX[plane] = coefficients[0] * factor;
+                this->planeY[plane] = coefficients[1] * factor;
+                this->planeZ[plane] = coefficients[2] * factor;
+                this->planeDistance[plane] = coefficients[3] * factor;
+
+                this->absoluteX[plane] = fabsf(this->planeX[plane]);
+                this->absoluteY[plane] = fabsf(this->planeY[plane]);
+                this->absoluteZ[plane] = fabsf(this->planeZ[plane]);
+            }
+        }
+
+        // ====================== Batch tests ====================== //
+
+        // The register operations the lane groups are written against, one
+        // specialization per lane count. gather() takes every stride-th
+        // float, lookup() the entries of a plane table, less() returns a bit
+        // per lane.
+        template<uint32bit Count> struct FrustumLanes;
+
+#ifdef GEOMETRY_AVX512_FRUSTUM
+        template<> struct FrustumLanes<16>
+        {
+            typedef __m512 Register;
+
+            static const int ALL = 0xFFFF;
+
+            static inline __m512 set(const float value) { return _mm512_set1_ps(value); }
+            static inline __m512 load(const float * values) { return _mm512_loadu_ps(values); }
+            static inline __m512 gather(const float * values, const size_t stride)
+            {
+                return _mm512_setr_ps(values[0], values[1 * stride], values[2 * stride], values[3 * stride], values[4 * stride], values[5 * stride], values[6 * stride], values[7 * stride],
+                    values[8 * stride], values[9 * stride], values[10 * stride], values[11 * stride], values[12 * stride], values[13 * stride], values[14 * stride], values[15 * stride]);
+            }
+
+            static inline __m512 lookup(const float * table, const uint8bit * indices)
+            {
+                return _mm512_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]], table[indices[4]], table[indices[5]], table[indices[6]], table[indices[7]],
+                    table[indices[8]], table[indices[9]], table[indices[10]], table[indices[11]], table[indices[12]], table[indices[13]], table[indices[14]], table[indices[15]]);
+            }
+
+            static inline __m512 add(const __m512 a, const __m512 b) { return _mm512_add_ps(a, b); }
+            static inline __m512 subtract(const __m512 a, const __m512 b) { return _mm512_sub_ps(a, b); }
+            static inline __m512 multiply(const __m512 a, const __m512 b) { return _mm512_mul_ps(a, b); }
+            static inline __m512 absolute(const __m512 a) { return _mm512_abs_ps(a); }
+            static inline int less(const __m512 a, const __m512 b) { return (int)_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        };
+#endif
+
+#ifdef GEOMETRY_AVX_FRUSTUM
+        template<> struct FrustumLanes<8>
+        {
+            typedef __m256 Register;
+
+            static const int ALL = 0xFF;
+
+            static inline __m256 set(const float value) { return _mm256_set1_ps(value); }
+            static inline __m256 load(const float * values) { return _mm256_loadu_ps(values); }
+            static inline __m256 gather(const float * values, const size_t stride) { return _mm256_setr_ps(values[0], values[1 * stride], values[2 * stride], values[3 * stride], values[4 * stride], values[5 * stride], values[6 * stride], values[7 * stride]); }
+            static inline __m256 lookup(const float * table, const uint8bit * indices) { return _mm256_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]], table[indices[4]], table[indices[5]], table[indices[6]], table[indices[7]]); }
+            static inline __m256 add(const __m256 a, const __m256 b) { return _mm256_add_ps(a, b); }
+            static inline __m256 subtract(const __m256 a, const __m256 b) { return _mm256_sub_ps(a, b); }
+            static inline __m256 multiply(const __m256 a, const __m256 b) { return _mm256_mul_ps(a, b); }
+            static inline __m256 absolute(const __m256 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+            static inline int less(const __m256 a, const __m256 b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+        };
+#endif
+
+#ifdef GEOMETRY_SSE_FRUSTUM
+        template<> struct FrustumLanes<4>
+        {
+            typedef __m128 Register;
+
+            static const int ALL = 0xF;
+
+            static inline __m128 set(const float value) { return _mm_set1_ps(value); }
+            static inline __m128 load(const float * values) { return _mm_loadu_ps(values); }
+            static inline __m128 gather(const float * values, const size_t stride) { return _mm_setr_ps(values[0], values[1 * stride], values[2 * stride], values[3 * stride]); }
+            static inline __m128 lookup(const float * table, const uint8bit * indices) { return _mm_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]]); }
+            static inline __m128 add(const __m128 a, const __m128 b) { return _mm_add_ps(a, b); }
+            static inline __m128 subtract(const __m128 a, const __m128 b) { return _mm_sub_ps(a, b); }
+            static inline __m128 multiply(const __m128 a, const __m128 b) { return _mm_mul_ps(a, b); }
+            static inline __m128 absolute(const __m128 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+            static inline int less(const __m128 a, const __m128 b) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+        };
+#endif
+
+        // Tests the objects from first on in groups of as many as the
+        // register holds and leaves first at the start of the remainder
+        template<bool Boxes, uint32bit LANES> void Frustum3F::testGroups(const Vector3F * centres, const float * radii, const AxisBox3F * boxes, uint8bit * results, const size_t count, uint8bit * lastPlanes, size_t & first, size_t & passed) const
+        {
+            typedef FrustumLanes<LANES> Lanes;
+            typedef typename Lanes::Register Register;
+
+            // The coordinates of neighbouring objects lie this many floats apart
+            const size_t BOX_STRIDE = sizeof(AxisBox3F) / sizeof(float);
+            const size_t CENTRE_STRIDE = sizeof(Vector3F) / sizeof(float);
+
+            const Register zero = Lanes::set(0.0f);
+            const Register half = Lanes::set(0.5f);
+
+            size_t i = first;
+
+            for (; i + LANES <= count; i += LANES) {
+                Register x, y, z, sizeX, sizeY, sizeZ;
+
+                if (Boxes) {
+                    const float * minimal = &boxes[i].minimum.x;
+                    const float * maximal = &boxes[i].maximum.x;
+
+                    const Register minimalX = Lanes::gather(minimal, BOX_STRIDE), maximalX = Lanes::gather(maximal, BOX_STRIDE);
+                    const Register minimalY = Lanes::gather(minimal + 1, BOX_STRIDE), maximalY = Lanes::gather(maximal + 1, BOX_STRIDE);
+                    const Register minimalZ = Lanes::gather(minimal + 2, BOX_STRIDE), maximalZ = Lanes::gather(maximal + 2, BOX_STRIDE);
+
+                    x = Lanes::multiply(Lanes::add(minimalX, maximalX), half);
+                    y = Lanes::multiply(Lanes::add(minimalY, maximalY), half);
+                    z = Lanes::multiply(Lanes::add(minimalZ, maximalZ), half);
+                    sizeX = Lanes::multiply(Lanes::subtract(maximalX, minimalX), half);
+                    sizeY = Lanes::multiply(Lanes::subtract(maximalY, minimalY), half);
+                    sizeZ = Lanes::multiply(Lanes::subtract(maximalZ, minimalZ), half);
+                }
+                else {
+                    const float * centre = &centres[i].x;
+
+                    x = Lanes::gather(centre, CENTRE_STRIDE);
+                    y = Lanes::gather(centre + 1, CENTRE_STRIDE);
+                    z = Lanes::gather(centre + 2, CENTRE_STRIDE);
+                    sizeX = Lanes::load(radii + i);
+                    sizeY = sizeX;
+                    sizeZ = sizeX;
+                }
+
+                if (lastPlanes != 0) {
+                    const uint8bit * first = lastPlanes + i;
+
+                    const Register normalX = Lanes::lookup(this->planeX, first);
+                    const Register normalY = Lanes::lookup(this->planeY, first);
+                    const Register normalZ = Lanes::lookup(this->planeZ, first);
+
+                    const Register distance = Lanes::add(Lanes::add(Lanes::multiply(normalX, x), Lanes::multiply(normalY, y)), Lanes::add(Lanes::multiply(normalZ, z), Lanes::lookup(this->planeDistance, first)));
+                    const Register extent = Boxes
+                        ? Lanes::add(Lanes::add(Lanes::multiply(Lanes::absolute(normalX), sizeX), Lanes::multiply(Lanes::absolute(normalY), sizeY)), Lanes::multiply(Lanes::absolute(normalZ), sizeZ))
+                        : sizeX;
+
+                    if (Lanes::less(distance, Lanes::subtract(zero, extent)) == Lanes::ALL) {
+                        memset(results + i, OUTSIDE, LANES);
+                        continue;
+                    }
+                }
+
+                int outsideMasks[PLANE_COUNT] = { 0, 0, 0, 0, 0, 0 };
+                int outside = 0;
+                int crossing = 0;
+
+                for (uint32bit plane = 0; plane < PLANE_COUNT && outside != Lanes::ALL; plane++) {
+                    const Register distance = Lanes::add(
+                        Lanes::add(Lanes::multiply(Lanes::set(this->planeX[plane]), x), Lanes::multiply(Lanes::set(this->planeY[plane]), y)),
+                        Lanes::add(Lanes::multiply(Lanes::set(this->planeZ[plane]), z), Lanes::set(this->planeDistance[plane])));
+
+                    const Register extent = Boxes
+                        ? Lanes::add(Lanes::add(Lanes::multiply(Lanes::set(this->absoluteX[plane]), sizeX), Lanes::multiply(Lanes::set(this->absoluteY[plane]), sizeY)), Lanes::multiply(Lanes::set(this->absoluteZ[plane]), sizeZ))
+                        : sizeX;
+
+                    outsideMasks[plane] = Lanes::less(distance, Lanes::subtract(zero, extent));
+                    outside |= outsideMasks[plane];
+                    crossing |= Lanes::less(distance, extent);
+                }
+
+                for (uint32bit lane = 0; lane < LANES; lane++) {
+                    const int bit = 1 << lane;
+
+                    if ((outside & bit) == 0) {
+                        results[i + lane] = (crossing & bit) != 0 ? INTERSECTS : INSIDE;
+                        passed++;
+                        continue;
+                    }
+
+                    results[i + lane] = OUTSIDE;
+
+                    if (lastPlanes != 0) {
+                        uint8bit plane = 0;
+
+                        while ((outsideMasks[plane] & bit) == 0) {
+                            plane++;
+                        }
+
+                        lastPlanes[i + lane] = plane;
+                    }
+                }
+            }
+
+            first = i;
+        }
+
+        // Spheres have the same extent towards every plane, the extent of
+        // a box is the projection of its half size onto the plane normal.
+        // The widest register available takes the bulk, the narrower ones
+        // and the scalar loop the rest.
+        template<bool Boxes> void Frustum3F::testLanes(const Vector3F * centres, const float * radii, const AxisBox3F * boxes, uint8bit * results, const size_t count, uint8bit * lastPlanes, size_t & passed) const
+        {
+            size_t i = 0;
+
+#ifdef GEOMETRY_AVX512_FRUSTUM
+            this->testGroups<Boxes, 16>(centres, radii, boxes, results, count, lastPlanes, i, passed);
+#endif
+
+#ifdef GEOMETRY_AVX_FRUSTUM
+            this->testGroups<Boxes, 8>(centres, radii, boxes, results, count, lastPlanes, i, passed);
+#endif
+
+#ifdef GEOMETRY_SSE_FRUSTUM
+            this->testGroups<Boxes, 4>(centres, radii, boxes, results, count, lastPlanes, i, passed);
+#endif
+
+            for (; i < count; i++) {
+                Vector3F centre, size;
+
+                if (Boxes) {
+                    centre = boxes[i].getCentre();
+                    size = boxes[i].getHalfSize();
+                }
+                else {
+                    centre = centres[i];
+                    size.setValues(radii[i], radii[i], radii[i]);
+                }
+
+                const uint32bit first = lastPlanes != 0 ? lastPlanes[i] : 0;
+
+                uint8bit result = INSIDE;
+
+                for (uint32bit step = 0; step < PLANE_COUNT; step++) {
+                    const uint32bit plane = first + step < PLANE_COUNT ? first + step : first + step - PLANE_COUNT;
+
+                    const float distance = this->getDistance(plane, centre);
+                    const float extent = Boxes
+                        ? this->absoluteX[plane] * size.x + this->absoluteY[plane] * size.y + this->absoluteZ[plane] * size.z
+                        : size.x;
+
+                    if (distance < -extent) {
+                        result = OUTSIDE;
+
+                        if (lastPlanes != 0) {
+                            lastPlanes[i] = (uint8bit)plane;
+                        }
+
+                        break;
+                    }
+
+                    if (distance < extent) {
+                        result = INTERSECTS;
+                    }
+                }
+
+                results[i] = result;
+                passed += result != OUTSIDE ? 1 : 0;
+            }
+        }
+
+        size_t Frustum3F::testSpheres(const Vector3F * centres, const float * radii, uint8bit * results, const size_t count, uint8bit * lastPlanes, const uint32bit threadCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("frustum.spheres");
+
+            std::atomic<size_t> passed(0);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                size_t localPassed = 0;
+                this->testLanes<false>(centres + first, radii + first, 0, results + first, last - first, lastPlanes != 0 ? lastPlanes + first : 0, localPassed);
+                passed += localPassed;
+            }, threadCount);
+
+            return passed;
+        }
+
+        size_t Frustum3F::testBoxes(const AxisBox3F * boxes, uint8bit * results, const size_t count, uint8bit * lastPlanes, const uint32bit threadCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("frustum.boxes");
+
+            std::atomic<size_t> passed(0);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                size_t localPassed = 0;
+                this->testLanes<true>(0, 0, boxes + first, results + first, last - first, lastPlanes != 0 ? lastPlanes + first : 0, localPassed);
+                passed += localPassed;
+            }, threadCount);
+
+            return passed;
+        }
+
+        // ====================== Hierarchy ====================== //
+
+        size_t Frustum3F::cullTree(const FrustumNode3F * nodes, const uint32bit * items, const AxisBox3F * itemBoxes, uint8bit * results, const size_t itemCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("frustum.tree");
+
+            memset(results, OUTSIDE, itemCount);
+
+            size_t passed = 0;
+            this->cullNode(nodes, 0, ALL_PLANES, items, itemBoxes, results, passed);
+
+            return passed;
+        }
+
+        void Frustum3F::cullNode(const FrustumNode3F * nodes, const uint32bit node, const uint8bit planeMask, const uint32bit * items, const AxisBox3F * itemBoxes, uint8bit * results, size_t & passed) const
+        {
+            const FrustumNode3F & current = nodes[node];
+
+            uint8bit remainingPlanes = planeMask;
+            const uint8bit result = this->testBox(current.box, remainingPlanes);
+
+            if (result == OUTSIDE) {
+                return;
+            }
+
+            if (result == INSIDE) {
+                this->markNode(nodes, node, items, results, passed);
+                return;
+            }
+
+            for (uint32bit i = 0; i < current.itemCount; i++) {
+                const uint32bit item = items[current.firstItem + i];
+
+                uint8bit itemPlanes = remainingPlanes;
+                results[item] = this->testBox(itemBoxes[item], itemPlanes);
+                passed += results[item] != OUTSIDE ? 1 : 0;
+            }
+
+            for (uint32bit i = 0; i < current.childCount; i++) {
+                this->cullNode(nodes, current.firstChild + i, remainingPlanes, items, itemBoxes, results, passed);
+            }
+        }
+
+        void Frustum3F::markNode(const FrustumNode3F * nodes, const uint32bit node, const uint32bit * items, uint8bit * results, size_t & passed) const
+        {
+            const FrustumNode3F & current = nodes[node];
+
+            for (uint32bit i = 0; i < current.itemCount; i++) {
+                results[items[current.firstItem + i]] = INSIDE;
+            }
+
+            passed += current.itemCount;
+
+            for (uint32bit i = 0; i < current.childCount; i++) {
+                this->markNode(nodes, current.firstChild + i, items, results, passed);
+            }
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_FRUSTUM3F_H_
+#define _GEOMETRY_STEREOMETRY_FRUSTUM3F_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "../Matrix.h"
+#include "AxisBox3.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // A node of a bounding volume hierarchy built by the caller. The
+        // children of an inner node are nodes[firstChild] to
+        // nodes[firstChild + childCount - 1], the items of a node are
+        // items[firstItem] to items[firstItem + itemCount - 1], a node may
+        // have both. The box of a node must contain the boxes of its
+        // children and its items.
+        struct FrustumNode3F
+        {
+            AxisBox3F box;
+            uint32bit firstChild;
+            uint32bit childCount;
+            uint32bit firstItem;
+            uint32bit itemCount;
+        };
+
+        // ======================= Frustum header ======================= //
+
+        // The six planes of the volume seen through a view-projection
+        // matrix of the clip convention of Projection3F.h, extracted from
+        // its rows. A point p is on the inner side of plane i when
+        // planeX[i] * p.x + planeY[i] * p.y + planeZ[i] * p.z + planeDistance[i] >= 0,
+        // the normals are of unit length so the value is the distance.
+        //
+        // The batch tests take the objects sixteen, eight or four at a time
+        // in AVX-512, AVX or SSE lanes, whichever the build targets. With
+        // lastPlanes given, the plane an object was rejected by is tested
+        // first the next time, an object that stays outside costs one plane.
+        class Frustum3F
+        {
+        public:
+            static const uint32bit LEFT_PLANE = 0;
+            static const uint32bit RIGHT_PLANE = 1;
+            static const uint32bit BOTTOM_PLANE = 2;
+            static const uint32bit TOP_PLANE = 3;
+            static const uint32bit NEAR_PLANE = 4;
+            static const uint32bit FAR_PLANE = 5;
+
+            static const uint32bit PLANE_COUNT = 6;
+            static const uint8bit ALL_PLANES = 0x3F;
+
+            static const uint8bit OUTSIDE = 0;
+            static const uint8bit INTERSECTS = 1;
+            static const uint8bit INSIDE = 2;
+
+            float planeX[PLANE_COUNT];
+            float planeY[PLANE_COUNT];
+            float planeZ[PLANE_COUNT];
+            float planeDistance[PLANE_COUNT];
+
+            Frustum3F();
+            explicit Frustum3F(const Matrix4x4F & viewProjection);
+
+            void setViewProjection(const Matrix4x4F & viewProjection);
+
+            inline float getDistance(const uint32bit plane, const Vector3F & point) const;
+
+            inline uint8bit testSphere(const Vector3F & centre, const float radius) const;
+            inline uint8bit testBox(const AxisBox3F & box) const;
+
+            // Tests the planes of planeMask only and removes from it the
+            // planes the box is entirely inside of, so the contents of the
+            // box need to be tested against the remaining ones only
+            inline uint8bit testBox(const AxisBox3F & box, uint8bit & planeMask) const;
+
+            // Write OUTSIDE, INTERSECTS or INSIDE for every object and
+            // return the number of the objects not outside. lastPlanes may
+            // be 0, otherwise it holds a plane index for every object: the
+            // plane to start with, replaced for the rejected objects.
+            size_t testSpheres(const Vector3F * centres, const float * radii, uint8bit * results, const size_t count, uint8bit * lastPlanes = 0, const uint32bit threadCount = 0) const;
+            size_t testBoxes(const AxisBox3F * boxes, uint8bit * results, const size_t count, uint8bit * lastPlanes = 0, const uint32bit threadCount = 0) const;
+
+            // Writes a result for every item of itemBoxes, walking the
+            // hierarchy from nodes[0]: the subtrees outside are skipped, the
+            // ones inside are marked without tests and only the planes a
+            // node crosses are tested for its contents
+            size_t cullTree(const FrustumNode3F * nodes, const uint32bit * items, const AxisBox3F * itemBoxes, uint8bit * results, const size_t itemCount) const;
+
+        private:
+            float absoluteX[PLANE_COUNT];
+            float absoluteY[PLANE_COUNT];
+            float absoluteZ[PLANE_COUNT];
+
+            template<bool Boxes, uint32bit LANES> void testGroups(const Vector3F * centres, const float * radii, const AxisBox3F * boxes, uint8bit * results, const size_t count, uint8bit * lastPlanes, size_t & first, size_t & passed) const;
+            template<bool Boxes> void testLanes(const Vector3F * centres, const float * radii, const AxisBox3F * boxes, uint8bit * results, const size_t count, uint8bit * lastPlanes, size_t & passed) const;
+
+            void cullNode(const FrustumNode3F * nodes, const uint32bit node, const uint8bit planeMask, const uint32bit * items, const AxisBox3F * itemBoxes, uint8bit * results, size_t & passed) const;
+            void markNode(const FrustumNode3F * nodes, const uint32bit node, const uint32bit * items, uint8bit * results, size_t & passed) const;
+        };
+
+        // =================== Frustum inline methods =================== //
+
+        float Frustum3F::getDistance(const uint32bit plane, const Vector3F & point) const
+        {
+            return this->planeX[plane] * point.x + this->planeY[plane] * point.y + this->planeZ[plane] * point.z + this->planeDistance[plane];
+        }
+
+        uint8bit Frustum3F::testSphere(const Vector3F & centre, const float radius) const
+        {
+            uint8bit result = INSIDE;
+
+            for (uint32bit plane = 0; plane < PLANE_COUNT; plane++) {
+                const float distance = this->getDistance(plane, centre);
+
+                if (distance < -radius) {
+                    return OUTSIDE;
+                }
+
+                if (distance < radius) {
+                    result = INTERSECTS;
+                }
+            }
+
+            return result;
+        }
+
+        uint8bit Frustum3F::testBox(const AxisBox3F & box) const
+        {
+            uint8bit planeMask = ALL_PLANES;
+            return this->testBox(box, planeMask);
+        }
+
+        uint8bit Frustum3F::testBox(const AxisBox3F & box, uint8bit & planeMask) const
+        {
+            const Vector3F centre = box.getCentre();
+            const Vector3F halfSize = box.getHalfSize();
+
+            for (uint32bit plane = 0; plane < PLANE_COUNT; plane++) {
+                if ((planeMask & (1 << plane)) == 0) {
+                    continue;
+                }
+
+                const float distance = this->getDistance(plane, centre);
+                const float extent = this->absoluteX[plane] * halfSize.x + this->absoluteY[plane] * halfSize.y + this->absoluteZ[plane] * halfSize.z;
+
+                if (distance < -extent) {
+                    return OUTSIDE;
+                }
+
+                if (distance >= extent) {
+                    planeMask &= (uint8bit)~(1 << plane);
+                }
+            }
+
+            return planeMask == 0 ? INSIDE : INTERSECTS;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_FRUSTUM3F_H_ */
@@ -0,0 +1,837 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Gjk3.h"
+
+#include <math.h>
+
+#include <atomic>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Tolerances relative to the size of the Minkowski difference
+        template<typename FloatType> struct GjkTolerance;
+
+        template<> struct GjkTolerance<float>
+        {
+            static inline float distance() { return 1E-5f; }
+            static inline float depth() { return 1E-4f; }
+        };
+
+        template<> struct GjkTolerance<double>
+        {
+            static inline double distance() { return 1E-10; }
+            static inline double depth() { return 1E-8; }
+        };
+
+        static const uint32bit GJK_ITERATION_LIMIT = 64;
+        static const uint32bit EPA_ITERATION_LIMIT = 64;
+        static const uint32bit EPA_VERTEX_LIMIT = EPA_ITERATION_LIMIT + 4;
+        static const uint32bit EPA_FACE_LIMIT = 256;
+        static const uint32bit EPA_EDGE_LIMIT = 128;
+
+        // A point w = a - b of the Minkowski difference with the support
+        // points of the shapes and the direction they were found in
+        template<class VectorType> struct SupportVertex
+        {
+            VectorType a;
+            VectorType b;
+            VectorType w;
+            VectorType direction;
+        };
+
+        template<typename FloatType, class VectorType> struct Simplex
+        {
+            SupportVertex<VectorType> vertices[4];
+            FloatType weights[4];
+            uint32bit count;
+        };
+
+        // GJK and EPA both run on the cores, the radii are added to the results
+        template<typename FloatType, class VectorType> static inline SupportVertex<VectorType> getSupportVertex(const ConvexShape3Template<FloatType, VectorType> & shapeA, const ConvexShape3Template<FloatType, VectorType> & shapeB, const VectorType & direction)
+        {
+            const VectorType opposite = direction * (-1);
+
+            SupportVertex<VectorType> vertex;
+
+            vertex.a = shapeA.getCoreSupport(direction);
+            vertex.b = shapeB.getCoreSupport(opposite);
+            vertex.w = vertex.a - vertex.b;
+            vertex.direction = direction;
+
+            return vertex;
+        }
+
+        // ====================== Closest points ====================== //
+
+        template<typename FloatType, class VectorType> static inline void setVertex(const SupportVertex<VectorType> & vertex, Simplex<FloatType, VectorType> & result)
+        {
+            result.vertices[0] = vertex;
+            result.weights[0] = 1;
+            result.count = 1;
+        }
+
+        template<typename FloatType, class VectorType> static inline void setEdge(const SupportVertex<VectorType> & a, const SupportVertex<VectorType> & b, const FloatType ratio, Simplex<FloatType, VectorType> & result)
+        {
+            result.vertices[0] = a;
+            result.vertices[1] = b;
+            result.weights[0] = 1 - ratio;
+            result.weights[1] = ratio;
+            result.count = 2;
+        }
+
+        template<typename FloatType, class VectorType> static inline VectorType getClosest(const Simplex<FloatType, VectorType> & simplex)
+        {
+            VectorType closest = simplex.vertices[0].w * simplex.weights[0];
+
+            for (uint32bit i = 1; i < simplex.count; i++) {
+                closest += simplex.vertices[i].w * simplex.weights[i];
+            }
+
+            return closest;
+        }
+
+        // The closest points to the origin on the segment, the triangle and
+        // the tetrahedron by their Voronoi regions, result keeps the
+        // vertices of the region with the barycentric weights of the point
+        template<typename FloatType, class VectorType> static void solveSegment(const SupportVertex<VectorType> & a, const SupportVertex<VectorType> & b, Simplex<FloatType, VectorType> & result)
+        {
+            const VectorType ab = b.w - a.w;
+
+            const FloatType projection = -a.w.scalar(ab);
+            const FloatType squareLength = ab.scalar(ab);
+
+            if (projection <= 0 || squareLength <= 0) {
+                setVertex(a, result);
+            }
+            else if (projection >= squareLength) {
+                setVertex(b, result);
+            }
+            else {
+                setEdge(a, b, projection / squareLength, result);
+            }
+        }
+
+        template<typename FloatType, class VectorType> static void solveTriangle(const SupportVertex<VectorType> & a, const SupportVertex<VectorType> & b, const SupportVertex<VectorType> & c, Simplex<FloatType, VectorType> & result)
+        {
+            const VectorType ab = b.w - a.w;
+            const VectorType ac = c.w - a.w;
+
+            const FloatType d1 = -ab.scalar(a.w);
+            const FloatType d2 = -ac.scalar(a.w);
+
+            if (d1 <= 0 && d2 <= 0) {
+                setVertex(a, result);
+                return;
+            }
+
+            const FloatType d3 = -ab.scalar(b.w);
+            const FloatType d4 = -ac.scalar(b.w);
+
+            if (d3 >= 0 && d4 <= d3) {
+                setVertex(b, result);
+                return;
+            }
+
+            const FloatType areaC = d1 * d4 - d3 * d2;
+
+            if (areaC <= 0 && d1 >= 0 && d3 <= 0) {
+                setEdge(a, b, d1 - d3 > 0 ? d1 / (d1 - d3) : FloatType(0), result);
+                return;
+            }
+
+            const FloatType d5 = -ab.scalar(c.w);
+            const FloatType d6 = -ac.scalar(c.w);
+
+            if (d6 >= 0 && d5 <= d6) {
+                setVertex(c, result);
+                return;
+            }
+
+            const FloatType areaB = d5 * d2 - d1 * d6;
+
+            if (areaB <= 0 && d2 >= 0 && d6 <= 0) {
+                setEdge(a, c, d2 - d6 > 0 ? d2 / (d2 - d6) : FloatType(0), result);
+                return;
+            }
+
+            const FloatType areaA = d3 * d6 - d5 * d4;
+
+            if (areaA <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+                const FloatType sum = (d4 - d3) + (d5 - d6);
+                setEdge(b, c, sum > 0 ? (d4 - d3) / sum : FloatType(0), result);
+                return;
+            }
+
+            const FloatType area = areaA + areaB + areaC;
+
+            if (!(area > 0)) {
+                // A degenerate triangle, the nearest of its edges
+                Simplex<FloatType, VectorType> edge;
+                solveSegment(a, b, result);
+                FloatType best = getClosest(result).scalar(getClosest(result));
+
+                solveSegment(a, c, edge);
+                const FloatType distanceAC = getClosest(edge).scalar(getClosest(edge));
+
+                if (distanceAC < best) {
+                    result = edge;
+                    best = distanceAC;
+                }
+
+                solveSegment(b, c, edge);
+
+                if (getClosest(edge).scalar(getClosest(edge)) < best) {
+                    result = edge;
+                }
+
+                return;
+            }
+
+            result.vertices[0] = a;
+            result.vertices[1] = b;
+            result.vertices[2] = c;
+            result.weights[1] = areaB / area;
+            result.weights[2] = areaC / area;
+            result.weights[0] = 1 - result.weights[1] - result.weights[2];
+            result.count = 3;
+        }
+
+        // Returns true when the origin is inside the tetrahedron
+        template<typename FloatType, class VectorType> static bool solveTetrahedron(const Simplex<FloatType, VectorType> & simplex, Simplex<FloatType, VectorType> & result)
+        {
+            static const uint32bit FACES[4][4] = {
+                { 0, 1, 2, 3 },
+                { 0, 2, 3, 1 },
+                { 0, 3, 1, 2 },
+                { 1, 3, 2, 0 }
+            };
+
+            bool found = false;
+            FloatType best = 0;
+
+            for (uint32bit face = 0; face < 4; face++) {
+                const SupportVertex<VectorType> & p = simplex.vertices[FACES[face][0]];
+                const SupportVertex<VectorType> & q = simplex.vertices[FACES[face][1]];
+                const SupportVertex<VectorType> & r = simplex.vertices[FACES[face][2]];
+                const SupportVertex<VectorType> & opposite = simplex.vertices[FACES[face][3]];
+
+                const VectorType normal = (q.w - p.w).vector(r.w - p.w);
+
+                const FloatType originSide = -normal.scalar(p.w);
+                const FloatType oppositeSide = normal.scalar(opposite.w - p.w);
+
+                // A flat tetrahedron has every face checked
+                if (oppositeSide != 0 && originSide * oppositeSide >= 0) {
+                    continue;
+                }
+
+                Simplex<FloatType, VectorType> candidate;
+                solveTriangle(p, q, r, candidate);
+
+                const VectorType closest = getClosest(candidate);
+                const FloatType squareDistance = closest.scalar(closest);
+
+                if (!found || squareDistance < best) {
+                    result = candidate;
+                    best = squareDistance;
+                    found = true;
+                }
+            }
+
+            if (!found) {
+                result = simplex;
+                return true;
+            }
+
+            return false;
+        }
+
+        template<typename FloatType, class VectorType> static bool solveSimplex(Simplex<FloatType, VectorType> & simplex)
+        {
+            Simplex<FloatType, VectorType> result;
+
+            switch (simplex.count) {
+                case 1:
+                    simplex.weights[0] = 1;
+                    return false;
+
+                case 2:
+                    solveSegment(simplex.vertices[0], simplex.vertices[1], result);
+                    break;
+
+                case 3:
+                    solveTriangle(simplex.vertices[0], simplex.vertices[1], simplex.vertices[2], result);
+                    break;
+
+                default:
+                    if (solveTetrahedron(simplex, result)) {
+                        return true;
+                    }
+            }
+
+            simplex = result;
+
+            return false;
+        }
+
+        // =========================== GJK =========================== //
+
+        template<class VectorType> static inline bool containsPoint(const SupportVertex<VectorType> * vertices, const uint32bit count, const VectorType & w)
+        {
+            for (uint32bit i = 0; i < count; i++) {
+                if (vertices[i].w.x == w.x && vertices[i].w.y == w.y && vertices[i].w.z == w.z) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Runs on the cores of the shapes, returns true when they intersect
+        // or touch, otherwise simplex holds the closest point
+        template<typename FloatType, class VectorType> static bool runGjk(const ConvexShape3Template<FloatType, VectorType> & shapeA, const ConvexShape3Template<FloatType, VectorType> & shapeB, const GjkCache3Template<FloatType, VectorType> * cache, Simplex<FloatType, VectorType> & simplex, uint32bit & iterations)
+        {
+            const FloatType tolerance = GjkTolerance<FloatType>::distance();
+
+            simplex.count = 0;
+            iterations = 0;
+
+            if (cache != 0) {
+                for (uint32bit i = 0; i < cache->count; i++) {
+                    const SupportVertex<VectorType> vertex = getSupportVertex(shapeA, shapeB, cache->directions[i]);
+
+                    if (!containsPoint(simplex.vertices, simplex.count, vertex.w)) {
+                        simplex.vertices[simplex.count++] = vertex;
+                    }
+                }
+            }
+
+            if (simplex.count == 0) {
+                VectorType direction = shapeB.getInnerPoint() - shapeA.getInnerPoint();
+
+                if (direction.scalar(direction) == 0) {
+                    direction.setValues(1, 0, 0);
+                }
+
+                simplex.vertices[0] = getSupportVertex(shapeA, shapeB, direction);
+                simplex.count = 1;
+            }
+
+            if (solveSimplex(simplex)) {
+                return true;
+            }
+
+            for (; iterations < GJK_ITERATION_LIMIT; iterations++) {
+                const VectorType closest = getClosest(simplex);
+                const FloatType squareDistance = closest.scalar(closest);
+
+                FloatType squareSize = 0;
+
+                for (uint32bit i = 0; i < simplex.count; i++) {
+                    const FloatType square = simplex.vertices[i].w.scalar(simplex.vertices[i].w);
+                    squareSize = square > squareSize ? square : squareSize;
+                }
+
+                if (squareDistance <= tolerance * tolerance * squareSize) {
+                    return true;
+                }
+
+                const SupportVertex<VectorType> vertex = getSupportVertex(shapeA, shapeB, closest * (-1));
+
+                // No point of the difference is much nearer to the origin
+                if (squareDistance - closest.scalar(vertex.w) <= tolerance * squareDistance) {
+                    return false;
+                }
+
+                if (containsPoint(simplex.vertices, simplex.count, vertex.w)) {
+                    return false;
+                }
+
+                const Simplex<FloatType, VectorType> previous = simplex;
+
+                simplex.vertices[simplex.count++] = vertex;
+
+                if (solveSimplex(simplex)) {
+                    return true;
+                }
+
+                // Rounding may stop the progress near the answer
+                const VectorType next = getClosest(simplex);
+
+                if (next.scalar(next) >= squareDistance) {
+                    simplex = previous;
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        // =========================== EPA =========================== //
+
+        template<typename FloatType, class VectorType> struct EpaFace
+        {
+            uint32bit indices[3];
+            VectorType normal;
+            FloatType distance;
+        };
+
+        template<typename FloatType, class VectorType> static bool makeFace(const SupportVertex<VectorType> * vertices, const uint32bit a, const uint32bit b, const uint32bit c, EpaFace<FloatType, VectorType> & face)
+        {
+            VectorType normal = (vertices[b].w - vertices[a].w).vector(vertices[c].w - vertices[a].w);
+
+            if (!normal.normalize()) {
+                return false;
+            }
+
+            face.indices[0] = a;
+            face.indices[1] = b;
+            face.indices[2] = c;
+            face.normal = normal;
+            face.distance = normal.scalar(vertices[a].w);
+
+            return true;
+        }
+
+        // Grows the simplex to a tetrahedron with the support points of
+        // directions across it
+        template<typename FloatType, class VectorType> static bool completeTetrahedron(const ConvexShape3Template<FloatType, VectorType> & shapeA, const ConvexShape3Template<FloatType, VectorType> & shapeB, SupportVertex<VectorType> * vertices, uint32bit & count, const FloatType squareScale)
+        {
+            const FloatType tolerance = GjkTolerance<FloatType>::depth();
+            const FloatType squareTolerance = tolerance * tolerance * squareScale;
+
+            if (count == 1) {
+                for (uint32bit axis = 0; axis < 6 && count == 1; axis++) {
+                    VectorType direction(0, 0, 0);
+
+                    if (axis / 2 == 0) {
+                        direction.x = axis % 2 == 0 ? 1 : -1;
+                    }
+                    else if (axis / 2 == 1) {
+                        direction.y = axis % 2 == 0 ? 1 : -1;
+                    }
+                    else {
+                        direction.z = axis % 2 == 0 ? 1 : -1;
+                    }
+
+                    const SupportVertex<VectorType> vertex = getSupportVertex(shapeA, shapeB, direction);
+                    const VectorType offset = vertex.w - vertices[0].w;
+
+                    if (offset.scalar(offset) > squareTolerance) {
+                        vertices[count++] = vertex;
+                    }
+                }
+            }
+
+            if (count == 2) {
+                const VectorType edge = vertices[1].w - vertices[0].w;
+
+                // The axis least parallel to the edge gives a perpendicular
+                VectorType axis(1, 0, 0);
+
+                if (fabs(edge.y) <= fabs(edge.x) && fabs(edge.y) <= fabs(edge.z)) {
+                    axis.setValues(0, 1, 0);
+                }
+                else if (fabs(edge.z) <= fabs(edge.x) && fabs(edge.z) <= fabs(edge.y)) {
+                    axis.setValues(0, 0, 1);
+                }
+
+                const VectorType first = edge.vector(axis);
+                const VectorType second = edge.vector(first);
+                const VectorType directions[4] = { first, first * (-1), second, second * (-1) };
+
+                for (uint32bit i = 0; i < 4 && count == 2; i++) {
+                    const SupportVertex<VectorType> vertex = getSupportVertex(shapeA, shapeB, directions[i]);
+                    const VectorType area = edge.vector(vertex.w - vertices[0].w);
+
+                    if (area.scalar(area) > squareTolerance * squareScale) {
+                        vertices[count++] = vertex;
+                    }
+                }
+            }
+
+            if (count == 3) {
+                VectorType normal = (vertices[1].w - vertices[0].w).vector(vertices[2].w - vertices[0].w);
+
+                if (!normal.normalize()) {
+                    return false;
+                }
+
+                for (uint32bit i = 0; i < 2 && count == 3; i++) {
+                    const VectorType direction = i == 0 ? normal : normal * (-1);
+                    const SupportVertex<VectorType> vertex = getSupportVertex(shapeA, shapeB, direction);
+                    const FloatType height = normal.scalar(vertex.w - vertices[0].w);
+
+                    if (height * height > squareTolerance) {
+                        vertices[count++] = vertex;
+                    }
+                }
+            }
+
+            return count == 4;
+        }
+
+        // The points of the cores the weights of the simplex give, for
+        // intersecting cores a point they share
+        template<typename FloatType, class VectorType> static void getWitnessPoints(const Simplex<FloatType, VectorType> & simplex, VectorType & pointA, VectorType & pointB)
+        {
+            pointA = simplex.vertices[0].a * simplex.weights[0];
+            pointB = simplex.vertices[0].b * simplex.weights[0];
+
+            for (uint32bit i = 1; i < simplex.count; i++) {
+                pointA += simplex.vertices[i].a * simplex.weights[i];
+                pointB += simplex.vertices[i].b * simplex.weights[i];
+            }
+        }
+
+        // The difference of the cores is flat, a polygon, a segment or a
+        // point, and contains the origin: the cores intersect with no depth
+        // across the difference. The normal is across it, towards B when
+        // the direction between the shapes allows.
+        template<typename FloatType, class VectorType> static void setFlatContact(const ConvexShape3Template<FloatType, VectorType> & shapeA, const ConvexShape3Template<FloatType, VectorType> & shapeB, const Simplex<FloatType, VectorType> & simplex, const SupportVertex<VectorType> * vertices, const uint32bit count, ConvexContact3Template<FloatType, VectorType> & contact)
+        {
+            VectorType preferred = shapeB.getInnerPoint() - shapeA.getInnerPoint();
+
+            if (preferred.scalar(preferred) == 0) {
+                preferred.setValues(1, 0, 0);
+            }
+
+            VectorType normal = preferred;
+
+            if (count == 3) {
+                normal = (vertices[1].w - vertices[0].w).vector(vertices[2].w - vertices[0].w);
+
+                if (normal.scalar(preferred) < 0) {
+                    normal = normal * (-1);
+                }
+            }
+            else if (count == 2) {
+                const VectorType edge = vertices[1].w - vertices[0].w;
+                normal = preferred - edge * (preferred.scalar(edge) / edge.scalar(edge));
+
+                // The direction between the shapes is along the segment
+                if (normal.scalar(normal) <= GjkTolerance<FloatType>::depth() * GjkTolerance<FloatType>::depth() * preferred.scalar(preferred)) {
+                    VectorType axis(1, 0, 0);
+
+                    if (fabs(edge.y) <= fabs(edge.x) && fabs(edge.y) <= fabs(edge.z)) {
+                        axis.setValues(0, 1, 0);
+                    }
+                    else if (fabs(edge.z) <= fabs(edge.x) && fabs(edge.z) <= fabs(edge.y)) {
+                        axis.setValues(0, 0, 1);
+                    }
+
+                    normal = edge.vector(axis);
+                }
+            }
+
+            if (!normal.normalize()) {
+                normal.setValues(1, 0, 0);
+            }
+
+            contact.depth = 0;
+            contact.normal = normal;
+
+            if (simplex.count < 4) {
+                getWitnessPoints(simplex, contact.pointA, contact.pointB);
+            }
+            else {
+                contact.pointA = vertices[0].a;
+                contact.pointB = vertices[0].b;
+            }
+        }
+
+        template<typename FloatType, class VectorType> static void runEpa(const ConvexShape3Template<FloatType, VectorType> & shapeA, const ConvexShape3Template<FloatType, VectorType> & shapeB, const Simplex<FloatType, VectorType> & simplex, ConvexContact3Template<FloatType, VectorType> & contact)
+        {
+            SupportVertex<VectorType> vertices[EPA_VERTEX_LIMIT];
+            EpaFace<FloatType, VectorType> faces[EPA_FACE_LIMIT];
+            uint32bit edges[EPA_EDGE_LIMIT][2];
+
+            uint32bit vertexCount = 0;
+            FloatType squareScale = 0;
+
+            for (uint32bit i = 0; i < simplex.count; i++) {
+                const SupportVertex<VectorType> & vertex = simplex.vertices[i];
+
+                if (!containsPoint(vertices, vertexCount, vertex.w)) {
+                    vertices[vertexCount++] = vertex;
+
+                    const FloatType square = vertex.w.scalar(vertex.w);
+                    squareScale = square > squareScale ? square : squareScale;
+                }
+            }
+
+            contact.intersecting = true;
+            contact.distance = 0;
+
+            if (!completeTetrahedron(shapeA, shapeB, vertices, vertexCount, squareScale)) {
+                setFlatContact(shapeA, shapeB, simplex, vertices, vertexCount, contact);
+                return;
+            }
+
+            for (uint32bit i = 0; i < 4; i++) {
+                const FloatType square = vertices[i].w.scalar(vertices[i].w);
+                squareScale = square > squareScale ? square : squareScale;
+            }
+
+            static const uint32bit TETRAHEDRON[4][4] = {
+                { 0, 1, 2, 3 },
+                { 0, 3, 1, 2 },
+                { 0, 2, 3, 1 },
+                { 1, 3, 2, 0 }
+            };
+
+            uint32bit faceCount = 0;
+
+            for (uint32bit i = 0; i < 4; i++) {
+                uint32bit a = TETRAHEDRON[i][0];
+                uint32bit b = TETRAHEDRON[i][1];
+                uint32bit c = TETRAHEDRON[i][2];
+
+                // The normals look away from the fourth vertex
+                const VectorType normal = (vertices[b].w - vertices[a].w).vector(vertices[c].w - vertices[a].w);
+
+                if (normal.scalar(vertices[TETRAHEDRON[i][3]].w - vertices[a].w) > 0) {
+                    const uint32bit swapped = b;
+                    b = c;
+                    c = swapped;
+                }
+
+                if (makeFace(vertices, a, b, c, faces[faceCount])) {
+                    faceCount++;
+                }
+            }
+
+            const FloatType tolerance = GjkTolerance<FloatType>::depth() * sqrt(squareScale);
+
+            uint32bit best = 0;
+
+            for (uint32bit iteration = 0; iteration < EPA_ITERATION_LIMIT && faceCount > 0; iteration++) {
+                best = 0;
+
+                for (uint32bit i = 1; i < faceCount; i++) {
+                    if (faces[i].distance < faces[best].distance) {
+                        best = i;
+                    }
+                }
+
+                const SupportVertex<VectorType> vertex = getSupportVertex(shapeA, shapeB, faces[best].normal);
+
+                if (vertex.w.scalar(faces[best].normal) - faces[best].distance <= tolerance || vertexCount == EPA_VERTEX_LIMIT) {
+                    break;
+                }
+
+                const uint32bit added = vertexCount++;
+                vertices[added] = vertex;
+
+                // The faces seen from the new vertex are removed, their edges
+                // not shared with another removed face are the horizon
+                uint32bit edgeCount = 0;
+                uint32bit kept = 0;
+                bool overflow = false;
+
+                for (uint32bit i = 0; i < faceCount; i++) {
+                    const EpaFace<FloatType, VectorType> & face = faces[i];
+
+                    if (face.normal.scalar(vertex.w - vertices[face.indices[0]].w) <= 0) {
+                        faces[kept++] = face;
+                        continue;
+                    }
+
+                    for (uint32bit k = 0; k < 3; k++) {
+                        const uint32bit from = face.indices[k];
+                        const uint32bit to = face.indices[k == 2 ? 0 : k + 1];
+
+                        uint32bit shared = edgeCount;
+
+                        for (uint32bit e = 0; e < edgeCount; e++) {
+                            if (edges[e][0] == to && edges[e][1] == from) {
+                                shared = e;
+                                break;
+                            }
+                        }
+
+                        if (shared < edgeCount) {
+                            edgeCount--;
+                            edges[shared][0] = edges[edgeCount][0];
+                            edges[shared][1] = edges[edgeCount][1];
+                        }
+                        else if (edgeCount < EPA_EDGE_LIMIT) {
+                            edges[edgeCount][0] = from;
+                            edges[edgeCount][1] = to;
+                            edgeCount++;
+                        }
+                        else {
+                            overflow = true;
+                        }
+                    }
+                }
+
+                faceCount = kept;
+
+                for (uint32bit e = 0; e < edgeCount && faceCount < EPA_FACE_LIMIT; e++) {
+                    if (makeFace(vertices, edges[e][0], edges[e][1], added, faces[faceCount])) {
+                        faceCount++;
+                    }
+                }
+
+                if (overflow || faceCount == EPA_FACE_LIMIT) {
+                    break;
+                }
+            }
+
+            if (faceCount == 0) {
+                setFlatContact(shapeA, shapeB, simplex, vertices, vertexCount, contact);
+                return;
+            }
+
+            best = 0;
+
+            for (uint32bit i = 1; i < faceCount; i++) {
+                if (faces[i].distance < faces[best].distance) {
+                    best = i;
+                }
+            }
+
+            const EpaFace<FloatType, VectorType> & face = faces[best];
+
+            // The barycentric weights of the projection of the origin
+            const SupportVertex<VectorType> & a = vertices[face.indices[0]];
+            const SupportVertex<VectorType> & b = vertices[face.indices[1]];
+            const SupportVertex<VectorType> & c = vertices[face.indices[2]];
+
+            const VectorType ab = b.w - a.w;
+            const VectorType ac = c.w - a.w;
+            const VectorType ap = face.normal * face.distance - a.w;
+
+            const FloatType d00 = ab.scalar(ab);
+            const FloatType d01 = ab.scalar(ac);
+            const FloatType d11 = ac.scalar(ac);
+            const FloatType d20 = ap.scalar(ab);
+            const FloatType d21 = ap.scalar(ac);
+            const FloatType denominator = d00 * d11 - d01 * d01;
+
+            FloatType weightB = 0;
+            FloatType weightC = 0;
+
+            if (denominator != 0) {
+                weightB = (d11 * d20 - d01 * d21) / denominator;
+                weightC = (d00 * d21 - d01 * d20) / denominator;
+            }
+
+            const FloatType weightA = 1 - weightB - weightC;
+
+            contact.depth = face.distance > 0 ? face.distance : 0;
+            contact.normal = face.normal;
+            contact.pointA = a.a * weightA + b.a * weightB + c.a * weightC;
+            contact.pointB = a.b * weightA + b.b * weightB + c.b * weightC;
+        }
+
+        // ========================= Queries ========================= //
+
+        template<typename FloatType, class VectorType> static bool computeContactOf(const ConvexShape3Template<FloatType, VectorType> & shapeA, const ConvexShape3Template<FloatType, VectorType> & shapeB, ConvexContact3Template<FloatType, VectorType> & contact, GjkCache3Template<FloatType, VectorType> * cache)
+        {
+            Simplex<FloatType, VectorType> simplex;
+            uint32bit iterations;
+
+            const bool coresIntersect = runGjk(shapeA, shapeB, cache, simplex, iterations);
+
+            if (cache != 0) {
+                cache->count = simplex.count;
+
+                for (uint32bit i = 0; i < simplex.count; i++) {
+                    cache->directions[i] = simplex.vertices[i].direction;
+                }
+            }
+
+            contact.iterations = iterations;
+
+            if (!coresIntersect) {
+                const VectorType closest = getClosest(simplex);
+                const FloatType coreDistance = closest.module();
+
+                VectorType pointA, pointB;
+                getWitnessPoints(simplex, pointA, pointB);
+
+                const FloatType distance = coreDistance - shapeA.radius - shapeB.radius;
+
+                contact.normal = closest * (-1 / coreDistance);
+                contact.pointA = pointA + contact.normal * shapeA.radius;
+                contact.pointB = pointB - contact.normal * shapeB.radius;
+                contact.intersecting = distance <= 0;
+                contact.distance = distance > 0 ? distance : 0;
+                contact.depth = distance > 0 ? 0 : -distance;
+
+                return contact.intersecting;
+            }
+
+            // The depth of the cores grows by the radii along the normal
+            runEpa(shapeA, shapeB, simplex, contact);
+
+            contact.depth += shapeA.radius + shapeB.radius;
+            contact.pointA += contact.normal * shapeA.radius;
+            contact.pointB -= contact.normal * shapeB.radius;
+
+            return true;
+        }
+
+        bool computeContact(const ConvexShape3F & shapeA, const ConvexShape3F & shapeB, ConvexContact3F & contact, GjkCache3F * cache)
+        {
+            return computeContactOf(shapeA, shapeB, contact, cache);
+        }
+
+        bool computeContact(const ConvexShape3 & shapeA, const ConvexShape3 & shapeB, ConvexContact3 & contact, GjkCache3 * cache)
+        {
+            return computeContactOf(shapeA, shapeB, contact, cache);
+        }
+
+        template<typename FloatType, class VectorType> static size_t computeContactsOf(const ConvexShape3Template<FloatType, VectorType> * shapes, const SweepPair3F * pairs, ConvexContact3Template<FloatType, VectorType> * contacts, GjkCache3Template<FloatType, VectorType> * caches, const size_t count, const uint32bit threadCount)
+        {
+            std::atomic<size_t> intersecting(0);
+
+            parallelFor(0, count, 64, [&](const size_t first, const size_t last) {
+                size_t localIntersecting = 0;
+
+                for (size_t i = first; i < last; i++) {
+                    if (computeContactOf(shapes[pairs[i].first], shapes[pairs[i].second], contacts[i], caches != 0 ? caches + i : 0)) {
+                        localIntersecting++;
+                    }
+                }
+
+                intersecting += localIntersecting;
+            }, threadCount);
+
+            return intersecting;
+        }
+
+        size_t computeContacts(const ConvexShape3F * shapes, const SweepPair3F * pairs, ConvexContact3F * contacts, GjkCache3F * caches, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("gjk.contacts.float");
+            return computeContactsOf(shapes, pairs, contacts, caches, count, threadCount);
+        }
+
+        size_t computeContacts(const ConvexShape3 * shapes, const SweepPair3F * pairs, ConvexContact3 * contacts, GjkCache3 * caches, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("gjk.contacts.double");
+            return computeContactsOf(shapes, pairs, contacts, caches, count, threadCount);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_GJK3_H_
+#define _GEOMETRY_STEREOMETRY_GJK3_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "ConvexShape3.h"
+#include "SweepAndPrune3F.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // The relation of two convex shapes A and B. normal is the unit
+        // direction from A towards B: moving B along it by depth separates
+        // the shapes, moving B against it by distance makes them touch.
+        //
+        // For separated shapes pointA and pointB are the closest points,
+        // for intersecting ones pointA is the point of A deepest inside B
+        // and pointB the point of B deepest inside A.
+        template<typename FloatType, class VectorType> struct ConvexContact3Template
+        {
+            bool intersecting;
+            FloatType distance;
+            FloatType depth;
+            VectorType normal;
+            VectorType pointA;
+            VectorType pointB;
+            uint32bit iterations;
+        };
+
+        typedef ConvexContact3Template<float, Vector3F> ConvexContact3F;
+        typedef ConvexContact3Template<double, Vector3> ConvexContact3;
+
+        // The search directions of the final simplex of a query. A query
+        // given the cache of the previous frame starts from the support
+        // points of these directions, for slowly moving shapes they are
+        // close to the answer.
+        template<typename FloatType, class VectorType> struct GjkCache3Template
+        {
+            VectorType directions[4];
+            uint32bit count;
+
+            GjkCache3Template() : count(0)
+            {
+            }
+        };
+
+        typedef GjkCache3Template<float, Vector3F> GjkCache3F;
+        typedef GjkCache3Template<double, Vector3> GjkCache3;
+
+        // GJK finds the distance between the cores of the shapes, the radii
+        // are subtracted from it. When the cores intersect, EPA expands the
+        // final simplex over the cores to the face of their Minkowski
+        // difference nearest to the origin and the radii are added to its
+        // depth, so spheres and capsules keep exact answers. Returns
+        // contact.intersecting, the cache may be 0.
+        bool computeContact(const ConvexShape3F & shapeA, const ConvexShape3F & shapeB, ConvexContact3F & contact, GjkCache3F * cache = 0);
+        bool computeContact(const ConvexShape3 & shapeA, const ConvexShape3 & shapeB, ConvexContact3 & contact, GjkCache3 * cache = 0);
+
+        // computeContact() for every pair of the shapes, such as the pairs of
+        // a broadphase, on the threads of the shared pool. caches may be 0,
+        // otherwise it has an entry for every pair. Returns the number of
+        // the intersecting pairs.
+        size_t computeContacts(const ConvexShape3F * shapes, const SweepPair3F * pairs, ConvexContact3F * contacts, GjkCache3F * caches, const size_t count, const uint32bit threadCount = 0);
+        size_t computeContacts(const ConvexShape3 * shapes, const SweepPair3F * pairs, ConvexContact3 * contacts, GjkCache3 * caches, const size_t count, const uint32bit threadCount = 0);
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_GJK3_H_ */
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IndexedMesh3F.h"
+
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        IndexedMesh3F::~IndexedMesh3F()
+        {
+        }
+
+        void IndexedMesh3F::getNormals(Vector3F * normals, const uint32bit threadCount) const
+        {
+            parallelFor(0, this->getTriangleCount(), DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    normals[i] = this->getNormal(i);
+                }
+            }, threadCount);
+        }
+
+        void IndexedMesh3F::getNormals(std::vector<Vector3F> & normals, const uint32bit threadCount) const
+        {
+            normals.resize(this->getTriangleCount());
+
+            if (!normals.empty()) {
+                this->getNormals(&normals[0], threadCount);
+            }
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_INDEXED_MESH3F_H_
+#define _GEOMETRY_STEREOMETRY_INDEXED_MESH3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "Vector3.h"
+#include "Triangle3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Triangle mesh with shared vertices: every three consecutive
+        // indices reference the vertices of one triangle.
+        class IndexedMesh3F
+        {
+        public:
+            std::vector<Vector3F> vertices;
+            std::vector<uint32bit> indices;
+
+            inline IndexedMesh3F();
+            virtual ~IndexedMesh3F();
+
+            inline void clear();
+
+            inline size_t getVertexCount() const;
+            inline size_t getTriangleCount() const;
+
+            inline Triangle3F getTriangle(const size_t index) const;
+
+            inline Vector3F getNormal(const size_t index) const;
+
+            // The unit normals of all triangles, computed on the threads of
+            // the shared pool
+            void getNormals(Vector3F * normals, const uint32bit threadCount = 0) const;
+            void getNormals(std::vector<Vector3F> & normals, const uint32bit threadCount = 0) const;
+        };
+
+        IndexedMesh3F::IndexedMesh3F()
+        {
+        }
+
+        void IndexedMesh3F::clear()
+        {
+            this->vertices.clear();
+            this->indices.clear();
+        }
+
+        size_t IndexedMesh3F::getVertexCount() const
+        {
+            return this->vertices.size();
+        }
+
+        size_t IndexedMesh3F::getTriangleCount() const
+        {
+            return this->indices.size() / 3;
+        }
+
+        Triangle3F IndexedMesh3F::getTriangle(const size_t index) const
+        {
+            const uint32bit * triangle = &this->indices[index * 3];
+
+            return Triangle3F(this->vertices[triangle[0]], this->vertices[triangle[1]], this->vertices[triangle[2]]);
+        }
+
+        Vector3F IndexedMesh3F::getNormal(const size_t index) const
+        {
+            const uint32bit * triangle = &this->indices[index * 3];
+
+            const Vector3F & A = this->vertices[triangle[0]];
+
+            Vector3F normal = (this->vertices[triangle[1]] - A).vector(this->vertices[triangle[2]] - A);
+
+            normal.normalize();
+
+            return normal;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_INDEXED_MESH3F_H_ */
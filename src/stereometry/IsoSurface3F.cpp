@@ -0,0 +1,591 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "IsoSurface3F.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // The layers of cells of a slab, thin enough for many slabs and thick
+        // enough that the shared planes are few
+        static const uint32bit SLAB_LAYERS = 8;
+
+        // A single loop through all twelve edges of a cell has ten triangles
+        static const uint32bit MAXIMAL_CASE_TRIANGLES = 10;
+
+        // A vertex of a slab refers to the bottom plane of the next slab or
+        // to the vertices shared by the previous chunk by its order there
+        static const uint32bit NEXT_SLAB_VERTEX = 0x80000000;
+        static const uint32bit SHARED_VERTEX = 0x40000000;
+        static const uint32bit VERTEX_INDEX_MASK = 0x3FFFFFFF;
+
+        static const uint32bit NO_VERTEX = 0xFFFFFFFF;
+
+        // ========================= Case table ========================= //
+
+        // The corner x + 2y + 4z of a cell is inside when its bit is set in
+        // the case. The edge along the axis a is a * 4 plus the other two
+        // coordinates of its corners, the lower axis in the lower bit.
+        struct CaseTable
+        {
+            uint8bit triangleCounts[256];
+            uint8bit edges[256][MAXIMAL_CASE_TRIANGLES * 3];
+        };
+
+        static inline uint32bit getCellEdge(const uint32bit corner, const uint32bit axis)
+        {
+            const uint32bit low = (axis + 1) % 3 < (axis + 2) % 3 ? (axis + 1) % 3 : (axis + 2) % 3;
+            const uint32bit high = 3 - axis - low;
+
+            return axis * 4 + ((corner >> low) & 1) + (((corner >> high) & 1) << 1);
+        }
+
+        // The axis of the edge between two corners of a cell
+        static inline uint32bit getAxis(const uint32bit from, const uint32bit to)
+        {
+            const uint32bit bit = from ^ to;
+
+            return bit == 1 ? 0 : (bit == 2 ? 1 : 2);
+        }
+
+        // The coordinate of an edge of a cell on another axis
+        static inline uint32bit getEdgeCoordinate(const uint32bit edge, const uint32bit axis)
+        {
+            const uint32bit low = edge / 4 == 0 ? 1 : 0;
+
+            return axis == low ? edge & 1 : (edge >> 1) & 1;
+        }
+
+        // Whether two edges of a cell bound one of its faces
+        static inline bool haveCommonFace(const uint32bit first, const uint32bit second)
+        {
+            if (first / 4 == second / 4) {
+                const uint32bit difference = (first ^ second) & 3;
+
+                return difference == 1 || difference == 2;
+            }
+
+            const uint32bit third = 3 - first / 4 - second / 4;
+
+            return getEdgeCoordinate(first, third) == getEdgeCoordinate(second, third);
+        }
+
+        // The surface crosses every face of a cell in segments between its
+        // crossed edges. Walking around a face counterclockwise from outside
+        // the cell, a segment starts where the walk enters the inside corners
+        // and ends where it leaves them, which keeps diagonal inside corners
+        // apart. Every crossed edge starts a segment on one of its faces and
+        // ends one on the other, so the segments close into loops, which are
+        // cut into fans.
+        static CaseTable buildCaseTable()
+        {
+            static const uint32bit FACE_CORNERS[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+            CaseTable table;
+
+            for (uint32bit mask = 0; mask < 256; mask++) {
+                int32bit next[12];
+
+                for (uint32bit edge = 0; edge < 12; edge++) {
+                    next[edge] = -1;
+                }
+
+                for (uint32bit axis = 0; axis < 3; axis++) {
+                    const uint32bit u = (axis + 1) % 3;
+                    const uint32bit v = (axis + 2) % 3;
+
+                    for (uint32bit side = 0; side < 2; side++) {
+                        uint32bit corners[4];
+
+                        // Counterclockwise seen from the positive side of the
+                        // axis, reversed for the negative side
+                        for (uint32bit k = 0; k < 4; k++) {
+                            const uint32bit * position = FACE_CORNERS[side == 1 ? k : 3 - k];
+                            corners[k] = (side << axis) | (position[0] << u) | (position[1] << v);
+                        }
+
+                        for (uint32bit k = 0; k < 4; k++) {
+                            const uint32bit from = corners[k];
+                            const uint32bit to = corners[(k + 1) % 4];
+
+                            if (((mask >> from) & 1) != 0 || ((mask >> to) & 1) == 0) {
+                                continue;
+                            }
+
+                            for (uint32bit j = 1; j < 4; j++) {
+                                const uint32bit first = corners[(k + j) % 4];
+                                const uint32bit second = corners[(k + j + 1) % 4];
+
+                                if (((mask >> first) & 1) != 0 && ((mask >> second) & 1) == 0) {
+                                    next[getCellEdge(from, getAxis(from, to))] = (int32bit)getCellEdge(first, getAxis(first, second));
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                uint32bit count = 0;
+                bool visited[12] = { false };
+
+                for (uint32bit start = 0; start < 12; start++) {
+                    if (next[start] < 0 || visited[start]) {
+                        continue;
+                    }
+
+                    uint32bit loop[12];
+                    uint32bit length = 0;
+
+                    for (uint32bit edge = start; !visited[edge]; edge = (uint32bit)next[edge]) {
+                        visited[edge] = true;
+                        loop[length++] = edge;
+                    }
+
+                    // A fan diagonal between two edges of one face would lie in
+                    // the face, where the cell behind it may put the same one
+                    uint32bit apex = 0;
+                    uint32bit fewestDiagonals = 12;
+
+                    for (uint32bit candidate = 0; candidate < length && fewestDiagonals > 0; candidate++) {
+                        uint32bit diagonals = 0;
+
+                        for (uint32bit i = 2; i + 1 < length; i++) {
+                            if (haveCommonFace(loop[candidate], loop[(candidate + i) % length])) {
+                                diagonals++;
+                            }
+                        }
+
+                        if (diagonals < fewestDiagonals) {
+                            fewestDiagonals = diagonals;
+                            apex = candidate;
+                        }
+                    }
+
+                    for (uint32bit i = 1; i + 1 < length; i++) {
+                        table.edges[mask][count * 3] = (uint8bit)loop[apex];
+                        table.edges[mask][count * 3 + 1] = (uint8bit)loop[(apex + i) % length];
+                        table.edges[mask][count * 3 + 2] = (uint8bit)loop[(apex + i + 1) % length];
+                        count++;
+                    }
+                }
+
+                table.triangleCounts[mask] = (uint8bit)count;
+            }
+
+            return table;
+        }
+
+        static const CaseTable & getCaseTable()
+        {
+            static const CaseTable table = buildCaseTable();
+
+            return table;
+        }
+
+        // ========================= Extraction ========================= //
+
+        struct Extraction
+        {
+            const float * const * slices;
+            uint32bit sliceCount;
+            uint32bit sizeX;
+            uint32bit sizeY;
+            uint32bit firstZ;
+            Vector3F origin;
+            float voxelSize;
+            float isoValue;
+            const CaseTable & table;
+        };
+
+        struct Slab
+        {
+            std::vector<Vector3F> vertices;
+            std::vector<uint32bit> indices;
+
+            // The vertices of the top plane of the last slab of a chunk
+            std::vector<uint32bit> topVertices;
+        };
+
+        // The vertices of the crossed edges of a plane along x and y, in
+        // the order of the rows. A plane is made by its slab or referred to
+        // by the marks and the order of its vertices in the plane.
+        static void makePlane(const Extraction & extraction, const uint32bit z, const uint32bit mark, Slab & slab, uint32bit * edgesX, uint32bit * edgesY)
+        {
+            const float * slice = extraction.slices[z];
+            const float iso = extraction.isoValue;
+            const float size = extraction.voxelSize;
+            const float positionZ = extraction.origin.z + (extraction.firstZ + z) * size;
+
+            uint32bit order = 0;
+
+            for (uint32bit y = 0; y < extraction.sizeY; y++) {
+                const float * row = slice + (size_t)y * extraction.sizeX;
+                const float * nextRow = row + extraction.sizeX;
+
+                for (uint32bit x = 0; x < extraction.sizeX; x++) {
+                    const size_t index = (size_t)y * extraction.sizeX + x;
+                    const bool inside = row[x] < iso;
+
+                    edgesX[index] = NO_VERTEX;
+                    edgesY[index] = NO_VERTEX;
+
+                    if (x + 1 < extraction.sizeX && inside != (row[x + 1] < iso)) {
+                        if (mark == 0) {
+                            const float t = (iso - row[x]) / (row[x + 1] - row[x]);
+
+                            edgesX[index] = (uint32bit)slab.vertices.size();
+                            slab.vertices.push_back(Vector3F(extraction.origin.x + (x + t) * size, extraction.origin.y + y * size, positionZ));
+                        }
+                        else {
+                            edgesX[index] = mark | order;
+                        }
+
+                        order++;
+                    }
+
+                    if (y + 1 < extraction.sizeY && inside != (nextRow[x] < iso)) {
+                        if (mark == 0) {
+                            const float t = (iso - row[x]) / (nextRow[x] - row[x]);
+
+                            edgesY[index] = (uint32bit)slab.vertices.size();
+                            slab.vertices.push_back(Vector3F(extraction.origin.x + x * size, extraction.origin.y + (y + t) * size, positionZ));
+                        }
+                        else {
+                            edgesY[index] = mark | order;
+                        }
+
+                        order++;
+                    }
+                }
+            }
+        }
+
+        // The vertices of the crossed edges along z between two planes
+        static void makeLayer(const Extraction & extraction, const uint32bit z, Slab & slab, uint32bit * edgesZ)
+        {
+            const float * lower = extraction.slices[z];
+            const float * upper = extraction.slices[z + 1];
+            const float iso = extraction.isoValue;
+            const float size = extraction.voxelSize;
+
+            for (uint32bit y = 0; y < extraction.sizeY; y++) {
+                for (uint32bit x = 0; x < extraction.sizeX; x++) {
+                    const size_t index = (size_t)y * extraction.sizeX + x;
+
+                    edgesZ[index] = NO_VERTEX;
+
+                    if ((lower[index] < iso) != (upper[index] < iso)) {
+                        const float t = (iso - lower[index]) / (upper[index] - lower[index]);
+
+                        edgesZ[index] = (uint32bit)slab.vertices.size();
+                        slab.vertices.push_back(Vector3F(extraction.origin.x + x * size, extraction.origin.y + y * size, extraction.origin.z + (extraction.firstZ + z + t) * size));
+                    }
+                }
+            }
+        }
+
+        // The triangles of the cells between two planes
+        static void triangulateLayer(const Extraction & extraction, const uint32bit z, const uint32bit * lowerX, const uint32bit * lowerY, const uint32bit * upperX, const uint32bit * upperY, const uint32bit * edgesZ, Slab & slab)
+        {
+            const float * lower = extraction.slices[z];
+            const float * upper = extraction.slices[z + 1];
+            const float iso = extraction.isoValue;
+            const uint32bit sizeX = extraction.sizeX;
+
+            for (uint32bit y = 0; y + 1 < extraction.sizeY; y++) {
+                for (uint32bit x = 0; x + 1 < sizeX; x++) {
+                    const size_t index = (size_t)y * sizeX + x;
+
+                    const uint32bit mask = (lower[index] < iso ? 1 : 0) | (lower[index + 1] < iso ? 2 : 0)
+                        | (lower[index + sizeX] < iso ? 4 : 0) | (lower[index + sizeX + 1] < iso ? 8 : 0)
+                        | (upper[index] < iso ? 16 : 0) | (upper[index + 1] < iso ? 32 : 0)
+                        | (upper[index + sizeX] < iso ? 64 : 0) | (upper[index + sizeX + 1] < iso ? 128 : 0);
+
+                    if (mask == 0 || mask == 255) {
+                        continue;
+                    }
+
+                    // By getCellEdge(): x edges by (y, z), y edges by (x, z),
+                    // z edges by (x, y)
+                    const uint32bit vertices[12] = {
+                        lowerX[index], lowerX[index + sizeX], upperX[index], upperX[index + sizeX],
+                        lowerY[index], lowerY[index + 1], upperY[index], upperY[index + 1],
+                        edgesZ[index], edgesZ[index + 1], edgesZ[index + sizeX], edgesZ[index + sizeX + 1]
+                    };
+
+                    const uint8bit * edges = extraction.table.edges[mask];
+                    const uint32bit count = extraction.table.triangleCounts[mask] * 3;
+
+                    for (uint32bit i = 0; i < count; i++) {
+                        slab.indices.push_back(vertices[edges[i]]);
+                    }
+                }
+            }
+        }
+
+        // The slab makes its bottom plane unless the previous chunk shares
+        // it and refers to its top plane in the next slab unless it is the
+        // last one of the chunk
+        static void extractSlab(const Extraction & extraction, const uint32bit first, const uint32bit last, const bool hasSharedVertices, Slab & slab)
+        {
+            const size_t planeSize = (size_t)extraction.sizeX * extraction.sizeY;
+
+            std::vector<uint32bit> edges(planeSize * 5);
+
+            uint32bit * lowerX = &edges[0];
+            uint32bit * lowerY = lowerX + planeSize;
+            uint32bit * upperX = lowerY + planeSize;
+            uint32bit * upperY = upperX + planeSize;
+            uint32bit * edgesZ = upperY + planeSize;
+
+            makePlane(extraction, first, first == 0 && hasSharedVertices ? SHARED_VERTEX : 0, slab, lowerX, lowerY);
+
+            for (uint32bit z = first; z < last; z++) {
+                const bool lastPlane = z + 1 == last;
+                const bool chunkEnd = z + 2 == extraction.sliceCount;
+
+                makeLayer(extraction, z, slab, edgesZ);
+
+                const size_t topStart = slab.vertices.size();
+                makePlane(extraction, z + 1, lastPlane && !chunkEnd ? NEXT_SLAB_VERTEX : 0, slab, upperX, upperY);
+
+                if (lastPlane && chunkEnd) {
+                    for (size_t i = topStart; i < slab.vertices.size(); i++) {
+                        slab.topVertices.push_back((uint32bit)i);
+                    }
+                }
+
+                triangulateLayer(extraction, z, lowerX, lowerY, upperX, upperY, edgesZ, slab);
+
+                std::swap(lowerX, upperX);
+                std::swap(lowerY, upperY);
+            }
+        }
+
+        // Extracts the layers between the slices of a chunk and appends them
+        // to the mesh. The shared vertices are the ones of the first slice
+        // made by the previous chunk, they are replaced by the ones of the
+        // last slice.
+        static void extractChunk(const Extraction & extraction, IndexedMesh3F & mesh, std::vector<uint32bit> & sharedVertices, const bool hasSharedVertices, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("iso_surface.chunk");
+
+            const uint32bit layerCount = extraction.sliceCount - 1;
+            const uint32bit slabCount = (layerCount + SLAB_LAYERS - 1) / SLAB_LAYERS;
+
+            std::vector<Slab> slabs(slabCount);
+
+            parallelFor(0, slabCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    extractSlab(extraction, (uint32bit)i * SLAB_LAYERS, std::min((uint32bit)(i + 1) * SLAB_LAYERS, layerCount), hasSharedVertices, slabs[i]);
+                }
+            }, threadCount);
+
+            std::vector<size_t> vertexOffsets(slabCount + 1);
+            std::vector<size_t> indexOffsets(slabCount + 1);
+
+            vertexOffsets[0] = mesh.vertices.size();
+            indexOffsets[0] = mesh.indices.size();
+
+            for (uint32bit i = 0; i < slabCount; i++) {
+                vertexOffsets[i + 1] = vertexOffsets[i] + slabs[i].vertices.size();
+                indexOffsets[i + 1] = indexOffsets[i] + slabs[i].indices.size();
+            }
+
+            mesh.vertices.resize(vertexOffsets[slabCount]);
+            mesh.indices.resize(indexOffsets[slabCount]);
+
+            parallelFor(0, slabCount, 1, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const Slab & slab = slabs[i];
+
+                    if (!slab.vertices.empty()) {
+                        memcpy(&mesh.vertices[vertexOffsets[i]], &slab.vertices[0], slab.vertices.size() * sizeof(Vector3F));
+                    }
+
+                    for (size_t j = 0; j < slab.indices.size(); j++) {
+                        const uint32bit vertex = slab.indices[j];
+
+                        if ((vertex & NEXT_SLAB_VERTEX) != 0) {
+                            mesh.indices[indexOffsets[i] + j] = (uint32bit)vertexOffsets[i + 1] + (vertex & VERTEX_INDEX_MASK);
+                        }
+                        else if ((vertex & SHARED_VERTEX) != 0) {
+                            mesh.indices[indexOffsets[i] + j] = sharedVertices[vertex & VERTEX_INDEX_MASK];
+                        }
+                        else {
+                            mesh.indices[indexOffsets[i] + j] = (uint32bit)vertexOffsets[i] + vertex;
+                        }
+                    }
+                }
+            }, threadCount);
+
+            const Slab & lastSlab = slabs[slabCount - 1];
+
+            sharedVertices.resize(lastSlab.topVertices.size());
+
+            for (size_t i = 0; i < lastSlab.topVertices.size(); i++) {
+                sharedVertices[i] = (uint32bit)vertexOffsets[slabCount - 1] + lastSlab.topVertices[i];
+            }
+        }
+
+        bool extractIsoSurface(const float * values, const uint32bit sizeX, const uint32bit sizeY, const uint32bit sizeZ, const Vector3F & origin, const float voxelSize, const float isoValue, IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("iso_surface.extract");
+
+            if (sizeX < 2 || sizeY < 2 || sizeZ < 2 || !(voxelSize > 0.0f)) {
+                return false;
+            }
+
+            std::vector<const float *> slices(sizeZ);
+
+            for (uint32bit z = 0; z < sizeZ; z++) {
+                slices[z] = values + (size_t)z * sizeX * sizeY;
+            }
+
+            const Extraction extraction = { &slices[0], sizeZ, sizeX, sizeY, 0, origin, voxelSize, isoValue, getCaseTable() };
+
+            std::vector<uint32bit> sharedVertices;
+            extractChunk(extraction, mesh, sharedVertices, false, threadCount);
+
+            return true;
+        }
+
+        bool extractIsoSurface(const SignedDistanceField3F & field, const float isoValue, IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            IsoSurfaceStream3F stream;
+
+            if (field.isEmpty() || !stream.begin(mesh, field.getSizeX(), field.getSizeY(), field.getOrigin(), field.getVoxelSize(), isoValue, IsoSurfaceStream3F::DEFAULT_CHUNK_SLICES, threadCount)) {
+                return false;
+            }
+
+            std::vector<float> slice((size_t)field.getSizeX() * field.getSizeY());
+
+            for (uint32bit z = 0; z < field.getSizeZ(); z++) {
+                field.getSlice(z, &slice[0], threadCount);
+                stream.addSlice(&slice[0]);
+            }
+
+            stream.finish();
+
+            return true;
+        }
+
+        // ===================== Iso surface stream ===================== //
+
+        const uint32bit IsoSurfaceStream3F::DEFAULT_CHUNK_SLICES;
+
+        IsoSurfaceStream3F::IsoSurfaceStream3F()
+            : mesh(0), sizeX(0), sizeY(0), voxelSize(0.0f), isoValue(0.0f), chunkSlices(0), threadCount(0), bufferedSlices(0), sliceCount(0), hasSharedVertices(false)
+        {
+        }
+
+        IsoSurfaceStream3F::~IsoSurfaceStream3F()
+        {
+        }
+
+        bool IsoSurfaceStream3F::begin(IndexedMesh3F & mesh, const uint32bit sizeX, const uint32bit sizeY, const Vector3F & origin, const float voxelSize, const float isoValue, const uint32bit chunkSlices, const uint32bit threadCount)
+        {
+            this->mesh = 0;
+
+            if (sizeX < 2 || sizeY < 2 || !(voxelSize > 0.0f) || chunkSlices == 0) {
+                return false;
+            }
+
+            this->mesh = &mesh;
+            this->sizeX = sizeX;
+            this->sizeY = sizeY;
+            this->origin = origin;
+            this->voxelSize = voxelSize;
+            this->isoValue = isoValue;
+            this->chunkSlices = chunkSlices;
+            this->threadCount = threadCount;
+
+            this->buffer.resize((size_t)(chunkSlices + 1) * sizeX * sizeY);
+            this->bufferedSlices = 0;
+            this->sliceCount = 0;
+
+            this->sharedVertices.clear();
+            this->hasSharedVertices = false;
+
+            return true;
+        }
+
+        bool IsoSurfaceStream3F::addSlice(const float * values)
+        {
+            if (this->mesh == 0) {
+                return false;
+            }
+
+            const size_t sliceSize = (size_t)this->sizeX * this->sizeY;
+
+            memcpy(&this->buffer[this->bufferedSlices * sliceSize], values, sliceSize * sizeof(float));
+
+            this->bufferedSlices++;
+            this->sliceCount++;
+
+            // The last slice of a chunk is the first one of the next
+            if (this->bufferedSlices == this->chunkSlices + 1) {
+                this->extractBuffer();
+
+                memcpy(&this->buffer[0], &this->buffer[this->chunkSlices * sliceSize], sliceSize * sizeof(float));
+                this->bufferedSlices = 1;
+            }
+
+            return true;
+        }
+
+        void IsoSurfaceStream3F::finish()
+        {
+            if (this->mesh != 0 && this->bufferedSlices > 1) {
+                this->extractBuffer();
+            }
+
+            this->mesh = 0;
+            this->bufferedSlices = 0;
+            this->sharedVertices.clear();
+            this->hasSharedVertices = false;
+
+            std::vector<float>().swap(this->buffer);
+        }
+
+        void IsoSurfaceStream3F::extractBuffer()
+        {
+            const size_t sliceSize = (size_t)this->sizeX * this->sizeY;
+
+            std::vector<const float *> slices(this->bufferedSlices);
+
+            for (uint32bit z = 0; z < this->bufferedSlices; z++) {
+                slices[z] = &this->buffer[z * sliceSize];
+            }
+
+            const uint32bit firstZ = this->sliceCount - this->bufferedSlices;
+            const Extraction extraction = { &slices[0], this->bufferedSlices, this->sizeX, this->sizeY, firstZ, this->origin, this->voxelSize, this->isoValue, getCaseTable() };
+
+            extractChunk(extraction, *this->mesh, this->sharedVertices, this->hasSharedVertices, this->threadCount);
+
+            this->hasSharedVertices = true;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_STEREOMETRY_ISO_SURFACE3F_H_
+#define _GEOMETRY_STEREOMETRY_ISO_SURFACE3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "IndexedMesh3F.h"
+#include "SignedDistanceField3F.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Marching cubes over a scalar field sampled at the voxels
+        // origin + (x, y, z) * voxelSize. The samples below the iso value
+        // are inside, the triangles are oriented like
+        // IndexedMesh3F::getNormal() with the normals outside. Every grid edge
+        // crossed by the surface gets one vertex, shared by all triangles
+        // around it. The faces with two inside corners on a diagonal keep
+        // the corners apart, in both cells sharing them, so the surface has
+        // no holes.
+        //
+        // The cells are processed in slabs of eight layers on the
+        // threads of the shared pool. A slab makes the vertices of its
+        // bottom plane and refers to the ones of its top plane by their order
+        // in the bottom plane of the next slab, so no vertex is made twice
+        // and the slabs share nothing while they run. The output does not
+        // depend on the number of threads.
+        //
+        // The triangles and vertices are appended to the mesh. Returns false
+        // for a size below 2 or a voxel size that is not positive.
+        bool extractIsoSurface(const float * values, const uint32bit sizeX, const uint32bit sizeY, const uint32bit sizeZ, const Vector3F & origin, const float voxelSize, const float isoValue, IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+
+        // The iso surface of the field, streamed slice by slice
+        bool extractIsoSurface(const SignedDistanceField3F & field, const float isoValue, IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+
+        // ================== Iso surface stream header ================== //
+
+        // Marching cubes over a field given slice by slice, x running fastest
+        // in a slice, for fields that do not fit in memory. The slices are
+        // buffered in chunks of chunkSlices layers, every chunk is extracted
+        // like by extractIsoSurface() and shares the vertices of its last
+        // slice with the next one. Only the chunk and the mesh are in memory.
+        class IsoSurfaceStream3F
+        {
+        public:
+            static const uint32bit DEFAULT_CHUNK_SLICES = 32;
+
+            IsoSurfaceStream3F();
+            virtual ~IsoSurfaceStream3F();
+
+            // Starts a surface appended to the mesh, which must stay alive
+            // until finish(). Returns false for a size below 2, a voxel size
+            // that is not positive or no chunk slices.
+            bool begin(IndexedMesh3F & mesh, const uint32bit sizeX, const uint32bit sizeY, const Vector3F & origin, const float voxelSize, const float isoValue, const uint32bit chunkSlices = DEFAULT_CHUNK_SLICES, const uint32bit threadCount = 0);
+
+            // Returns false when no surface is started
+            bool addSlice(const float * values);
+
+            // Extracts the buffered slices and ends the surface
+            void finish();
+
+            inline bool isStarted() const;
+
+            // The slices added since begin()
+            inline uint32bit getSliceCount() const;
+
+        private:
+            IndexedMesh3F * mesh;
+
+            uint32bit sizeX;
+            uint32bit sizeY;
+            Vector3F origin;
+            float voxelSize;
+            float isoValue;
+            uint32bit chunkSlices;
+            uint32bit threadCount;
+
+            std::vector<float> buffer;
+            uint32bit bufferedSlices;
+            uint32bit sliceCount;
+
+            // The vertices of the crossed edges of the last extracted slice
+            std::vector<uint32bit> sharedVertices;
+            bool hasSharedVertices;
+
+            void extractBuffer();
+
+            IsoSurfaceStream3F(const IsoSurfaceStream3F &);
+            IsoSurfaceStream3F & operator=(const IsoSurfaceStream3F &);
+        };
+
+        // ============== Iso surface stream inline methods ============== //
+
+        bool IsoSurfaceStream3F::isStarted() const
+        {
+            return this->mesh != 0;
+        }
+
+        uint32bit IsoSurfaceStream3F::getSliceCount() const
+        {
+            return this->sliceCount;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_ISO_SURFACE3F_H_ */
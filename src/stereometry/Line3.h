@@ -47,6 +47,10 @@ namespace geometry
 
             inline VectorType pointAt(const FloatType position) const;
 
+            // The position of the foot of the perpendicular from the point,
+            // the direction is of unit length so it is a distance
+            inline FloatType projectionOf(const VectorType& point) const;
+
         protected:
             inline Line3Template();
             inline Line3Template(const VectorType& point, const VectorType& direction);
@@ -72,6 +76,9 @@ namespace geometry
             inline Line3(const double pointX, const double pointY, const double pointZ, const double directionX, const double directionY, const double directionZ);
             virtual ~Line3();
 
+            inline Vector3 closestPoint(const Vector3& point) const;
+            inline double distanceTo(const Vector3& point) const;
+
             inline Line3F toFloat() const;
         };
 
@@ -85,6 +92,9 @@ namespace geometry
             inline Line3F(const float pointX, const float pointY, const float pointZ, const float directionX, const float directionY, const float directionZ);
             virtual ~Line3F();
 
+            inline Vector3F closestPoint(const Vector3F& point) const;
+            inline float distanceTo(const Vector3F& point) const;
+
             inline Line3 toDouble() const;
         };
 
@@ -98,6 +108,9 @@ namespace geometry
             inline Ray3(const double pointX, const double pointY, const double pointZ, const double directionX, const double directionY, const double directionZ);
             virtual ~Ray3();
 
+            inline Vector3 closestPoint(const Vector3& point) const;
+            inline double distanceTo(const Vector3& point) const;
+
             inline Ray3F toFloat() const;
         };
 
@@ -111,6 +124,9 @@ namespace geometry
             inline Ray3F(const float pointX, const float pointY, const float pointZ, const float directionX, const float directionY, const float directionZ);
             virtual ~Ray3F();
 
+            inline Vector3F closestPoint(const Vector3F& point) const;
+            inline float distanceTo(const Vector3F& point) const;
+
             inline Ray3 toDouble() const;
         };
 
@@ -179,7 +195,7 @@ namespace geometry
         template <typename FloatType, class VectorType> void Line3Template<FloatType, VectorType>::setValues(const FloatType pointX, const FloatType pointY, const FloatType pointZ, const FloatType directionX, const FloatType directionY, const FloatType directionZ)
         {
             this->linePoint.setValues(pointX, pointY, pointZ);
-            this->linePoint.setValues(directionX, directionY, directionZ);
+            this->lineDirection.setValues(directionX, directionY, directionZ);
             this->valid = this->lineDirection.normalize();
         }
 
@@ -201,7 +217,12 @@ namespace geometry
 
         template <typename FloatType, class VectorType> VectorType Line3Template<FloatType, VectorType>::pointAt(const FloatType position) const
         {
-            return VectorType(this->linePoint.x + this->lineDirection.x * position, this->linePoint.y + this->lineDirection.y * position);
+            return VectorType(this->linePoint.x + this->lineDirection.x * position, this->linePoint.y + this->lineDirection.y * position, this->linePoint.z + this->lineDirection.z * position);
+        }
+
+        template <typename FloatType, class VectorType> FloatType Line3Template<FloatType, VectorType>::projectionOf(const VectorType& point) const
+        {
+            return (point - this->linePoint).scalar(this->lineDirection);
         }
 
         // ================ Line3<double> inline methods ================= //
@@ -221,6 +242,16 @@ namespace geometry
         {
         }
 
+        Vector3 Line3::closestPoint(const Vector3& point) const
+        {
+            return this->pointAt(this->projectionOf(point));
+        }
+
+        double Line3::distanceTo(const Vector3& point) const
+        {
+            return (point - this->closestPoint(point)).module();
+        }
+
         Line3F Line3::toFloat() const
         {
             return Line3F((float)this->constPoint().x, (float)this->constPoint().y, (float)this->constPoint().z, (float)this->constDirection().x, (float)this->constDirection().y, (float)this->constDirection().z);
@@ -243,6 +274,16 @@ namespace geometry
         {
         }
 
+        Vector3F Line3F::closestPoint(const Vector3F& point) const
+        {
+            return this->pointAt(this->projectionOf(point));
+        }
+
+        float Line3F::distanceTo(const Vector3F& point) const
+        {
+            return (point - this->closestPoint(point)).module();
+        }
+
         Line3 Line3F::toDouble() const
         {
             return Line3(this->constPoint().x, this->constPoint().y, this->constPoint().z, this->constDirection().x, this->constDirection().y, this->constDirection().z);
@@ -265,6 +306,18 @@ namespace geometry
         {
         }
 
+        Vector3 Ray3::closestPoint(const Vector3& point) const
+        {
+            const double position = this->projectionOf(point);
+
+            return position > 0 ? this->pointAt(position) : this->constPoint();
+        }
+
+        double Ray3::distanceTo(const Vector3& point) const
+        {
+            return (point - this->closestPoint(point)).module();
+        }
+
         Ray3F Ray3::toFloat() const
         {
             return Ray3F((float)this->constPoint().x, (float)this->constPoint().y, (float)this->constPoint().z, (float)this->constDirection().x, (float)this->constDirection().y, (float)this->constDirection().z);
@@ -287,6 +340,18 @@ namespace geometry
         {
         }
 
+        Vector3F Ray3F::closestPoint(const Vector3F& point) const
+        {
+            const float position = this->projectionOf(point);
+
+            return position > 0 ? this->pointAt(position) : this->constPoint();
+        }
+
+        float Ray3F::distanceTo(const Vector3F& point) const
+        {
+            return (point - this->closestPoint(point)).module();
+        }
+
         Ray3 Ray3F::toDouble() const
         {
             return Ray3(this->constPoint().x, this->constPoint().y, this->constPoint().z, this->constDirection().x, this->constDirection().y, this->constDirection().z);
@@ -29,11 +29,11 @@ namespace geometry
         template <typename FloatType, class VectorType> class Matrix3x3Template
         {
         public:
-            static const int32bit ZERO_MATRIX = 0x0;
-            static const int32bit IDENTITY_MATRIX = 0x1;
+            static constexpr int32bit ZERO_MATRIX = 0x0;
+            static constexpr int32bit IDENTITY_MATRIX = 0x1;
 
-            static const FloatType ZERO;
-            static const FloatType UNIT;
+            static constexpr FloatType ZERO = FloatConstants<FloatType>::ZERO;
+            static constexpr FloatType UNIT = FloatConstants<FloatType>::UNIT;
 
             FloatType r1c1;
             FloatType r1c2;
@@ -47,47 +47,64 @@ namespace geometry
             FloatType r3c2;
             FloatType r3c3;
 
-            inline Matrix3x3Template();
-            inline Matrix3x3Template(const int32bit matrixType);
-            virtual ~Matrix3x3Template();
+            constexpr Matrix3x3Template();
+            constexpr Matrix3x3Template(const int32bit matrixType);
+            constexpr Matrix3x3Template(
+                const FloatType r1c1, const FloatType r1c2, const FloatType r1c3,
+                const FloatType r2c1, const FloatType r2c2, const FloatType r2c3,
+                const FloatType r3c1, const FloatType r3c2, const FloatType r3c3
+            );
 
-            inline void setToIdentity();
-            inline void setToZero();
+            constexpr void setToIdentity();
+            constexpr void setToZero();
 
-            inline FloatType determinant() const;
+            constexpr FloatType determinant() const;
 
-            inline VectorType row1() const;
-            inline VectorType row2() const;
-            inline VectorType row3() const;
+            constexpr VectorType row1() const;
+            constexpr VectorType row2() const;
+            constexpr VectorType row3() const;
 
-            inline VectorType column1() const;
-            inline VectorType column2() const;
-            inline VectorType column3() const;
+            constexpr VectorType column1() const;
+            constexpr VectorType column2() const;
+            constexpr VectorType column3() const;
 
-            inline VectorType operator* (const VectorType & vector) const;
+            constexpr VectorType operator* (const VectorType & vector) const;
         };
 
+        // ================= Matrix3x3 Template methods ================== //
+
+        template <typename FloatType, class VectorType> constexpr int32bit Matrix3x3Template<FloatType, VectorType>::ZERO_MATRIX;
+        template <typename FloatType, class VectorType> constexpr int32bit Matrix3x3Template<FloatType, VectorType>::IDENTITY_MATRIX;
+
+        template <typename FloatType, class VectorType> constexpr FloatType Matrix3x3Template<FloatType, VectorType>::ZERO;
+        template <typename FloatType, class VectorType> constexpr FloatType Matrix3x3Template<FloatType, VectorType>::UNIT;
 
-        template <typename FloatType, class VectorType> Matrix3x3Template<FloatType, VectorType>::Matrix3x3Template()
+        template <typename FloatType, class VectorType> constexpr Matrix3x3Template<FloatType, VectorType>::Matrix3x3Template()
+            : r1c1(UNIT), r1c2(ZERO), r1c3(ZERO),
+              r2c1(ZERO), r2c2(UNIT), r2c3(ZERO),
+              r3c1(ZERO), r3c2(ZERO), r3c3(UNIT)
         {
-            this->setToIdentity();
         }
 
-        template <typename FloatType, class VectorType> Matrix3x3Template<FloatType, VectorType>::Matrix3x3Template(const int32bit matrixType)
+        template <typename FloatType, class VectorType> constexpr Matrix3x3Template<FloatType, VectorType>::Matrix3x3Template(const int32bit matrixType)
+            : r1c1(matrixType == ZERO_MATRIX ? ZERO : UNIT), r1c2(ZERO), r1c3(ZERO),
+              r2c1(ZERO), r2c2(matrixType == ZERO_MATRIX ? ZERO : UNIT), r2c3(ZERO),
+              r3c1(ZERO), r3c2(ZERO), r3c3(matrixType == ZERO_MATRIX ? ZERO : UNIT)
         {
-            if (matrixType == ZERO_MATRIX) {
-                this->setToZero();
-            }
-            else {
-                this->setToIdentity();
-            }
         }
 
-        template <typename FloatType, class VectorType> Matrix3x3Template<FloatType, VectorType>::~Matrix3x3Template()
+        template <typename FloatType, class VectorType> constexpr Matrix3x3Template<FloatType, VectorType>::Matrix3x3Template(
+            const FloatType r1c1, const FloatType r1c2, const FloatType r1c3,
+            const FloatType r2c1, const FloatType r2c2, const FloatType r2c3,
+            const FloatType r3c1, const FloatType r3c2, const FloatType r3c3
+        )
+            : r1c1(r1c1), r1c2(r1c2), r1c3(r1c3),
+              r2c1(r2c1), r2c2(r2c2), r2c3(r2c3),
+              r3c1(r3c1), r3c2(r3c2), r3c3(r3c3)
         {
         }
 
-        template <typename FloatType, class VectorType> void Matrix3x3Template<FloatType, VectorType>::setToIdentity()
+        template <typename FloatType, class VectorType> constexpr void Matrix3x3Template<FloatType, VectorType>::setToIdentity()
         {
             this->r1c1 = UNIT;
             this->r1c2 = ZERO;
@@ -102,7 +119,7 @@ namespace geometry
             this->r3c3 = UNIT;
         }
 
-        template <typename FloatType, class VectorType> void Matrix3x3Template<FloatType, VectorType>::setToZero()
+        template <typename FloatType, class VectorType> constexpr void Matrix3x3Template<FloatType, VectorType>::setToZero()
         {
             this->r1c1 = ZERO;
             this->r1c2 = ZERO;
@@ -117,7 +134,7 @@ namespace geometry
             this->r3c3 = ZERO;
         }
 
-        template <typename FloatType, class VectorType> FloatType Matrix3x3Template<FloatType, VectorType>::determinant() const
+        template <typename FloatType, class VectorType> constexpr FloatType Matrix3x3Template<FloatType, VectorType>::determinant() const
         {
             return    this->r1c1 * this->r2c2 * this->r3c3
                     + this->r1c2 * this->r2c3 * this->r3c1
@@ -127,37 +144,37 @@ namespace geometry
                     - this->r1c1 * this->r2c3 * this->r3c2;
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::row1() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::row1() const
         {
             return VectorType(this->r1c1, this->r1c2, this->r1c3);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::row2() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::row2() const
         {
             return VectorType(this->r2c1, this->r2c2, this->r2c3);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::row3() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::row3() const
         {
             return VectorType(this->r3c1, this->r3c2, this->r3c3);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::column1() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::column1() const
         {
             return VectorType(this->r1c1, this->r2c1, this->r3c1);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::column2() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::column2() const
         {
             return VectorType(this->r1c2, this->r2c2, this->r3c2);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::column3() const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::column3() const
         {
             return VectorType(this->r1c3, this->r2c3, this->r3c3);
         }
 
-        template <typename FloatType, class VectorType> VectorType Matrix3x3Template<FloatType, VectorType>::operator* (const VectorType & vector) const
+        template <typename FloatType, class VectorType> constexpr VectorType Matrix3x3Template<FloatType, VectorType>::operator* (const VectorType & vector) const
         {
             return VectorType(
                     this->r1c1 * vector.x + this->r1c2 * vector.y + this->r1c3 * vector.z,
@@ -174,20 +191,24 @@ namespace geometry
         {
         public:
 
-            inline Matrix3x3F();
-            inline Matrix3x3F(const int type);
-            inline Matrix3x3F(const Matrix3x3 & matrix);
-            virtual ~Matrix3x3F();
+            constexpr Matrix3x3F();
+            constexpr Matrix3x3F(const int type);
+            constexpr Matrix3x3F(
+                const float r1c1, const float r1c2, const float r1c3,
+                const float r2c1, const float r2c2, const float r2c3,
+                const float r3c1, const float r3c2, const float r3c3
+            );
+            constexpr Matrix3x3F(const Matrix3x3 & matrix);
 
-            inline Matrix3x3 toDouble() const;
+            constexpr Matrix3x3 toDouble() const;
 
-            Matrix3x3F operator* (const Matrix3x3F & matrix) const;
-            inline Matrix3x3F operator* (const float value) const;
-            inline Matrix3x3F operator/ (const float value) const;
+            constexpr Matrix3x3F operator* (const Matrix3x3F & matrix) const;
+            constexpr Matrix3x3F operator* (const float value) const;
+            constexpr Matrix3x3F operator/ (const float value) const;
 
-            Matrix3x3F & operator*= (const Matrix3x3F & matrix);
-            inline Matrix3x3F & operator*= (const float value);
-            inline Matrix3x3F & operator/= (const float value);
+            constexpr Matrix3x3F & operator*= (const Matrix3x3F & matrix);
+            constexpr Matrix3x3F & operator*= (const float value);
+            constexpr Matrix3x3F & operator/= (const float value);
         };
 
         // =================== Matrix3x3<double> header ================== //
@@ -196,69 +217,114 @@ namespace geometry
         {
         public:
 
-            inline Matrix3x3();
-            inline Matrix3x3(const int type);
-            inline Matrix3x3(const Matrix3x3F & matrix);
-            virtual ~Matrix3x3();
+            constexpr Matrix3x3();
+            constexpr Matrix3x3(const int type);
+            constexpr Matrix3x3(
+                const double r1c1, const double r1c2, const double r1c3,
+                const double r2c1, const double r2c2, const double r2c3,
+                const double r3c1, const double r3c2, const double r3c3
+            );
+            constexpr Matrix3x3(const Matrix3x3F & matrix);
 
-            inline Matrix3x3F toFloat() const;
+            constexpr Matrix3x3F toFloat() const;
 
-            Matrix3x3 operator* (const Matrix3x3 & matrix) const;
-            inline Matrix3x3 operator* (const double value) const;
-            inline Matrix3x3 operator/ (const double value) const;
+            constexpr Matrix3x3 operator* (const Matrix3x3 & matrix) const;
+            constexpr Matrix3x3 operator* (const double value) const;
+            constexpr Matrix3x3 operator/ (const double value) const;
 
-            Matrix3x3 & operator*= (const Matrix3x3 & matrix);
-            inline Matrix3x3 & operator*= (const double value);
-            inline Matrix3x3 & operator/= (const double value);
+            constexpr Matrix3x3 & operator*= (const Matrix3x3 & matrix);
+            constexpr Matrix3x3 & operator*= (const double value);
+            constexpr Matrix3x3 & operator/= (const double value);
         };
 
         // =================== Matrix3x3<float> methods ================== //
 
-        Matrix3x3F::Matrix3x3F()
+        constexpr Matrix3x3F::Matrix3x3F()
             : Matrix3x3Template<float, Vector3F>()
         {
         }
 
-        Matrix3x3F::Matrix3x3F(const int matrixType)
+        constexpr Matrix3x3F::Matrix3x3F(const int matrixType)
             : Matrix3x3Template<float, Vector3F>(matrixType)
         {
         }
 
-        Matrix3x3F::Matrix3x3F(const Matrix3x3 & matrix)
+        constexpr Matrix3x3F::Matrix3x3F(
+            const float r1c1, const float r1c2, const float r1c3,
+            const float r2c1, const float r2c2, const float r2c3,
+            const float r3c1, const float r3c2, const float r3c3
+        )
+            : Matrix3x3Template<float, Vector3F>(r1c1, r1c2, r1c3, r2c1, r2c2, r2c3, r3c1, r3c2, r3c3)
         {
-            this->r1c1 = (float)matrix.r1c1;
-            this->r1c2 = (float)matrix.r1c2;
-            this->r1c3 = (float)matrix.r1c3;
-
-            this->r2c1 = (float)matrix.r2c1;
-            this->r2c2 = (float)matrix.r2c2;
-            this->r2c3 = (float)matrix.r2c3;
+        }
 
-            this->r3c1 = (float)matrix.r3c1;
-            this->r3c2 = (float)matrix.r3c2;
-            this->r3c3 = (float)matrix.r3c3;
+        constexpr Matrix3x3F::Matrix3x3F(const Matrix3x3 & matrix)
+            : Matrix3x3Template<float, Vector3F>(
+                (float)matrix.r1c1, (float)matrix.r1c2, (float)matrix.r1c3,
+                (float)matrix.r2c1, (float)matrix.r2c2, (float)matrix.r2c3,
+                (float)matrix.r3c1, (float)matrix.r3c2, (float)matrix.r3c3
+            )
+        {
         }
 
-        Matrix3x3 Matrix3x3F::toDouble() const
+        constexpr Matrix3x3 Matrix3x3F::toDouble() const
         {
             return Matrix3x3(*this);
         }
 
-        Matrix3x3F Matrix3x3F::operator* (const float value) const
+        constexpr Matrix3x3F Matrix3x3F::operator* (const Matrix3x3F & matrix) const
+        {
+            Matrix3x3F result(*this);
+
+            result *= matrix;
+
+            return result;
+        }
+
+        constexpr Matrix3x3F Matrix3x3F::operator* (const float value) const
         {
             Matrix3x3F result(*this);
             result *= value;
             return result;
         }
 
-        Matrix3x3F Matrix3x3F::operator/ (const float value) const
+        constexpr Matrix3x3F Matrix3x3F::operator/ (const float value) const
         {
             Matrix3x3F result(*this);
             result /= value;
             return result;
         }
 
-        Matrix3x3F & Matrix3x3F::operator*= (const float value)
+        constexpr Matrix3x3F & Matrix3x3F::operator*= (const Matrix3x3F & matrix)
+        {
+            const float r1c1 = this->r1c1 * matrix.r1c1 + this->r1c2 * matrix.r2c1 + this->r1c3 * matrix.r3c1;
+            const float r1c2 = this->r1c1 * matrix.r1c2 + this->r1c2 * matrix.r2c2 + this->r1c3 * matrix.r3c2;
+            const float r1c3 = this->r1c1 * matrix.r1c3 + this->r1c2 * matrix.r2c3 + this->r1c3 * matrix.r3c3;
+
+            const float r2c1 = this->r2c1 * matrix.r1c1 + this->r2c2 * matrix.r2c1 + this->r2c3 * matrix.r3c1;
+            const float r2c2 = this->r2c1 * matrix.r1c2 + this->r2c2 * matrix.r2c2 + this->r2c3 * matrix.r3c2;
+            const float r2c3 = this->r2c1 * matrix.r1c3 + this->r2c2 * matrix.r2c3 + this->r2c3 * matrix.r3c3;
+
+            const float r3c1 = this->r3c1 * matrix.r1c1 + this->r3c2 * matrix.r2c1 + this->r3c3 * matrix.r3c1;
+            const float r3c2 = this->r3c1 * matrix.r1c2 + this->r3c2 * matrix.r2c2 + this->r3c3 * matrix.r3c2;
+            const float r3c3 = this->r3c1 * matrix.r1c3 + this->r3c2 * matrix.r2c3 + this->r3c3 * matrix.r3c3;
+
+            this->r1c1 = r1c1;
+            this->r1c2 = r1c2;
+            this->r1c3 = r1c3;
+
+            this->r2c1 = r2c1;
+            this->r2c2 = r2c2;
+            this->r2c3 = r2c3;
+
+            this->r3c1 = r3c1;
+            this->r3c2 = r3c2;
+            this->r3c3 = r3c3;
+
+            return (*this);
+        }
+
+        constexpr Matrix3x3F & Matrix3x3F::operator*= (const float value)
         {
             this->r1c1 *= value;
             this->r1c2 *= value;
@@ -275,7 +341,7 @@ namespace geometry
             return (*this);
         }
 
-        Matrix3x3F & Matrix3x3F::operator/= (const float value)
+        constexpr Matrix3x3F & Matrix3x3F::operator/= (const float value)
         {
             this->r1c1 /= value;
             this->r1c2 /= value;
@@ -292,53 +358,94 @@ namespace geometry
             return (*this);
         }
 
-        // ================== Matrix2x2<double> methods ================== //
+        // ================== Matrix3x3<double> methods ================== //
 
-        Matrix3x3::Matrix3x3()
+        constexpr Matrix3x3::Matrix3x3()
             : Matrix3x3Template<double, Vector3>()
         {
         }
 
-        Matrix3x3::Matrix3x3(const int matrixType)
+        constexpr Matrix3x3::Matrix3x3(const int matrixType)
             : Matrix3x3Template<double, Vector3>(matrixType)
         {
         }
 
-        Matrix3x3::Matrix3x3(const Matrix3x3F & matrix)
+        constexpr Matrix3x3::Matrix3x3(
+            const double r1c1, const double r1c2, const double r1c3,
+            const double r2c1, const double r2c2, const double r2c3,
+            const double r3c1, const double r3c2, const double r3c3
+        )
+            : Matrix3x3Template<double, Vector3>(r1c1, r1c2, r1c3, r2c1, r2c2, r2c3, r3c1, r3c2, r3c3)
         {
-            this->r1c1 = matrix.r1c1;
-            this->r1c2 = matrix.r1c2;
-            this->r1c3 = matrix.r1c3;
-
-            this->r2c1 = matrix.r2c1;
-            this->r2c2 = matrix.r2c2;
-            this->r2c3 = matrix.r2c3;
+        }
 
-            this->r3c1 = matrix.r3c1;
-            this->r3c2 = matrix.r3c2;
-            this->r3c3 = matrix.r3c3;
+        constexpr Matrix3x3::Matrix3x3(const Matrix3x3F & matrix)
+            : Matrix3x3Template<double, Vector3>(
+                matrix.r1c1, matrix.r1c2, matrix.r1c3,
+                matrix.r2c1, matrix.r2c2, matrix.r2c3,
+                matrix.r3c1, matrix.r3c2, matrix.r3c3
+            )
+        {
         }
 
-        Matrix3x3F Matrix3x3::toFloat() const
+        constexpr Matrix3x3F Matrix3x3::toFloat() const
         {
             return Matrix3x3F(*this);
         }
 
-        Matrix3x3 Matrix3x3::operator* (const double value) const
+        constexpr Matrix3x3 Matrix3x3::operator* (const Matrix3x3 & matrix) const
+        {
+            Matrix3x3 result(*this);
+
+            result *= matrix;
+
+            return result;
+        }
+
+        constexpr Matrix3x3 Matrix3x3::operator* (const double value) const
         {
             Matrix3x3 result(*this);
             result *= value;
             return result;
         }
 
-        Matrix3x3 Matrix3x3::operator/ (const double value) const
+        constexpr Matrix3x3 Matrix3x3::operator/ (const double value) const
         {
             Matrix3x3 result(*this);
             result /= value;
             return result;
         }
 
-        Matrix3x3 & Matrix3x3::operator*= (const double value)
+        constexpr Matrix3x3 & Matrix3x3::operator*= (const Matrix3x3 & matrix)
+        {
+            const double r1c1 = this->r1c1 * matrix.r1c1 + this->r1c2 * matrix.r2c1 + this->r1c3 * matrix.r3c1;
+            const double r1c2 = this->r1c1 * matrix.r1c2 + this->r1c2 * matrix.r2c2 + this->r1c3 * matrix.r3c2;
+            const double r1c3 = this->r1c1 * matrix.r1c3 + this->r1c2 * matrix.r2c3 + this->r1c3 * matrix.r3c3;
+
+            const double r2c1 = this->r2c1 * matrix.r1c1 + this->r2c2 * matrix.r2c1 + this->r2c3 * matrix.r3c1;
+            const double r2c2 = this->r2c1 * matrix.r1c2 + this->r2c2 * matrix.r2c2 + this->r2c3 * matrix.r3c2;
+            const double r2c3 = this->r2c1 * matrix.r1c3 + this->r2c2 * matrix.r2c3 + this->r2c3 * matrix.r3c3;
+
+            const double r3c1 = this->r3c1 * matrix.r1c1 + this->r3c2 * matrix.r2c1 + this->r3c3 * matrix.r3c1;
+            const double r3c2 = this->r3c1 * matrix.r1c2 + this->r3c2 * matrix.r2c2 + this->r3c3 * matrix.r3c2;
+            const double r3c3 = this->r3c1 * matrix.r1c3 + this->r3c2 * matrix.r2c3 + this->r3c3 * matrix.r3c3;
+
+            this->r1c1 = r1c1;
+            this->r1c2 = r1c2;
+            this->r1c3 = r1c3;
+
+            this->r2c1 = r2c1;
+            this->r2c2 = r2c2;
+            this->r2c3 = r2c3;
+
+            this->r3c1 = r3c1;
+            this->r3c2 = r3c2;
+            this->r3c3 = r3c3;
+
+            return (*this);
+        }
+
+        constexpr Matrix3x3 & Matrix3x3::operator*= (const double value)
         {
             this->r1c1 *= value;
             this->r1c2 *= value;
@@ -355,7 +462,7 @@ namespace geometry
             return (*this);
         }
 
-        Matrix3x3 & Matrix3x3::operator/= (const double value)
+        constexpr Matrix3x3 & Matrix3x3::operator/= (const double value)
         {
             this->r1c1 /= value;
             this->r1c2 /= value;
@@ -0,0 +1,688 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Matrix3x3Decomposition.h"
+
+#include <math.h>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_DECOMPOSITION
+#endif
+
+#ifdef __AVX__
+#include <immintrin.h>
+#define GEOMETRY_AVX_DECOMPOSITION
+#endif
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        static_assert(sizeof(Matrix3x3F) == 9 * sizeof(float), "the matrices are read as packed floats");
+        static_assert(sizeof(Matrix3x3) == 9 * sizeof(double), "the matrices are read as packed doubles");
+
+        // A decomposition is a few hundred operations, smaller chunks keep the threads busy
+        static const size_t DECOMPOSITION_GRAIN = 256;
+
+        // ========================= Arithmetic ========================== //
+
+        // The decompositions are written once for a value type which is a
+        // float, a double or several floats in SIMD lanes. Branches are selects,
+        // so every lane runs the same instructions.
+
+        template<typename T> static inline T squareRoot(const T value)
+        {
+            return sqrt(value);
+        }
+
+        template<typename T> static inline T absolute(const T value)
+        {
+            return value < 0 ? -value : value;
+        }
+
+        template<typename T> static inline T minimum(const T a, const T b)
+        {
+            return a < b ? a : b;
+        }
+
+        template<typename T> static inline T maximum(const T a, const T b)
+        {
+            return a < b ? b : a;
+        }
+
+        template<typename T> static inline bool isLess(const T a, const T b)
+        {
+            return a < b;
+        }
+
+        template<typename T> static inline T select(const bool mask, const T chosen, const T other)
+        {
+            return mask ? chosen : other;
+        }
+
+        // The value negated where the sign is negative
+        template<typename T> static inline T multiplySign(const T value, const T sign)
+        {
+            return sign < 0 ? -value : value;
+        }
+
+        template<typename T> struct DecompositionTraits
+        {
+        };
+
+        template<> struct DecompositionTraits<float>
+        {
+            static const int32bit SWEEPS = 4;
+
+            static inline float negligible()
+            {
+                return 1E-12f;
+            }
+        };
+
+        template<> struct DecompositionTraits<double>
+        {
+            static const int32bit SWEEPS = 6;
+
+            static inline double negligible()
+            {
+                return 1E-30;
+            }
+        };
+
+#if defined(GEOMETRY_AVX_DECOMPOSITION)
+        // Eight matrices at a time, one in each lane
+        typedef __m256 LaneRegister;
+
+        static const size_t LANE_COUNT = 8;
+
+        static inline __m256 setLanes(const float value) { return _mm256_set1_ps(value); }
+        static inline __m256 addLanes(const __m256 a, const __m256 b) { return _mm256_add_ps(a, b); }
+        static inline __m256 subtractLanes(const __m256 a, const __m256 b) { return _mm256_sub_ps(a, b); }
+        static inline __m256 multiplyLanes(const __m256 a, const __m256 b) { return _mm256_mul_ps(a, b); }
+        static inline __m256 divideLanes(const __m256 a, const __m256 b) { return _mm256_div_ps(a, b); }
+        static inline __m256 squareRootLanes(const __m256 a) { return _mm256_sqrt_ps(a); }
+        static inline __m256 minimumLanes(const __m256 a, const __m256 b) { return _mm256_min_ps(a, b); }
+        static inline __m256 maximumLanes(const __m256 a, const __m256 b) { return _mm256_max_ps(a, b); }
+        static inline __m256 andLanes(const __m256 a, const __m256 b) { return _mm256_and_ps(a, b); }
+        static inline __m256 andNotLanes(const __m256 a, const __m256 b) { return _mm256_andnot_ps(a, b); }
+        static inline __m256 xorLanes(const __m256 a, const __m256 b) { return _mm256_xor_ps(a, b); }
+        static inline __m256 lessLanes(const __m256 a, const __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static inline __m256 selectLanes(const __m256 mask, const __m256 chosen, const __m256 other) { return _mm256_blendv_ps(other, chosen, mask); }
+        static inline void storeRegister(float * values, const __m256 a) { _mm256_store_ps(values, a); }
+#elif defined(GEOMETRY_SSE_DECOMPOSITION)
+        // Four matrices at a time, one in each lane
+        typedef __m128 LaneRegister;
+
+        static const size_t LANE_COUNT = 4;
+
+        static inline __m128 setLanes(const float value) { return _mm_set1_ps(value); }
+        static inline __m128 addLanes(const __m128 a, const __m128 b) { return _mm_add_ps(a, b); }
+        static inline __m128 subtractLanes(const __m128 a, const __m128 b) { return _mm_sub_ps(a, b); }
+        static inline __m128 multiplyLanes(const __m128 a, const __m128 b) { return _mm_mul_ps(a, b); }
+        static inline __m128 divideLanes(const __m128 a, const __m128 b) { return _mm_div_ps(a, b); }
+        static inline __m128 squareRootLanes(const __m128 a) { return _mm_sqrt_ps(a); }
+        static inline __m128 minimumLanes(const __m128 a, const __m128 b) { return _mm_min_ps(a, b); }
+        static inline __m128 maximumLanes(const __m128 a, const __m128 b) { return _mm_max_ps(a, b); }
+        static inline __m128 andLanes(const __m128 a, const __m128 b) { return _mm_and_ps(a, b); }
+        static inline __m128 andNotLanes(const __m128 a, const __m128 b) { return _mm_andnot_ps(a, b); }
+        static inline __m128 xorLanes(const __m128 a, const __m128 b) { return _mm_xor_ps(a, b); }
+        static inline __m128 lessLanes(const __m128 a, const __m128 b) { return _mm_cmplt_ps(a, b); }
+        static inline __m128 selectLanes(const __m128 mask, const __m128 chosen, const __m128 other) { return _mm_or_ps(_mm_and_ps(mask, chosen), _mm_andnot_ps(mask, other)); }
+        static inline void storeRegister(float * values, const __m128 a) { _mm_store_ps(values, a); }
+#endif
+
+#ifdef GEOMETRY_SSE_DECOMPOSITION
+        struct Lanes
+        {
+            LaneRegister value;
+
+            inline Lanes()
+            {
+            }
+
+            inline Lanes(const LaneRegister value) : value(value)
+            {
+            }
+
+            explicit inline Lanes(const float value) : value(setLanes(value))
+            {
+            }
+        };
+
+        static inline Lanes operator+ (const Lanes a, const Lanes b)
+        {
+            return addLanes(a.value, b.value);
+        }
+
+        static inline Lanes operator- (const Lanes a, const Lanes b)
+        {
+            return subtractLanes(a.value, b.value);
+        }
+
+        static inline Lanes operator- (const Lanes a)
+        {
+            return xorLanes(a.value, setLanes(-0.0f));
+        }
+
+        static inline Lanes operator* (const Lanes a, const Lanes b)
+        {
+            return multiplyLanes(a.value, b.value);
+        }
+
+        static inline Lanes operator/ (const Lanes a, const Lanes b)
+        {
+            return divideLanes(a.value, b.value);
+        }
+
+        static inline Lanes squareRoot(const Lanes value)
+        {
+            return squareRootLanes(value.value);
+        }
+
+        static inline Lanes absolute(const Lanes value)
+        {
+            return andNotLanes(setLanes(-0.0f), value.value);
+        }
+
+        static inline Lanes minimum(const Lanes a, const Lanes b)
+        {
+            return minimumLanes(a.value, b.value);
+        }
+
+        static inline Lanes maximum(const Lanes a, const Lanes b)
+        {
+            return maximumLanes(a.value, b.value);
+        }
+
+        static inline Lanes isLess(const Lanes a, const Lanes b)
+        {
+            return lessLanes(a.value, b.value);
+        }
+
+        static inline Lanes select(const Lanes mask, const Lanes chosen, const Lanes other)
+        {
+            return selectLanes(mask.value, chosen.value, other.value);
+        }
+
+        static inline Lanes multiplySign(const Lanes value, const Lanes sign)
+        {
+            return xorLanes(value.value, andLanes(setLanes(-0.0f), sign.value));
+        }
+
+        template<> struct DecompositionTraits<Lanes>
+        {
+            static const int32bit SWEEPS = DecompositionTraits<float>::SWEEPS;
+
+            static inline Lanes negligible()
+            {
+                return Lanes(DecompositionTraits<float>::negligible());
+            }
+        };
+#endif
+
+        // ======================== Building blocks ====================== //
+
+        template<typename T> static inline void setToIdentity(T (&matrix)[3][3])
+        {
+            for (int32bit row = 0; row < 3; row++) {
+                for (int32bit column = 0; column < 3; column++) {
+                    matrix[row][column] = T(row == column ? 1.0f : 0.0f);
+                }
+            }
+        }
+
+        // Entries far below the scale of the matrix are zeros, otherwise the
+        // converged entries multiply down to denormal numbers, which are many
+        // times slower to compute with
+        template<typename T> static inline T zeroNegligible(const T value)
+        {
+            return select(isLess(absolute(value), DecompositionTraits<T>::negligible()), T(0.0f), value);
+        }
+
+        // Divides the matrix by its largest entry, so squares neither overflow nor vanish
+        template<typename T> static inline T normalizeScale(T (&matrix)[3][3])
+        {
+            T scale = absolute(matrix[0][0]);
+
+            for (int32bit row = 0; row < 3; row++) {
+                for (int32bit column = 0; column < 3; column++) {
+                    scale = maximum(scale, absolute(matrix[row][column]));
+                }
+            }
+
+            scale = select(isLess(T(0.0f), scale), scale, T(1.0f));
+
+            const T inverse = T(1.0f) / scale;
+
+            for (int32bit row = 0; row < 3; row++) {
+                for (int32bit column = 0; column < 3; column++) {
+                    matrix[row][column] = matrix[row][column] * inverse;
+                }
+            }
+
+            return scale;
+        }
+
+        // A Jacobi rotation which zeroes the entry (p, q) of the symmetric
+        // matrix, accumulated in the columns p and q of the vectors
+        template<int32bit p, int32bit q, typename T> static inline void rotateJacobi(T (&matrix)[3][3], T (&vectors)[3][3])
+        {
+            const int32bit r = 3 - p - q;
+
+            const T offDiagonal = zeroNegligible(matrix[p][q]);
+            const T difference = matrix[q][q] - matrix[p][p];
+            const T twice = offDiagonal + offDiagonal;
+            const T radius = squareRoot(difference * difference + twice * twice);
+
+            // The tangent of the smaller of the two angles, it is at most one
+            const T one(1.0f);
+            const T denominator = maximum(absolute(difference) + radius, DecompositionTraits<T>::negligible());
+            const T tangent = minimum(maximum(multiplySign(twice, difference) / denominator, -one), one);
+            const T cosine = one / squareRoot(one + tangent * tangent);
+            const T sine = tangent * cosine;
+
+            matrix[p][p] = matrix[p][p] - tangent * offDiagonal;
+            matrix[q][q] = matrix[q][q] + tangent * offDiagonal;
+            matrix[p][q] = T(0.0f);
+            matrix[q][p] = T(0.0f);
+
+            const T rp = matrix[r][p];
+            const T rq = matrix[r][q];
+
+            matrix[r][p] = cosine * rp - sine * rq;
+            matrix[r][q] = sine * rp + cosine * rq;
+            matrix[p][r] = matrix[r][p];
+            matrix[q][r] = matrix[r][q];
+
+            for (int32bit row = 0; row < 3; row++) {
+                const T vp = vectors[row][p];
+                const T vq = vectors[row][q];
+
+                vectors[row][p] = cosine * vp - sine * vq;
+                vectors[row][q] = sine * vp + cosine * vq;
+            }
+        }
+
+        // Diagonalizes the symmetric matrix, the vectors get the rotation
+        template<typename T> static inline void diagonalize(T (&matrix)[3][3], T (&vectors)[3][3])
+        {
+            setToIdentity(vectors);
+
+            for (int32bit sweep = 0; sweep < DecompositionTraits<T>::SWEEPS; sweep++) {
+                rotateJacobi<0, 1>(matrix, vectors);
+                rotateJacobi<0, 2>(matrix, vectors);
+                rotateJacobi<1, 2>(matrix, vectors);
+            }
+        }
+
+        // Swaps the columns i and j where the mask is set
+        template<int32bit i, int32bit j, typename T, typename Mask> static inline void swapColumns(const Mask mask, T (&matrix)[3][3])
+        {
+            for (int32bit row = 0; row < 3; row++) {
+                const T a = matrix[row][i];
+                const T b = matrix[row][j];
+
+                matrix[row][i] = select(mask, b, a);
+                matrix[row][j] = select(mask, a, b);
+            }
+        }
+
+        // Swaps the columns i and j where the mask is set negating one of
+        // them, so a rotation stays a rotation
+        template<int32bit i, int32bit j, typename T, typename Mask> static inline void swapColumnsNegated(const Mask mask, T (&matrix)[3][3])
+        {
+            for (int32bit row = 0; row < 3; row++) {
+                const T a = matrix[row][i];
+                const T b = matrix[row][j];
+
+                matrix[row][i] = select(mask, b, a);
+                matrix[row][j] = select(mask, -a, b);
+            }
+        }
+
+        template<int32bit i, int32bit j, typename T> static inline void sortEigenPair(T (&values)[3], T (&vectors)[3][3])
+        {
+            const auto mask = isLess(values[i], values[j]);
+            const T a = values[i];
+            const T b = values[j];
+
+            values[i] = select(mask, b, a);
+            values[j] = select(mask, a, b);
+
+            swapColumns<i, j>(mask, vectors);
+        }
+
+        // Orders the columns of the product and of v by length, descending
+        template<int32bit i, int32bit j, typename T> static inline void sortColumns(T (&lengths)[3], T (&product)[3][3], T (&v)[3][3])
+        {
+            const auto mask = isLess(lengths[i], lengths[j]);
+            const T a = lengths[i];
+            const T b = lengths[j];
+
+            lengths[i] = select(mask, b, a);
+            lengths[j] = select(mask, a, b);
+
+            swapColumnsNegated<i, j>(mask, product);
+            swapColumnsNegated<i, j>(mask, v);
+        }
+
+        // A Givens rotation of the rows i and j which zeroes the entry (j, column)
+        // leaving a non-negative entry (i, column), accumulated in the columns
+        // i and j of the rotation
+        template<int32bit i, int32bit j, int32bit column, typename T> static inline void rotateGivens(T (&matrix)[3][3], T (&rotation)[3][3])
+        {
+            const T a = matrix[i][column];
+            const T b = zeroNegligible(matrix[j][column]);
+            const T negligible = DecompositionTraits<T>::negligible();
+            const T length = squareRoot(a * a + b * b);
+            const T inverse = T(1.0f) / maximum(length, negligible);
+            const auto valid = isLess(negligible, length);
+            const T cosine = select(valid, a * inverse, T(1.0f));
+            const T sine = select(valid, b * inverse, T(0.0f));
+
+            for (int32bit k = 0; k < 3; k++) {
+                const T ik = matrix[i][k];
+                const T jk = matrix[j][k];
+
+                matrix[i][k] = cosine * ik + sine * jk;
+                matrix[j][k] = cosine * jk - sine * ik;
+
+                const T ki = rotation[k][i];
+                const T kj = rotation[k][j];
+
+                rotation[k][i] = cosine * ki + sine * kj;
+                rotation[k][j] = cosine * kj - sine * ki;
+            }
+        }
+
+        // ======================== Decompositions ======================= //
+
+        template<typename T> static inline void findEigenPairs(T (&matrix)[3][3], T (&values)[3], T (&vectors)[3][3])
+        {
+            matrix[1][0] = matrix[0][1];
+            matrix[2][0] = matrix[0][2];
+            matrix[2][1] = matrix[1][2];
+
+            const T scale = normalizeScale(matrix);
+
+            diagonalize(matrix, vectors);
+
+            for (int32bit i = 0; i < 3; i++) {
+                values[i] = matrix[i][i] * scale;
+            }
+
+            sortEigenPair<0, 1>(values, vectors);
+            sortEigenPair<1, 2>(values, vectors);
+            sortEigenPair<0, 1>(values, vectors);
+
+            // The sorting may have made a reflection
+            vectors[0][2] = vectors[1][0] * vectors[2][1] - vectors[2][0] * vectors[1][1];
+            vectors[1][2] = vectors[2][0] * vectors[0][1] - vectors[0][0] * vectors[2][1];
+            vectors[2][2] = vectors[0][0] * vectors[1][1] - vectors[1][0] * vectors[0][1];
+        }
+
+        // The scheme of McAdams et al.: the rotation v diagonalizes the
+        // transposed matrix by the matrix, the columns of matrix * v are
+        // ordered by length and the QR decomposition of them by Givens
+        // rotations gives u and the singular values.
+        template<typename T> static inline void findSingularValues(T (&matrix)[3][3], T (&u)[3][3], T (&values)[3], T (&v)[3][3])
+        {
+            const T scale = normalizeScale(matrix);
+
+            T square[3][3];
+
+            for (int32bit i = 0; i < 3; i++) {
+                for (int32bit j = i; j < 3; j++) {
+                    square[i][j] = matrix[0][i] * matrix[0][j] + matrix[1][i] * matrix[1][j] + matrix[2][i] * matrix[2][j];
+                    square[j][i] = square[i][j];
+                }
+            }
+
+            diagonalize(square, v);
+
+            T product[3][3];
+
+            for (int32bit row = 0; row < 3; row++) {
+                for (int32bit column = 0; column < 3; column++) {
+                    product[row][column] = matrix[row][0] * v[0][column] + matrix[row][1] * v[1][column] + matrix[row][2] * v[2][column];
+                }
+            }
+
+            T lengths[3];
+
+            for (int32bit column = 0; column < 3; column++) {
+                lengths[column] = product[0][column] * product[0][column] + product[1][column] * product[1][column] + product[2][column] * product[2][column];
+            }
+
+            sortColumns<0, 1>(lengths, product, v);
+            sortColumns<1, 2>(lengths, product, v);
+            sortColumns<0, 1>(lengths, product, v);
+
+            setToIdentity(u);
+
+            rotateGivens<0, 1, 0>(product, u);
+            rotateGivens<0, 2, 0>(product, u);
+            rotateGivens<1, 2, 1>(product, u);
+
+            for (int32bit i = 0; i < 3; i++) {
+                values[i] = product[i][i] * scale;
+            }
+        }
+
+        // ======================== Loading, storing ===================== //
+
+        template<typename T> static inline void loadMatrix(const T * data, T (&matrix)[3][3])
+        {
+            for (int32bit i = 0; i < 9; i++) {
+                matrix[i / 3][i % 3] = data[i];
+            }
+        }
+
+        template<typename T> static inline void storeMatrix(const T (&matrix)[3][3], T * data)
+        {
+            for (int32bit i = 0; i < 9; i++) {
+                data[i] = matrix[i / 3][i % 3];
+            }
+        }
+
+        template<typename T> static inline void storeVector(const T (&values)[3], T * data)
+        {
+            data[0] = values[0];
+            data[1] = values[1];
+            data[2] = values[2];
+        }
+
+#ifdef GEOMETRY_SSE_DECOMPOSITION
+        // An element of consecutive matrices or vectors with the given stride
+        static inline Lanes loadLanes(const float * data, const size_t stride)
+        {
+            alignas(32) float values[LANE_COUNT];
+
+            for (size_t lane = 0; lane < LANE_COUNT; lane++) {
+                values[lane] = data[lane * stride];
+            }
+
+            return Lanes(*(const LaneRegister *)values);
+        }
+
+        static inline void storeLanes(const Lanes lanes, float * data, const size_t stride)
+        {
+            alignas(32) float values[LANE_COUNT];
+
+            storeRegister(values, lanes.value);
+
+            for (size_t lane = 0; lane < LANE_COUNT; lane++) {
+                data[lane * stride] = values[lane];
+            }
+        }
+
+        static inline void loadMatrices(const Matrix3x3F * matrices, Lanes (&matrix)[3][3])
+        {
+            for (int32bit i = 0; i < 9; i++) {
+                matrix[i / 3][i % 3] = loadLanes(&matrices->r1c1 + i, 9);
+            }
+        }
+
+        static inline void storeMatrices(const Lanes (&matrix)[3][3], Matrix3x3F * matrices)
+        {
+            for (int32bit i = 0; i < 9; i++) {
+                storeLanes(matrix[i / 3][i % 3], &matrices->r1c1 + i, 9);
+            }
+        }
+
+        static inline void storeVectors(const Lanes (&values)[3], Vector3F * vectors)
+        {
+            for (int32bit i = 0; i < 3; i++) {
+                storeLanes(values[i], &vectors->x + i, 3);
+            }
+        }
+#endif
+
+        template<typename T, class MatrixType, class VectorType> static inline void decomposeSymmetricMatrix(const MatrixType & matrix, VectorType & eigenvalues, MatrixType & eigenvectors)
+        {
+            T input[3][3];
+            T values[3];
+            T vectors[3][3];
+
+            loadMatrix(&matrix.r1c1, input);
+            findEigenPairs(input, values, vectors);
+            storeVector(values, &eigenvalues.x);
+            storeMatrix(vectors, &eigenvectors.r1c1);
+        }
+
+        template<typename T, class MatrixType, class VectorType> static inline void decomposeMatrix(const MatrixType & matrix, MatrixType & u, VectorType & singularValues, MatrixType & v)
+        {
+            T input[3][3];
+            T left[3][3];
+            T values[3];
+            T right[3][3];
+
+            loadMatrix(&matrix.r1c1, input);
+            findSingularValues(input, left, values, right);
+            storeMatrix(left, &u.r1c1);
+            storeVector(values, &singularValues.x);
+            storeMatrix(right, &v.r1c1);
+        }
+
+        // ================ Symmetric eigen decomposition ================ //
+
+        void decomposeSymmetric(const Matrix3x3F & matrix, Vector3F & eigenvalues, Matrix3x3F & eigenvectors)
+        {
+            decomposeSymmetricMatrix<float>(matrix, eigenvalues, eigenvectors);
+        }
+
+        void decomposeSymmetric(const Matrix3x3 & matrix, Vector3 & eigenvalues, Matrix3x3 & eigenvectors)
+        {
+            decomposeSymmetricMatrix<double>(matrix, eigenvalues, eigenvectors);
+        }
+
+        // ================= Singular value decomposition ================ //
+
+        void decomposeSingularValues(const Matrix3x3F & matrix, Matrix3x3F & u, Vector3F & singularValues, Matrix3x3F & v)
+        {
+            decomposeMatrix<float>(matrix, u, singularValues, v);
+        }
+
+        void decomposeSingularValues(const Matrix3x3 & matrix, Matrix3x3 & u, Vector3 & singularValues, Matrix3x3 & v)
+        {
+            decomposeMatrix<double>(matrix, u, singularValues, v);
+        }
+
+        // ======================= Batch versions ======================== //
+
+        void decomposeSymmetric(const Matrix3x3F * matrices, Vector3F * eigenvalues, Matrix3x3F * eigenvectors, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("decomposition.symmetric.float");
+
+            parallelFor(0, count, DECOMPOSITION_GRAIN, [&](const size_t first, const size_t last) {
+                size_t i = first;
+
+#ifdef GEOMETRY_SSE_DECOMPOSITION
+                for (; i + LANE_COUNT <= last; i += LANE_COUNT) {
+                    Lanes input[3][3];
+                    Lanes values[3];
+                    Lanes vectors[3][3];
+
+                    loadMatrices(matrices + i, input);
+                    findEigenPairs(input, values, vectors);
+                    storeVectors(values, eigenvalues + i);
+                    storeMatrices(vectors, eigenvectors + i);
+                }
+#endif
+
+                for (; i < last; i++) {
+                    decomposeSymmetricMatrix<float>(matrices[i], eigenvalues[i], eigenvectors[i]);
+                }
+            }, threadCount);
+        }
+
+        void decomposeSymmetric(const Matrix3x3 * matrices, Vector3 * eigenvalues, Matrix3x3 * eigenvectors, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("decomposition.symmetric.double");
+
+            parallelFor(0, count, DECOMPOSITION_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    decomposeSymmetricMatrix<double>(matrices[i], eigenvalues[i], eigenvectors[i]);
+                }
+            }, threadCount);
+        }
+
+        void decomposeSingularValues(const Matrix3x3F * matrices, Matrix3x3F * u, Vector3F * singularValues, Matrix3x3F * v, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("decomposition.singular_values.float");
+
+            parallelFor(0, count, DECOMPOSITION_GRAIN, [&](const size_t first, const size_t last) {
+                size_t i = first;
+
+#ifdef GEOMETRY_SSE_DECOMPOSITION
+                for (; i + LANE_COUNT <= last; i += LANE_COUNT) {
+                    Lanes input[3][3];
+                    Lanes left[3][3];
+                    Lanes values[3];
+                    Lanes right[3][3];
+
+                    loadMatrices(matrices + i, input);
+                    findSingularValues(input, left, values, right);
+                    storeMatrices(left, u + i);
+                    storeVectors(values, singularValues + i);
+                    storeMatrices(right, v + i);
+                }
+#endif
+
+                for (; i < last; i++) {
+                    decomposeMatrix<float>(matrices[i], u[i], singularValues[i], v[i]);
+                }
+            }, threadCount);
+        }
+
+        void decomposeSingularValues(const Matrix3x3 * matrices, Matrix3x3 * u, Vector3 * singularValues, Matrix3x3 * v, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("decomposition.singular_values.double");
+
+            parallelFor(0, count, DECOMPOSITION_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    decomposeMatrix<double>(matrices[i], u[i], singularValues[i], v[i]);
+                }
+            }, threadCount);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
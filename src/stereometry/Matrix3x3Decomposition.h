@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_STEREOMETRY_MATRIX3X3_DECOMPOSITION_H_
+#define _GEOMETRY_STEREOMETRY_MATRIX3X3_DECOMPOSITION_H_
+
+#include <stddef.h>
+
+#include "../types.h"
+#include "Vector3.h"
+#include "Matrix3x3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // ================ Symmetric eigen decomposition ================ //
+
+        // matrix = eigenvectors * diag(eigenvalues) * transposed eigenvectors.
+        // Only the upper triangle of the matrix is read. The eigenvalues go
+        // in descending order, the eigenvectors are the columns in the same
+        // order and make a right-handed rotation. A fixed number of Jacobi
+        // sweeps is made, so the cost does not depend on the matrix.
+        void decomposeSymmetric(const Matrix3x3F & matrix, Vector3F & eigenvalues, Matrix3x3F & eigenvectors);
+        void decomposeSymmetric(const Matrix3x3 & matrix, Vector3 & eigenvalues, Matrix3x3 & eigenvectors);
+
+        // ================= Singular value decomposition ================ //
+
+        // matrix = u * diag(singularValues) * transposed v, where u and v are
+        // rotations. The singular values go in descending order of magnitude
+        // and the last one takes the sign of the determinant, so a rotation
+        // closest to the matrix is u * transposed v.
+        void decomposeSingularValues(const Matrix3x3F & matrix, Matrix3x3F & u, Vector3F & singularValues, Matrix3x3F & v);
+        void decomposeSingularValues(const Matrix3x3 & matrix, Matrix3x3 & u, Vector3 & singularValues, Matrix3x3 & v);
+
+        // ======================= Batch versions ======================== //
+
+        // The float versions take eight matrices at a time in AVX lanes or four
+        // in SSE lanes, all of them run on the threads of the shared pool.
+        void decomposeSymmetric(const Matrix3x3F * matrices, Vector3F * eigenvalues, Matrix3x3F * eigenvectors, const size_t count, const uint32bit threadCount = 0);
+        void decomposeSymmetric(const Matrix3x3 * matrices, Vector3 * eigenvalues, Matrix3x3 * eigenvectors, const size_t count, const uint32bit threadCount = 0);
+
+        void decomposeSingularValues(const Matrix3x3F * matrices, Matrix3x3F * u, Vector3F * singularValues, Matrix3x3F * v, const size_t count, const uint32bit threadCount = 0);
+        void decomposeSingularValues(const Matrix3x3 * matrices, Matrix3x3 * u, Vector3 * singularValues, Matrix3x3 * v, const size_t count, const uint32bit threadCount = 0);
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_MATRIX3X3_DECOMPOSITION_H_ */
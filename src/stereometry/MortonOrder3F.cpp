@@ -0,0 +1,88 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MortonOrder3F.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "../ThreadPool.h"
+#include "AxisBox3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        static const float LAST_CELL = 1023.0f;
+
+        // Spreads the low ten bits of the value to every third bit
+        static inline uint32bit spreadBits(uint32bit value)
+        {
+            value &= 0x3FF;
+            value = (value | (value << 16)) & 0x030000FF;
+            value = (value | (value << 8)) & 0x0300F00F;
+            value = (value | (value << 4)) & 0x030C30C3;
+            value = (value | (value << 2)) & 0x09249249;
+
+            return value;
+        }
+
+        // The comparisons are false for NaN, which takes it to the first cell
+        static inline uint32bit toCell(const float coordinate)
+        {
+            if (!(coordinate > 0.0f)) {
+                return 0;
+            }
+
+            return coordinate < LAST_CELL ? (uint32bit)coordinate : (uint32bit)LAST_CELL;
+        }
+
+        void sortInMortonOrder(const Vector3F * points, const size_t count, std::vector<uint32bit> & order, const uint32bit threadCount)
+        {
+            AxisBox3F bounds;
+
+            for (size_t i = 0; i < count; i++) {
+                if (isfinite(points[i].x) && isfinite(points[i].y) && isfinite(points[i].z)) {
+                    bounds.add(points[i]);
+                }
+            }
+
+            const Vector3F extent = bounds.maximum - bounds.minimum;
+            const float largest = std::max(extent.x, std::max(extent.y, extent.z));
+            const float scale = largest > 0.0f && isfinite(largest) ? LAST_CELL / largest : 0.0f;
+
+            std::vector<uint64bit> codes(count);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const Vector3F cell = (points[i] - bounds.minimum) * scale;
+                    const uint32bit code = spreadBits(toCell(cell.x)) | (spreadBits(toCell(cell.y)) << 1) | (spreadBits(toCell(cell.z)) << 2);
+
+                    codes[i] = ((uint64bit)code << 32) | (uint64bit)i;
+                }
+            }, threadCount);
+
+            std::sort(codes.begin(), codes.end());
+
+            order.resize(count);
+
+            for (size_t i = 0; i < count; i++) {
+                order[i] = (uint32bit)codes[i];
+            }
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_MORTON_ORDER3F_H_
+#define _GEOMETRY_STEREOMETRY_MORTON_ORDER3F_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "../types.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Fills order with the indices of the points sorted along a Morton
+        // curve through a 1024^3 grid over their bounding box, so points
+        // near each other in space are near each other in the order. The
+        // batch searches of the trees run their queries in this order.
+        //
+        // The box covers the finite points only: infinite coordinates fall
+        // into the edge cells and NaN ones into the first cell.
+        void sortInMortonOrder(const Vector3F * points, const size_t count, std::vector<uint32bit> & order, const uint32bit threadCount = 0);
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_MORTON_ORDER3F_H_ */
@@ -0,0 +1,556 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OcclusionCuller3F.h"
+
+#include <atomic>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_OCCLUSION_CULLER
+#endif
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        const uint32bit OcclusionCuller3F::REFINEMENT_TEXEL_LIMIT;
+
+        OcclusionCuller3F::OcclusionCuller3F()
+        {
+        }
+
+        OcclusionCuller3F::~OcclusionCuller3F()
+        {
+        }
+
+        bool OcclusionCuller3F::setSize(const uint32bit width, const uint32bit height)
+        {
+            if (!this->buffer.setSize(width, height)) {
+                return false;
+            }
+
+            this->levelWidths.clear();
+            this->levelHeights.clear();
+            this->levelOffsets.clear();
+
+            uint32bit levelWidth = width;
+            uint32bit levelHeight = height;
+            size_t offset = 0;
+
+            while (true) {
+                this->levelWidths.push_back(levelWidth);
+                this->levelHeights.push_back(levelHeight);
+                this->levelOffsets.push_back(offset);
+
+                offset += (size_t)levelWidth * levelHeight;
+
+                if (levelWidth == 1 && levelHeight == 1) {
+                    break;
+                }
+
+                levelWidth = (levelWidth + 1) / 2;
+                levelHeight = (levelHeight + 1) / 2;
+            }
+
+            this->minimalDepths.assign(offset, 0.0f);
+            this->maximalDepths.assign(offset, 0.0f);
+
+            this->buildHierarchy();
+
+            return true;
+        }
+
+        void OcclusionCuller3F::beginFrame(const Matrix4x4F & viewProjection)
+        {
+            this->viewProjection = viewProjection;
+            this->buffer.clear();
+        }
+
+        // ====================== Occluders ====================== //
+
+        void OcclusionCuller3F::projectOccluder(const Vector3F & a, const Vector3F & b, const Vector3F & c, const size_t index)
+        {
+            const float (&m)[4][4] = this->viewProjection.values;
+            const Vector3F * vertices[3] = { &a, &b, &c };
+
+            float clip[3][4];
+
+            for (uint32bit i = 0; i < 3; i++) {
+                const Vector3F & vertex = *vertices[i];
+
+                for (uint32bit row = 0; row < 4; row++) {
+                    clip[i][row] = m[row][0] * vertex.x + m[row][1] * vertex.y + m[row][2] * vertex.z + m[row][3];
+                }
+            }
+
+            // Clipping by the near plane Z = 0 leaves a triangle or a quadrangle
+            float polygon[4][4];
+            uint32bit corners = 0;
+
+            for (uint32bit i = 0; i < 3; i++) {
+                const float * current = clip[i];
+                const float * next = clip[i == 2 ? 0 : i + 1];
+
+                const bool currentInside = current[2] >= 0.0f;
+                const bool nextInside = next[2] >= 0.0f;
+
+                if (currentInside) {
+                    for (uint32bit row = 0; row < 4; row++) {
+                        polygon[corners][row] = current[row];
+                    }
+
+                    corners++;
+                }
+
+                if (currentInside != nextInside) {
+                    const float ratio = current[2] / (current[2] - next[2]);
+
+                    for (uint32bit row = 0; row < 4; row++) {
+                        polygon[corners][row] = current[row] + (next[row] - current[row]) * ratio;
+                    }
+
+                    corners++;
+                }
+            }
+
+            planimetry::Triangle2F * triangles = &this->projectedTriangles[index * 2];
+            float * depths = &this->projectedDepths[index * 6];
+
+            const planimetry::Vector2F origin(0.0f, 0.0f);
+
+            triangles[0].setValuesOf(origin, origin, origin);
+            triangles[1].setValuesOf(origin, origin, origin);
+
+            // The projection of the rest is not defined for a general matrix
+            for (uint32bit i = 0; i < corners; i++) {
+                if (!(polygon[i][3] > 0.0f)) {
+                    return;
+                }
+            }
+
+            const float halfWidth = this->buffer.getWidth() * 0.5f;
+            const float halfHeight = this->buffer.getHeight() * 0.5f;
+
+            float x[4], y[4], depth[4];
+
+            for (uint32bit i = 0; i < corners; i++) {
+                const float inverseW = 1.0f / polygon[i][3];
+
+                x[i] = (polygon[i][0] * inverseW + 1.0f) * halfWidth;
+                y[i] = (1.0f - polygon[i][1] * inverseW) * halfHeight;
+                depth[i] = polygon[i][2] * inverseW;
+            }
+
+            if (corners >= 3) {
+                triangles[0].setValuesOf(planimetry::Vector2F(x[0], y[0]), planimetry::Vector2F(x[1], y[1]), planimetry::Vector2F(x[2], y[2]));
+                depths[0] = depth[0];
+                depths[1] = depth[1];
+                depths[2] = depth[2];
+            }
+
+            if (corners == 4) {
+                triangles[1].setValuesOf(planimetry::Vector2F(x[0], y[0]), planimetry::Vector2F(x[2], y[2]), planimetry::Vector2F(x[3], y[3]));
+                depths[3] = depth[0];
+                depths[4] = depth[2];
+                depths[5] = depth[3];
+            }
+        }
+
+        void OcclusionCuller3F::rasterizeProjected(const size_t count, const uint32bit threadCount)
+        {
+            if (count > 0) {
+                this->rasterizer.rasterize(&this->projectedTriangles[0], &this->projectedDepths[0], 0, count * 2, this->buffer, threadCount);
+            }
+        }
+
+        void OcclusionCuller3F::addOccluders(const Triangle3F * triangles, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("occlusion.occluders");
+
+            this->projectedTriangles.resize(count * 2);
+            this->projectedDepths.resize(count * 6);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    this->projectOccluder(triangles[i].A, triangles[i].B, triangles[i].C, i);
+                }
+            }, threadCount);
+
+            this->rasterizeProjected(count, threadCount);
+        }
+
+        void OcclusionCuller3F::addOccluders(const IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("occlusion.occluders");
+
+            const size_t count = mesh.getTriangleCount();
+
+            this->projectedTriangles.resize(count * 2);
+            this->projectedDepths.resize(count * 6);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const uint32bit * indices = &mesh.indices[i * 3];
+                    this->projectOccluder(mesh.vertices[indices[0]], mesh.vertices[indices[1]], mesh.vertices[indices[2]], i);
+                }
+            }, threadCount);
+
+            this->rasterizeProjected(count, threadCount);
+        }
+
+        // ====================== Hierarchy ====================== //
+
+        void OcclusionCuller3F::buildHierarchy()
+        {
+            GEOMETRY_PROFILE_SCOPE("occlusion.hierarchy");
+
+            if (this->levelWidths.empty()) {
+                return;
+            }
+
+            const uint32bit width = this->buffer.getWidth();
+            const uint32bit height = this->buffer.getHeight();
+            const uint32bit stride = this->buffer.getStride();
+
+            for (uint32bit y = 0; y < height; y++) {
+                const float * source = &this->buffer.depth[(size_t)y * stride];
+                float * minimal = &this->minimalDepths[(size_t)y * width];
+                float * maximal = &this->maximalDepths[(size_t)y * width];
+
+                for (uint32bit x = 0; x < width; x++) {
+                    minimal[x] = source[x];
+                    maximal[x] = source[x];
+                }
+            }
+
+            for (size_t level = 1; level < this->levelWidths.size(); level++) {
+                const uint32bit sourceWidth = this->levelWidths[level - 1];
+                const uint32bit sourceHeight = this->levelHeights[level - 1];
+                const uint32bit targetWidth = this->levelWidths[level];
+                const uint32bit targetHeight = this->levelHeights[level];
+
+                const size_t sourceOffset = this->levelOffsets[level - 1];
+                const size_t targetOffset = this->levelOffsets[level];
+
+                for (uint32bit y = 0; y < targetHeight; y++) {
+                    const uint32bit y0 = y * 2;
+                    const uint32bit y1 = y0 + 1 < sourceHeight ? y0 + 1 : y0;
+
+                    for (uint32bit x = 0; x < targetWidth; x++) {
+                        const uint32bit x0 = x * 2;
+                        const uint32bit x1 = x0 + 1 < sourceWidth ? x0 + 1 : x0;
+
+                        const size_t i00 = sourceOffset + (size_t)y0 * sourceWidth + x0;
+                        const size_t i01 = sourceOffset + (size_t)y0 * sourceWidth + x1;
+                        const size_t i10 = sourceOffset + (size_t)y1 * sourceWidth + x0;
+                        const size_t i11 = sourceOffset + (size_t)y1 * sourceWidth + x1;
+
+                        const float * minimal = &this->minimalDepths[0];
+                        const float * maximal = &this->maximalDepths[0];
+
+                        const float minimal0 = minimal[i00] < minimal[i01] ? minimal[i00] : minimal[i01];
+                        const float minimal1 = minimal[i10] < minimal[i11] ? minimal[i10] : minimal[i11];
+                        const float maximal0 = maximal[i00] > maximal[i01] ? maximal[i00] : maximal[i01];
+                        const float maximal1 = maximal[i10] > maximal[i11] ? maximal[i10] : maximal[i11];
+
+                        const size_t target = targetOffset + (size_t)y * targetWidth + x;
+
+                        this->minimalDepths[target] = minimal0 < minimal1 ? minimal0 : minimal1;
+                        this->maximalDepths[target] = maximal0 > maximal1 ? maximal0 : maximal1;
+                    }
+                }
+            }
+        }
+
+        // ====================== Box queries ====================== //
+
+        void OcclusionCuller3F::projectBox(const AxisBox3F & box, ScreenBounds & bounds) const
+        {
+            const float (&m)[4][4] = this->viewProjection.values;
+
+            float minimalX = 3.402823466E+38f, maximalX = -3.402823466E+38f;
+            float minimalY = 3.402823466E+38f, maximalY = -3.402823466E+38f;
+            float nearestDepth = 3.402823466E+38f;
+
+            uint32bit inFront = 0;
+
+            for (uint32bit corner = 0; corner < 8; corner++) {
+                const float x = (corner & 1) == 0 ? box.minimum.x : box.maximum.x;
+                const float y = (corner & 2) == 0 ? box.minimum.y : box.maximum.y;
+                const float z = (corner & 4) == 0 ? box.minimum.z : box.maximum.z;
+
+                const float clipX = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+                const float clipY = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+                const float clipZ = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+                const float clipW = m[3][0] * x + m[3][1] * y + m[3][2] * z + m[3][3];
+
+                if (!(clipZ >= 0.0f && clipW > 0.0f)) {
+                    continue;
+                }
+
+                inFront++;
+
+                const float inverseW = 1.0f / clipW;
+                const float projectedX = clipX * inverseW;
+                const float projectedY = clipY * inverseW;
+                const float depth = clipZ * inverseW;
+
+                minimalX = projectedX < minimalX ? projectedX : minimalX;
+                maximalX = projectedX > maximalX ? projectedX : maximalX;
+                minimalY = projectedY < minimalY ? projectedY : minimalY;
+                maximalY = projectedY > maximalY ? projectedY : maximalY;
+                nearestDepth = depth < nearestDepth ? depth : nearestDepth;
+            }
+
+            const float halfWidth = this->buffer.getWidth() * 0.5f;
+            const float halfHeight = this->buffer.getHeight() * 0.5f;
+
+            bounds.minimalX = (minimalX + 1.0f) * halfWidth;
+            bounds.maximalX = (maximalX + 1.0f) * halfWidth;
+            bounds.minimalY = (1.0f - maximalY) * halfHeight;
+            bounds.maximalY = (1.0f - minimalY) * halfHeight;
+            bounds.nearestDepth = nearestDepth;
+            bounds.crossesNear = inFront != 8;
+            bounds.behindNear = inFront == 0;
+        }
+
+#ifdef GEOMETRY_SSE_OCCLUSION_CULLER
+
+        // The boxes are in the lanes: every corner of the four boxes is
+        // the sum of the column terms of its coordinates
+        void OcclusionCuller3F::projectBoxes(const AxisBox3F * boxes, ScreenBounds * bounds) const
+        {
+            const float (&m)[4][4] = this->viewProjection.values;
+
+            __m128 coordinates[3][2];
+
+            coordinates[0][0] = _mm_setr_ps(boxes[0].minimum.x, boxes[1].minimum.x, boxes[2].minimum.x, boxes[3].minimum.x);
+            coordinates[1][0] = _mm_setr_ps(boxes[0].minimum.y, boxes[1].minimum.y, boxes[2].minimum.y, boxes[3].minimum.y);
+            coordinates[2][0] = _mm_setr_ps(boxes[0].minimum.z, boxes[1].minimum.z, boxes[2].minimum.z, boxes[3].minimum.z);
+            coordinates[0][1] = _mm_setr_ps(boxes[0].maximum.x, boxes[1].maximum.x, boxes[2].maximum.x, boxes[3].maximum.x);
+            coordinates[1][1] = _mm_setr_ps(boxes[0].maximum.y, boxes[1].maximum.y, boxes[2].maximum.y, boxes[3].maximum.y);
+            coordinates[2][1] = _mm_setr_ps(boxes[0].maximum.z, boxes[1].maximum.z, boxes[2].maximum.z, boxes[3].maximum.z);
+
+            // terms[axis][side][row] = m[row][axis] * coordinate
+            __m128 terms[3][2][4];
+
+            for (uint32bit axis = 0; axis < 3; axis++) {
+                for (uint32bit side = 0; side < 2; side++) {
+                    for (uint32bit row = 0; row < 4; row++) {
+                        terms[axis][side][row] = _mm_mul_ps(_mm_set1_ps(m[row][axis]), coordinates[axis][side]);
+                    }
+                }
+            }
+
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+
+            __m128 minimalX = _mm_set1_ps(3.402823466E+38f);
+            __m128 maximalX = _mm_set1_ps(-3.402823466E+38f);
+            __m128 minimalY = minimalX;
+            __m128 maximalY = maximalX;
+            __m128 nearestDepth = minimalX;
+
+            __m128 allInFront = _mm_cmpeq_ps(zero, zero);
+            __m128 anyInFront = zero;
+
+            for (uint32bit corner = 0; corner < 8; corner++) {
+                const uint32bit sideX = corner & 1;
+                const uint32bit sideY = (corner >> 1) & 1;
+                const uint32bit sideZ = corner >> 2;
+
+                __m128 clip[4];
+
+                for (uint32bit row = 0; row < 4; row++) {
+                    clip[row] = _mm_add_ps(_mm_add_ps(terms[0][sideX][row], terms[1][sideY][row]), _mm_add_ps(terms[2][sideZ][row], _mm_set1_ps(m[row][3])));
+                }
+
+                const __m128 inFront = _mm_and_ps(_mm_cmpge_ps(clip[2], zero), _mm_cmpgt_ps(clip[3], zero));
+
+                allInFront = _mm_and_ps(allInFront, inFront);
+                anyInFront = _mm_or_ps(anyInFront, inFront);
+
+                // The corners behind the near plane do not take part
+                const __m128 inverseW = _mm_div_ps(one, _mm_or_ps(_mm_and_ps(inFront, clip[3]), _mm_andnot_ps(inFront, one)));
+
+                const __m128 projectedX = _mm_mul_ps(clip[0], inverseW);
+                const __m128 projectedY = _mm_mul_ps(clip[1], inverseW);
+                const __m128 depth = _mm_mul_ps(clip[2], inverseW);
+
+                minimalX = _mm_or_ps(_mm_and_ps(inFront, _mm_min_ps(minimalX, projectedX)), _mm_andnot_ps(inFront, minimalX));
+                maximalX = _mm_or_ps(_mm_and_ps(inFront, _mm_max_ps(maximalX, projectedX)), _mm_andnot_ps(inFront, maximalX));
+                minimalY = _mm_or_ps(_mm_and_ps(inFront, _mm_min_ps(minimalY, projectedY)), _mm_andnot_ps(inFront, minimalY));
+                maximalY = _mm_or_ps(_mm_and_ps(inFront, _mm_max_ps(maximalY, projectedY)), _mm_andnot_ps(inFront, maximalY));
+                nearestDepth = _mm_or_ps(_mm_and_ps(inFront, _mm_min_ps(nearestDepth, depth)), _mm_andnot_ps(inFront, nearestDepth));
+            }
+
+            const __m128 halfWidth = _mm_set1_ps(this->buffer.getWidth() * 0.5f);
+            const __m128 halfHeight = _mm_set1_ps(this->buffer.getHeight() * 0.5f);
+
+            float screenMinimalX[4], screenMaximalX[4], screenMinimalY[4], screenMaximalY[4], depths[4];
+
+            _mm_storeu_ps(screenMinimalX, _mm_mul_ps(_mm_add_ps(minimalX, one), halfWidth));
+            _mm_storeu_ps(screenMaximalX, _mm_mul_ps(_mm_add_ps(maximalX, one), halfWidth));
+            _mm_storeu_ps(screenMinimalY, _mm_mul_ps(_mm_sub_ps(one, maximalY), halfHeight));
+            _mm_storeu_ps(screenMaximalY, _mm_mul_ps(_mm_sub_ps(one, minimalY), halfHeight));
+            _mm_storeu_ps(depths, nearestDepth);
+
+            const int allMask = _mm_movemask_ps(allInFront);
+            const int anyMask = _mm_movemask_ps(anyInFront);
+
+            for (uint32bit lane = 0; lane < 4; lane++) {
+                bounds[lane].minimalX = screenMinimalX[lane];
+                bounds[lane].maximalX = screenMaximalX[lane];
+                bounds[lane].minimalY = screenMinimalY[lane];
+                bounds[lane].maximalY = screenMaximalY[lane];
+                bounds[lane].nearestDepth = depths[lane];
+                bounds[lane].crossesNear = ((allMask >> lane) & 1) == 0;
+                bounds[lane].behindNear = ((anyMask >> lane) & 1) == 0;
+            }
+        }
+
+#else
+
+        void OcclusionCuller3F::projectBoxes(const AxisBox3F * boxes, ScreenBounds * bounds) const
+        {
+            for (uint32bit lane = 0; lane < 4; lane++) {
+                this->projectBox(boxes[lane], bounds[lane]);
+            }
+        }
+
+#endif
+
+        bool OcclusionCuller3F::isRectangleVisible(const ScreenBounds & bounds) const
+        {
+            if (bounds.behindNear) {
+                return false;
+            }
+
+            if (bounds.crossesNear || this->levelWidths.empty()) {
+                return true;
+            }
+
+            const float width = (float)this->buffer.getWidth();
+            const float height = (float)this->buffer.getHeight();
+
+            if (!(bounds.maximalX >= 0.0f && bounds.maximalY >= 0.0f && bounds.minimalX < width && bounds.minimalY < height)) {
+                return false;
+            }
+
+            // The pixels touched by the rectangle
+            const uint32bit x0 = (uint32bit)(bounds.minimalX > 0.0f ? bounds.minimalX : 0.0f);
+            const uint32bit y0 = (uint32bit)(bounds.minimalY > 0.0f ? bounds.minimalY : 0.0f);
+            const uint32bit x1 = (uint32bit)(bounds.maximalX < width - 1.0f ? bounds.maximalX : width - 1.0f);
+            const uint32bit y1 = (uint32bit)(bounds.maximalY < height - 1.0f ? bounds.maximalY : height - 1.0f);
+
+            const uint32bit levelCount = (uint32bit)this->levelWidths.size();
+
+            uint32bit level = 0;
+
+            while (level + 1 < levelCount && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+                level++;
+            }
+
+            while (true) {
+                const uint32bit levelWidth = this->levelWidths[level];
+                const size_t offset = this->levelOffsets[level];
+
+                float minimal = 3.402823466E+38f;
+                float maximal = -3.402823466E+38f;
+
+                for (uint32bit y = y0 >> level; y <= (y1 >> level); y++) {
+                    const size_t row = offset + (size_t)y * levelWidth;
+
+                    for (uint32bit x = x0 >> level; x <= (x1 >> level); x++) {
+                        const float levelMinimal = this->minimalDepths[row + x];
+                        const float levelMaximal = this->maximalDepths[row + x];
+
+                        minimal = levelMinimal < minimal ? levelMinimal : minimal;
+                        maximal = levelMaximal > maximal ? levelMaximal : maximal;
+                    }
+                }
+
+                if (bounds.nearestDepth > maximal) {
+                    return false;
+                }
+
+                if (bounds.nearestDepth < minimal || level == 0) {
+                    return true;
+                }
+
+                level--;
+
+                const uint32bit texels = ((x1 >> level) - (x0 >> level) + 1) * ((y1 >> level) - (y0 >> level) + 1);
+
+                if (texels > REFINEMENT_TEXEL_LIMIT) {
+                    return true;
+                }
+            }
+        }
+
+        bool OcclusionCuller3F::isVisible(const AxisBox3F & box) const
+        {
+            if (box.isEmpty()) {
+                return false;
+            }
+
+            ScreenBounds bounds;
+            this->projectBox(box, bounds);
+
+            return this->isRectangleVisible(bounds);
+        }
+
+        size_t OcclusionCuller3F::testBoxes(const AxisBox3F * boxes, uint8bit * visible, const size_t count, const uint32bit threadCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("occlusion.boxes");
+
+            std::atomic<size_t> visibleCount(0);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                size_t localCount = 0;
+                size_t i = first;
+
+                ScreenBounds bounds[4];
+
+                for (; i + 4 <= last; i += 4) {
+                    this->projectBoxes(boxes + i, bounds);
+
+                    for (uint32bit lane = 0; lane < 4; lane++) {
+                        const bool result = !boxes[i + lane].isEmpty() && this->isRectangleVisible(bounds[lane]);
+
+                        visible[i + lane] = result ? 1 : 0;
+                        localCount += result ? 1 : 0;
+                    }
+                }
+
+                for (; i < last; i++) {
+                    const bool result = this->isVisible(boxes[i]);
+
+                    visible[i] = result ? 1 : 0;
+                    localCount += result ? 1 : 0;
+                }
+
+                visibleCount += localCount;
+            }, threadCount);
+
+            return visibleCount;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_OCCLUSION_CULLER3F_H_
+#define _GEOMETRY_STEREOMETRY_OCCLUSION_CULLER3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "../Matrix.h"
+#include "../planimetry/Rasterizer2F.h"
+#include "../planimetry/Triangle2.h"
+#include "AxisBox3.h"
+#include "IndexedMesh3F.h"
+#include "Triangle3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Software occlusion culling. The occluders are projected by a 4x4
+        // view-projection matrix (see Projection3F.h), clipped by the near
+        // plane and rasterized with their Z / W into a depth buffer of
+        // a low resolution. The buffer is reduced to the levels of the
+        // minimal and the maximal depth of 2x2 texels of the previous level.
+        //
+        // A box is tested on the level where its screen rectangle spans at
+        // most 2x2 texels: it is hidden when its nearest depth is behind the
+        // maximal depth there and visible when it is in front of the minimal
+        // one, otherwise the test goes a few levels down. Boxes crossing the
+        // near plane are visible, boxes behind the camera or outside the
+        // screen are not.
+        //
+        // The depth is sampled at the pixel centres, so an occluder
+        // is taken to cover the whole of every pixel whose centre it covers.
+        class OcclusionCuller3F
+        {
+        public:
+            // The test stops going down when a level has more texels to read
+            static const uint32bit REFINEMENT_TEXEL_LIMIT = 16;
+
+            OcclusionCuller3F();
+            virtual ~OcclusionCuller3F();
+
+            // Returns false when the size is zero or too large for the rasterizer
+            bool setSize(const uint32bit width, const uint32bit height);
+
+            // Sets the transformation and removes the occluders of the previous frame
+            void beginFrame(const Matrix4x4F & viewProjection);
+
+            // Rasterizes the triangles on the threads of the shared pool
+            void addOccluders(const Triangle3F * triangles, const size_t count, const uint32bit threadCount = 0);
+            void addOccluders(const IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+
+            // Reduces the depth buffer to the levels, must be called after
+            // the occluders are added and before the queries
+            void buildHierarchy();
+
+            bool isVisible(const AxisBox3F & box) const;
+
+            // Writes 1 for the visible boxes and 0 for the hidden ones,
+            // four boxes are projected at once. Returns the number of the
+            // visible boxes.
+            size_t testBoxes(const AxisBox3F * boxes, uint8bit * visible, const size_t count, const uint32bit threadCount = 0) const;
+
+            inline const Matrix4x4F & getViewProjection() const;
+            inline const planimetry::RasterBuffer2F & getDepthBuffer() const;
+
+            // Level 0 has the size of the depth buffer, the last one is 1x1
+            inline uint32bit getLevelCount() const;
+            inline uint32bit getLevelWidth(const uint32bit level) const;
+            inline uint32bit getLevelHeight(const uint32bit level) const;
+            inline float getMinimalDepth(const uint32bit level, const uint32bit x, const uint32bit y) const;
+            inline float getMaximalDepth(const uint32bit level, const uint32bit x, const uint32bit y) const;
+
+        private:
+            // The projection of a box in pixels, valid when the box is
+            // entirely in front of the near plane
+            struct ScreenBounds
+            {
+                float minimalX;
+                float minimalY;
+                float maximalX;
+                float maximalY;
+                float nearestDepth;
+
+                // Some corners are behind the near plane
+                bool crossesNear;
+
+                // All corners are behind the near plane
+                bool behindNear;
+            };
+
+            Matrix4x4F viewProjection;
+
+            planimetry::Rasterizer2F rasterizer;
+            planimetry::RasterBuffer2F buffer;
+
+            // Two slots for every occluder, an unused one is left degenerate
+            std::vector<planimetry::Triangle2F> projectedTriangles;
+            std::vector<float> projectedDepths;
+
+            std::vector<uint32bit> levelWidths;
+            std::vector<uint32bit> levelHeights;
+            std::vector<size_t> levelOffsets;
+            std::vector<float> minimalDepths;
+            std::vector<float> maximalDepths;
+
+            void rasterizeProjected(const size_t count, const uint32bit threadCount);
+
+            void projectOccluder(const Vector3F & a, const Vector3F & b, const Vector3F & c, const size_t index);
+
+            void projectBox(const AxisBox3F & box, ScreenBounds & bounds) const;
+            void projectBoxes(const AxisBox3F * boxes, ScreenBounds * bounds) const;
+
+            bool isRectangleVisible(const ScreenBounds & bounds) const;
+
+            OcclusionCuller3F(const OcclusionCuller3F &);
+            OcclusionCuller3F & operator=(const OcclusionCuller3F &);
+        };
+
+        const Matrix4x4F & OcclusionCuller3F::getViewProjection() const
+        {
+            return this->viewProjection;
+        }
+
+        const planimetry::RasterBuffer2F & OcclusionCuller3F::getDepthBuffer() const
+        {
+            return this->buffer;
+        }
+
+        uint32bit OcclusionCuller3F::getLevelCount() const
+        {
+            return (uint32bit)this->levelWidths.size();
+        }
+
+        uint32bit OcclusionCuller3F::getLevelWidth(const uint32bit level) const
+        {
+            return this->levelWidths[level];
+        }
+
+        uint32bit OcclusionCuller3F::getLevelHeight(const uint32bit level) const
+        {
+            return this->levelHeights[level];
+        }
+
+        float OcclusionCuller3F::getMinimalDepth(const uint32bit level, const uint32bit x, const uint32bit y) const
+        {
+            return this->minimalDepths[this->levelOffsets[level] + (size_t)y * this->levelWidths[level] + x];
+        }
+
+        float OcclusionCuller3F::getMaximalDepth(const uint32bit level, const uint32bit x, const uint32bit y) const
+        {
+            return this->maximalDepths[this->levelOffsets[level] + (size_t)y * this->levelWidths[level] + x];
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_OCCLUSION_CULLER3F_H_ */
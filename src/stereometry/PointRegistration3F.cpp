@@ -0,0 +1,722 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PointRegistration3F.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+#include "AxisBox3.h"
+#include "Matrix3x3.h"
+#include "Matrix3x3Decomposition.h"
+#include "MortonOrder3F.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Pairs summed together, a fixed part size keeps the sums the same
+        // for any number of threads
+        static const size_t SUM_PART_SIZE = 4096;
+
+        // Points whose normals are found together, their covariances are
+        // decomposed in one batch
+        static const size_t NORMAL_PART_SIZE = 256;
+
+        // The relative damping of the point-to-plane equations, it keeps the
+        // directions a flat target does not fix from moving
+        static const double PLANE_DAMPING = 1E-9;
+
+        // ========================= Rigid sums ========================== //
+
+        // The sums of the Kabsch method over pairs taken from two origins and
+        // the square distance of the pairs
+        struct RigidSums3
+        {
+            double count;
+            double source[3];
+            double target[3];
+            double cross[3][3];
+            double sourceSquare;
+            double square;
+
+            inline void reset()
+            {
+                this->count = 0.0;
+                this->sourceSquare = 0.0;
+                this->square = 0.0;
+
+                for (int32bit i = 0; i < 3; i++) {
+                    this->source[i] = 0.0;
+                    this->target[i] = 0.0;
+                    this->cross[i][0] = this->cross[i][1] = this->cross[i][2] = 0.0;
+                }
+            }
+
+            inline void add(const Vector3 & source, const Vector3 & target)
+            {
+                const double s[3] = { source.x, source.y, source.z };
+                const double t[3] = { target.x, target.y, target.z };
+
+                this->count += 1.0;
+                this->sourceSquare += s[0] * s[0] + s[1] * s[1] + s[2] * s[2];
+                this->square += (s[0] - t[0]) * (s[0] - t[0]) + (s[1] - t[1]) * (s[1] - t[1]) + (s[2] - t[2]) * (s[2] - t[2]);
+
+                for (int32bit i = 0; i < 3; i++) {
+                    this->source[i] += s[i];
+                    this->target[i] += t[i];
+                    this->cross[i][0] += t[i] * s[0];
+                    this->cross[i][1] += t[i] * s[1];
+                    this->cross[i][2] += t[i] * s[2];
+                }
+            }
+
+            inline void add(const RigidSums3 & sums)
+            {
+                this->count += sums.count;
+                this->sourceSquare += sums.sourceSquare;
+                this->square += sums.square;
+
+                for (int32bit i = 0; i < 3; i++) {
+                    this->source[i] += sums.source[i];
+                    this->target[i] += sums.target[i];
+
+                    for (int32bit j = 0; j < 3; j++) {
+                        this->cross[i][j] += sums.cross[i][j];
+                    }
+                }
+            }
+        };
+
+        // The sums of the linearized point-to-plane error: the upper triangle
+        // of the normal matrix, the right side and the square residual
+        struct PlaneSums3
+        {
+            double count;
+            double matrix[6][6];
+            double vector[6];
+            double square;
+
+            inline void reset()
+            {
+                this->count = 0.0;
+                this->square = 0.0;
+
+                for (int32bit i = 0; i < 6; i++) {
+                    this->vector[i] = 0.0;
+
+                    for (int32bit j = 0; j < 6; j++) {
+                        this->matrix[i][j] = 0.0;
+                    }
+                }
+            }
+
+            inline void add(const Vector3 & point, const Vector3 & target, const Vector3 & normal)
+            {
+                const double residual = (point - target).scalar(normal);
+                const Vector3 arm = point.vector(normal);
+                const double row[6] = { arm.x, arm.y, arm.z, normal.x, normal.y, normal.z };
+
+                this->count += 1.0;
+                this->square += residual * residual;
+
+                for (int32bit i = 0; i < 6; i++) {
+                    this->vector[i] -= row[i] * residual;
+
+                    for (int32bit j = i; j < 6; j++) {
+                        this->matrix[i][j] += row[i] * row[j];
+                    }
+                }
+            }
+
+            inline void add(const PlaneSums3 & sums)
+            {
+                this->count += sums.count;
+                this->square += sums.square;
+
+                for (int32bit i = 0; i < 6; i++) {
+                    this->vector[i] += sums.vector[i];
+
+                    for (int32bit j = i; j < 6; j++) {
+                        this->matrix[i][j] += sums.matrix[i][j];
+                    }
+                }
+            }
+        };
+
+        // Calls add(sums, first, last) for fixed parts of the range on the
+        // threads of the pool and adds the parts up in their order
+        template<class Sums, class Function> static void sumParts(const size_t count, Sums & total, const Function & add, const uint32bit threadCount)
+        {
+            std::vector<Sums> parts((count + SUM_PART_SIZE - 1) / SUM_PART_SIZE);
+
+            parallelFor(0, parts.size(), 1, [&](const size_t first, const size_t last) {
+                for (size_t part = first; part < last; part++) {
+                    parts[part].reset();
+                    add(parts[part], part * SUM_PART_SIZE, std::min(count, (part + 1) * SUM_PART_SIZE));
+                }
+            }, threadCount);
+
+            total.reset();
+
+            for (size_t part = 0; part < parts.size(); part++) {
+                total.add(parts[part]);
+            }
+        }
+
+        static inline Vector3 multiply(const Matrix3x3 & matrix, const Vector3 & vector)
+        {
+            return Vector3(
+                matrix.r1c1 * vector.x + matrix.r1c2 * vector.y + matrix.r1c3 * vector.z,
+                matrix.r2c1 * vector.x + matrix.r2c2 * vector.y + matrix.r2c3 * vector.z,
+                matrix.r3c1 * vector.x + matrix.r3c2 * vector.y + matrix.r3c3 * vector.z
+            );
+        }
+
+        static inline Matrix3x3 multiplyTransposed(const Matrix3x3 & a, const Matrix3x3 & b)
+        {
+            return Matrix3x3(
+                a.r1c1 * b.r1c1 + a.r1c2 * b.r1c2 + a.r1c3 * b.r1c3,
+                a.r1c1 * b.r2c1 + a.r1c2 * b.r2c2 + a.r1c3 * b.r2c3,
+                a.r1c1 * b.r3c1 + a.r1c2 * b.r3c2 + a.r1c3 * b.r3c3,
+                a.r2c1 * b.r1c1 + a.r2c2 * b.r1c2 + a.r2c3 * b.r1c3,
+                a.r2c1 * b.r2c1 + a.r2c2 * b.r2c2 + a.r2c3 * b.r2c3,
+                a.r2c1 * b.r3c1 + a.r2c2 * b.r3c2 + a.r2c3 * b.r3c3,
+                a.r3c1 * b.r1c1 + a.r3c2 * b.r1c2 + a.r3c3 * b.r1c3,
+                a.r3c1 * b.r2c1 + a.r3c2 * b.r2c2 + a.r3c3 * b.r2c3,
+                a.r3c1 * b.r3c1 + a.r3c2 * b.r3c2 + a.r3c3 * b.r3c3
+            );
+        }
+
+        // The rotation, the scale and the shift which move the source of the
+        // sums onto their target, the origins are added back to the shift
+        static bool solveRigid(const RigidSums3 & sums, const Vector3 & sourceOrigin, const Vector3 & targetOrigin, const bool withScale, Matrix3x3 & rotation, double & scale, Vector3 & shift)
+        {
+            if (sums.count <= 0.0) {
+                return false;
+            }
+
+            const Vector3 sourceCentre(sums.source[0] / sums.count, sums.source[1] / sums.count, sums.source[2] / sums.count);
+            const Vector3 targetCentre(sums.target[0] / sums.count, sums.target[1] / sums.count, sums.target[2] / sums.count);
+            const double s[3] = { sourceCentre.x, sourceCentre.y, sourceCentre.z };
+            const double t[3] = { targetCentre.x, targetCentre.y, targetCentre.z };
+
+            // The covariance of the target by the source about the centres
+            Matrix3x3 covariance;
+            double * entries = &covariance.r1c1;
+
+            for (int32bit i = 0; i < 3; i++) {
+                for (int32bit j = 0; j < 3; j++) {
+                    entries[i * 3 + j] = sums.cross[i][j] - sums.count * t[i] * s[j];
+                }
+            }
+
+            Matrix3x3 u;
+            Matrix3x3 v;
+            Vector3 singularValues;
+
+            decomposeSingularValues(covariance, u, singularValues, v);
+
+            // u and v are rotations and the last singular value is signed,
+            // so no reflection has to be undone
+            rotation = multiplyTransposed(u, v);
+            scale = 1.0;
+
+            if (withScale) {
+                const double variance = sums.sourceSquare - sums.count * sourceCentre.scalar(sourceCentre);
+
+                if (variance > 0.0) {
+                    scale = (singularValues.x + singularValues.y + singularValues.z) / variance;
+                }
+            }
+
+            shift = (targetCentre + targetOrigin) - multiply(rotation, sourceCentre + sourceOrigin) * scale;
+
+            return true;
+        }
+
+        // The unit quaternion of a rotation matrix by the method of Shepperd,
+        // from the largest of the four squares
+        static Quaternion toQuaternion(const Matrix3x3 & rotation)
+        {
+            const double trace = rotation.r1c1 + rotation.r2c2 + rotation.r3c3;
+
+            Quaternion result;
+
+            if (trace >= rotation.r1c1 && trace >= rotation.r2c2 && trace >= rotation.r3c3) {
+                const double root = sqrt(1.0 + trace) * 2.0;
+                result.setValues(0.25 * root, (rotation.r3c2 - rotation.r2c3) / root, (rotation.r1c3 - rotation.r3c1) / root, (rotation.r2c1 - rotation.r1c2) / root);
+            }
+            else if (rotation.r1c1 >= rotation.r2c2 && rotation.r1c1 >= rotation.r3c3) {
+                const double root = sqrt(1.0 + rotation.r1c1 - rotation.r2c2 - rotation.r3c3) * 2.0;
+                result.setValues((rotation.r3c2 - rotation.r2c3) / root, 0.25 * root, (rotation.r1c2 + rotation.r2c1) / root, (rotation.r1c3 + rotation.r3c1) / root);
+            }
+            else if (rotation.r2c2 >= rotation.r3c3) {
+                const double root = sqrt(1.0 + rotation.r2c2 - rotation.r1c1 - rotation.r3c3) * 2.0;
+                result.setValues((rotation.r1c3 - rotation.r3c1) / root, (rotation.r1c2 + rotation.r2c1) / root, 0.25 * root, (rotation.r2c3 + rotation.r3c2) / root);
+            }
+            else {
+                const double root = sqrt(1.0 + rotation.r3c3 - rotation.r1c1 - rotation.r2c2) * 2.0;
+                result.setValues((rotation.r2c1 - rotation.r1c2) / root, (rotation.r1c3 + rotation.r3c1) / root, (rotation.r2c3 + rotation.r3c2) / root, 0.25 * root);
+            }
+
+            result.normalize();
+
+            return result;
+        }
+
+        // The rotation by the angle of the length of the vector about it
+        static Matrix3x3 toRotation(const Vector3 & vector)
+        {
+            const double angle = vector.module();
+            const double sine = angle > 1E-12 ? sin(angle) / angle : 1.0;
+            const double cosine = angle > 1E-12 ? (1.0 - cos(angle)) / (angle * angle) : 0.5;
+
+            const double x = vector.x;
+            const double y = vector.y;
+            const double z = vector.z;
+
+            return Matrix3x3(
+                1.0 - cosine * (y * y + z * z), cosine * x * y - sine * z, cosine * x * z + sine * y,
+                cosine * x * y + sine * z, 1.0 - cosine * (x * x + z * z), cosine * y * z - sine * x,
+                cosine * x * z - sine * y, cosine * y * z + sine * x, 1.0 - cosine * (x * x + y * y)
+            );
+        }
+
+        // The angle of a rotation matrix
+        static double getRotationAngle(const Matrix3x3 & rotation)
+        {
+            const double cosine = (rotation.r1c1 + rotation.r2c2 + rotation.r3c3 - 1.0) * 0.5;
+
+            return acos(cosine < -1.0 ? -1.0 : (cosine > 1.0 ? 1.0 : cosine));
+        }
+
+        // Solves the damped point-to-plane equations by Cholesky decomposition
+        static bool solvePlane(const PlaneSums3 & sums, double (&solution)[6])
+        {
+            double lower[6][6];
+            double trace = 0.0;
+
+            for (int32bit i = 0; i < 6; i++) {
+                trace += sums.matrix[i][i];
+            }
+
+            const double damping = trace * PLANE_DAMPING;
+
+            for (int32bit i = 0; i < 6; i++) {
+                for (int32bit j = 0; j <= i; j++) {
+                    double value = sums.matrix[j][i] + (i == j ? damping : 0.0);
+
+                    for (int32bit k = 0; k < j; k++) {
+                        value -= lower[i][k] * lower[j][k];
+                    }
+
+                    if (i == j) {
+                        if (value <= 0.0) {
+                            return false;
+                        }
+
+                        lower[i][i] = sqrt(value);
+                    }
+                    else {
+                        lower[i][j] = value / lower[j][j];
+                    }
+                }
+            }
+
+            for (int32bit i = 0; i < 6; i++) {
+                double value = sums.vector[i];
+
+                for (int32bit k = 0; k < i; k++) {
+                    value -= lower[i][k] * solution[k];
+                }
+
+                solution[i] = value / lower[i][i];
+            }
+
+            for (int32bit i = 5; i >= 0; i--) {
+                double value = solution[i];
+
+                for (int32bit k = i + 1; k < 6; k++) {
+                    value -= lower[k][i] * solution[k];
+                }
+
+                solution[i] = value / lower[i][i];
+            }
+
+            return true;
+        }
+
+        // ======================== Rigid alignment ======================== //
+
+        static bool findRigidTransform(const Vector3F * source, const Vector3F * target, const size_t count, const bool withScale, Matrix3x3 & rotation, double & scale, Vector3 & shift, const uint32bit threadCount)
+        {
+            if (count == 0) {
+                return false;
+            }
+
+            // Sums from the first pair, so far clouds lose no precision
+            const Vector3 sourceOrigin(source[0]);
+            const Vector3 targetOrigin(target[0]);
+
+            RigidSums3 sums;
+
+            sumParts(count, sums, [&](RigidSums3 & part, const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    part.add(Vector3(source[i]) - sourceOrigin, Vector3(target[i]) - targetOrigin);
+                }
+            }, threadCount);
+
+            return solveRigid(sums, sourceOrigin, targetOrigin, withScale, rotation, scale, shift);
+        }
+
+        bool findRigidTransform(const Vector3F * source, const Vector3F * target, const size_t count, Converter3F & transform, const bool withScale, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("registration.rigid");
+
+            Matrix3x3 rotation;
+            double scale;
+            Vector3 shift;
+
+            if (!findRigidTransform(source, target, count, withScale, rotation, scale, shift, threadCount)) {
+                return false;
+            }
+
+            transform.warp = (rotation * scale).toFloat();
+            transform.shift = shift.toFloat();
+
+            return true;
+        }
+
+        bool findRigidTransform(const Vector3F * source, const Vector3F * target, const size_t count, QuaternionF & rotation, Vector3F & shift, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("registration.rigid");
+
+            Matrix3x3 matrix;
+            double scale;
+            Vector3 offset;
+
+            if (!findRigidTransform(source, target, count, false, matrix, scale, offset, threadCount)) {
+                return false;
+            }
+
+            rotation = toQuaternion(matrix).toFloat();
+            shift = offset.toFloat();
+
+            return true;
+        }
+
+        // ============================ Normals ============================ //
+
+        void estimateNormals(const PointTree3F & tree, const Vector3F * cloud, const Vector3F * points, Vector3F * normals, const size_t count, const uint32bit neighbours, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("registration.normals");
+
+            parallelFor(0, count, NORMAL_PART_SIZE, [&](const size_t first, const size_t last) {
+                const size_t size = last - first;
+
+                std::vector<NearestPoint3F> found(neighbours);
+                std::vector<Matrix3x3F> covariances(size);
+                std::vector<Vector3F> values(size);
+                std::vector<Matrix3x3F> vectors(size);
+
+                for (size_t i = 0; i < size; i++) {
+                    const uint32bit foundCount = tree.findNearest(points[first + i], found.data(), neighbours);
+
+                    Matrix3x3F & covariance = covariances[i];
+                    covariance.setToZero();
+
+                    if (foundCount < 3) {
+                        continue;
+                    }
+
+                    Vector3F centre(0.0f, 0.0f, 0.0f);
+
+                    for (uint32bit j = 0; j < foundCount; j++) {
+                        centre += cloud[found[j].index];
+                    }
+
+                    centre /= (float)foundCount;
+
+                    for (uint32bit j = 0; j < foundCount; j++) {
+                        const Vector3F offset = cloud[found[j].index] - centre;
+
+                        covariance.r1c1 += offset.x * offset.x;
+                        covariance.r1c2 += offset.x * offset.y;
+                        covariance.r1c3 += offset.x * offset.z;
+                        covariance.r2c2 += offset.y * offset.y;
+                        covariance.r2c3 += offset.y * offset.z;
+                        covariance.r3c3 += offset.z * offset.z;
+                    }
+                }
+
+                decomposeSymmetric(covariances.data(), values.data(), vectors.data(), size, 1);
+
+                for (size_t i = 0; i < size; i++) {
+                    const Matrix3x3F & vector = vectors[i];
+
+                    if (values[i].x > 0.0f) {
+                        normals[first + i].setValues(vector.r1c3, vector.r2c3, vector.r3c3);
+                    }
+                    else {
+                        normals[first + i].setToZero();
+                    }
+                }
+            }, threadCount);
+        }
+
+        // ======================= ICP registration ======================== //
+
+        const uint32bit IcpRegistration3F::DEFAULT_MAXIMUM_ITERATIONS;
+        const uint32bit IcpRegistration3F::DEFAULT_NORMAL_NEIGHBOURS;
+        constexpr float IcpRegistration3F::DEFAULT_TRIM_RATIO;
+        constexpr float IcpRegistration3F::DEFAULT_ANGLE_TOLERANCE;
+        constexpr float IcpRegistration3F::DEFAULT_SHIFT_TOLERANCE;
+
+        IcpRegistration3F::IcpRegistration3F()
+            : targetSize(0.0f),
+            maximumIterations(DEFAULT_MAXIMUM_ITERATIONS),
+            maximumDistance(3.402823466E+38f),
+            trimRatio(DEFAULT_TRIM_RATIO),
+            pointToPlane(true),
+            angleTolerance(DEFAULT_ANGLE_TOLERANCE),
+            shiftTolerance(DEFAULT_SHIFT_TOLERANCE),
+            iterationCount(0),
+            pairCount(0),
+            error(0.0f),
+            converged(false)
+        {
+            this->targetCentre.setToZero();
+        }
+
+        IcpRegistration3F::~IcpRegistration3F()
+        {
+        }
+
+        void IcpRegistration3F::setTarget(const Vector3F * points, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("icp.target");
+
+            this->targetPoints.assign(points, points + count);
+            this->targetNormals.clear();
+            this->tree.build(points, count, threadCount);
+
+            AxisBox3F bounds;
+            bounds.setToPoints(points, count);
+
+            this->targetCentre = count > 0 ? bounds.getCentre() : Vector3F(0.0f, 0.0f, 0.0f);
+            this->targetSize = count > 0 ? (bounds.maximum - bounds.minimum).module() : 0.0f;
+
+            if (this->pointToPlane) {
+                this->makeNormals(threadCount);
+            }
+        }
+
+        void IcpRegistration3F::clear()
+        {
+            this->tree.clear();
+            this->targetPoints.clear();
+            this->targetNormals.clear();
+            this->order.clear();
+            this->pairs.clear();
+            this->distances.clear();
+        }
+
+        void IcpRegistration3F::makeNormals(const uint32bit threadCount)
+        {
+            const size_t count = this->targetPoints.size();
+
+            this->targetNormals.resize(count);
+            estimateNormals(this->tree, this->targetPoints.data(), this->targetPoints.data(), this->targetNormals.data(), count, DEFAULT_NORMAL_NEIGHBOURS, threadCount);
+        }
+
+        bool IcpRegistration3F::align(const Vector3F * source, const size_t count, const Converter3F & initial, Converter3F & transform, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("icp.align");
+
+            this->iterationCount = 0;
+            this->pairCount = 0;
+            this->error = 0.0f;
+            this->converged = false;
+
+            if (!this->hasTarget() || count == 0) {
+                return false;
+            }
+
+            if (this->pointToPlane && this->targetNormals.size() != this->targetPoints.size()) {
+                this->makeNormals(threadCount);
+            }
+
+            // The source is paired in the Morton order of its points, so the
+            // searches near each other visit the same nodes
+            sortInMortonOrder(source, count, this->order, threadCount);
+
+            this->pairs.resize(count);
+            this->distances.resize(count);
+
+            for (size_t i = 0; i < count; i++) {
+                this->pairs[i].index = PointTree3F::NO_POINT;
+            }
+
+            // The steps are taken about the centre of the target, which keeps
+            // the point-to-plane equations well scaled
+            const Vector3 centre(this->targetCentre);
+            const double shiftLimit = (double)this->shiftTolerance * (double)this->targetSize;
+            const float slack = this->targetSize * 1E-6f;
+            const size_t minimalPairs = this->pointToPlane ? 6 : 3;
+
+            Matrix3x3 rotation(initial.warp);
+            Vector3 shift(initial.shift);
+
+            bool result = true;
+
+            while (this->iterationCount < this->maximumIterations) {
+                this->iterationCount++;
+
+                Converter3F current;
+                current.warp = rotation.toFloat();
+                current.shift = shift.toFloat();
+
+                // Every search is bounded by the distance to the previous
+                // pair, which the small steps of the later iterations keep near
+                parallelFor(0, count, 256, [&](const size_t first, const size_t last) {
+                    for (size_t i = first; i < last; i++) {
+                        const uint32bit index = this->order[i];
+                        const Vector3F point = current.convert(source[index]);
+
+                        NearestPoint3F & pair = this->pairs[index];
+                        float bound = this->maximumDistance;
+
+                        if (pair.index != PointTree3F::NO_POINT) {
+                            const float distance = (point - this->targetPoints[pair.index]).module() * 1.001f + slack;
+                            bound = std::min(bound, distance);
+                        }
+
+                        if (!this->tree.findNearest(point, pair, bound) && bound < this->maximumDistance) {
+                            this->tree.findNearest(point, pair, this->maximumDistance);
+                        }
+                    }
+                }, threadCount);
+
+                // Trimming keeps the given part of the nearest pairs
+                size_t validCount = 0;
+
+                for (size_t i = 0; i < count; i++) {
+                    if (this->pairs[i].index != PointTree3F::NO_POINT) {
+                        this->distances[validCount++] = this->pairs[i].distance;
+                    }
+                }
+
+                const size_t keptCount = (size_t)ceil((double)this->trimRatio * (double)validCount);
+
+                if (keptCount < minimalPairs) {
+                    result = false;
+                    break;
+                }
+
+                float threshold = 3.402823466E+38f;
+
+                if (keptCount < validCount) {
+                    std::nth_element(this->distances.begin(), this->distances.begin() + (keptCount - 1), this->distances.begin() + validCount);
+                    threshold = this->distances[keptCount - 1];
+                }
+
+                Matrix3x3 stepRotation;
+                Vector3 stepShift;
+                double square = 0.0;
+                double keptPairs = 0.0;
+
+                if (this->pointToPlane) {
+                    PlaneSums3 sums;
+
+                    sumParts(count, sums, [&](PlaneSums3 & part, const size_t first, const size_t last) {
+                        for (size_t i = first; i < last; i++) {
+                            const NearestPoint3F & pair = this->pairs[i];
+
+                            if (pair.index == PointTree3F::NO_POINT || pair.distance > threshold || this->targetNormals[pair.index].isZero()) {
+                                continue;
+                            }
+
+                            const Vector3 point = multiply(rotation, Vector3(source[i])) + shift - centre;
+                            part.add(point, Vector3(this->targetPoints[pair.index]) - centre, Vector3(this->targetNormals[pair.index]));
+                        }
+                    }, threadCount);
+
+                    double solution[6];
+
+                    if (sums.count < (double)minimalPairs || !solvePlane(sums, solution)) {
+                        result = false;
+                        break;
+                    }
+
+                    stepRotation = toRotation(Vector3(solution[0], solution[1], solution[2]));
+                    stepShift = centre - multiply(stepRotation, centre) + Vector3(solution[3], solution[4], solution[5]);
+                    square = sums.square;
+                    keptPairs = sums.count;
+                }
+                else {
+                    RigidSums3 sums;
+
+                    sumParts(count, sums, [&](RigidSums3 & part, const size_t first, const size_t last) {
+                        for (size_t i = first; i < last; i++) {
+                            const NearestPoint3F & pair = this->pairs[i];
+
+                            if (pair.index == PointTree3F::NO_POINT || pair.distance > threshold) {
+                                continue;
+                            }
+
+                            const Vector3 point = multiply(rotation, Vector3(source[i])) + shift - centre;
+                            part.add(point, Vector3(this->targetPoints[pair.index]) - centre);
+                        }
+                    }, threadCount);
+
+                    double scale;
+
+                    if (sums.count < (double)minimalPairs || !solveRigid(sums, centre, centre, false, stepRotation, scale, stepShift)) {
+                        result = false;
+                        break;
+                    }
+
+                    square = sums.square;
+                    keptPairs = sums.count;
+                }
+
+                rotation = stepRotation * rotation;
+                shift = multiply(stepRotation, shift) + stepShift;
+
+                this->pairCount = (size_t)keptPairs;
+                this->error = (float)sqrt(square / keptPairs);
+
+                // The step is measured by how far it moves the centre
+                const Vector3 move = multiply(stepRotation, centre) + stepShift - centre;
+
+                if (getRotationAngle(stepRotation) < this->angleTolerance && move.module() < shiftLimit) {
+                    this->converged = true;
+                    break;
+                }
+            }
+
+            transform.warp = rotation.toFloat();
+            transform.shift = shift.toFloat();
+
+            return result;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
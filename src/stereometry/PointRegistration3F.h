@@ -0,0 +1,243 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_STEREOMETRY_POINT_REGISTRATION3F_H_
+#define _GEOMETRY_STEREOMETRY_POINT_REGISTRATION3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "../Quaternion.h"
+#include "Vector3.h"
+#include "Converter3F.h"
+#include "PointTree3F.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // ======================== Rigid alignment ======================== //
+
+        // The rotation and the shift, with withScale also the uniform scale,
+        // which move every source[i] nearest to target[i] in the least squares
+        // sense: the Kabsch method, the Umeyama one with the scale. The sums
+        // are taken in double precision on the threads of the shared pool.
+        // Returns false when count is zero.
+        bool findRigidTransform(const Vector3F * source, const Vector3F * target, const size_t count, Converter3F & transform, const bool withScale = false, const uint32bit threadCount = 0);
+
+        // The same transform without the scale as a unit quaternion, which
+        // turns v into rotation * v * conjugated rotation, and the shift added
+        // after the rotation
+        bool findRigidTransform(const Vector3F * source, const Vector3F * target, const size_t count, QuaternionF & rotation, Vector3F & shift, const uint32bit threadCount = 0);
+
+        // ============================ Normals ============================ //
+
+        // normals[i] is the unit normal of the plane fitted to the given
+        // number of points of the cloud nearest to points[i]: the eigenvector
+        // of the least eigenvalue of their covariance, its sign is arbitrary.
+        // The tree is the one of the cloud. A normal is zero when fewer than
+        // three points are found. The points run on the threads of the shared
+        // pool, the covariances are decomposed in batches.
+        void estimateNormals(const PointTree3F & tree, const Vector3F * cloud, const Vector3F * points, Vector3F * normals, const size_t count, const uint32bit neighbours = 8, const uint32bit threadCount = 0);
+
+        // ==================== ICP registration header ==================== //
+
+        // Iterative closest point alignment of source clouds onto a fixed
+        // target cloud. Every iteration pairs each moved source point with its
+        // nearest target point, drops the pairs farther than the maximum
+        // distance and then the farthest ones beyond the trim ratio, and
+        // solves for the step of the transform: by the Kabsch method for the
+        // point-to-point error, by linearized least squares for the
+        // point-to-plane error with the normals of the target. The search of a
+        // point starts from the distance to its pair of the last iteration.
+        // Pairing and sums run on the threads of the shared pool.
+        class IcpRegistration3F
+        {
+        public:
+            static const uint32bit DEFAULT_MAXIMUM_ITERATIONS = 30;
+            static const uint32bit DEFAULT_NORMAL_NEIGHBOURS = 8;
+
+            static constexpr float DEFAULT_TRIM_RATIO = 0.9f;
+
+            // A step of the rotation, in radians
+            static constexpr float DEFAULT_ANGLE_TOLERANCE = 1E-5f;
+
+            // A step of the shift, as a part of the size of the target bounds
+            static constexpr float DEFAULT_SHIFT_TOLERANCE = 1E-5f;
+
+            IcpRegistration3F();
+            virtual ~IcpRegistration3F();
+
+            // Copies the target cloud, builds its tree and, for the
+            // point-to-plane error, its normals
+            void setTarget(const Vector3F * points, const size_t count, const uint32bit threadCount = 0);
+
+            void clear();
+
+            inline bool hasTarget() const;
+            inline const PointTree3F & getTree() const;
+            inline const std::vector<Vector3F> & getTargetNormals() const;
+
+            inline uint32bit getMaximumIterations() const;
+            inline void setMaximumIterations(const uint32bit iterations);
+
+            // Pairs farther than this are dropped; a point with no target
+            // point this near searches this far on every iteration, so a bound
+            // near the expected misalignment keeps the outliers cheap
+            inline float getMaximumDistance() const;
+            inline void setMaximumDistance(const float distance);
+
+            // The part of the pairs kept, the nearest ones
+            inline float getTrimRatio() const;
+            inline void setTrimRatio(const float ratio);
+
+            // Set by default; the normals are made by the next setTarget()
+            // or align() if they are missing
+            inline bool isPointToPlane() const;
+            inline void setPointToPlane(const bool pointToPlane);
+
+            // The iterations stop once a step rotates by less than the angle
+            // and shifts by less than the part of the size of the target
+            inline void setTolerances(const float angle, const float shift);
+
+            // Moves the source onto the target starting from the initial
+            // transform, which is taken as a rotation and a shift; transform
+            // may be initial. Returns false without a target or when an
+            // iteration keeps too few pairs to fix the transform.
+            bool align(const Vector3F * source, const size_t count, const Converter3F & initial, Converter3F & transform, const uint32bit threadCount = 0);
+
+            // The iterations, the kept pairs and their root mean square
+            // error of the last alignment, the error is measured before its
+            // last step
+            inline uint32bit getIterationCount() const;
+            inline size_t getPairCount() const;
+            inline float getError() const;
+            inline bool isConverged() const;
+
+        private:
+            PointTree3F tree;
+            std::vector<Vector3F> targetPoints;
+            std::vector<Vector3F> targetNormals;
+            Vector3F targetCentre;
+            float targetSize;
+
+            uint32bit maximumIterations;
+            float maximumDistance;
+            float trimRatio;
+            bool pointToPlane;
+            float angleTolerance;
+            float shiftTolerance;
+
+            uint32bit iterationCount;
+            size_t pairCount;
+            float error;
+            bool converged;
+
+            std::vector<uint32bit> order;
+            std::vector<NearestPoint3F> pairs;
+            std::vector<float> distances;
+
+            void makeNormals(const uint32bit threadCount);
+        };
+
+        // ================= ICP registration inline methods ================ //
+
+        bool IcpRegistration3F::hasTarget() const
+        {
+            return !this->tree.isEmpty();
+        }
+
+        const PointTree3F & IcpRegistration3F::getTree() const
+        {
+            return this->tree;
+        }
+
+        const std::vector<Vector3F> & IcpRegistration3F::getTargetNormals() const
+        {
+            return this->targetNormals;
+        }
+
+        uint32bit IcpRegistration3F::getMaximumIterations() const
+        {
+            return this->maximumIterations;
+        }
+
+        void IcpRegistration3F::setMaximumIterations(const uint32bit iterations)
+        {
+            this->maximumIterations = iterations;
+        }
+
+        float IcpRegistration3F::getMaximumDistance() const
+        {
+            return this->maximumDistance;
+        }
+
+        void IcpRegistration3F::setMaximumDistance(const float distance)
+        {
+            this->maximumDistance = distance;
+        }
+
+        float IcpRegistration3F::getTrimRatio() const
+        {
+            return this->trimRatio;
+        }
+
+        void IcpRegistration3F::setTrimRatio(const float ratio)
+        {
+            this->trimRatio = ratio < 0.0f ? 0.0f : (ratio > 1.0f ? 1.0f : ratio);
+        }
+
+        bool IcpRegistration3F::isPointToPlane() const
+        {
+            return this->pointToPlane;
+        }
+
+        void IcpRegistration3F::setPointToPlane(const bool pointToPlane)
+        {
+            this->pointToPlane = pointToPlane;
+        }
+
+        void IcpRegistration3F::setTolerances(const float angle, const float shift)
+        {
+            this->angleTolerance = angle;
+            this->shiftTolerance = shift;
+        }
+
+        uint32bit IcpRegistration3F::getIterationCount() const
+        {
+            return this->iterationCount;
+        }
+
+        size_t IcpRegistration3F::getPairCount() const
+        {
+            return this->pairCount;
+        }
+
+        float IcpRegistration3F::getError() const
+        {
+            return this->error;
+        }
+
+        bool IcpRegistration3F::isConverged() const
+        {
+            return this->converged;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_POINT_REGISTRATION3F_H_ */
@@ -0,0 +1,369 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "PointTree3F.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+#include "AxisBox3.h"
+#include "MortonOrder3F.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Subtrees built apart on the threads, several for every thread so
+        // that the uneven ones even out
+        static const uint32bit SUBTREES_PER_THREAD = 8;
+
+        // Deeper than the median split of 2^32 points gets
+        static const uint32bit QUERY_STACK_SIZE = 64;
+
+        static inline float getCoordinate(const Vector3F & vector, const uint32bit axis)
+        {
+            return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+        }
+
+        // A point with its index in the cloud, sorted together while building
+        struct TreePoint3F
+        {
+            Vector3F point;
+            uint32bit index;
+        };
+
+        // Splits the points of the range at the median on the longest axis
+        // of their bounds, returns the first point of the upper half
+        static uint32bit splitPoints(TreePoint3F * points, const uint32bit first, const uint32bit last, uint32bit & axis, float & split)
+        {
+            AxisBox3F bounds;
+            bounds.minimum = bounds.maximum = points[first].point;
+
+            for (uint32bit i = first + 1; i < last; i++) {
+                bounds.add(points[i].point);
+            }
+
+            const Vector3F extent = bounds.maximum - bounds.minimum;
+
+            axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+            const uint32bit middle = first + (last - first) / 2;
+
+            std::nth_element(points + first, points + middle, points + last, [axis](const TreePoint3F & a, const TreePoint3F & b) {
+                return getCoordinate(a.point, axis) < getCoordinate(b.point, axis);
+            });
+
+            split = getCoordinate(points[middle].point, axis);
+
+            return middle;
+        }
+
+        // ========================= Point tree ========================== //
+
+        const uint32bit PointTree3F::LEAF_SIZE;
+        const uint32bit PointTree3F::NO_POINT;
+
+        PointTree3F::PointTree3F()
+        {
+        }
+
+        PointTree3F::~PointTree3F()
+        {
+        }
+
+        void PointTree3F::build(const Vector3F * points, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("point_tree.build");
+
+            this->clear();
+
+            if (count == 0) {
+                return;
+            }
+
+            std::vector<TreePoint3F> sorted(count);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    sorted[i].point = points[i];
+                    sorted[i].index = (uint32bit)i;
+                }
+            }, threadCount);
+
+            // A binary tree with leaves of at least one point has fewer than
+            // twice as many nodes as points
+            this->nodes.reserve(count / LEAF_SIZE * 4 + 1);
+
+            const size_t threads = threadCount > 0 ? threadCount : ThreadPool::getDefault().getThreadCount();
+
+            uint32bit depth = 0;
+
+            while (threads > 1 && ((size_t)1 << depth) < threads * SUBTREES_PER_THREAD && (count >> depth) > DEFAULT_PARALLEL_GRAIN) {
+                depth++;
+            }
+
+            // The first splits are made here, the subtrees under them are
+            // left as leaves holding their whole ranges
+            std::vector<uint32bit> pending;
+
+            this->buildNode(sorted.data(), this->nodes, 0, (uint32bit)count, depth, &pending);
+
+            std::vector<std::vector<Node>> subtrees(pending.size());
+
+            parallelFor(0, pending.size(), 1, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const Node & node = this->nodes[pending[i]];
+
+                    subtrees[i].reserve((node.second - node.first) / LEAF_SIZE * 4 + 1);
+                    this->buildNode(sorted.data(), subtrees[i], node.first, node.second, 0, 0);
+                }
+            }, threadCount);
+
+            // The root of a subtree takes the place of its leaf, the other
+            // nodes go to the end
+            for (size_t i = 0; i < pending.size(); i++) {
+                const uint32bit offset = (uint32bit)this->nodes.size() - 1;
+                const uint32bit place = pending[i];
+
+                for (size_t j = 0; j < subtrees[i].size(); j++) {
+                    Node node = subtrees[i][j];
+
+                    if (node.axis < 3) {
+                        node.first += offset;
+                        node.second += offset;
+                    }
+
+                    if (j == 0) {
+                        this->nodes[place] = node;
+                    }
+                    else {
+                        this->nodes.push_back(node);
+                    }
+                }
+            }
+
+            this->points.resize(count);
+            this->indices.resize(count);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    this->points[i] = sorted[i].point;
+                    this->indices[i] = sorted[i].index;
+                }
+            }, threadCount);
+        }
+
+        void PointTree3F::clear()
+        {
+            this->nodes.clear();
+            this->points.clear();
+            this->indices.clear();
+        }
+
+        uint32bit PointTree3F::buildNode(TreePoint3F * points, std::vector<Node> & output, const uint32bit first, const uint32bit last, const uint32bit depth, std::vector<uint32bit> * pending)
+        {
+            const uint32bit index = (uint32bit)output.size();
+
+            Node node;
+            node.split = 0.0f;
+            node.axis = 3;
+            node.first = first;
+            node.second = last;
+
+            output.push_back(node);
+
+            if (last - first <= LEAF_SIZE) {
+                return index;
+            }
+
+            if (pending != 0 && depth == 0) {
+                pending->push_back(index);
+                return index;
+            }
+
+            const uint32bit middle = splitPoints(points, first, last, node.axis, node.split);
+
+            node.first = this->buildNode(points, output, first, middle, depth - 1, pending);
+            node.second = this->buildNode(points, output, middle, last, depth - 1, pending);
+
+            output[index] = node;
+
+            return index;
+        }
+
+        template<class Visitor> void PointTree3F::searchLeaves(const Vector3F & point, float bound, Visitor & visitor) const
+        {
+            uint32bit stack[QUERY_STACK_SIZE];
+            float stackDistances[QUERY_STACK_SIZE];
+            uint32bit depth = 0;
+
+            stack[depth] = 0;
+            stackDistances[depth] = 0.0f;
+            depth++;
+
+            while (depth > 0) {
+                depth--;
+
+                if (stackDistances[depth] >= bound) {
+                    continue;
+                }
+
+                const Node * node = &this->nodes[stack[depth]];
+
+                // Down the nearer side, the farther one is left for later
+                while (node->axis < 3) {
+                    const float offset = getCoordinate(point, node->axis) - node->split;
+
+                    if (offset * offset < bound) {
+                        stack[depth] = offset < 0.0f ? node->second : node->first;
+                        stackDistances[depth] = offset * offset;
+                        depth++;
+                    }
+
+                    node = &this->nodes[offset < 0.0f ? node->first : node->second];
+                }
+
+                bound = visitor(node->first, node->second);
+            }
+        }
+
+        bool PointTree3F::findNearest(const Vector3F & point, NearestPoint3F & result, const float maximumDistance) const
+        {
+            result.index = NO_POINT;
+
+            if (this->nodes.empty()) {
+                return false;
+            }
+
+            float bestSquareDistance = maximumDistance < 1.8E+19f ? maximumDistance * maximumDistance : 3.402823466E+38f;
+            uint32bit best = NO_POINT;
+
+            auto visitor = [&](const uint32bit first, const uint32bit last) {
+                for (uint32bit i = first; i < last; i++) {
+                    const Vector3F difference = this->points[i] - point;
+                    const float squareDistance = difference.scalar(difference);
+
+                    if (squareDistance < bestSquareDistance) {
+                        bestSquareDistance = squareDistance;
+                        best = i;
+                    }
+                }
+
+                return bestSquareDistance;
+            };
+
+            this->searchLeaves(point, bestSquareDistance, visitor);
+
+            if (best == NO_POINT) {
+                return false;
+            }
+
+            result.index = this->indices[best];
+            result.distance = sqrt(bestSquareDistance);
+
+            return true;
+        }
+
+        uint32bit PointTree3F::findNearest(const Vector3F & point, NearestPoint3F * results, const uint32bit count, const float maximumDistance) const
+        {
+            if (this->nodes.empty() || count == 0) {
+                return 0;
+            }
+
+            const float limit = maximumDistance < 1.8E+19f ? maximumDistance * maximumDistance : 3.402823466E+38f;
+
+            // The found points by square distance, the farthest is replaced
+            uint32bit found = 0;
+
+            auto visitor = [&](const uint32bit first, const uint32bit last) {
+                float bestSquareDistance = found == count ? results[count - 1].distance : limit;
+
+                for (uint32bit i = first; i < last; i++) {
+                    const Vector3F difference = this->points[i] - point;
+                    const float squareDistance = difference.scalar(difference);
+
+                    if (squareDistance >= bestSquareDistance) {
+                        continue;
+                    }
+
+                    uint32bit position = found < count ? found++ : count - 1;
+
+                    while (position > 0 && results[position - 1].distance > squareDistance) {
+                        results[position] = results[position - 1];
+                        position--;
+                    }
+
+                    results[position].index = i;
+                    results[position].distance = squareDistance;
+
+                    bestSquareDistance = found == count ? results[count - 1].distance : limit;
+                }
+
+                return bestSquareDistance;
+            };
+
+            this->searchLeaves(point, limit, visitor);
+
+            for (uint32bit i = 0; i < found; i++) {
+                results[i].index = this->indices[results[i].index];
+                results[i].distance = sqrt(results[i].distance);
+            }
+
+            return found;
+        }
+
+        size_t PointTree3F::findNearest(const Vector3F * points, NearestPoint3F * results, const size_t count, const float maximumDistance, const uint32bit threadCount) const
+        {
+            GEOMETRY_PROFILE_SCOPE("point_tree.nearest");
+
+            if (this->nodes.empty()) {
+                for (size_t i = 0; i < count; i++) {
+                    results[i].index = NO_POINT;
+                }
+
+                return 0;
+            }
+
+            // The queries run in the Morton order of their points, the ones
+            // near each other visit the same nodes while they are cached
+            std::vector<uint32bit> order;
+            sortInMortonOrder(points, count, order, threadCount);
+
+            std::atomic<size_t> found(0);
+
+            parallelFor(0, count, 256, [&](const size_t first, const size_t last) {
+                size_t localFound = 0;
+
+                for (size_t i = first; i < last; i++) {
+                    const uint32bit index = order[i];
+
+                    if (this->findNearest(points[index], results[index], maximumDistance)) {
+                        localFound++;
+                    }
+                }
+
+                found += localFound;
+            }, threadCount);
+
+            return found;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_STEREOMETRY_POINT_TREE3F_H_
+#define _GEOMETRY_STEREOMETRY_POINT_TREE3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        struct TreePoint3F;
+
+        // A point of a cloud found for a query and its distance
+        struct NearestPoint3F
+        {
+            uint32bit index;
+            float distance;
+        };
+
+        // ====================== Point tree header ======================= //
+
+        // A k-d tree over a point cloud. A node is split at the median of its
+        // points on the longest axis of their bounds until it holds at most
+        // LEAF_SIZE of them. The points are kept in the order of the leaves,
+        // so the points of a leaf are read from one place.
+        class PointTree3F
+        {
+        public:
+            static const uint32bit LEAF_SIZE = 8;
+
+            // The index of a query without an answer
+            static const uint32bit NO_POINT = 0xFFFFFFFF;
+
+            PointTree3F();
+            virtual ~PointTree3F();
+
+            // The subtrees under the first few splits are built on the
+            // threads of the shared pool
+            void build(const Vector3F * points, const size_t count, const uint32bit threadCount = 0);
+
+            void clear();
+
+            inline bool isEmpty() const;
+            inline size_t getPointCount() const;
+
+            // The point of the cloud nearest to the given one closer than
+            // maximumDistance, for callers that already run on the threads of
+            // the pool. Returns false and sets the index to NO_POINT when there
+            // is none.
+            bool findNearest(const Vector3F & point, NearestPoint3F & result, const float maximumDistance = 3.402823466E+38f) const;
+
+            // Up to count points of the cloud nearest to the given one closer
+            // than maximumDistance, nearest first. Returns their number.
+            uint32bit findNearest(const Vector3F & point, NearestPoint3F * results, const uint32bit count, const float maximumDistance = 3.402823466E+38f) const;
+
+            // The nearest point of the cloud to every query point closer than
+            // maximumDistance, otherwise the index of the result is NO_POINT.
+            // The queries run on the threads of the shared pool. Returns the
+            // number of the points with an answer.
+            size_t findNearest(const Vector3F * points, NearestPoint3F * results, const size_t count, const float maximumDistance = 3.402823466E+38f, const uint32bit threadCount = 0) const;
+
+        private:
+            // An inner node has an axis below three and its children, a leaf
+            // has the range of its points
+            struct Node
+            {
+                float split;
+                uint32bit axis;
+                uint32bit first;
+                uint32bit second;
+            };
+
+            std::vector<Node> nodes;
+            std::vector<Vector3F> points;
+            std::vector<uint32bit> indices;
+
+            // Calls visitor(first, last) for the points of the leaves nearer
+            // than the bound, it returns the square distance of the new bound
+            template<class Visitor> void searchLeaves(const Vector3F & point, float bound, Visitor & visitor) const;
+
+            // Builds the subtree of the range, with pending set the ranges
+            // depth splits down are left as leaves and listed there
+            uint32bit buildNode(TreePoint3F * points, std::vector<Node> & output, const uint32bit first, const uint32bit last, const uint32bit depth, std::vector<uint32bit> * pending);
+        };
+
+        // =================== Point tree inline methods ================== //
+
+        bool PointTree3F::isEmpty() const
+        {
+            return this->nodes.empty();
+        }
+
+        size_t PointTree3F::getPointCount() const
+        {
+            return this->points.size();
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_POINT_TREE3F_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_PROJECTION3F_H_
+#define _GEOMETRY_STEREOMETRY_PROJECTION3F_H_
+
+#include "../types.h"
+#include "../Angle.h"
+#include "../Matrix.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // ================ Projection transformations ================ //
+
+        // The view space looks along +z with +y up. A point (x, y, z, 1) is
+        // taken to the clip space (X, Y, Z, W): it is visible when
+        // -W <= X <= W, -W <= Y <= W and 0 <= Z <= W, and Z / W grows from
+        // 0 at the near plane to 1 at the far one.
+
+        // fieldOfView is the vertical angle, aspect is width / height
+        inline Matrix4x4F makePerspectiveProjection(const AngleF & fieldOfView, const float aspect, const float nearDistance, const float farDistance);
+
+        // The box [-width / 2, width / 2] x [-height / 2, height / 2] x [nearDistance, farDistance]
+        inline Matrix4x4F makeOrthographicProjection(const float width, const float height, const float nearDistance, const float farDistance);
+
+        // projection * view
+        inline Matrix4x4F makeViewProjection(const Matrix4x4F & projection, const Converter3F & view);
+
+        // ================ Projection inline functions ================ //
+
+        Matrix4x4F makePerspectiveProjection(const AngleF & fieldOfView, const float aspect, const float nearDistance, const float farDistance)
+        {
+            const AngleF halfAngle = fieldOfView / 2.0f;
+            const float yScale = halfAngle.ctg();
+
+            Matrix4x4F result(Matrix4x4F::ZERO_MATRIX);
+
+            result.values[0][0] = yScale / aspect;
+            result.values[1][1] = yScale;
+            result.values[2][2] = farDistance / (farDistance - nearDistance);
+            result.values[2][3] = -nearDistance * farDistance / (farDistance - nearDistance);
+            result.values[3][2] = 1.0f;
+
+            return result;
+        }
+
+        Matrix4x4F makeOrthographicProjection(const float width, const float height, const float nearDistance, const float farDistance)
+        {
+            Matrix4x4F result(Matrix4x4F::ZERO_MATRIX);
+
+            result.values[0][0] = 2.0f / width;
+            result.values[1][1] = 2.0f / height;
+            result.values[2][2] = 1.0f / (farDistance - nearDistance);
+            result.values[2][3] = -nearDistance / (farDistance - nearDistance);
+            result.values[3][3] = 1.0f;
+
+            return result;
+        }
+
+        Matrix4x4F makeViewProjection(const Matrix4x4F & projection, const Converter3F & view)
+        {
+            return projection * toMatrix(view);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_PROJECTION3F_H_ */
@@ -0,0 +1,952 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SignedDistanceField3F.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        static const float UNKNOWN_DISTANCE = 3.402823466E+38f;
+
+        // Barycentric coordinates below this are taken as zero when the
+        // feature of a nearest point is chosen
+        static const float FEATURE_TOLERANCE = 1E-4f;
+
+        // The coarse grid converges in one round of the eight sweeps unless
+        // the surface wraps around, the rounds are limited anyway
+        static const uint32bit MAXIMAL_SWEEP_ROUNDS = 8;
+
+        // The voxels of a brick share the nearby triangles in blocks of
+        // BLOCK_SIZE^3; wider blocks gather many triangles no voxel needs
+        static const uint32bit BLOCK_SIZE = 4;
+
+        // Deeper than the median split of 2^32 triangles gets
+        static const uint32bit QUERY_STACK_SIZE = 64;
+
+        // The normals of the features of the triangles, by the corner
+        // triangle * 3 + i; the edge i runs from the corner i to the next one
+        struct Pseudonormals
+        {
+            std::vector<Vector3F> faces;
+            std::vector<Vector3F> edges;
+            std::vector<Vector3F> vertices;
+        };
+
+        struct EdgeEntry
+        {
+            uint64bit key;
+            uint32bit corner;
+        };
+
+        // The state shared by the threads filling the field
+        struct FieldSampler
+        {
+            const IndexedMesh3F & mesh;
+            const TriangleTree3F & tree;
+            const Pseudonormals & normals;
+            Vector3F origin;
+            float voxelSize;
+
+            // The voxels nearer than this to the surface are exact
+            float exactDistance;
+
+            inline Vector3F getPoint(const uint32bit x, const uint32bit y, const uint32bit z) const
+            {
+                return Vector3F(this->origin.x + x * this->voxelSize, this->origin.y + y * this->voxelSize, this->origin.z + z * this->voxelSize);
+            }
+        };
+
+        static inline float getLength(const Vector3F & vector)
+        {
+            return sqrtf(vector.scalar(vector));
+        }
+
+        // ======================== Pseudonormals ======================== //
+
+        // The same index for the vertices with equal coordinates
+        static void weldVertices(const IndexedMesh3F & mesh, std::vector<uint32bit> & welded)
+        {
+            const std::vector<Vector3F> & vertices = mesh.vertices;
+
+            std::vector<uint32bit> order(vertices.size());
+
+            for (uint32bit i = 0; i < order.size(); i++) {
+                order[i] = i;
+            }
+
+            std::sort(order.begin(), order.end(), [&](const uint32bit first, const uint32bit second) {
+                const Vector3F & a = vertices[first];
+                const Vector3F & b = vertices[second];
+
+                return a.x != b.x ? a.x < b.x : (a.y != b.y ? a.y < b.y : (a.z != b.z ? a.z < b.z : first < second));
+            });
+
+            welded.resize(vertices.size());
+
+            uint32bit index = 0;
+
+            for (size_t i = 0; i < order.size(); i++) {
+                if (i > 0) {
+                    const Vector3F & a = vertices[order[i - 1]];
+                    const Vector3F & b = vertices[order[i]];
+
+                    if (a.x != b.x || a.y != b.y || a.z != b.z) {
+                        index++;
+                    }
+                }
+
+                welded[order[i]] = index;
+            }
+        }
+
+        // Face normals, sums of the normals of the faces at the edges and
+        // sums weighted by the angles at the vertices [Baerentzen, Aanaes]
+        static void computePseudonormals(const IndexedMesh3F & mesh, Pseudonormals & normals, const uint32bit threadCount)
+        {
+            const size_t triangleCount = mesh.getTriangleCount();
+            const uint32bit * indices = &mesh.indices[0];
+
+            std::vector<uint32bit> welded;
+            weldVertices(mesh, welded);
+
+            normals.faces.resize(triangleCount);
+            normals.edges.resize(triangleCount * 3);
+            normals.vertices.resize(triangleCount * 3);
+
+            // The part of every corner in the normal of its vertex
+            std::vector<Vector3F> & corners = normals.edges;
+
+            parallelFor(0, triangleCount, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const Triangle3F triangle = mesh.getTriangle(i);
+
+                    Vector3F normal = triangle.vectorAB().vector(triangle.vectorAC());
+                    const float length = getLength(normal);
+
+                    normal = length > 0.0f ? normal / length : Vector3F();
+                    normals.faces[i] = normal;
+
+                    const Vector3F * vertices[3] = { &triangle.A, &triangle.B, &triangle.C };
+
+                    for (uint32bit corner = 0; corner < 3; corner++) {
+                        const Vector3F next = *vertices[(corner + 1) % 3] - *vertices[corner];
+                        const Vector3F previous = *vertices[(corner + 2) % 3] - *vertices[corner];
+                        const float lengths = getLength(next) * getLength(previous);
+
+                        const float cosine = lengths > 0.0f ? std::max(-1.0f, std::min(1.0f, next.scalar(previous) / lengths)) : 1.0f;
+
+                        corners[i * 3 + corner] = normal * acosf(cosine);
+                    }
+                }
+            }, threadCount);
+
+            std::vector<Vector3F> vertexSums(mesh.vertices.size());
+
+            for (size_t i = 0; i < triangleCount * 3; i++) {
+                vertexSums[welded[indices[i]]] += corners[i];
+            }
+
+            std::vector<EdgeEntry> edges(triangleCount * 3);
+
+            parallelFor(0, triangleCount * 3, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    normals.vertices[i] = vertexSums[welded[indices[i]]];
+
+                    const uint32bit start = welded[indices[i]];
+                    const uint32bit end = welded[indices[i - i % 3 + (i + 1) % 3]];
+
+                    edges[i].key = start < end ? ((uint64bit)start << 32) | end : ((uint64bit)end << 32) | start;
+                    edges[i].corner = (uint32bit)i;
+                }
+            }, threadCount);
+
+            std::sort(edges.begin(), edges.end(), [](const EdgeEntry & first, const EdgeEntry & second) {
+                return first.key != second.key ? first.key < second.key : first.corner < second.corner;
+            });
+
+            for (size_t first = 0; first < edges.size();) {
+                size_t last = first;
+                Vector3F sum;
+
+                while (last < edges.size() && edges[last].key == edges[first].key) {
+                    sum += normals.faces[edges[last].corner / 3];
+                    last++;
+                }
+
+                for (size_t i = first; i < last; i++) {
+                    normals.edges[edges[i].corner] = sum;
+                }
+
+                first = last;
+            }
+        }
+
+        // The distance to the nearest point, negative when the point is on
+        // the inner side of the pseudonormal of the feature holding it
+        static float getSignedDistance(const FieldSampler & sampler, const Vector3F & point, const ClosestMeshPoint3F & closest)
+        {
+            if (closest.distance <= 0.0f) {
+                return 0.0f;
+            }
+
+            const Triangle3F triangle = sampler.mesh.getTriangle(closest.triangle);
+            const size_t corner = (size_t)closest.triangle * 3;
+
+            const Vector3F ab = triangle.vectorAB();
+            const Vector3F ac = triangle.vectorAC();
+            const Vector3F aq = closest.point - triangle.A;
+
+            const float abab = ab.scalar(ab);
+            const float abac = ab.scalar(ac);
+            const float acac = ac.scalar(ac);
+            const float determinant = abab * acac - abac * abac;
+
+            const Vector3F * normal = &sampler.normals.faces[closest.triangle];
+
+            if (determinant > 0.0f) {
+                const float abaq = ab.scalar(aq);
+                const float acaq = ac.scalar(aq);
+
+                const float v = (acac * abaq - abac * acaq) / determinant;
+                const float w = (abab * acaq - abac * abaq) / determinant;
+                const float u = 1.0f - v - w;
+
+                const bool atA = u < FEATURE_TOLERANCE;
+                const bool atB = v < FEATURE_TOLERANCE;
+                const bool atC = w < FEATURE_TOLERANCE;
+
+                if (atB && atC) {
+                    normal = &sampler.normals.vertices[corner];
+                }
+                else if (atA && atC) {
+                    normal = &sampler.normals.vertices[corner + 1];
+                }
+                else if (atA && atB) {
+                    normal = &sampler.normals.vertices[corner + 2];
+                }
+                else if (atC) {
+                    normal = &sampler.normals.edges[corner];
+                }
+                else if (atA) {
+                    normal = &sampler.normals.edges[corner + 1];
+                }
+                else if (atB) {
+                    normal = &sampler.normals.edges[corner + 2];
+                }
+            }
+            else {
+                // A degenerate triangle has no face, its nearest vertex decides
+                const float toA = (closest.point - triangle.A).scalar(closest.point - triangle.A);
+                const float toB = (closest.point - triangle.B).scalar(closest.point - triangle.B);
+                const float toC = (closest.point - triangle.C).scalar(closest.point - triangle.C);
+
+                normal = &sampler.normals.vertices[corner + (toA <= toB && toA <= toC ? 0 : (toB <= toC ? 1 : 2))];
+            }
+
+            return (point - closest.point).scalar(*normal) < 0.0f ? -closest.distance : closest.distance;
+        }
+
+        static float findSignedDistance(const FieldSampler & sampler, const Vector3F & point)
+        {
+            ClosestMeshPoint3F closest;
+            findClosestPoint(sampler.mesh, sampler.tree, point, closest);
+
+            return getSignedDistance(sampler, point, closest);
+        }
+
+        static inline float getSquareDistance(const AxisBox3F & box, const Vector3F & point)
+        {
+            const float x = std::max(std::max(box.minimum.x - point.x, point.x - box.maximum.x), 0.0f);
+            const float y = std::max(std::max(box.minimum.y - point.y, point.y - box.maximum.y), 0.0f);
+            const float z = std::max(std::max(box.minimum.z - point.z, point.z - box.maximum.z), 0.0f);
+
+            return x * x + y * y + z * z;
+        }
+
+        struct Candidate
+        {
+            float distance;
+            uint32bit triangle;
+
+            inline bool operator<(const Candidate & candidate) const
+            {
+                return this->distance < candidate.distance || (this->distance == candidate.distance && this->triangle < candidate.triangle);
+            }
+        };
+
+        // The triangles with boxes within the distance of the point, nearest
+        // first
+        static void gatherCandidates(const TriangleTree3F & tree, const Vector3F & point, const float distance, std::vector<Candidate> & candidates)
+        {
+            const std::vector<FrustumNode3F> & nodes = tree.getNodes();
+            const std::vector<uint32bit> & items = tree.getItems();
+            const std::vector<AxisBox3F> & itemBoxes = tree.getItemBoxes();
+
+            const float squareDistance = distance * distance;
+
+            uint32bit stack[QUERY_STACK_SIZE];
+            uint32bit depth = 0;
+
+            stack[depth++] = 0;
+            candidates.clear();
+
+            while (depth > 0) {
+                const FrustumNode3F & node = nodes[stack[--depth]];
+
+                if (getSquareDistance(node.box, point) > squareDistance) {
+                    continue;
+                }
+
+                for (uint32bit i = node.firstItem; i < node.firstItem + node.itemCount; i++) {
+                    const float itemDistance = getSquareDistance(itemBoxes[items[i]], point);
+
+                    if (itemDistance <= squareDistance) {
+                        const Candidate candidate = { sqrtf(itemDistance), items[i] };
+                        candidates.push_back(candidate);
+                    }
+                }
+
+                for (uint32bit i = 0; i < node.childCount; i++) {
+                    stack[depth++] = node.firstChild + i;
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end());
+        }
+
+        // The voxels of a brick with their nearest triangles, the exact ones
+        // stay as they are while the others are swept
+        struct BrickState
+        {
+            std::vector<Candidate> candidates;
+            uint32bit triangles[SignedDistanceField3F::BRICK_SIZE * SignedDistanceField3F::BRICK_SIZE * SignedDistanceField3F::BRICK_SIZE];
+            bool exact[SignedDistanceField3F::BRICK_SIZE * SignedDistanceField3F::BRICK_SIZE * SignedDistanceField3F::BRICK_SIZE];
+
+            // -1 inside, 1 outside and 0 before the sweeps reach the voxel
+            int8bit signs[SignedDistanceField3F::BRICK_SIZE * SignedDistanceField3F::BRICK_SIZE * SignedDistanceField3F::BRICK_SIZE];
+        };
+
+        static inline uint32bit getBrickIndex(const uint32bit x, const uint32bit y, const uint32bit z)
+        {
+            return (z * SignedDistanceField3F::BRICK_SIZE + y) * SignedDistanceField3F::BRICK_SIZE + x;
+        }
+
+        // Every triangle within the exact distance of a voxel has its box
+        // within that distance and the half diagonal of the block of the
+        // centre, so the candidates are gathered once per block. Their boxes
+        // are at least their distance to the centre less the half diagonal
+        // away from the voxel, the scan stops at the first one beyond the
+        // best triangle. The voxels are visited in a serpentine order, the
+        // best triangle of the previous voxel is the first guess for the
+        // next one.
+        static void fillBlock(const FieldSampler & sampler, const uint32bit brickX, const uint32bit brickY, const uint32bit brickZ, const uint32bit startX, const uint32bit startY, const uint32bit startZ, BrickState & state, float * distances)
+        {
+            const uint32bit brickSize = SignedDistanceField3F::BRICK_SIZE;
+            const float halfSize = 0.5f * (BLOCK_SIZE - 1) * sampler.voxelSize;
+            const float halfDiagonal = halfSize * 1.7320508f * 1.0001f;
+            const Vector3F corner = sampler.getPoint(brickX * brickSize + startX, brickY * brickSize + startY, brickZ * brickSize + startZ);
+            const Vector3F centre = corner + Vector3F(halfSize, halfSize, halfSize);
+
+            std::vector<Candidate> & candidates = state.candidates;
+            gatherCandidates(sampler.tree, centre, sampler.exactDistance + halfDiagonal, candidates);
+
+            const std::vector<AxisBox3F> & itemBoxes = sampler.tree.getItemBoxes();
+
+            ClosestMeshPoint3F closest;
+            closest.triangle = TriangleTree3F::NO_TRIANGLE;
+
+            bool hasFarVoxels = false;
+            uint32bit row = 0;
+
+            for (uint32bit z = 0; z < BLOCK_SIZE; z++) {
+                for (uint32bit j = 0; j < BLOCK_SIZE; j++, row++) {
+                    const uint32bit y = z % 2 == 0 ? j : BLOCK_SIZE - 1 - j;
+
+                    for (uint32bit i = 0; i < BLOCK_SIZE; i++) {
+                        const uint32bit x = row % 2 == 0 ? i : BLOCK_SIZE - 1 - i;
+                        const uint32bit index = getBrickIndex(startX + x, startY + y, startZ + z);
+                        const Vector3F point = corner + Vector3F(x * sampler.voxelSize, y * sampler.voxelSize, z * sampler.voxelSize);
+
+                        float bestDistance = sampler.exactDistance;
+                        float bestSquareDistance = bestDistance * bestDistance;
+
+                        if (closest.triangle != TriangleTree3F::NO_TRIANGLE) {
+                            const Vector3F previous = sampler.mesh.getTriangle(closest.triangle).closestPoint(point);
+                            const float squareDistance = (previous - point).scalar(previous - point);
+
+                            if (squareDistance <= bestSquareDistance) {
+                                bestSquareDistance = squareDistance;
+                                bestDistance = sqrtf(squareDistance);
+                                closest.point = previous;
+                            }
+                            else {
+                                closest.triangle = TriangleTree3F::NO_TRIANGLE;
+                            }
+                        }
+
+                        for (size_t k = 0; k < candidates.size() && candidates[k].distance - halfDiagonal <= bestDistance; k++) {
+                            const uint32bit triangle = candidates[k].triangle;
+
+                            if (getSquareDistance(itemBoxes[triangle], point) >= bestSquareDistance) {
+                                continue;
+                            }
+
+                            const Vector3F candidate = sampler.mesh.getTriangle(triangle).closestPoint(point);
+                            const float squareDistance = (candidate - point).scalar(candidate - point);
+
+                            if (squareDistance < bestSquareDistance) {
+                                bestSquareDistance = squareDistance;
+                                bestDistance = sqrtf(squareDistance);
+                                closest.point = candidate;
+                                closest.triangle = triangle;
+                            }
+                        }
+
+                        state.triangles[index] = closest.triangle;
+                        state.exact[index] = closest.triangle != TriangleTree3F::NO_TRIANGLE;
+                        state.signs[index] = 0;
+
+                        if (state.exact[index]) {
+                            closest.distance = bestDistance;
+
+                            const float distance = getSignedDistance(sampler, point, closest);
+
+                            distances[index] = fabsf(distance);
+                            state.signs[index] = distance < 0.0f ? -1 : 1;
+                        }
+                        else {
+                            distances[index] = UNKNOWN_DISTANCE;
+                            hasFarVoxels = true;
+                        }
+                    }
+                }
+            }
+
+            // The far voxels start from the nearest triangle of the centre
+            if (hasFarVoxels) {
+                findClosestPoint(sampler.mesh, sampler.tree, centre, closest);
+
+                const Triangle3F triangle = sampler.mesh.getTriangle(closest.triangle);
+
+                for (uint32bit z = 0; z < BLOCK_SIZE; z++) {
+                    for (uint32bit y = 0; y < BLOCK_SIZE; y++) {
+                        for (uint32bit x = 0; x < BLOCK_SIZE; x++) {
+                            const uint32bit index = getBrickIndex(startX + x, startY + y, startZ + z);
+
+                            if (!state.exact[index]) {
+                                state.triangles[index] = closest.triangle;
+                                distances[index] = triangle.distanceTo(corner + Vector3F(x * sampler.voxelSize, y * sampler.voxelSize, z * sampler.voxelSize));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // The voxels farther than the exact distance take the nearest of the
+        // triangles of their neighbours, swept over the brick in the eight
+        // diagonal directions once [Batty, SDFGen]. The result is the distance to
+        // a triangle of the mesh, exact but for rare voxels whose nearest
+        // triangle is not nearest to any neighbour. The signs spread with
+        // the triangles: a voxel edge crossed by the surface has both ends
+        // within one voxel of it, so they are exact.
+        static void sweepBrick(const FieldSampler & sampler, const uint32bit brickX, const uint32bit brickY, const uint32bit brickZ, BrickState & state, float * distances)
+        {
+            const uint32bit size = SignedDistanceField3F::BRICK_SIZE;
+            const int32bit strides[3] = { 1, (int32bit)size, (int32bit)(size * size) };
+
+            for (uint32bit direction = 0; direction < 8; direction++) {
+                const int32bit steps[3] = { (direction & 1) == 0 ? 1 : -1, (direction & 2) == 0 ? 1 : -1, (direction & 4) == 0 ? 1 : -1 };
+
+                for (uint32bit k = 0; k < size; k++) {
+                    const uint32bit z = steps[2] > 0 ? k : size - 1 - k;
+
+                    for (uint32bit j = 0; j < size; j++) {
+                        const uint32bit y = steps[1] > 0 ? j : size - 1 - j;
+
+                        for (uint32bit i = 0; i < size; i++) {
+                            const uint32bit x = steps[0] > 0 ? i : size - 1 - i;
+                            const uint32bit index = getBrickIndex(x, y, z);
+
+                            if (state.exact[index]) {
+                                continue;
+                            }
+
+                            const uint32bit position[3] = { i, j, k };
+                            const Vector3F point = sampler.getPoint(brickX * size + x, brickY * size + y, brickZ * size + z);
+
+                            for (uint32bit axis = 0; axis < 3; axis++) {
+                                if (position[axis] == 0) {
+                                    continue;
+                                }
+
+                                const uint32bit neighbour = (uint32bit)((int32bit)index - steps[axis] * strides[axis]);
+                                const uint32bit triangle = state.triangles[neighbour];
+
+                                if (state.signs[index] == 0) {
+                                    state.signs[index] = state.signs[neighbour];
+                                }
+
+                                if (triangle == state.triangles[index]) {
+                                    continue;
+                                }
+
+                                const Vector3F closest = sampler.mesh.getTriangle(triangle).closestPoint(point);
+                                const float squareDistance = (closest - point).scalar(closest - point);
+
+                                if (squareDistance < distances[index] * distances[index]) {
+                                    state.triangles[index] = triangle;
+                                    distances[index] = sqrtf(squareDistance);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        static void fillBrick(const FieldSampler & sampler, const uint32bit brickX, const uint32bit brickY, const uint32bit brickZ, BrickState & state, float * distances)
+        {
+            const uint32bit size = SignedDistanceField3F::BRICK_SIZE;
+
+            bool anyExact = false;
+
+            for (uint32bit z = 0; z < size; z += BLOCK_SIZE) {
+                for (uint32bit y = 0; y < size; y += BLOCK_SIZE) {
+                    for (uint32bit x = 0; x < size; x += BLOCK_SIZE) {
+                        fillBlock(sampler, brickX, brickY, brickZ, x, y, z, state, distances);
+                    }
+                }
+            }
+
+            for (uint32bit i = 0; i < size * size * size && !anyExact; i++) {
+                anyExact = state.exact[i];
+            }
+
+            // A brick kept for the surface just beyond its voxels starts the
+            // sweeps from its corners
+            if (!anyExact) {
+                for (uint32bit corner = 0; corner < 8; corner++) {
+                    const uint32bit x = (corner & 1) * (size - 1);
+                    const uint32bit y = ((corner >> 1) & 1) * (size - 1);
+                    const uint32bit z = (corner >> 2) * (size - 1);
+                    const uint32bit index = getBrickIndex(x, y, z);
+                    const Vector3F point = sampler.getPoint(brickX * size + x, brickY * size + y, brickZ * size + z);
+
+                    ClosestMeshPoint3F closest;
+                    findClosestPoint(sampler.mesh, sampler.tree, point, closest);
+
+                    const float distance = getSignedDistance(sampler, point, closest);
+
+                    state.triangles[index] = closest.triangle;
+                    state.exact[index] = true;
+                    state.signs[index] = distance < 0.0f ? -1 : 1;
+                    distances[index] = fabsf(distance);
+                }
+            }
+
+            sweepBrick(sampler, brickX, brickY, brickZ, state, distances);
+
+            for (uint32bit i = 0; i < size * size * size; i++) {
+                distances[i] *= state.signs[i];
+            }
+        }
+
+        // ====================== Fast sweeping ====================== //
+
+        // The smallest distance of the two neighbours on an axis
+        static inline void takeNeighbour(const float value, float & magnitude, float & signedValue)
+        {
+            if (fabsf(value) < magnitude) {
+                magnitude = fabsf(value);
+                signedValue = value;
+            }
+        }
+
+        // Godunov upwind update of |grad u| = 1 from the nearest neighbours on
+        // the three axes [Zhao 2005], the sign is taken from the nearest one
+        static inline float solveEikonal(float a, float b, float c, const float spacing)
+        {
+            if (a > b) std::swap(a, b);
+            if (b > c) std::swap(b, c);
+            if (a > b) std::swap(a, b);
+
+            float value = a + spacing;
+
+            if (value > b) {
+                value = 0.5f * (a + b + sqrtf(std::max(0.0f, 2.0f * spacing * spacing - (a - b) * (a - b))));
+
+                if (value > c) {
+                    const float sum = a + b + c;
+                    const float discriminant = sum * sum - 3.0f * (a * a + b * b + c * c - spacing * spacing);
+
+                    value = (sum + sqrtf(std::max(0.0f, discriminant))) / 3.0f;
+                }
+            }
+
+            return value;
+        }
+
+        // Fills the unknown nodes of the grid from the known ones, which
+        // stay as they are
+        static void sweepGrid(std::vector<float> & distances, const std::vector<uint8bit> & known, const uint32bit * counts, const float spacing)
+        {
+            const size_t strides[3] = { 1, counts[0], (size_t)counts[0] * counts[1] };
+
+            for (uint32bit round = 0; round < MAXIMAL_SWEEP_ROUNDS; round++) {
+                bool changed = false;
+
+                for (uint32bit direction = 0; direction < 8; direction++) {
+                    for (uint32bit k = 0; k < counts[2]; k++) {
+                        const uint32bit z = (direction & 4) == 0 ? k : counts[2] - 1 - k;
+
+                        for (uint32bit j = 0; j < counts[1]; j++) {
+                            const uint32bit y = (direction & 2) == 0 ? j : counts[1] - 1 - j;
+
+                            for (uint32bit i = 0; i < counts[0]; i++) {
+                                const uint32bit x = (direction & 1) == 0 ? i : counts[0] - 1 - i;
+                                const uint32bit position[3] = { x, y, z };
+                                const size_t node = x * strides[0] + y * strides[1] + z * strides[2];
+
+                                if (known[node] != 0) {
+                                    continue;
+                                }
+
+                                float magnitudes[3];
+                                float nearest = UNKNOWN_DISTANCE;
+                                float nearestValue = UNKNOWN_DISTANCE;
+
+                                for (uint32bit axis = 0; axis < 3; axis++) {
+                                    float magnitude = UNKNOWN_DISTANCE;
+                                    float value = UNKNOWN_DISTANCE;
+
+                                    if (position[axis] > 0) {
+                                        takeNeighbour(distances[node - strides[axis]], magnitude, value);
+                                    }
+
+                                    if (position[axis] + 1 < counts[axis]) {
+                                        takeNeighbour(distances[node + strides[axis]], magnitude, value);
+                                    }
+
+                                    magnitudes[axis] = magnitude;
+                                    takeNeighbour(value, nearest, nearestValue);
+                                }
+
+                                if (nearest >= UNKNOWN_DISTANCE) {
+                                    continue;
+                                }
+
+                                const float value = solveEikonal(magnitudes[0], magnitudes[1], magnitudes[2], spacing);
+
+                                if (value < fabsf(distances[node]) - spacing * 1E-5f) {
+                                    distances[node] = nearestValue < 0.0f ? -value : value;
+                                    changed = true;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                if (!changed) {
+                    break;
+                }
+            }
+        }
+
+        // ================== Signed distance field ================== //
+
+        const uint32bit SignedDistanceField3F::BRICK_SIZE;
+        const uint32bit SignedDistanceField3F::NO_BRICK;
+        const uint32bit SignedDistanceField3F::BRICK_VOLUME;
+
+        SignedDistanceField3F::SignedDistanceField3F() : voxelSize(0.0f)
+        {
+            this->sizes[0] = this->sizes[1] = this->sizes[2] = 0;
+            this->brickCounts[0] = this->brickCounts[1] = this->brickCounts[2] = 0;
+        }
+
+        SignedDistanceField3F::~SignedDistanceField3F()
+        {
+        }
+
+        void SignedDistanceField3F::clear()
+        {
+            this->voxelSize = 0.0f;
+            this->sizes[0] = this->sizes[1] = this->sizes[2] = 0;
+            this->brickCounts[0] = this->brickCounts[1] = this->brickCounts[2] = 0;
+
+            this->brickSlots.clear();
+            this->brickDistances.clear();
+            this->coarseDistances.clear();
+        }
+
+        bool SignedDistanceField3F::build(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F & origin, const float voxelSize, const uint32bit sizeX, const uint32bit sizeY, const uint32bit sizeZ, const float bandWidth, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("signed_distance_field.build");
+
+            this->clear();
+
+            if (mesh.getTriangleCount() == 0 || tree.isEmpty() || !(voxelSize > 0.0f) || sizeX == 0 || sizeY == 0 || sizeZ == 0) {
+                return false;
+            }
+
+            this->origin = origin;
+            this->voxelSize = voxelSize;
+            this->sizes[0] = sizeX;
+            this->sizes[1] = sizeY;
+            this->sizes[2] = sizeZ;
+
+            for (uint32bit axis = 0; axis < 3; axis++) {
+                this->brickCounts[axis] = (this->sizes[axis] + BRICK_SIZE - 1) / BRICK_SIZE;
+            }
+
+            const uint32bit * counts = this->brickCounts;
+            const size_t brickCount = (size_t)counts[0] * counts[1] * counts[2];
+            const float band = std::max(bandWidth, 0.0f);
+            const float originCoordinates[3] = { origin.x, origin.y, origin.z };
+
+            Pseudonormals normals;
+            computePseudonormals(mesh, normals, threadCount);
+
+            const FieldSampler sampler = { mesh, tree, normals, origin, voxelSize, std::max(band, voxelSize * 1.01f) };
+
+            // The bricks overlapping the boxes of the triangles grown by the
+            // band are the candidates
+            std::vector<uint8bit> candidates(brickCount, 0);
+
+            {
+                GEOMETRY_PROFILE_SCOPE("signed_distance_field.candidates");
+
+                const std::vector<AxisBox3F> & boxes = tree.getItemBoxes();
+
+                for (size_t i = 0; i < boxes.size(); i++) {
+                    const float minima[3] = { boxes[i].minimum.x, boxes[i].minimum.y, boxes[i].minimum.z };
+                    const float maxima[3] = { boxes[i].maximum.x, boxes[i].maximum.y, boxes[i].maximum.z };
+
+                    uint32bit first[3];
+                    uint32bit last[3];
+                    bool outside = false;
+
+                    for (uint32bit axis = 0; axis < 3; axis++) {
+                        const float lowest = floorf((minima[axis] - band - originCoordinates[axis]) / voxelSize);
+                        const float highest = ceilf((maxima[axis] + band - originCoordinates[axis]) / voxelSize);
+
+                        if (!(highest >= 0.0f) || !(lowest < (float)this->sizes[axis])) {
+                            outside = true;
+                            break;
+                        }
+
+                        // The cell of a brick reaches the first voxel of the next one
+                        first[axis] = lowest > 1.0f ? ((uint32bit)lowest - 1) / BRICK_SIZE : 0;
+                        last[axis] = (uint32bit)std::min(highest, (float)(this->sizes[axis] - 1)) / BRICK_SIZE;
+                    }
+
+                    if (outside) {
+                        continue;
+                    }
+
+                    for (uint32bit z = first[2]; z <= last[2]; z++) {
+                        for (uint32bit y = first[1]; y <= last[1]; y++) {
+                            uint8bit * row = &candidates[((size_t)z * counts[1] + y) * counts[0]];
+
+                            for (uint32bit x = first[0]; x <= last[0]; x++) {
+                                row[x] = 1;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // A candidate is kept when its cell, from its first voxel to the
+            // first one of the next brick, is within the band of the surface.
+            // Every edge of the coarse grid crossed by the surface is in
+            // the cell of a kept brick then, so its ends are exact and the
+            // signs swept over the grid never cross the surface.
+            std::vector<uint32bit> bricks;
+
+            for (size_t i = 0; i < brickCount; i++) {
+                if (candidates[i] != 0) {
+                    bricks.push_back((uint32bit)i);
+                }
+            }
+
+            parallelFor(0, bricks.size(), 64, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const uint32bit brick = bricks[i];
+                    const uint32bit position[3] = { brick % counts[0], brick / counts[0] % counts[1], brick / counts[0] / counts[1] };
+
+                    const float halfSize = 0.5f * BRICK_SIZE * voxelSize;
+                    const Vector3F centre = sampler.getPoint(position[0] * BRICK_SIZE, position[1] * BRICK_SIZE, position[2] * BRICK_SIZE) + Vector3F(halfSize, halfSize, halfSize);
+
+                    ClosestMeshPoint3F closest;
+                    const bool near = findClosestPoint(mesh, tree, centre, closest, halfSize * 1.7320508f + band);
+
+                    candidates[brick] = near ? 1 : 0;
+                }
+            }, threadCount);
+
+            this->brickSlots.assign(brickCount, NO_BRICK);
+
+            uint32bit slotCount = 0;
+
+            for (size_t i = 0; i < bricks.size(); i++) {
+                if (candidates[bricks[i]] != 0) {
+                    this->brickSlots[bricks[i]] = slotCount;
+                    bricks[slotCount] = bricks[i];
+                    slotCount++;
+                }
+            }
+
+            bricks.resize(slotCount);
+
+            {
+                GEOMETRY_PROFILE_SCOPE("signed_distance_field.bricks");
+
+                this->brickDistances.resize((size_t)slotCount * BRICK_VOLUME);
+
+                parallelFor(0, bricks.size(), 1, [&](const size_t first, const size_t last) {
+                    BrickState state;
+
+                    for (size_t i = first; i < last; i++) {
+                        const uint32bit brick = bricks[i];
+
+                        fillBrick(sampler, brick % counts[0], brick / counts[0] % counts[1], brick / counts[0] / counts[1], state, &this->brickDistances[i * BRICK_VOLUME]);
+                    }
+                }, threadCount);
+            }
+
+            // The corners of the stored bricks are exact, the rest of the
+            // coarse grid is swept from them; without stored bricks the
+            // whole grid is exact
+            {
+                GEOMETRY_PROFILE_SCOPE("signed_distance_field.coarse");
+
+                const uint32bit nodeCounts[3] = { counts[0] + 1, counts[1] + 1, counts[2] + 1 };
+                const size_t nodeCount = (size_t)nodeCounts[0] * nodeCounts[1] * nodeCounts[2];
+
+                std::vector<uint8bit> known(nodeCount, slotCount == 0 ? 1 : 0);
+
+                for (size_t i = 0; i < bricks.size(); i++) {
+                    const uint32bit x = bricks[i] % counts[0];
+                    const uint32bit y = bricks[i] / counts[0] % counts[1];
+                    const uint32bit z = bricks[i] / counts[0] / counts[1];
+
+                    for (uint32bit corner = 0; corner < 8; corner++) {
+                        known[((size_t)(z + (corner >> 2)) * nodeCounts[1] + y + ((corner >> 1) & 1)) * nodeCounts[0] + x + (corner & 1)] = 1;
+                    }
+                }
+
+                this->coarseDistances.assign(nodeCount, UNKNOWN_DISTANCE);
+
+                parallelFor(0, nodeCount, 256, [&](const size_t first, const size_t last) {
+                    for (size_t i = first; i < last; i++) {
+                        if (known[i] != 0) {
+                            const uint32bit x = (uint32bit)(i % nodeCounts[0]);
+                            const uint32bit y = (uint32bit)(i / nodeCounts[0] % nodeCounts[1]);
+                            const uint32bit z = (uint32bit)(i / nodeCounts[0] / nodeCounts[1]);
+
+                            this->coarseDistances[i] = findSignedDistance(sampler, sampler.getPoint(x * BRICK_SIZE, y * BRICK_SIZE, z * BRICK_SIZE));
+                        }
+                    }
+                }, threadCount);
+
+                if (slotCount > 0) {
+                    sweepGrid(this->coarseDistances, known, nodeCounts, voxelSize * BRICK_SIZE);
+                }
+            }
+
+            return true;
+        }
+
+        size_t SignedDistanceField3F::getMemorySize() const
+        {
+            return sizeof(*this) + this->brickSlots.capacity() * sizeof(uint32bit) + (this->brickDistances.capacity() + this->coarseDistances.capacity()) * sizeof(float);
+        }
+
+        float SignedDistanceField3F::sample(const Vector3F & point) const
+        {
+            const float coordinates[3] = { (point.x - this->origin.x) / this->voxelSize, (point.y - this->origin.y) / this->voxelSize, (point.z - this->origin.z) / this->voxelSize };
+
+            uint32bit lower[3];
+            uint32bit upper[3];
+            float weights[3];
+
+            for (uint32bit axis = 0; axis < 3; axis++) {
+                const float coordinate = std::max(0.0f, std::min(coordinates[axis], (float)(this->sizes[axis] - 1)));
+
+                lower[axis] = std::min((uint32bit)coordinate, this->sizes[axis] - 1);
+                upper[axis] = std::min(lower[axis] + 1, this->sizes[axis] - 1);
+                weights[axis] = coordinate - lower[axis];
+            }
+
+            float values[4];
+
+            // Most points have all eight voxels in one stored brick
+            if (lower[0] / BRICK_SIZE == upper[0] / BRICK_SIZE && lower[1] / BRICK_SIZE == upper[1] / BRICK_SIZE && lower[2] / BRICK_SIZE == upper[2] / BRICK_SIZE) {
+                const uint32bit slot = this->brickSlots[((size_t)(lower[2] / BRICK_SIZE) * this->brickCounts[1] + lower[1] / BRICK_SIZE) * this->brickCounts[0] + lower[0] / BRICK_SIZE];
+
+                if (slot != NO_BRICK) {
+                    const float * brick = &this->brickDistances[(size_t)slot * BRICK_VOLUME];
+                    const uint32bit stepX = upper[0] - lower[0];
+                    const uint32bit stepY = (upper[1] - lower[1]) * BRICK_SIZE;
+                    const uint32bit stepZ = (upper[2] - lower[2]) * BRICK_SIZE * BRICK_SIZE;
+                    const float * first = brick + ((lower[2] % BRICK_SIZE) * BRICK_SIZE + lower[1] % BRICK_SIZE) * BRICK_SIZE + lower[0] % BRICK_SIZE;
+
+                    for (uint32bit i = 0; i < 4; i++) {
+                        const float * row = first + ((i & 1) == 0 ? 0 : stepY) + ((i & 2) == 0 ? 0 : stepZ);
+
+                        values[i] = row[0] * (1.0f - weights[0]) + row[stepX] * weights[0];
+                    }
+
+                    return (values[0] * (1.0f - weights[1]) + values[1] * weights[1]) * (1.0f - weights[2]) + (values[2] * (1.0f - weights[1]) + values[3] * weights[1]) * weights[2];
+                }
+            }
+
+            for (uint32bit i = 0; i < 4; i++) {
+                const uint32bit y = (i & 1) == 0 ? lower[1] : upper[1];
+                const uint32bit z = (i & 2) == 0 ? lower[2] : upper[2];
+
+                values[i] = this->getDistance(lower[0], y, z) * (1.0f - weights[0]) + this->getDistance(upper[0], y, z) * weights[0];
+            }
+
+            return (values[0] * (1.0f - weights[1]) + values[1] * weights[1]) * (1.0f - weights[2]) + (values[2] * (1.0f - weights[1]) + values[3] * weights[1]) * weights[2];
+        }
+
+        void SignedDistanceField3F::getSlice(const uint32bit z, float * distances, const uint32bit threadCount) const
+        {
+            const uint32bit sizeX = this->sizes[0];
+
+            parallelFor(0, this->sizes[1], 16, [&](const size_t first, const size_t last) {
+                for (size_t y = first; y < last; y++) {
+                    float * row = distances + y * sizeX;
+
+                    for (uint32bit x = 0; x < sizeX; x++) {
+                        row[x] = this->getDistance(x, (uint32bit)y, z);
+                    }
+                }
+            }, threadCount);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
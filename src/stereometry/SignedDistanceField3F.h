@@ -0,0 +1,197 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_STEREOMETRY_SIGNED_DISTANCE_FIELD3F_H_
+#define _GEOMETRY_STEREOMETRY_SIGNED_DISTANCE_FIELD3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "IndexedMesh3F.h"
+#include "TriangleTree3F.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // ================ Signed distance field header ================ //
+
+        // Signed distance to a closed mesh sampled at the voxels
+        // origin + (x, y, z) * voxelSize, negative inside. The mesh must be
+        // oriented like IndexedMesh3F::getNormal(), with the normals outside;
+        // vertices with equal coordinates are taken as one, so unwelded
+        // meshes are fine.
+        //
+        // The voxels are grouped into bricks of BRICK_SIZE^3. Only the bricks
+        // within bandWidth of the surface are stored. Their voxels within
+        // bandWidth, and at least within one voxel, hold the exact distance
+        // to the nearest triangle with the sign of the angle weighted
+        // pseudonormal of its nearest face, edge or vertex. The farther
+        // voxels of the bricks take the nearest of the triangles swept in
+        // from their neighbours, an upper bound exact for most of them, and
+        // the signs of the neighbours. The voxels of the
+        // other bricks are interpolated from a coarse grid at the corners of
+        // the bricks, which is exact next to the stored bricks and swept by
+        // the fast sweeping method for the eikonal equation elsewhere. The
+        // error there stays below about the size of a brick, while the
+        // memory grows with the surface instead of the volume: a 1024^3 field
+        // needs 17 MB besides its stored bricks of 2 KB each.
+        class SignedDistanceField3F
+        {
+        public:
+            static const uint32bit BRICK_SIZE = 8;
+
+            // The slot of a brick that is not stored
+            static const uint32bit NO_BRICK = 0xFFFFFFFF;
+
+            SignedDistanceField3F();
+            virtual ~SignedDistanceField3F();
+
+            // The bricks are filled on the threads of the shared pool. Returns
+            // false for an empty mesh or tree, a zero size or a voxel size
+            // that is not positive; the field is empty then.
+            bool build(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F & origin, const float voxelSize, const uint32bit sizeX, const uint32bit sizeY, const uint32bit sizeZ, const float bandWidth, const uint32bit threadCount = 0);
+
+            void clear();
+
+            inline bool isEmpty() const;
+
+            inline const Vector3F & getOrigin() const;
+            inline float getVoxelSize() const;
+
+            inline uint32bit getSizeX() const;
+            inline uint32bit getSizeY() const;
+            inline uint32bit getSizeZ() const;
+
+            // The number of the stored bricks
+            inline size_t getBrickCount() const;
+            inline bool hasBrick(const uint32bit brickX, const uint32bit brickY, const uint32bit brickZ) const;
+
+            // The bytes held by the field
+            size_t getMemorySize() const;
+
+            // The voxel must be inside the field
+            inline float getDistance(const uint32bit x, const uint32bit y, const uint32bit z) const;
+
+            // Trilinear interpolation between the voxels, the point is clamped
+            // to the field
+            float sample(const Vector3F & point) const;
+
+            // The distances of the voxels with the given z, sizeX * sizeY of
+            // them with x running fastest
+            void getSlice(const uint32bit z, float * distances, const uint32bit threadCount = 0) const;
+
+        private:
+            static const uint32bit BRICK_VOLUME = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+
+            Vector3F origin;
+            float voxelSize;
+            uint32bit sizes[3];
+
+            // Bricks on every axis, the coarse grid has one node more
+            uint32bit brickCounts[3];
+
+            std::vector<uint32bit> brickSlots;
+            std::vector<float> brickDistances;
+            std::vector<float> coarseDistances;
+
+            inline float getCoarseDistance(const uint32bit x, const uint32bit y, const uint32bit z) const;
+
+            SignedDistanceField3F(const SignedDistanceField3F &);
+            SignedDistanceField3F & operator=(const SignedDistanceField3F &);
+        };
+
+        // ============ Signed distance field inline methods ============ //
+
+        bool SignedDistanceField3F::isEmpty() const
+        {
+            return this->coarseDistances.empty();
+        }
+
+        const Vector3F & SignedDistanceField3F::getOrigin() const
+        {
+            return this->origin;
+        }
+
+        float SignedDistanceField3F::getVoxelSize() const
+        {
+            return this->voxelSize;
+        }
+
+        uint32bit SignedDistanceField3F::getSizeX() const
+        {
+            return this->sizes[0];
+        }
+
+        uint32bit SignedDistanceField3F::getSizeY() const
+        {
+            return this->sizes[1];
+        }
+
+        uint32bit SignedDistanceField3F::getSizeZ() const
+        {
+            return this->sizes[2];
+        }
+
+        size_t SignedDistanceField3F::getBrickCount() const
+        {
+            return this->brickDistances.size() / BRICK_VOLUME;
+        }
+
+        bool SignedDistanceField3F::hasBrick(const uint32bit brickX, const uint32bit brickY, const uint32bit brickZ) const
+        {
+            return this->brickSlots[((size_t)brickZ * this->brickCounts[1] + brickY) * this->brickCounts[0] + brickX] != NO_BRICK;
+        }
+
+        float SignedDistanceField3F::getCoarseDistance(const uint32bit x, const uint32bit y, const uint32bit z) const
+        {
+            return this->coarseDistances[((size_t)z * (this->brickCounts[1] + 1) + y) * (this->brickCounts[0] + 1) + x];
+        }
+
+        float SignedDistanceField3F::getDistance(const uint32bit x, const uint32bit y, const uint32bit z) const
+        {
+            const uint32bit brickX = x / BRICK_SIZE;
+            const uint32bit brickY = y / BRICK_SIZE;
+            const uint32bit brickZ = z / BRICK_SIZE;
+
+            const uint32bit localX = x % BRICK_SIZE;
+            const uint32bit localY = y % BRICK_SIZE;
+            const uint32bit localZ = z % BRICK_SIZE;
+
+            const uint32bit slot = this->brickSlots[((size_t)brickZ * this->brickCounts[1] + brickY) * this->brickCounts[0] + brickX];
+
+            if (slot != NO_BRICK) {
+                return this->brickDistances[(size_t)slot * BRICK_VOLUME + (localZ * BRICK_SIZE + localY) * BRICK_SIZE + localX];
+            }
+
+            const float u = (float)localX / BRICK_SIZE;
+            const float v = (float)localY / BRICK_SIZE;
+            const float w = (float)localZ / BRICK_SIZE;
+
+            const float near00 = this->getCoarseDistance(brickX, brickY, brickZ) * (1.0f - u) + this->getCoarseDistance(brickX + 1, brickY, brickZ) * u;
+            const float near10 = this->getCoarseDistance(brickX, brickY + 1, brickZ) * (1.0f - u) + this->getCoarseDistance(brickX + 1, brickY + 1, brickZ) * u;
+            const float far00 = this->getCoarseDistance(brickX, brickY, brickZ + 1) * (1.0f - u) + this->getCoarseDistance(brickX + 1, brickY, brickZ + 1) * u;
+            const float far10 = this->getCoarseDistance(brickX, brickY + 1, brickZ + 1) * (1.0f - u) + this->getCoarseDistance(brickX + 1, brickY + 1, brickZ + 1) * u;
+
+            return (near00 * (1.0f - v) + near10 * v) * (1.0f - w) + (far00 * (1.0f - v) + far10 * v) * w;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_SIGNED_DISTANCE_FIELD3F_H_ */
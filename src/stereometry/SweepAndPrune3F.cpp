@@ -0,0 +1,413 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SweepAndPrune3F.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <mutex>
+
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMETRY_SSE_SWEEP_AND_PRUNE
+#endif
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        static inline float getCoordinate(const Vector3F & vector, const uint32bit axis)
+        {
+            return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+        }
+
+        // The order of the bits of a float taken as an unsigned integer
+        // is the order of the values
+        static inline uint32bit toSortKey(const float value)
+        {
+            uint32bit bits;
+            memcpy(&bits, &value, sizeof(bits));
+
+            return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+        }
+
+        // Infinities and NaN taken to the largest finite values, so the
+        // infinite padding stops every scan and the spread stays finite
+        static inline float toFinite(const float value)
+        {
+            return value < -3.402823466E+38f ? -3.402823466E+38f : (value <= 3.402823466E+38f ? value : 3.402823466E+38f);
+        }
+
+        const uint32bit SweepAndPrune3F::SWEEP_PADDING;
+
+        SweepAndPrune3F::SweepAndPrune3F()
+            : bodyCount(0), pairs(0, std::hash<uint64bit>(), std::equal_to<uint64bit>(), PoolSetAllocator<uint64bit>(pairNodes))
+        {
+        }
+
+        SweepAndPrune3F::~SweepAndPrune3F()
+        {
+        }
+
+        void SweepAndPrune3F::clear()
+        {
+            this->bodyCount = 0;
+
+            for (uint32bit axis = 0; axis < 3; axis++) {
+                this->endpoints[axis].clear();
+                this->sortBuffers[axis].clear();
+            }
+
+            this->pairs.clear();
+            this->pairCounts.clear();
+            this->addedPairs.clear();
+            this->removedPairs.clear();
+            this->foundPairs.clear();
+        }
+
+        void SweepAndPrune3F::getMemoryStatistics(MemoryStatistics & statistics) const
+        {
+            MemoryStatistics nodeStatistics;
+
+            this->scanArenas.getStatistics(statistics);
+            this->pairNodes.getStatistics(nodeStatistics);
+
+            statistics.reserved += nodeStatistics.reserved;
+            statistics.used += nodeStatistics.used;
+            statistics.wasted += nodeStatistics.wasted;
+            statistics.systemAllocations += nodeStatistics.systemAllocations;
+        }
+
+        void SweepAndPrune3F::getPairs(std::vector<SweepPair3F> & pairs) const
+        {
+            std::vector<uint64bit> keys(this->pairs.begin(), this->pairs.end());
+            std::sort(keys.begin(), keys.end());
+
+            pairs.resize(keys.size());
+
+            for (size_t i = 0; i < keys.size(); i++) {
+                pairs[i] = getPair(keys[i]);
+            }
+        }
+
+        // ====================== Full rebuild ====================== //
+
+        // Least significant digit radix sort by bytes. The minima are put
+        // before the maxima and the sort is stable, so at equal values the
+        // minima come first, as the overlaps of touching boxes need.
+        void SweepAndPrune3F::sortAxis(const uint32bit axis, const AxisBox3F * boxes)
+        {
+            std::vector<Endpoint> & target = this->endpoints[axis];
+            std::vector<Endpoint> & buffer = this->sortBuffers[axis];
+
+            const size_t count = this->bodyCount;
+
+            target.resize(count * 2);
+            buffer.resize(count * 2);
+
+            for (size_t i = 0; i < count; i++) {
+                target[i].value = getCoordinate(boxes[i].minimum, axis);
+                target[i].data = (uint32bit)(i * 2);
+                target[count + i].value = getCoordinate(boxes[i].maximum, axis);
+                target[count + i].data = (uint32bit)(i * 2 + 1);
+            }
+
+            Endpoint * source = &target[0];
+            Endpoint * destination = &buffer[0];
+
+            for (uint32bit shift = 0; shift < 32; shift += 8) {
+                size_t offsets[256];
+                memset(offsets, 0, sizeof(offsets));
+
+                for (size_t i = 0; i < count * 2; i++) {
+                    offsets[(toSortKey(source[i].value) >> shift) & 0xFF]++;
+                }
+
+                size_t offset = 0;
+
+                for (uint32bit digit = 0; digit < 256; digit++) {
+                    const size_t digitCount = offsets[digit];
+                    offsets[digit] = offset;
+                    offset += digitCount;
+                }
+
+                for (size_t i = 0; i < count * 2; i++) {
+                    destination[offsets[(toSortKey(source[i].value) >> shift) & 0xFF]++] = source[i];
+                }
+
+                std::swap(source, destination);
+            }
+        }
+
+        void SweepAndPrune3F::rebuild(const AxisBox3F * boxes, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("sweep.rebuild");
+
+            this->bodyCount = count;
+
+            parallelFor(0, 3, 1, [&](const size_t first, const size_t last) {
+                for (size_t axis = first; axis < last; axis++) {
+                    this->sortAxis((uint32bit)axis, boxes);
+                }
+            }, threadCount);
+
+            // The sweep runs along the axis where the centres spread the most
+            double sums[3] = { 0.0, 0.0, 0.0 };
+            double squareSums[3] = { 0.0, 0.0, 0.0 };
+
+            for (size_t i = 0; i < count; i++) {
+                for (uint32bit axis = 0; axis < 3; axis++) {
+                    const double value = ((double)toFinite(getCoordinate(boxes[i].minimum, axis)) + (double)toFinite(getCoordinate(boxes[i].maximum, axis))) * 0.5;
+                    sums[axis] += value;
+                    squareSums[axis] += value * value;
+                }
+            }
+
+            uint32bit sweepAxis = 0;
+            double largestVariance = -1.0;
+
+            for (uint32bit axis = 0; axis < 3 && count > 0; axis++) {
+                const double variance = squareSums[axis] - sums[axis] * sums[axis] / count;
+
+                if (variance > largestVariance) {
+                    largestVariance = variance;
+                    sweepAxis = axis;
+                }
+            }
+
+            // The bodies in the order of their minima on the sweep axis with
+            // the coordinates side by side, so the scans read them in order
+            const std::vector<Endpoint> & sweep = this->endpoints[sweepAxis];
+            const uint32bit axisA = sweepAxis == 0 ? 1 : 0;
+            const uint32bit axisB = sweepAxis == 2 ? 1 : 2;
+
+            this->sweepBodies.resize(count);
+            this->sweepMinima.resize(count + SWEEP_PADDING);
+            this->sweepMaxima.resize(count);
+            this->sweepMinimaA.resize(count + SWEEP_PADDING);
+            this->sweepMaximaA.resize(count + SWEEP_PADDING);
+            this->sweepMinimaB.resize(count + SWEEP_PADDING);
+            this->sweepMaximaB.resize(count + SWEEP_PADDING);
+
+            size_t position = 0;
+
+            for (size_t i = 0; i < sweep.size(); i++) {
+                if ((sweep[i].data & 1) == 0) {
+                    const uint32bit body = sweep[i].data >> 1;
+                    const AxisBox3F & box = boxes[body];
+
+                    this->sweepBodies[position] = body;
+                    this->sweepMinima[position] = toFinite(sweep[i].value);
+                    this->sweepMaxima[position] = toFinite(getCoordinate(box.maximum, sweepAxis));
+                    this->sweepMinimaA[position] = toFinite(getCoordinate(box.minimum, axisA));
+                    this->sweepMaximaA[position] = toFinite(getCoordinate(box.maximum, axisA));
+                    this->sweepMinimaB[position] = toFinite(getCoordinate(box.minimum, axisB));
+                    this->sweepMaximaB[position] = toFinite(getCoordinate(box.maximum, axisB));
+                    position++;
+                }
+            }
+
+            // The padding starts after every interval, the finite maxima
+            // included, and stops the scans
+            for (size_t i = count; i < count + SWEEP_PADDING; i++) {
+                this->sweepMinima[i] = INFINITY;
+                this->sweepMinimaA[i] = 0.0f;
+                this->sweepMaximaA[i] = 0.0f;
+                this->sweepMinimaB[i] = 0.0f;
+                this->sweepMaximaB[i] = 0.0f;
+            }
+
+            std::vector<uint64bit> & found = this->foundPairs;
+            std::mutex foundMutex;
+
+            found.clear();
+            this->scanArenas.reset();
+
+            // Every body meets the bodies starting inside its interval
+            parallelFor(0, count, 1024, [&](const size_t first, const size_t last) {
+                ScanBuffer local((ArenaAllocator<uint64bit>(this->scanArenas.getLocal())));
+
+                for (size_t i = first; i < last; i++) {
+                    this->scanSweep(i, local);
+                }
+
+                std::lock_guard<std::mutex> lock(foundMutex);
+                found.insert(found.end(), local.begin(), local.end());
+            }, threadCount);
+
+            // The order of the chunks depends on the threads
+            std::sort(found.begin(), found.end());
+
+            this->addedPairs.clear();
+            this->removedPairs.clear();
+
+            // The set is changed in place, so its nodes are reused
+            for (PairSet::iterator i = this->pairs.begin(); i != this->pairs.end();) {
+                if (!std::binary_search(found.begin(), found.end(), *i)) {
+                    this->removedPairs.push_back(getPair(*i));
+                    i = this->pairs.erase(i);
+                }
+                else {
+                    ++i;
+                }
+            }
+
+            for (size_t i = 0; i < found.size(); i++) {
+                if (this->pairs.insert(found[i]).second) {
+                    this->addedPairs.push_back(getPair(found[i]));
+                }
+            }
+
+            this->pairCounts.assign(count, 0);
+
+            for (size_t i = 0; i < found.size(); i++) {
+                this->pairCounts[found[i] >> 32]++;
+                this->pairCounts[(uint32bit)found[i]]++;
+            }
+        }
+
+#ifdef GEOMETRY_SSE_SWEEP_AND_PRUNE
+
+        void SweepAndPrune3F::scanSweep(const size_t index, ScanBuffer & found) const
+        {
+            const uint32bit body = this->sweepBodies[index];
+
+            const __m128 maximum = _mm_set1_ps(this->sweepMaxima[index]);
+            const __m128 minimumA = _mm_set1_ps(this->sweepMinimaA[index]);
+            const __m128 maximumA = _mm_set1_ps(this->sweepMaximaA[index]);
+            const __m128 minimumB = _mm_set1_ps(this->sweepMinimaB[index]);
+            const __m128 maximumB = _mm_set1_ps(this->sweepMaximaB[index]);
+
+            for (size_t other = index + 1; true; other += 4) {
+                const __m128 inside = _mm_cmple_ps(_mm_loadu_ps(&this->sweepMinima[other]), maximum);
+
+                const __m128 overlapA = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&this->sweepMinimaA[other]), maximumA), _mm_cmpge_ps(_mm_loadu_ps(&this->sweepMaximaA[other]), minimumA));
+                const __m128 overlapB = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&this->sweepMinimaB[other]), maximumB), _mm_cmpge_ps(_mm_loadu_ps(&this->sweepMaximaB[other]), minimumB));
+
+                const int insideMask = _mm_movemask_ps(inside);
+                int overlapMask = insideMask & _mm_movemask_ps(_mm_and_ps(overlapA, overlapB));
+
+                while (overlapMask != 0) {
+                    const uint32bit lane = overlapMask & 1 ? 0 : (overlapMask & 2 ? 1 : (overlapMask & 4 ? 2 : 3));
+                    found.push_back(getKey(body, this->sweepBodies[other + lane]));
+                    overlapMask &= overlapMask - 1;
+                }
+
+                // The minima grow, so a lane outside ends the interval
+                if (insideMask != 0xF) {
+                    return;
+                }
+            }
+        }
+
+#else
+
+        void SweepAndPrune3F::scanSweep(const size_t index, ScanBuffer & found) const
+        {
+            const uint32bit body = this->sweepBodies[index];
+            const float maximum = this->sweepMaxima[index];
+
+            for (size_t other = index + 1; this->sweepMinima[other] <= maximum; other++) {
+                if (this->sweepMinimaA[other] <= this->sweepMaximaA[index] && this->sweepMaximaA[other] >= this->sweepMinimaA[index]
+                    && this->sweepMinimaB[other] <= this->sweepMaximaB[index] && this->sweepMaximaB[other] >= this->sweepMinimaB[index]) {
+                    found.push_back(getKey(body, this->sweepBodies[other]));
+                }
+            }
+        }
+
+#endif
+
+        // ===================== Incremental update ===================== //
+
+        // Every two endpoints are swapped at most once by the insertion and
+        // only when their order has changed, so a swap compares the bodies
+        // in their final positions
+        void SweepAndPrune3F::insertAxis(const uint32bit axis, const AxisBox3F * boxes)
+        {
+            std::vector<Endpoint> & list = this->endpoints[axis];
+
+            for (size_t i = 0; i < list.size(); i++) {
+                const AxisBox3F & box = boxes[list[i].data >> 1];
+                list[i].value = getCoordinate((list[i].data & 1) != 0 ? box.maximum : box.minimum, axis);
+            }
+
+            for (size_t i = 1; i < list.size(); i++) {
+                const Endpoint key = list[i];
+                const bool keyIsMaximum = (key.data & 1) != 0;
+
+                size_t j = i;
+
+                while (j > 0 && (list[j - 1].value > key.value || (list[j - 1].value == key.value && (list[j - 1].data & 1) != 0 && !keyIsMaximum))) {
+                    j--;
+                }
+
+                if (j == i) {
+                    continue;
+                }
+
+                // Only the endpoints of the other kind change the overlaps
+                for (size_t k = j; k < i; k++) {
+                    const uint32bit other = list[k].data;
+
+                    if (((other ^ key.data) & 1) == 0) {
+                        continue;
+                    }
+
+                    const uint64bit pairKey = getKey(key.data >> 1, other >> 1);
+
+                    if (!keyIsMaximum) {
+                        if (boxes[key.data >> 1].intersects(boxes[other >> 1]) && this->pairs.insert(pairKey).second) {
+                            this->pairCounts[key.data >> 1]++;
+                            this->pairCounts[other >> 1]++;
+                            this->addedPairs.push_back(getPair(pairKey));
+                        }
+                    }
+                    else if (this->pairCounts[key.data >> 1] != 0 && this->pairCounts[other >> 1] != 0 && this->pairs.erase(pairKey) != 0) {
+                        this->pairCounts[key.data >> 1]--;
+                        this->pairCounts[other >> 1]--;
+                        this->removedPairs.push_back(getPair(pairKey));
+                    }
+                }
+
+                memmove(&list[j + 1], &list[j], (i - j) * sizeof(Endpoint));
+                list[j] = key;
+            }
+        }
+
+        bool SweepAndPrune3F::update(const AxisBox3F * boxes, const size_t count)
+        {
+            GEOMETRY_PROFILE_SCOPE("sweep.update");
+
+            if (count != this->bodyCount) {
+                return false;
+            }
+
+            this->addedPairs.clear();
+            this->removedPairs.clear();
+
+            for (uint32bit axis = 0; axis < 3; axis++) {
+                this->insertAxis(axis, boxes);
+            }
+
+            return true;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_SWEEP_AND_PRUNE3F_H_
+#define _GEOMETRY_STEREOMETRY_SWEEP_AND_PRUNE3F_H_
+
+#include <stddef.h>
+#include <unordered_set>
+#include <vector>
+
+#include "../types.h"
+#include "../Memory.h"
+#include "AxisBox3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Two bodies with overlapping boxes, first < second
+        struct SweepPair3F
+        {
+            uint32bit first;
+            uint32bit second;
+        };
+
+        // Broadphase over the boxes of the bodies, see AxisBox3::setToPoints()
+        // and AxisBox3::setToTriangles(); the boxes must not be empty. The
+        // minimal and the maximal coordinates of the boxes are kept sorted on
+        // every axis, a pair overlaps when it overlaps on all three. Touching
+        // boxes overlap. rebuild() takes infinite coordinates as the largest
+        // finite ones; the pairs of boxes with NaN coordinates are undefined.
+        //
+        // update() sorts the endpoints moved since the last call by
+        // insertion, which is close to linear when the bodies move little
+        // between the frames. The pairs are found from the swaps: a minimum
+        // passing a maximum may start an overlap, a maximum passing
+        // a minimum ends one. rebuild() sorts all endpoints by radix and
+        // finds the pairs from scratch in parallel, for the first frame and
+        // after teleports. Both report the difference to the previous pairs
+        // in getAddedPairs() and getRemovedPairs().
+        class SweepAndPrune3F
+        {
+        public:
+            SweepAndPrune3F();
+            virtual ~SweepAndPrune3F();
+
+            void rebuild(const AxisBox3F * boxes, const size_t count, const uint32bit threadCount = 0);
+
+            // Returns false when the count differs from the one of the last
+            // rebuild(), the state is left as it was then
+            bool update(const AxisBox3F * boxes, const size_t count);
+
+            // Removes the bodies and the pairs without reporting them
+            void clear();
+
+            inline size_t getBodyCount() const;
+            inline size_t getPairCount() const;
+
+            inline bool hasPair(const uint32bit first, const uint32bit second) const;
+            void getPairs(std::vector<SweepPair3F> & pairs) const;
+
+            // The events of the last rebuild() or update()
+            inline const std::vector<SweepPair3F> & getAddedPairs() const;
+            inline const std::vector<SweepPair3F> & getRemovedPairs() const;
+
+            // The memory of the pair set and of the scans of rebuild(), once
+            // the pairs stop growing the frames take no more from the system
+            void getMemoryStatistics(MemoryStatistics & statistics) const;
+
+        private:
+            // Entries after the last body, the vector scans read four at once
+            static const uint32bit SWEEP_PADDING = 4;
+
+            // data is body * 2, plus one for the maximum
+            struct Endpoint
+            {
+                float value;
+                uint32bit data;
+            };
+
+            size_t bodyCount;
+
+            std::vector<Endpoint> endpoints[3];
+            std::vector<Endpoint> sortBuffers[3];
+
+            // The bodies sorted by the minima on the sweep axis of rebuild(),
+            // A and B are the other axes
+            std::vector<uint32bit> sweepBodies;
+            std::vector<float> sweepMinima;
+            std::vector<float> sweepMaxima;
+            std::vector<float> sweepMinimaA;
+            std::vector<float> sweepMaximaA;
+            std::vector<float> sweepMinimaB;
+            std::vector<float> sweepMaximaB;
+
+            typedef std::vector<uint64bit, ArenaAllocator<uint64bit>> ScanBuffer;
+            typedef std::unordered_set<uint64bit, std::hash<uint64bit>, std::equal_to<uint64bit>, PoolSetAllocator<uint64bit>> PairSet;
+
+            // The scans of rebuild() collect their pairs in the arenas of
+            // their threads, foundPairs keeps them all sorted
+            ArenaSet scanArenas;
+            std::vector<uint64bit> foundPairs;
+
+            // The nodes of the pair set come from the pools and go back to
+            // them when the pairs end
+            PoolSet pairNodes;
+            PairSet pairs;
+
+            // The pairs of every body, most bodies have none and need no
+            // look up in the set when their overlaps end
+            std::vector<uint32bit> pairCounts;
+
+            std::vector<SweepPair3F> addedPairs;
+            std::vector<SweepPair3F> removedPairs;
+
+            static inline uint64bit getKey(const uint32bit first, const uint32bit second);
+            static inline SweepPair3F getPair(const uint64bit key);
+
+            void sortAxis(const uint32bit axis, const AxisBox3F * boxes);
+            void insertAxis(const uint32bit axis, const AxisBox3F * boxes);
+            void scanSweep(const size_t index, ScanBuffer & found) const;
+
+            SweepAndPrune3F(const SweepAndPrune3F &);
+            SweepAndPrune3F & operator=(const SweepAndPrune3F &);
+        };
+
+        size_t SweepAndPrune3F::getBodyCount() const
+        {
+            return this->bodyCount;
+        }
+
+        size_t SweepAndPrune3F::getPairCount() const
+        {
+            return this->pairs.size();
+        }
+
+        uint64bit SweepAndPrune3F::getKey(const uint32bit first, const uint32bit second)
+        {
+            return first < second ? ((uint64bit)first << 32) | second : ((uint64bit)second << 32) | first;
+        }
+
+        SweepPair3F SweepAndPrune3F::getPair(const uint64bit key)
+        {
+            SweepPair3F pair;
+
+            pair.first = (uint32bit)(key >> 32);
+            pair.second = (uint32bit)key;
+
+            return pair;
+        }
+
+        bool SweepAndPrune3F::hasPair(const uint32bit first, const uint32bit second) const
+        {
+            return this->pairs.find(getKey(first, second)) != this->pairs.end();
+        }
+
+        const std::vector<SweepPair3F> & SweepAndPrune3F::getAddedPairs() const
+        {
+            return this->addedPairs;
+        }
+
+        const std::vector<SweepPair3F> & SweepAndPrune3F::getRemovedPairs() const
+        {
+            return this->removedPairs;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_SWEEP_AND_PRUNE3F_H_ */
@@ -18,6 +18,7 @@
 #define _GEOMETRY_STEREOMETRY_TRIANGLE3_H_
 
 #include "Vector3.h"
+#include "Vector3Expression.h"
 
 namespace geometry
 {
@@ -43,6 +44,11 @@ namespace geometry
 
             inline VectorType getMedianCentre() const;
 
+            // The point of the triangle nearest to the given one, found by
+            // the Voronoi region of the point: a vertex, an edge or the face
+            inline VectorType closestPoint(const VectorType& point) const;
+            inline FloatType distanceTo(const VectorType& point) const;
+
             inline void setValuesOf(const BasicTriangle3Template<FloatType, VectorType>& triangle);
             inline void setValuesOf(const VectorType& vertexA, const VectorType& vertexB, const VectorType& vertexC);
 
@@ -132,7 +138,7 @@ namespace geometry
 
         template<typename FloatType, class VectorType> FloatType BasicTriangle3Template<FloatType, VectorType>::square() const
         {
-            return ((B - A).vector(C - A)).module() / 2;
+            return module(cross(expression(B) - A, expression(C) - A)) / 2;
         }
 
         template<typename FloatType, class VectorType> VectorType BasicTriangle3Template<FloatType, VectorType>::getMedianCentre() const
@@ -140,6 +146,63 @@ namespace geometry
             return VectorType((A.x + B.x + C.x) / 3, (A.y + B.y + C.y) / 3, (A.z + B.z + C.z) / 3);
         }
 
+        template<typename FloatType, class VectorType> VectorType BasicTriangle3Template<FloatType, VectorType>::closestPoint(const VectorType& point) const
+        {
+            const VectorType ab = B - A;
+            const VectorType ac = C - A;
+
+            const VectorType ap = point - A;
+            const FloatType d1 = ab.scalar(ap);
+            const FloatType d2 = ac.scalar(ap);
+
+            if (d1 <= 0 && d2 <= 0) {
+                return A;
+            }
+
+            const VectorType bp = point - B;
+            const FloatType d3 = ab.scalar(bp);
+            const FloatType d4 = ac.scalar(bp);
+
+            if (d3 >= 0 && d4 <= d3) {
+                return B;
+            }
+
+            const FloatType vc = d1 * d4 - d3 * d2;
+
+            if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+                return A + ab * (d1 / (d1 - d3));
+            }
+
+            const VectorType cp = point - C;
+            const FloatType d5 = ab.scalar(cp);
+            const FloatType d6 = ac.scalar(cp);
+
+            if (d6 >= 0 && d5 <= d6) {
+                return C;
+            }
+
+            const FloatType vb = d5 * d2 - d1 * d6;
+
+            if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+                return A + ac * (d2 / (d2 - d6));
+            }
+
+            const FloatType va = d3 * d6 - d5 * d4;
+
+            if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+                return B + (C - B) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+            }
+
+            const FloatType denominator = 1 / (va + vb + vc);
+
+            return A + ab * (vb * denominator) + ac * (vc * denominator);
+        }
+
+        template<typename FloatType, class VectorType> FloatType BasicTriangle3Template<FloatType, VectorType>::distanceTo(const VectorType& point) const
+        {
+            return (point - this->closestPoint(point)).module();
+        }
+
         template<typename FloatType, class VectorType> void BasicTriangle3Template<FloatType, VectorType>::setValuesOf(const BasicTriangle3Template<FloatType, VectorType>& triangle)
         {
             this->A.x = triangle.A.x;
@@ -208,12 +271,15 @@ namespace geometry
 
             result.A.x = (float)this->A.x;
             result.A.y = (float)this->A.y;
+            result.A.z = (float)this->A.z;
 
             result.B.x = (float)this->B.x;
             result.B.y = (float)this->B.y;
+            result.B.z = (float)this->B.z;
 
             result.C.x = (float)this->C.x;
             result.C.y = (float)this->C.y;
+            result.C.z = (float)this->C.z;
 
             return result;
         }
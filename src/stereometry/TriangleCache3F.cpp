@@ -0,0 +1,206 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TriangleCache3F.h"
+
+#include <math.h>
+
+#include "../constants.h"
+#include "../ThreadPool.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        void TriangleCache3F::Components::resize(const size_t count)
+        {
+            this->x.resize(count);
+            this->y.resize(count);
+            this->z.resize(count);
+        }
+
+        void TriangleCache3F::Components::clear()
+        {
+            this->x.clear();
+            this->y.clear();
+            this->z.clear();
+        }
+
+        TriangleCache3F::TriangleCache3F() : mesh(0)
+        {
+        }
+
+        TriangleCache3F::~TriangleCache3F()
+        {
+        }
+
+        bool TriangleCache3F::build(const IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            const size_t triangleCount = mesh.getTriangleCount();
+            const size_t vertexCount = mesh.getVertexCount();
+
+            for (size_t i = 0; i < triangleCount * 3; i++) {
+                if (mesh.indices[i] >= vertexCount) {
+                    this->clear();
+                    return false;
+                }
+            }
+
+            this->mesh = &mesh;
+
+            this->edgesAB.resize(triangleCount);
+            this->edgesAC.resize(triangleCount);
+            this->normals.resize(triangleCount);
+            this->centroids.resize(triangleCount);
+            this->areas.resize(triangleCount);
+
+            this->states.assign(triangleCount, CURRENT);
+            this->dirtyTriangles.clear();
+
+            // Counting sort of the corners by vertex
+            this->vertexOffsets.assign(vertexCount + 1, 0);
+            this->vertexTriangles.resize(triangleCount * 3);
+
+            for (size_t i = 0; i < triangleCount * 3; i++) {
+                this->vertexOffsets[mesh.indices[i] + 1]++;
+            }
+
+            for (size_t i = 0; i < vertexCount; i++) {
+                this->vertexOffsets[i + 1] += this->vertexOffsets[i];
+            }
+
+            std::vector<uint32bit> positions(this->vertexOffsets.begin(), this->vertexOffsets.end() - 1);
+
+            for (size_t i = 0; i < triangleCount * 3; i++) {
+                this->vertexTriangles[positions[mesh.indices[i]]++] = (uint32bit)(i / 3);
+            }
+
+            parallelFor(0, triangleCount, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    this->compute(i);
+                }
+            }, threadCount);
+
+            return true;
+        }
+
+        void TriangleCache3F::clear()
+        {
+            this->mesh = 0;
+
+            this->edgesAB.clear();
+            this->edgesAC.clear();
+            this->normals.clear();
+            this->centroids.clear();
+            this->areas.clear();
+
+            this->vertexOffsets.clear();
+            this->vertexTriangles.clear();
+
+            this->states.clear();
+            this->dirtyTriangles.clear();
+        }
+
+        void TriangleCache3F::markVertexDirty(const uint32bit vertex)
+        {
+            if ((size_t)vertex + 1 >= this->vertexOffsets.size()) {
+                return;
+            }
+
+            for (uint32bit i = this->vertexOffsets[vertex]; i < this->vertexOffsets[vertex + 1]; i++) {
+                const uint32bit triangle = this->vertexTriangles[i];
+
+                // A queued triangle is listed already, it is listed once until refresh()
+                if (this->states[triangle] == CURRENT) {
+                    this->dirtyTriangles.push_back(triangle);
+                }
+
+                this->states[triangle] = DIRTY;
+            }
+        }
+
+        void TriangleCache3F::markAllDirty()
+        {
+            this->dirtyTriangles.clear();
+
+            for (size_t i = 0; i < this->states.size(); i++) {
+                this->states[i] = DIRTY;
+                this->dirtyTriangles.push_back((uint32bit)i);
+            }
+        }
+
+        void TriangleCache3F::refresh(const uint32bit threadCount)
+        {
+            // Every triangle is listed once, triangles already recomputed by a
+            // getter are only marked current
+            parallelFor(0, this->dirtyTriangles.size(), DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const uint32bit triangle = this->dirtyTriangles[i];
+
+                    if (this->states[triangle] == DIRTY) {
+                        this->compute(triangle);
+                    }
+
+                    this->states[triangle] = CURRENT;
+                }
+            }, threadCount);
+
+            this->dirtyTriangles.clear();
+        }
+
+        void TriangleCache3F::compute(const size_t triangle)
+        {
+            const uint32bit * indices = &this->mesh->indices[triangle * 3];
+
+            const Vector3F & A = this->mesh->vertices[indices[0]];
+            const Vector3F & B = this->mesh->vertices[indices[1]];
+            const Vector3F & C = this->mesh->vertices[indices[2]];
+
+            const Vector3F edgeAB = B - A;
+            const Vector3F edgeAC = C - A;
+            const Vector3F product = edgeAB.vector(edgeAC);
+
+            const float squareProduct = product.x * product.x + product.y * product.y + product.z * product.z;
+            const float doubleArea = sqrtf(squareProduct);
+
+            this->edgesAB.x[triangle] = edgeAB.x;
+            this->edgesAB.y[triangle] = edgeAB.y;
+            this->edgesAB.z[triangle] = edgeAB.z;
+
+            this->edgesAC.x[triangle] = edgeAC.x;
+            this->edgesAC.y[triangle] = edgeAC.y;
+            this->edgesAC.z[triangle] = edgeAC.z;
+
+            // Degenerate triangles get a zero normal like Vector3F::normalize gives
+            if (squareProduct <= FloatConstants<float>::SQUARE_EPSYLON) {
+                this->normals.x[triangle] = 0.0f;
+                this->normals.y[triangle] = 0.0f;
+                this->normals.z[triangle] = 0.0f;
+            }
+            else {
+                this->normals.x[triangle] = product.x / doubleArea;
+                this->normals.y[triangle] = product.y / doubleArea;
+                this->normals.z[triangle] = product.z / doubleArea;
+            }
+
+            this->centroids.x[triangle] = (A.x + B.x + C.x) / 3.0f;
+            this->centroids.y[triangle] = (A.y + B.y + C.y) / 3.0f;
+            this->centroids.z[triangle] = (A.z + B.z + C.z) / 3.0f;
+
+            this->areas[triangle] = doubleArea * 0.5f;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
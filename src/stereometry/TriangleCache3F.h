@@ -0,0 +1,200 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_TRIANGLE_CACHE3F_H_
+#define _GEOMETRY_STEREOMETRY_TRIANGLE_CACHE3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "IndexedMesh3F.h"
+#include "Vector3.h"
+#include "Vector3Expression.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Derived data of the triangles of an indexed mesh: the edge vectors
+        // AB and AC, the unit normal, the area and the centroid, every
+        // component stored in its own array.
+        //
+        // The cache keeps a pointer to the mesh. When vertices are moved they
+        // are marked dirty, the triangles sharing them are recomputed by the
+        // next refresh() or, one by one, by the first getter asking for them.
+        // A change of the vertex or triangle count needs a new build().
+        class TriangleCache3F
+        {
+        public:
+            TriangleCache3F();
+            virtual ~TriangleCache3F();
+
+            // Computes the data of all triangles of the mesh in parallel, a mesh
+            // with an index out of its vertices is rejected and the cache is cleared
+            bool build(const IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+            void clear();
+
+            inline size_t getTriangleCount() const;
+
+            void markVertexDirty(const uint32bit vertex);
+            void markAllDirty();
+
+            inline bool hasDirtyTriangles() const;
+
+            // Recomputes all dirty triangles in parallel
+            void refresh(const uint32bit threadCount = 0);
+
+            // The getters recompute a dirty triangle before returning its data
+            inline Vector3F getEdgeAB(const size_t triangle);
+            inline Vector3F getEdgeAC(const size_t triangle);
+            inline Vector3F getNormal(const size_t triangle);
+            inline Vector3F getCentroid(const size_t triangle);
+            inline float getArea(const size_t triangle);
+
+            // Direct access to the arrays for batch kernels, valid until the
+            // next build() and current only after refresh()
+            inline Vector3Array<const float> getEdgesAB() const;
+            inline Vector3Array<const float> getEdgesAC() const;
+            inline Vector3Array<const float> getNormals() const;
+            inline Vector3Array<const float> getCentroids() const;
+            inline const float * getAreas() const;
+
+        private:
+            struct Components
+            {
+                std::vector<float> x, y, z;
+
+                void resize(const size_t count);
+                void clear();
+            };
+
+            const IndexedMesh3F * mesh;
+
+            Components edgesAB;
+            Components edgesAC;
+            Components normals;
+            Components centroids;
+            std::vector<float> areas;
+
+            // Triangles of every vertex: the triangles of vertex v are
+            // vertexTriangles[vertexOffsets[v]] to vertexTriangles[vertexOffsets[v + 1] - 1]
+            std::vector<uint32bit> vertexOffsets;
+            std::vector<uint32bit> vertexTriangles;
+
+            // States of the triangles, a triangle recomputed by a getter stays
+            // listed in dirtyTriangles as QUEUED until the next refresh()
+            enum TriangleState
+            {
+                CURRENT = 0,
+                DIRTY = 1,
+                QUEUED = 2
+            };
+
+            std::vector<uint8bit> states;
+            std::vector<uint32bit> dirtyTriangles;
+
+            void compute(const size_t triangle);
+            inline void ensureCurrent(const size_t triangle);
+
+            static inline Vector3Array<const float> view(const Components & components);
+        };
+
+        size_t TriangleCache3F::getTriangleCount() const
+        {
+            return this->areas.size();
+        }
+
+        bool TriangleCache3F::hasDirtyTriangles() const
+        {
+            return !this->dirtyTriangles.empty();
+        }
+
+        void TriangleCache3F::ensureCurrent(const size_t triangle)
+        {
+            if (this->states[triangle] == DIRTY) {
+                this->compute(triangle);
+                this->states[triangle] = QUEUED;
+            }
+        }
+
+        Vector3F TriangleCache3F::getEdgeAB(const size_t triangle)
+        {
+            this->ensureCurrent(triangle);
+            return Vector3F(this->edgesAB.x[triangle], this->edgesAB.y[triangle], this->edgesAB.z[triangle]);
+        }
+
+        Vector3F TriangleCache3F::getEdgeAC(const size_t triangle)
+        {
+            this->ensureCurrent(triangle);
+            return Vector3F(this->edgesAC.x[triangle], this->edgesAC.y[triangle], this->edgesAC.z[triangle]);
+        }
+
+        Vector3F TriangleCache3F::getNormal(const size_t triangle)
+        {
+            this->ensureCurrent(triangle);
+            return Vector3F(this->normals.x[triangle], this->normals.y[triangle], this->normals.z[triangle]);
+        }
+
+        Vector3F TriangleCache3F::getCentroid(const size_t triangle)
+        {
+            this->ensureCurrent(triangle);
+            return Vector3F(this->centroids.x[triangle], this->centroids.y[triangle], this->centroids.z[triangle]);
+        }
+
+        float TriangleCache3F::getArea(const size_t triangle)
+        {
+            this->ensureCurrent(triangle);
+            return this->areas[triangle];
+        }
+
+        Vector3Array<const float> TriangleCache3F::view(const Components & components)
+        {
+            if (components.x.empty()) {
+                return Vector3Array<const float>();
+            }
+
+            return Vector3Array<const float>(&components.x[0], &components.y[0], &components.z[0]);
+        }
+
+        Vector3Array<const float> TriangleCache3F::getEdgesAB() const
+        {
+            return view(this->edgesAB);
+        }
+
+        Vector3Array<const float> TriangleCache3F::getEdgesAC() const
+        {
+            return view(this->edgesAC);
+        }
+
+        Vector3Array<const float> TriangleCache3F::getNormals() const
+        {
+            return view(this->normals);
+        }
+
+        Vector3Array<const float> TriangleCache3F::getCentroids() const
+        {
+            return view(this->centroids);
+        }
+
+        const float * TriangleCache3F::getAreas() const
+        {
+            return this->areas.empty() ? 0 : &this->areas[0];
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_TRIANGLE_CACHE3F_H_ */
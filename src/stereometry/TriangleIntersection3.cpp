@@ -0,0 +1,291 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TriangleIntersection3.h"
+
+#include <math.h>
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Plane distances below this part of the size of the triangles are
+        // taken as zero
+        template<typename FloatType> struct TriangleTolerance;
+
+        template<> struct TriangleTolerance<float>
+        {
+            static inline float relative() { return 1E-6f; }
+        };
+
+        template<> struct TriangleTolerance<double>
+        {
+            static inline double relative() { return 1E-12; }
+        };
+
+        template<typename FloatType, class VectorType> static inline FloatType getSquareSize(const BasicTriangle3Template<FloatType, VectorType> & triangle)
+        {
+            const VectorType ab = triangle.B - triangle.A;
+            const VectorType bc = triangle.C - triangle.B;
+            const VectorType ca = triangle.A - triangle.C;
+
+            FloatType size = ab.scalar(ab);
+            size = bc.scalar(bc) > size ? bc.scalar(bc) : size;
+            size = ca.scalar(ca) > size ? ca.scalar(ca) : size;
+
+            return size;
+        }
+
+        // The distances of the vertices of triangle from the plane of the
+        // other one, multiplied by the length of its normal. Returns false
+        // when the triangle is on one side of the plane.
+        template<typename FloatType, class VectorType> static bool getPlaneDistances(const BasicTriangle3Template<FloatType, VectorType> & plane, const BasicTriangle3Template<FloatType, VectorType> & triangle, VectorType & normal, FloatType * distances)
+        {
+            normal = (plane.B - plane.A).vector(plane.C - plane.A);
+
+            const FloatType planeSize = getSquareSize(plane);
+            const FloatType triangleSize = getSquareSize(triangle);
+
+            const FloatType threshold = TriangleTolerance<FloatType>::relative() * (FloatType)sqrt(normal.scalar(normal) * (planeSize > triangleSize ? planeSize : triangleSize));
+
+            distances[0] = normal.scalar(triangle.A - plane.A);
+            distances[1] = normal.scalar(triangle.B - plane.A);
+            distances[2] = normal.scalar(triangle.C - plane.A);
+
+            for (uint32bit i = 0; i < 3; i++) {
+                if (fabs(distances[i]) <= threshold) {
+                    distances[i] = 0;
+                }
+            }
+
+            return !(distances[0] * distances[1] > 0 && distances[0] * distances[2] > 0);
+        }
+
+        // The segment where a triangle crossing a plane is cut by it, from
+        // the vertex alone on its side towards the two other ones
+        template<typename FloatType, class VectorType> static void getCut(const BasicTriangle3Template<FloatType, VectorType> & triangle, const FloatType * distances, VectorType & start, VectorType & end)
+        {
+            const VectorType * vertices[3] = { &triangle.A, &triangle.B, &triangle.C };
+
+            uint32bit alone = 0;
+
+            if (distances[0] * distances[1] > 0) {
+                alone = 2;
+            }
+            else if (distances[0] * distances[2] > 0) {
+                alone = 1;
+            }
+            else if (distances[1] * distances[2] > 0 || distances[0] != 0) {
+                alone = 0;
+            }
+            else if (distances[1] != 0) {
+                alone = 1;
+            }
+            else {
+                alone = 2;
+            }
+
+            const uint32bit next = alone == 2 ? 0 : alone + 1;
+            const uint32bit previous = alone == 0 ? 2 : alone - 1;
+
+            const VectorType & vertex = *vertices[alone];
+            const FloatType distance = distances[alone];
+
+            start = vertex + (*vertices[next] - vertex) * (distance / (distance - distances[next]));
+            end = vertex + (*vertices[previous] - vertex) * (distance / (distance - distances[previous]));
+        }
+
+        // ================= Coplanar triangles ================= //
+
+        template<typename FloatType> static inline FloatType orient(const FloatType * a, const FloatType * b, const FloatType * c)
+        {
+            return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+        }
+
+        template<typename FloatType> static bool intersectSegments(const FloatType * a, const FloatType * b, const FloatType * c, const FloatType * d)
+        {
+            const FloatType abc = orient(a, b, c);
+            const FloatType abd = orient(a, b, d);
+
+            if (abc == 0 && abd == 0) {
+                // On one line: the projections onto the longer axis overlap
+                const uint32bit axis = fabs(b[0] - a[0]) + fabs(d[0] - c[0]) >= fabs(b[1] - a[1]) + fabs(d[1] - c[1]) ? 0 : 1;
+
+                const FloatType minimumAB = a[axis] < b[axis] ? a[axis] : b[axis];
+                const FloatType maximumAB = a[axis] < b[axis] ? b[axis] : a[axis];
+                const FloatType minimumCD = c[axis] < d[axis] ? c[axis] : d[axis];
+                const FloatType maximumCD = c[axis] < d[axis] ? d[axis] : c[axis];
+
+                return minimumAB <= maximumCD && minimumCD <= maximumAB;
+            }
+
+            const FloatType cda = orient(c, d, a);
+            const FloatType cdb = orient(c, d, b);
+
+            return abc * abd <= 0 && cda * cdb <= 0;
+        }
+
+        template<typename FloatType> static bool containsPoint(const FloatType (* triangle)[2], const FloatType * point)
+        {
+            const FloatType ab = orient(triangle[0], triangle[1], point);
+            const FloatType bc = orient(triangle[1], triangle[2], point);
+            const FloatType ca = orient(triangle[2], triangle[0], point);
+
+            return (ab >= 0 && bc >= 0 && ca >= 0) || (ab <= 0 && bc <= 0 && ca <= 0);
+        }
+
+        // The test in the coordinate plane the triangles are least slanted to
+        template<typename FloatType, class VectorType> static bool intersectCoplanar(const BasicTriangle3Template<FloatType, VectorType> & first, const BasicTriangle3Template<FloatType, VectorType> & second, const VectorType & normal)
+        {
+            const FloatType x = fabs(normal.x);
+            const FloatType y = fabs(normal.y);
+            const FloatType z = fabs(normal.z);
+
+            const VectorType * firstVertices[3] = { &first.A, &first.B, &first.C };
+            const VectorType * secondVertices[3] = { &second.A, &second.B, &second.C };
+
+            FloatType p[3][2];
+            FloatType q[3][2];
+
+            for (uint32bit i = 0; i < 3; i++) {
+                if (x >= y && x >= z) {
+                    p[i][0] = firstVertices[i]->y;
+                    p[i][1] = firstVertices[i]->z;
+                    q[i][0] = secondVertices[i]->y;
+                    q[i][1] = secondVertices[i]->z;
+                }
+                else if (y >= z) {
+                    p[i][0] = firstVertices[i]->x;
+                    p[i][1] = firstVertices[i]->z;
+                    q[i][0] = secondVertices[i]->x;
+                    q[i][1] = secondVertices[i]->z;
+                }
+                else {
+                    p[i][0] = firstVertices[i]->x;
+                    p[i][1] = firstVertices[i]->y;
+                    q[i][0] = secondVertices[i]->x;
+                    q[i][1] = secondVertices[i]->y;
+                }
+            }
+
+            for (uint32bit i = 0; i < 3; i++) {
+                for (uint32bit j = 0; j < 3; j++) {
+                    if (intersectSegments(p[i], p[i == 2 ? 0 : i + 1], q[j], q[j == 2 ? 0 : j + 1])) {
+                        return true;
+                    }
+                }
+            }
+
+            return containsPoint(q, p[0]) || containsPoint(p, q[0]);
+        }
+
+        // ================= Triangle intersection ================= //
+
+        template<typename FloatType, class VectorType> static bool intersectTrianglesOf(const BasicTriangle3Template<FloatType, VectorType> & first, const BasicTriangle3Template<FloatType, VectorType> & second, VectorType * start, VectorType * end, bool * coplanar)
+        {
+            if (coplanar != 0) {
+                *coplanar = false;
+            }
+
+            VectorType secondNormal;
+            FloatType firstDistances[3];
+
+            if (!getPlaneDistances(second, first, secondNormal, firstDistances)) {
+                return false;
+            }
+
+            VectorType firstNormal;
+            FloatType secondDistances[3];
+
+            if (!getPlaneDistances(first, second, firstNormal, secondDistances)) {
+                return false;
+            }
+
+            if ((firstDistances[0] == 0 && firstDistances[1] == 0 && firstDistances[2] == 0) || (secondDistances[0] == 0 && secondDistances[1] == 0 && secondDistances[2] == 0)) {
+                if (coplanar != 0) {
+                    *coplanar = true;
+                }
+
+                return intersectCoplanar(first, second, firstNormal);
+            }
+
+            // Both cuts are on the line of direction, compared by their
+            // projections onto it
+            const VectorType direction = firstNormal.vector(secondNormal);
+
+            VectorType firstStart, firstEnd, secondStart, secondEnd;
+            getCut(first, firstDistances, firstStart, firstEnd);
+            getCut(second, secondDistances, secondStart, secondEnd);
+
+            FloatType firstMinimum = direction.scalar(firstStart);
+            FloatType firstMaximum = direction.scalar(firstEnd);
+
+            if (firstMinimum > firstMaximum) {
+                const VectorType swapped = firstStart;
+                firstStart = firstEnd;
+                firstEnd = swapped;
+
+                const FloatType value = firstMinimum;
+                firstMinimum = firstMaximum;
+                firstMaximum = value;
+            }
+
+            FloatType secondMinimum = direction.scalar(secondStart);
+            FloatType secondMaximum = direction.scalar(secondEnd);
+
+            if (secondMinimum > secondMaximum) {
+                const VectorType swapped = secondStart;
+                secondStart = secondEnd;
+                secondEnd = swapped;
+
+                const FloatType value = secondMinimum;
+                secondMinimum = secondMaximum;
+                secondMaximum = value;
+            }
+
+            if (firstMaximum < secondMinimum || secondMaximum < firstMinimum) {
+                return false;
+            }
+
+            if (start != 0) {
+                *start = firstMinimum > secondMinimum ? firstStart : secondStart;
+                *end = firstMaximum < secondMaximum ? firstEnd : secondEnd;
+            }
+
+            return true;
+        }
+
+        bool intersectTriangles(const Triangle3F & first, const Triangle3F & second)
+        {
+            return intersectTrianglesOf<float, Vector3F>(first, second, 0, 0, 0);
+        }
+
+        bool intersectTriangles(const Triangle3 & first, const Triangle3 & second)
+        {
+            return intersectTrianglesOf<double, Vector3>(first, second, 0, 0, 0);
+        }
+
+        bool intersectTriangles(const Triangle3F & first, const Triangle3F & second, Vector3F & start, Vector3F & end, bool & coplanar)
+        {
+            return intersectTrianglesOf<float, Vector3F>(first, second, &start, &end, &coplanar);
+        }
+
+        bool intersectTriangles(const Triangle3 & first, const Triangle3 & second, Vector3 & start, Vector3 & end, bool & coplanar)
+        {
+            return intersectTrianglesOf<double, Vector3>(first, second, &start, &end, &coplanar);
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
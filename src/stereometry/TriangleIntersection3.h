@@ -0,0 +1,45 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_TRIANGLE_INTERSECTION3_H_
+#define _GEOMETRY_STEREOMETRY_TRIANGLE_INTERSECTION3_H_
+
+#include "../types.h"
+#include "Triangle3.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Möller's interval test: each triangle is cut by the plane of the
+        // other one, the two cuts lie on the line where the planes meet and
+        // the triangles intersect when the cuts overlap. Touching counts as
+        // intersecting. Distances to a plane below a tolerance relative to
+        // the size of the triangles are taken as zero.
+        //
+        // With the segment, start and end get the ends of the overlap. For
+        // coplanar triangles coplanar is set, the intersection is an area
+        // and the segment is not computed.
+        bool intersectTriangles(const Triangle3F & first, const Triangle3F & second);
+        bool intersectTriangles(const Triangle3 & first, const Triangle3 & second);
+
+        bool intersectTriangles(const Triangle3F & first, const Triangle3F & second, Vector3F & start, Vector3F & end, bool & coplanar);
+        bool intersectTriangles(const Triangle3 & first, const Triangle3 & second, Vector3 & start, Vector3 & end, bool & coplanar);
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_TRIANGLE_INTERSECTION3_H_ */
@@ -0,0 +1,678 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TriangleTree3F.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "../Memory.h"
+#include "../Profiler.h"
+#include "../ThreadPool.h"
+#include "MortonOrder3F.h"
+#include "TriangleIntersection3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // The node pairs found before the parallel search, several for every
+        // thread so that the uneven ones even out
+        static const size_t SEARCH_TASK_COUNT = 256;
+
+        // Deeper than the median split of 2^32 triangles gets
+        static const uint32bit QUERY_STACK_SIZE = 64;
+
+        // Lengths and sines below this part of the size of the triangles are
+        // taken as zero for the neighbours
+        static const float NEIGHBOUR_TOLERANCE = 1E-5f;
+
+        static inline float getCoordinate(const Vector3F & vector, const uint32bit axis)
+        {
+            return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+        }
+
+        // ======================== Triangle tree ======================== //
+
+        const uint32bit TriangleTree3F::LEAF_SIZE;
+        const uint32bit TriangleTree3F::NO_TRIANGLE;
+
+        TriangleTree3F::TriangleTree3F()
+        {
+        }
+
+        TriangleTree3F::TriangleTree3F(const TriangleTree3F & tree)
+            : nodes(tree.nodes), items(tree.items), itemBoxes(tree.itemBoxes)
+        {
+        }
+
+        TriangleTree3F::~TriangleTree3F()
+        {
+        }
+
+        TriangleTree3F & TriangleTree3F::operator=(const TriangleTree3F & tree)
+        {
+            this->nodes = tree.nodes;
+            this->items = tree.items;
+            this->itemBoxes = tree.itemBoxes;
+
+            return *this;
+        }
+
+        void TriangleTree3F::build(const IndexedMesh3F & mesh, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle_tree.build");
+
+            this->itemBoxes.resize(mesh.getTriangleCount());
+
+            parallelFor(0, this->itemBoxes.size(), DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const uint32bit * triangle = &mesh.indices[i * 3];
+
+                    AxisBox3F & box = this->itemBoxes[i];
+                    box.minimum = box.maximum = mesh.vertices[triangle[0]];
+                    box.add(mesh.vertices[triangle[1]]);
+                    box.add(mesh.vertices[triangle[2]]);
+                }
+            }, threadCount);
+
+            this->buildNodes();
+        }
+
+        void TriangleTree3F::build(const Triangle3F * triangles, const size_t count, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle_tree.build");
+
+            this->itemBoxes.resize(count);
+
+            parallelFor(0, count, DEFAULT_PARALLEL_GRAIN, [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    this->itemBoxes[i].setToTriangles(triangles + i, 1);
+                }
+            }, threadCount);
+
+            this->buildNodes();
+        }
+
+        void TriangleTree3F::clear()
+        {
+            this->nodes.clear();
+            this->items.clear();
+            this->itemBoxes.clear();
+        }
+
+        void TriangleTree3F::buildNodes()
+        {
+            const size_t count = this->itemBoxes.size();
+
+            this->nodes.clear();
+            this->items.resize(count);
+
+            if (count == 0) {
+                return;
+            }
+
+            // The temporaries take the memory of the last build
+            this->buildArena.reset();
+
+            std::vector<Vector3F, ArenaAllocator<Vector3F>> centres(count, Vector3F(), ArenaAllocator<Vector3F>(this->buildArena));
+
+            for (size_t i = 0; i < count; i++) {
+                this->items[i] = (uint32bit)i;
+                centres[i] = this->itemBoxes[i].getCentre();
+            }
+
+            // A binary tree with leaves of at least one item has fewer than
+            // twice as many nodes as items
+            this->nodes.reserve(count * 2);
+
+            FrustumNode3F root;
+            root.firstChild = 0;
+            root.childCount = 0;
+            root.firstItem = 0;
+            root.itemCount = (uint32bit)count;
+            this->nodes.push_back(root);
+
+            std::vector<uint32bit, ArenaAllocator<uint32bit>> stack(1, 0, ArenaAllocator<uint32bit>(this->buildArena));
+
+            while (!stack.empty()) {
+                const uint32bit index = stack.back();
+                stack.pop_back();
+
+                const uint32bit firstItem = this->nodes[index].firstItem;
+                const uint32bit itemCount = this->nodes[index].itemCount;
+
+                AxisBox3F box = this->itemBoxes[this->items[firstItem]];
+                AxisBox3F centreBox(centres[this->items[firstItem]], centres[this->items[firstItem]]);
+
+                for (uint32bit i = firstItem + 1; i < firstItem + itemCount; i++) {
+                    box.add(this->itemBoxes[this->items[i]]);
+                    centreBox.add(centres[this->items[i]]);
+                }
+
+                this->nodes[index].box = box;
+
+                const Vector3F extent = centreBox.maximum - centreBox.minimum;
+                const uint32bit axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+                // Equal centres can not be split
+                if (itemCount <= LEAF_SIZE || getCoordinate(extent, axis) <= 0.0f) {
+                    continue;
+                }
+
+                const uint32bit half = itemCount / 2;
+                uint32bit * begin = &this->items[firstItem];
+
+                std::nth_element(begin, begin + half, begin + itemCount, [&](const uint32bit a, const uint32bit b) {
+                    return getCoordinate(centres[a], axis) < getCoordinate(centres[b], axis);
+                });
+
+                const uint32bit firstChild = (uint32bit)this->nodes.size();
+
+                FrustumNode3F child;
+                child.firstChild = 0;
+                child.childCount = 0;
+                child.firstItem = firstItem;
+                child.itemCount = half;
+                this->nodes.push_back(child);
+
+                child.firstItem = firstItem + half;
+                child.itemCount = itemCount - half;
+                this->nodes.push_back(child);
+
+                this->nodes[index].firstChild = firstChild;
+                this->nodes[index].childCount = 2;
+                this->nodes[index].itemCount = 0;
+
+                stack.push_back(firstChild);
+                stack.push_back(firstChild + 1);
+            }
+        }
+
+        // ========================= Neighbours ========================= //
+
+        static inline float getSquareSize(const Triangle3F & triangle)
+        {
+            const float ab = (triangle.B - triangle.A).scalar(triangle.B - triangle.A);
+            const float bc = (triangle.C - triangle.B).scalar(triangle.C - triangle.B);
+            const float ca = (triangle.A - triangle.C).scalar(triangle.A - triangle.C);
+
+            return std::max(ab, std::max(bc, ca));
+        }
+
+        // Whether the ray is strictly between the rays of a wedge, all of
+        // unit length in the plane of the unit normal
+        static inline bool isInsideWedge(const Vector3F & normal, const Vector3F & ray, const Vector3F & from, const Vector3F & to)
+        {
+            if (normal.scalar(from.vector(to)) < 0.0f) {
+                return isInsideWedge(normal, ray, to, from);
+            }
+
+            return normal.scalar(from.vector(ray)) > NEIGHBOUR_TOLERANCE && normal.scalar(ray.vector(to)) > NEIGHBOUR_TOLERANCE;
+        }
+
+        static inline bool isSameRay(const Vector3F & normal, const Vector3F & first, const Vector3F & second)
+        {
+            return fabs(normal.scalar(first.vector(second))) <= NEIGHBOUR_TOLERANCE && first.scalar(second) > 0.0f;
+        }
+
+        // Triangles of the mesh, which may share vertices
+        static bool crossTriangles(const IndexedMesh3F & mesh, const uint32bit first, const uint32bit second)
+        {
+            const uint32bit * a = &mesh.indices[first * 3];
+            const uint32bit * b = &mesh.indices[second * 3];
+
+            // Positions of the shared vertices in both triangles
+            uint32bit sharedA[3];
+            uint32bit sharedB[3];
+            uint32bit shared = 0;
+
+            // Unwelded meshes, as read from STL, repeat the shared vertices
+            for (uint32bit i = 0; i < 3; i++) {
+                for (uint32bit j = 0; j < 3; j++) {
+                    const Vector3F & vertexA = mesh.vertices[a[i]];
+                    const Vector3F & vertexB = mesh.vertices[b[j]];
+
+                    if (a[i] == b[j] || (vertexA.x == vertexB.x && vertexA.y == vertexB.y && vertexA.z == vertexB.z)) {
+                        sharedA[shared] = i;
+                        sharedB[shared] = j;
+                        shared++;
+                        break;
+                    }
+                }
+            }
+
+            const Triangle3F triangleA = mesh.getTriangle(first);
+            const Triangle3F triangleB = mesh.getTriangle(second);
+
+            if (shared == 0) {
+                return intersectTriangles(triangleA, triangleB);
+            }
+
+            // The same face twice
+            if (shared == 3) {
+                return true;
+            }
+
+            const Vector3F & apex = mesh.vertices[a[sharedA[0]]];
+
+            if (shared == 2) {
+                // Planes crossing at the shared edge meet only there, in one
+                // plane the triangles overlap when they are on one side
+                const Vector3F edge = mesh.vertices[a[sharedA[1]]] - apex;
+                const Vector3F oppositeA = mesh.vertices[a[3 - sharedA[0] - sharedA[1]]] - apex;
+                const Vector3F oppositeB = mesh.vertices[b[3 - sharedB[0] - sharedB[1]]] - apex;
+
+                const Vector3F normal = edge.vector(oppositeA);
+                const float height = normal.scalar(oppositeB);
+                const float size = std::max(edge.scalar(edge), std::max(oppositeA.scalar(oppositeA), oppositeB.scalar(oppositeB)));
+
+                if (height * height > NEIGHBOUR_TOLERANCE * NEIGHBOUR_TOLERANCE * normal.scalar(normal) * size) {
+                    return false;
+                }
+
+                return normal.scalar(edge.vector(oppositeB)) > 0.0f;
+            }
+
+            Vector3F start, end;
+            bool coplanar;
+
+            if (!intersectTriangles(triangleA, triangleB, start, end, coplanar)) {
+                return false;
+            }
+
+            if (!coplanar) {
+                const float tolerance = NEIGHBOUR_TOLERANCE * NEIGHBOUR_TOLERANCE * std::max(getSquareSize(triangleA), getSquareSize(triangleB));
+
+                return (end - start).scalar(end - start) > tolerance;
+            }
+
+            // In one plane the triangles at a vertex overlap when the wedges
+            // of their edges from it do
+            Vector3F fromA = mesh.vertices[a[(sharedA[0] + 1) % 3]] - apex;
+            Vector3F toA = mesh.vertices[a[(sharedA[0] + 2) % 3]] - apex;
+            Vector3F fromB = mesh.vertices[b[(sharedB[0] + 1) % 3]] - apex;
+            Vector3F toB = mesh.vertices[b[(sharedB[0] + 2) % 3]] - apex;
+
+            Vector3F normal = fromA.vector(toA);
+
+            if (!normal.normalize() || !fromA.normalize() || !toA.normalize() || !fromB.normalize() || !toB.normalize()) {
+                return false;
+            }
+
+            if (isInsideWedge(normal, fromB, fromA, toA) || isInsideWedge(normal, toB, fromA, toA) || isInsideWedge(normal, fromA, fromB, toB) || isInsideWedge(normal, toA, fromB, toB)) {
+                return true;
+            }
+
+            return (isSameRay(normal, fromA, fromB) && isSameRay(normal, toA, toB)) || (isSameRay(normal, fromA, toB) && isSameRay(normal, toA, fromB));
+        }
+
+        // =========================== Search =========================== //
+
+        struct IntersectionSearch
+        {
+            const IndexedMesh3F * first;
+            const TriangleTree3F * firstTree;
+            const IndexedMesh3F * second;
+            const TriangleTree3F * secondTree;
+
+            // The triangles of one mesh against each other
+            bool self;
+
+            ArenaSet * taskArenas;
+            ArenaSet * stackArenas;
+        };
+
+        // A node of the first tree against one of the second, or a node
+        // against itself when searching one mesh
+        struct SearchTask
+        {
+            uint32bit first;
+            uint32bit second;
+            bool self;
+        };
+
+        static inline SearchTask makeTask(const uint32bit first, const uint32bit second, const bool self)
+        {
+            SearchTask task;
+            task.first = first;
+            task.second = second;
+            task.self = self;
+
+            return task;
+        }
+
+        typedef std::vector<SearchTask, ArenaAllocator<SearchTask>> SearchTasks;
+        typedef std::vector<TrianglePair3F, ArenaAllocator<TrianglePair3F>> FoundPairs;
+
+        // Puts the subtasks of the task into tasks, none when the boxes are
+        // apart. Returns false for a task of two leaves, which is tested.
+        static bool splitTask(const IntersectionSearch & search, const SearchTask & task, SearchTasks & tasks)
+        {
+            const FrustumNode3F & first = search.firstTree->getNodes()[task.first];
+
+            if (task.self) {
+                if (first.childCount == 0) {
+                    return false;
+                }
+
+                tasks.push_back(makeTask(first.firstChild, first.firstChild, true));
+                tasks.push_back(makeTask(first.firstChild + 1, first.firstChild + 1, true));
+                tasks.push_back(makeTask(first.firstChild, first.firstChild + 1, false));
+
+                return true;
+            }
+
+            const FrustumNode3F & second = search.secondTree->getNodes()[task.second];
+
+            if (!first.box.intersects(second.box)) {
+                return true;
+            }
+
+            if (first.childCount == 0 && second.childCount == 0) {
+                return false;
+            }
+
+            // The larger node is split
+            const Vector3F firstSize = first.box.getHalfSize();
+            const Vector3F secondSize = second.box.getHalfSize();
+
+            if (second.childCount == 0 || (first.childCount != 0 && firstSize.x + firstSize.y + firstSize.z >= secondSize.x + secondSize.y + secondSize.z)) {
+                tasks.push_back(makeTask(first.firstChild, task.second, false));
+                tasks.push_back(makeTask(first.firstChild + 1, task.second, false));
+            }
+            else {
+                tasks.push_back(makeTask(task.first, second.firstChild, false));
+                tasks.push_back(makeTask(task.first, second.firstChild + 1, false));
+            }
+
+            return true;
+        }
+
+        static void testLeaves(const IntersectionSearch & search, const SearchTask & task, FoundPairs & found)
+        {
+            const std::vector<uint32bit> & firstItems = search.firstTree->getItems();
+            const std::vector<uint32bit> & secondItems = search.secondTree->getItems();
+            const std::vector<AxisBox3F> & firstBoxes = search.firstTree->getItemBoxes();
+            const std::vector<AxisBox3F> & secondBoxes = search.secondTree->getItemBoxes();
+
+            const FrustumNode3F & firstNode = search.firstTree->getNodes()[task.first];
+            const FrustumNode3F & secondNode = search.secondTree->getNodes()[task.second];
+
+            for (uint32bit i = 0; i < firstNode.itemCount; i++) {
+                const uint32bit a = firstItems[firstNode.firstItem + i];
+
+                // Within a leaf every pair is taken once
+                for (uint32bit j = task.self ? i + 1 : 0; j < secondNode.itemCount; j++) {
+                    const uint32bit b = secondItems[secondNode.firstItem + j];
+
+                    if (!firstBoxes[a].intersects(secondBoxes[b])) {
+                        continue;
+                    }
+
+                    TrianglePair3F pair;
+
+                    if (search.self) {
+                        if (!crossTriangles(*search.first, a, b)) {
+                            continue;
+                        }
+
+                        pair.first = std::min(a, b);
+                        pair.second = std::max(a, b);
+                    }
+                    else {
+                        if (!intersectTriangles(search.first->getTriangle(a), search.second->getTriangle(b))) {
+                            continue;
+                        }
+
+                        pair.first = a;
+                        pair.second = b;
+                    }
+
+                    found.push_back(pair);
+                }
+            }
+        }
+
+        static size_t searchTrees(const IntersectionSearch & search, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount)
+        {
+            pairs.clear();
+
+            if (search.firstTree->isEmpty() || search.secondTree->isEmpty()) {
+                return 0;
+            }
+
+            // The first levels of the search give the parallel tasks. Only
+            // the own arena of a thread is reset, at the start of its work.
+            Arena & taskArena = search.taskArenas->getLocal();
+            taskArena.reset();
+
+            SearchTasks tasks(1, makeTask(0, 0, search.self), ArenaAllocator<SearchTask>(taskArena));
+            SearchTasks next((ArenaAllocator<SearchTask>(taskArena)));
+            bool split = true;
+
+            while (split && tasks.size() < SEARCH_TASK_COUNT) {
+                next.clear();
+                split = false;
+
+                for (size_t i = 0; i < tasks.size(); i++) {
+                    if (splitTask(search, tasks[i], next)) {
+                        split = true;
+                    }
+                    else {
+                        next.push_back(tasks[i]);
+                    }
+                }
+
+                tasks.swap(next);
+            }
+
+            std::mutex pairsMutex;
+
+            parallelFor(0, tasks.size(), 1, [&](const size_t first, const size_t last) {
+                Arena & stackArena = search.stackArenas->getLocal();
+                stackArena.reset();
+
+                FoundPairs found((ArenaAllocator<TrianglePair3F>(stackArena)));
+                SearchTasks stack((ArenaAllocator<SearchTask>(stackArena)));
+
+                for (size_t i = first; i < last; i++) {
+                    stack.push_back(tasks[i]);
+
+                    while (!stack.empty()) {
+                        const SearchTask task = stack.back();
+                        stack.pop_back();
+
+                        if (!splitTask(search, task, stack)) {
+                            testLeaves(search, task, found);
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(pairsMutex);
+                pairs.insert(pairs.end(), found.begin(), found.end());
+            }, threadCount);
+
+            // The order of the tasks depends on the threads
+            std::sort(pairs.begin(), pairs.end(), [](const TrianglePair3F & a, const TrianglePair3F & b) {
+                return a.first < b.first || (a.first == b.first && a.second < b.second);
+            });
+
+            return pairs.size();
+        }
+
+        size_t findSelfIntersections(const IndexedMesh3F & mesh, const TriangleTree3F & tree, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle_tree.self_intersections");
+
+            IntersectionSearch search;
+            search.first = &mesh;
+            search.firstTree = &tree;
+            search.second = &mesh;
+            search.secondTree = &tree;
+            search.self = true;
+            search.taskArenas = &tree.searchTaskArenas;
+            search.stackArenas = &tree.searchStackArenas;
+
+            return searchTrees(search, pairs, threadCount);
+        }
+
+        size_t findIntersections(const IndexedMesh3F & first, const TriangleTree3F & firstTree, const IndexedMesh3F & second, const TriangleTree3F & secondTree, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle_tree.intersections");
+
+            IntersectionSearch search;
+            search.first = &first;
+            search.firstTree = &firstTree;
+            search.second = &second;
+            search.secondTree = &secondTree;
+            search.self = false;
+            search.taskArenas = &firstTree.searchTaskArenas;
+            search.stackArenas = &firstTree.searchStackArenas;
+
+            return searchTrees(search, pairs, threadCount);
+        }
+
+        // ======================= Closest points ======================= //
+
+        static inline float getSquareDistance(const AxisBox3F & box, const Vector3F & point)
+        {
+            const float x = std::max(std::max(box.minimum.x - point.x, point.x - box.maximum.x), 0.0f);
+            const float y = std::max(std::max(box.minimum.y - point.y, point.y - box.maximum.y), 0.0f);
+            const float z = std::max(std::max(box.minimum.z - point.z, point.z - box.maximum.z), 0.0f);
+
+            return x * x + y * y + z * z;
+        }
+
+        static bool searchClosestPoint(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F & point, const float maximumDistance, ClosestMeshPoint3F & result)
+        {
+            const std::vector<FrustumNode3F> & nodes = tree.getNodes();
+            const std::vector<uint32bit> & items = tree.getItems();
+            const std::vector<AxisBox3F> & itemBoxes = tree.getItemBoxes();
+
+            float bestSquareDistance = maximumDistance < 1.8E+19f ? maximumDistance * maximumDistance : 3.402823466E+38f;
+
+            result.triangle = TriangleTree3F::NO_TRIANGLE;
+
+            uint32bit stack[QUERY_STACK_SIZE];
+            float stackDistances[QUERY_STACK_SIZE];
+            uint32bit depth = 0;
+
+            stack[depth] = 0;
+            stackDistances[depth] = getSquareDistance(nodes[0].box, point);
+            depth++;
+
+            while (depth > 0) {
+                depth--;
+
+                if (stackDistances[depth] > bestSquareDistance) {
+                    continue;
+                }
+
+                const FrustumNode3F & node = nodes[stack[depth]];
+
+                for (uint32bit i = node.firstItem; i < node.firstItem + node.itemCount; i++) {
+                    const uint32bit triangle = items[i];
+
+                    if (getSquareDistance(itemBoxes[triangle], point) > bestSquareDistance) {
+                        continue;
+                    }
+
+                    const Vector3F closest = mesh.getTriangle(triangle).closestPoint(point);
+                    const float squareDistance = (closest - point).scalar(closest - point);
+
+                    if (squareDistance <= bestSquareDistance) {
+                        bestSquareDistance = squareDistance;
+                        result.point = closest;
+                        result.triangle = triangle;
+                    }
+                }
+
+                if (node.childCount == 0) {
+                    continue;
+                }
+
+                // The nearer child is popped first
+                const float firstDistance = getSquareDistance(nodes[node.firstChild].box, point);
+                const float secondDistance = getSquareDistance(nodes[node.firstChild + 1].box, point);
+                const bool firstNearer = firstDistance <= secondDistance;
+
+                stack[depth] = firstNearer ? node.firstChild + 1 : node.firstChild;
+                stackDistances[depth] = firstNearer ? secondDistance : firstDistance;
+                stack[depth + 1] = firstNearer ? node.firstChild : node.firstChild + 1;
+                stackDistances[depth + 1] = firstNearer ? firstDistance : secondDistance;
+                depth += 2;
+            }
+
+            if (result.triangle == TriangleTree3F::NO_TRIANGLE) {
+                return false;
+            }
+
+            result.distance = sqrt(bestSquareDistance);
+
+            return true;
+        }
+
+        bool findClosestPoint(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F & point, ClosestMeshPoint3F & result, const float maximumDistance)
+        {
+            if (tree.isEmpty()) {
+                result.triangle = TriangleTree3F::NO_TRIANGLE;
+                return false;
+            }
+
+            return searchClosestPoint(mesh, tree, point, maximumDistance, result);
+        }
+
+        size_t findClosestPoints(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F * points, ClosestMeshPoint3F * results, const size_t count, const float maximumDistance, const uint32bit threadCount)
+        {
+            GEOMETRY_PROFILE_SCOPE("triangle_tree.closest_points");
+
+            if (tree.isEmpty()) {
+                for (size_t i = 0; i < count; i++) {
+                    results[i].triangle = TriangleTree3F::NO_TRIANGLE;
+                }
+
+                return 0;
+            }
+
+            // The queries run in the Morton order of their points, the ones
+            // near each other visit the same nodes while they are cached
+            std::vector<uint32bit> order;
+            sortInMortonOrder(points, count, order, threadCount);
+
+            std::atomic<size_t> found(0);
+
+            parallelFor(0, count, 256, [&](const size_t first, const size_t last) {
+                size_t localFound = 0;
+
+                for (size_t i = first; i < last; i++) {
+                    const uint32bit index = order[i];
+
+                    if (searchClosestPoint(mesh, tree, points[index], maximumDistance, results[index])) {
+                        localFound++;
+                    }
+                }
+
+                found += localFound;
+            }, threadCount);
+
+            return found;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GEOMETRY_STEREOMETRY_TRIANGLE_TREE3F_H_
+#define _GEOMETRY_STEREOMETRY_TRIANGLE_TREE3F_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "../types.h"
+#include "../Memory.h"
+#include "AxisBox3.h"
+#include "Frustum3F.h"
+#include "IndexedMesh3F.h"
+#include "Triangle3.h"
+#include "Vector3.h"
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // Two intersecting triangles, of one mesh with first < second or of
+        // two meshes with first in the first one
+        struct TrianglePair3F
+        {
+            uint32bit first;
+            uint32bit second;
+        };
+
+        // The point of a mesh nearest to a query point and its triangle
+        struct ClosestMeshPoint3F
+        {
+            Vector3F point;
+            float distance;
+            uint32bit triangle;
+        };
+
+        // ===================== Triangle tree header ===================== //
+
+        // Bounding volume hierarchy over the boxes of triangles. A node is
+        // split at the median of the centres of its triangles on the longest
+        // axis of their bounds until it holds at most LEAF_SIZE of them.
+        // Inner nodes have two children and no items, so the nodes can be
+        // given to Frustum3F::cullTree() as they are.
+        class TriangleTree3F
+        {
+        public:
+            static const uint32bit LEAF_SIZE = 4;
+
+            // The triangle of a query without an answer
+            static const uint32bit NO_TRIANGLE = 0xFFFFFFFF;
+
+            TriangleTree3F();
+
+            // The copies do not take the memory of the builds and searches
+            TriangleTree3F(const TriangleTree3F & tree);
+            virtual ~TriangleTree3F();
+
+            TriangleTree3F & operator=(const TriangleTree3F & tree);
+
+            // The boxes of the triangles are found on the threads of the
+            // shared pool
+            void build(const IndexedMesh3F & mesh, const uint32bit threadCount = 0);
+            void build(const Triangle3F * triangles, const size_t count, const uint32bit threadCount = 0);
+
+            void clear();
+
+            inline bool isEmpty() const;
+
+            inline const std::vector<FrustumNode3F> & getNodes() const;
+
+            // The triangles in the order of the leaves
+            inline const std::vector<uint32bit> & getItems() const;
+
+            // The boxes of the triangles by their indices
+            inline const std::vector<AxisBox3F> & getItemBoxes() const;
+
+        private:
+            std::vector<FrustumNode3F> nodes;
+            std::vector<uint32bit> items;
+            std::vector<AxisBox3F> itemBoxes;
+
+            // The temporaries of the builds, rebuilds of the same size take
+            // no memory from the system
+            Arena buildArena;
+
+            // The temporaries of the intersection searches started with this
+            // tree first, an arena per thread: the tasks are split on the
+            // calling thread and run with the stacks of the loop threads
+            mutable ArenaSet searchTaskArenas;
+            mutable ArenaSet searchStackArenas;
+
+            void buildNodes();
+
+            friend size_t findSelfIntersections(const IndexedMesh3F & mesh, const TriangleTree3F & tree, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount);
+            friend size_t findIntersections(const IndexedMesh3F & first, const TriangleTree3F & firstTree, const IndexedMesh3F & second, const TriangleTree3F & secondTree, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount);
+        };
+
+        // The triangles of the mesh crossing each other, sorted. Triangles
+        // sharing vertices, by index or by equal coordinates in unwelded
+        // meshes, touch by design and are reported only when they overlap
+        // beyond the shared vertex or edge: folded neighbours and flaps
+        // through the fan of a vertex. The node pairs of the tree are
+        // searched on the threads of the shared pool. Returns the number of
+        // the pairs.
+        size_t findSelfIntersections(const IndexedMesh3F & mesh, const TriangleTree3F & tree, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount = 0);
+
+        // The triangles of the first mesh intersecting ones of the second,
+        // sorted. Returns the number of the pairs.
+        size_t findIntersections(const IndexedMesh3F & first, const TriangleTree3F & firstTree, const IndexedMesh3F & second, const TriangleTree3F & secondTree, std::vector<TrianglePair3F> & pairs, const uint32bit threadCount = 0);
+
+        // The nearest point of the mesh to one point within maximumDistance,
+        // for callers that already run on the threads of the pool. Returns
+        // false and sets the triangle to TriangleTree3F::NO_TRIANGLE when
+        // there is none.
+        bool findClosestPoint(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F & point, ClosestMeshPoint3F & result, const float maximumDistance = 3.402823466E+38f);
+
+        // The nearest point of the mesh to every query point within
+        // maximumDistance, otherwise the triangle of the result is
+        // TriangleTree3F::NO_TRIANGLE. The nodes are visited nearest first
+        // and skipped when their boxes are farther than the best point so
+        // far. The queries run on the threads of the shared pool. Returns
+        // the number of the points with an answer.
+        size_t findClosestPoints(const IndexedMesh3F & mesh, const TriangleTree3F & tree, const Vector3F * points, ClosestMeshPoint3F * results, const size_t count, const float maximumDistance = 3.402823466E+38f, const uint32bit threadCount = 0);
+
+        // ================= Triangle tree inline methods ================= //
+
+        bool TriangleTree3F::isEmpty() const
+        {
+            return this->nodes.empty();
+        }
+
+        const std::vector<FrustumNode3F> & TriangleTree3F::getNodes() const
+        {
+            return this->nodes;
+        }
+
+        const std::vector<uint32bit> & TriangleTree3F::getItems() const
+        {
+            return this->items;
+        }
+
+        const std::vector<AxisBox3F> & TriangleTree3F::getItemBoxes() const
+        {
+            return this->itemBoxes;
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_TRIANGLE_TREE3F_H_ */
@@ -30,32 +30,31 @@ namespace geometry
         template<typename FloatType> class BasicVector3Template
         {
         public:
-            static const FloatType ZERO;
-            static const FloatType UNIT;
-            static const FloatType EPSYLON;
-            static const FloatType NEGATIVE_EPSYLON;
-            static const FloatType SQUARE_EPSYLON;
+            static constexpr FloatType ZERO = FloatConstants<FloatType>::ZERO;
+            static constexpr FloatType UNIT = FloatConstants<FloatType>::UNIT;
+            static constexpr FloatType EPSYLON = FloatConstants<FloatType>::EPSYLON;
+            static constexpr FloatType NEGATIVE_EPSYLON = FloatConstants<FloatType>::NEGATIVE_EPSYLON;
+            static constexpr FloatType SQUARE_EPSYLON = FloatConstants<FloatType>::SQUARE_EPSYLON;
 
             FloatType x, y, z;
 
-            virtual ~BasicVector3Template()
-            {
-            }
+            constexpr BasicVector3Template();
+            constexpr BasicVector3Template(const FloatType x, const FloatType y, const FloatType z);
 
-            inline void setToZero();
+            constexpr void setToZero();
 
-            inline bool isZero() const;
-            inline bool isUnit() const;
-            inline bool isCloseTo(const FloatType x, const FloatType y, const FloatType z) const;
-            inline bool isCloseTo(const BasicVector3Template<FloatType>& vector) const;
+            constexpr bool isZero() const;
+            constexpr bool isUnit() const;
+            constexpr bool isCloseTo(const FloatType x, const FloatType y, const FloatType z) const;
+            constexpr bool isCloseTo(const BasicVector3Template<FloatType>& vector) const;
 
-            inline void setValues(const FloatType x, const FloatType y, const FloatType z);
-            inline void setValuesOf(const BasicVector3Template<FloatType> & vector);
+            constexpr void setValues(const FloatType x, const FloatType y, const FloatType z);
+            constexpr void setValuesOf(const BasicVector3Template<FloatType> & vector);
 
-            inline FloatType scalar(const FloatType x, const FloatType y, const FloatType z) const;
-            inline FloatType scalar(const BasicVector3Template<FloatType> & vector) const;
+            constexpr FloatType scalar(const FloatType x, const FloatType y, const FloatType z) const;
+            constexpr FloatType scalar(const BasicVector3Template<FloatType> & vector) const;
 
-            inline FloatType triple(const BasicVector3Template<FloatType> & vector2, const BasicVector3Template<FloatType> & vector3) const;
+            constexpr FloatType triple(const BasicVector3Template<FloatType> & vector2, const BasicVector3Template<FloatType> & vector3) const;
         };
 
         // ==================== Vector3<double> header =================== //
@@ -65,32 +64,30 @@ namespace geometry
         class Vector3 : public BasicVector3Template<double>
         {
         public:
-            inline Vector3();
-            inline Vector3(const Vector3F& vector);
-            inline Vector3(const double x, const double y, const double z);
+            constexpr Vector3();
+            constexpr Vector3(const Vector3F& vector);
+            constexpr Vector3(const double x, const double y, const double z);
 
-            virtual ~Vector3();
-
-            inline void setValuesOf(const Vector3F& vector);
+            constexpr void setValuesOf(const Vector3F& vector);
 
             inline double module() const;
 
             inline bool normalize();
 
-            inline Vector3F toFloat() const;
+            constexpr Vector3F toFloat() const;
 
-            inline Vector3 vector(const Vector3& vector) const;
+            constexpr Vector3 vector(const Vector3& vector) const;
 
-            inline Vector3 operator+(const Vector3 & vector) const;
-            inline Vector3 operator-(const Vector3 & vector) const;
-            inline Vector3 operator*(const double value) const;
-            inline Vector3 operator/(const double value) const;
+            constexpr Vector3 operator+(const Vector3 & vector) const;
+            constexpr Vector3 operator-(const Vector3 & vector) const;
+            constexpr Vector3 operator*(const double value) const;
+            constexpr Vector3 operator/(const double value) const;
 
-            inline Vector3 & operator+=(const Vector3 & vector);
-            inline Vector3 & operator-=(const Vector3 & vector);
-            inline Vector3 & operator*=(const double value);
-            inline Vector3 & operator*=(const Vector3 & vector);
-            inline Vector3 & operator/=(const double value);
+            constexpr Vector3 & operator+=(const Vector3 & vector);
+            constexpr Vector3 & operator-=(const Vector3 & vector);
+            constexpr Vector3 & operator*=(const double value);
+            constexpr Vector3 & operator*=(const Vector3 & vector);
+            constexpr Vector3 & operator/=(const double value);
         };
 
         // ==================== Vector3<float> header ==================== //
@@ -98,55 +95,69 @@ namespace geometry
         class Vector3F : public BasicVector3Template<float>
         {
         public:
-            inline Vector3F();
-            inline Vector3F(const Vector3 & vector);
-            inline Vector3F(const float x, const float y, const float z);
-
-            virtual ~Vector3F();
+            constexpr Vector3F();
+            constexpr Vector3F(const Vector3 & vector);
+            constexpr Vector3F(const float x, const float y, const float z);
 
-            inline void setValuesOf(const Vector3 & vector);
+            constexpr void setValuesOf(const Vector3 & vector);
 
             inline float module() const;
 
             inline bool normalize();
 
-            inline Vector3 toDouble() const;
+            constexpr Vector3 toDouble() const;
 
-            inline Vector3F vector(const Vector3F& vector) const;
+            constexpr Vector3F vector(const Vector3F& vector) const;
 
-            inline Vector3F operator+(const Vector3F & vector) const;
-            inline Vector3F operator-(const Vector3F & vector) const;
-            inline Vector3F operator*(const float value) const;
-            inline Vector3F operator/(const float value) const;
+            constexpr Vector3F operator+(const Vector3F & vector) const;
+            constexpr Vector3F operator-(const Vector3F & vector) const;
+            constexpr Vector3F operator*(const float value) const;
+            constexpr Vector3F operator/(const float value) const;
 
-            inline Vector3F & operator+=(const Vector3F & vector);
-            inline Vector3F & operator-=(const Vector3F & vector);
-            inline Vector3F & operator*=(const float value);
-            inline Vector3F & operator*=(const Vector3F& vector);
-            inline Vector3F & operator/=(const float value);
+            constexpr Vector3F & operator+=(const Vector3F & vector);
+            constexpr Vector3F & operator-=(const Vector3F & vector);
+            constexpr Vector3F & operator*=(const float value);
+            constexpr Vector3F & operator*=(const Vector3F& vector);
+            constexpr Vector3F & operator/=(const float value);
         };
 
         // =============== Vector3 Template inline methods =============== //
 
-        template<typename FloatType> void BasicVector3Template<FloatType>::setToZero()
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::ZERO;
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::UNIT;
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::EPSYLON;
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::NEGATIVE_EPSYLON;
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::SQUARE_EPSYLON;
+
+        template<typename FloatType> constexpr BasicVector3Template<FloatType>::BasicVector3Template()
+            : x(ZERO), y(ZERO), z(ZERO)
+        {
+        }
+
+        template<typename FloatType> constexpr BasicVector3Template<FloatType>::BasicVector3Template(const FloatType x, const FloatType y, const FloatType z)
+            : x(x), y(y), z(z)
+        {
+        }
+
+        template<typename FloatType> constexpr void BasicVector3Template<FloatType>::setToZero()
         {
             this->x = ZERO;
             this->y = ZERO;
             this->z = ZERO;
         }
 
-        template<typename FloatType> bool BasicVector3Template<FloatType>::isZero() const
+        template<typename FloatType> constexpr bool BasicVector3Template<FloatType>::isZero() const
         {
             return this->x * this->x + this->y * this->y + this->z * this->z <= SQUARE_EPSYLON;
         }
 
-        template<typename FloatType> bool BasicVector3Template<FloatType>::isUnit() const
+        template<typename FloatType> constexpr bool BasicVector3Template<FloatType>::isUnit() const
         {
             FloatType difference = this->x * this->x + this->y * this->y + this->z * this->z - UNIT;
             return NEGATIVE_EPSYLON <= difference && difference <= EPSYLON;
         }
 
-        template<typename FloatType> bool BasicVector3Template<FloatType>::isCloseTo(const FloatType x, const FloatType y, const FloatType z) const
+        template<typename FloatType> constexpr bool BasicVector3Template<FloatType>::isCloseTo(const FloatType x, const FloatType y, const FloatType z) const
         {
             FloatType dx = this->x - x;
             FloatType dy = this->y - y;
@@ -155,7 +166,7 @@ namespace geometry
             return dx * dx + dy * dy + dz * dz <= SQUARE_EPSYLON;
         }
 
-        template<typename FloatType> bool BasicVector3Template<FloatType>::isCloseTo(const BasicVector3Template<FloatType>& vector) const
+        template<typename FloatType> constexpr bool BasicVector3Template<FloatType>::isCloseTo(const BasicVector3Template<FloatType>& vector) const
         {
             FloatType dx = this->x - vector.x;
             FloatType dy = this->y - vector.y;
@@ -165,31 +176,31 @@ namespace geometry
         }
 
 
-        template<typename FloatType> void BasicVector3Template<FloatType>::setValues(const FloatType x, const FloatType y, const FloatType z)
+        template<typename FloatType> constexpr void BasicVector3Template<FloatType>::setValues(const FloatType x, const FloatType y, const FloatType z)
         {
             this->x = x;
             this->y = y;
             this->z = z;
         }
 
-        template<typename FloatType> void BasicVector3Template<FloatType>::setValuesOf(const BasicVector3Template<FloatType> & vector)
+        template<typename FloatType> constexpr void BasicVector3Template<FloatType>::setValuesOf(const BasicVector3Template<FloatType> & vector)
         {
             this->x = vector.x;
             this->y = vector.y;
             this->z = vector.z;
         }
 
-        template<typename FloatType> FloatType BasicVector3Template<FloatType>::scalar(const FloatType x, const FloatType y, const FloatType z) const
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::scalar(const FloatType x, const FloatType y, const FloatType z) const
         {
             return this->x * x + this->y * y + this->z * z;
         }
 
-        template<typename FloatType> FloatType BasicVector3Template<FloatType>::scalar(const BasicVector3Template<FloatType> & vector) const
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::scalar(const BasicVector3Template<FloatType> & vector) const
         {
             return this->x * vector.x + this->y * vector.y + this->z * vector.z;
         }
 
-        template<typename FloatType> FloatType BasicVector3Template<FloatType>::triple(const BasicVector3Template<FloatType> & vector2, const BasicVector3Template<FloatType> & vector3) const
+        template<typename FloatType> constexpr FloatType BasicVector3Template<FloatType>::triple(const BasicVector3Template<FloatType> & vector2, const BasicVector3Template<FloatType> & vector3) const
         {
             return this->x * vector2.y *vector3.z
                  + this->y * vector2.z *vector3.x
@@ -201,28 +212,22 @@ namespace geometry
 
         // ================ Vector3<double> inline methods =============== //
 
-        Vector3::Vector3()
+        constexpr Vector3::Vector3()
+            : BasicVector3Template<double>()
         {
-            this->x = ZERO;
-            this->y = ZERO;
-            this->z = ZERO;
         }
 
-        Vector3::Vector3(const Vector3F& vector)
+        constexpr Vector3::Vector3(const Vector3F & vector)
+            : BasicVector3Template<double>(vector.x, vector.y, vector.z)
         {
-            this->x = vector.x;
-            this->y = vector.y;
-            this->z = vector.z;
         }
 
-        Vector3::Vector3(const double x, const double y, const double z)
+        constexpr Vector3::Vector3(const double x, const double y, const double z)
+            : BasicVector3Template<double>(x, y, z)
         {
-            this->x = x;
-            this->y = y;
-            this->z = z;
         }
 
-        void Vector3::setValuesOf(const Vector3F& vector)
+        constexpr void Vector3::setValuesOf(const Vector3F& vector)
         {
             this->x = vector.x;
             this->y = vector.y;
@@ -253,41 +258,41 @@ namespace geometry
             return true;
         }
 
-        Vector3F Vector3::toFloat() const
+        constexpr Vector3F Vector3::toFloat() const
         {
             return Vector3F((float)this->x, (float)this->y, (float)this->z);
         }
 
-        Vector3 Vector3::vector(const Vector3 & vector) const
+        constexpr Vector3 Vector3::vector(const Vector3 & vector) const
         {
             return Vector3(
                 this->y * vector.z - this->z * vector.y,
-                this->x * vector.z - this->z * vector.x,
+                this->z * vector.x - this->x * vector.z,
                 this->x * vector.y - this->y * vector.x
             );
         }
 
-        Vector3 Vector3::operator+(const Vector3 & vector) const
+        constexpr Vector3 Vector3::operator+(const Vector3 & vector) const
         {
             return Vector3(this->x + vector.x, this->y + vector.y, this->z + vector.z);
         }
 
-        Vector3 Vector3::operator-(const Vector3 & vector) const
+        constexpr Vector3 Vector3::operator-(const Vector3 & vector) const
         {
             return Vector3(this->x - vector.x, this->y - vector.y, this->z - vector.z);
         }
 
-        Vector3 Vector3::operator*(const double value) const
+        constexpr Vector3 Vector3::operator*(const double value) const
         {
             return Vector3(this->x * value, this->y * value, this->z * value);
         }
 
-        Vector3 Vector3::operator/(const double value) const
+        constexpr Vector3 Vector3::operator/(const double value) const
         {
             return Vector3(this->x / value, this->y / value, this->z / value);
         }
 
-        Vector3 & Vector3::operator+=(const Vector3 & vector)
+        constexpr Vector3 & Vector3::operator+=(const Vector3 & vector)
         {
             this->x += vector.x;
             this->y += vector.y;
@@ -296,7 +301,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector3 & Vector3::operator-=(const Vector3 & vector)
+        constexpr Vector3 & Vector3::operator-=(const Vector3 & vector)
         {
             this->x -= vector.x;
             this->y -= vector.y;
@@ -305,7 +310,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector3 & Vector3::operator*=(const double value)
+        constexpr Vector3 & Vector3::operator*=(const double value)
         {
             this->x *= value;
             this->y *= value;
@@ -314,10 +319,10 @@ namespace geometry
             return (*this);
         }
 
-        Vector3 & Vector3::operator*=(const Vector3 & vector)
+        constexpr Vector3 & Vector3::operator*=(const Vector3 & vector)
         {
             double x = this->y * vector.z - this->z * vector.y;
-            double y = this->x * vector.z - this->z * vector.x;
+            double y = this->z * vector.x - this->x * vector.z;
             double z = this->x * vector.y - this->y * vector.x;
 
             this->x = x;
@@ -327,7 +332,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector3 & Vector3::operator/=(const double value)
+        constexpr Vector3 & Vector3::operator/=(const double value)
         {
             this->x /= value;
             this->y /= value;
@@ -336,32 +341,26 @@ namespace geometry
             return (*this);
         }
 
-        inline Vector3 operator*(const double value, const Vector3 & vector)
+        constexpr Vector3 operator*(const double value, const Vector3 & vector)
         {
             return Vector3(vector.x * value, vector.y * value, vector.z * value);
         }
 
         // ================ Vector3<float> inline methods ================ //
 
-        Vector3F::Vector3F()
+        constexpr Vector3F::Vector3F()
+            : BasicVector3Template<float>()
         {
-            this->x = ZERO;
-            this->y = ZERO;
-            this->z = ZERO;
         }
 
-        Vector3F::Vector3F(const Vector3 & vector)
+        constexpr Vector3F::Vector3F(const Vector3 & vector)
+            : BasicVector3Template<float>((float)vector.x, (float)vector.y, (float)vector.z)
         {
-            this->x = (float)vector.x;
-            this->y = (float)vector.y;
-            this->z = (float)vector.z;
         }
 
-        Vector3F::Vector3F(const float x, const float y, const float z)
+        constexpr Vector3F::Vector3F(const float x, const float y, const float z)
+            : BasicVector3Template<float>(x, y, z)
         {
-            this->x = x;
-            this->y = y;
-            this->z = z;
         }
 
         float Vector3F::module() const
@@ -388,48 +387,48 @@ namespace geometry
             return true;
         }
 
-        void Vector3F::setValuesOf(const Vector3 & vector)
+        constexpr void Vector3F::setValuesOf(const Vector3 & vector)
         {
             this->x = (float)vector.x;
             this->y = (float)vector.y;
             this->z = (float)vector.z;
         }
 
-        Vector3 Vector3F::toDouble() const
+        constexpr Vector3 Vector3F::toDouble() const
         {
             return Vector3(this->x, this->y, this->z);
         }
 
-        Vector3F Vector3F::vector(const Vector3F& vector) const
+        constexpr Vector3F Vector3F::vector(const Vector3F& vector) const
         {
             return Vector3F(
                 this->y * vector.z - this->z * vector.y,
-                this->x * vector.z - this->z * vector.x,
+                this->z * vector.x - this->x * vector.z,
                 this->x * vector.y - this->y * vector.x
             );
         }
 
-        Vector3F Vector3F::operator+(const Vector3F & vector) const
+        constexpr Vector3F Vector3F::operator+(const Vector3F & vector) const
         {
             return Vector3F(this->x + vector.x, this->y + vector.y, this->z + vector.z);
         }
 
-        Vector3F Vector3F::operator-(const Vector3F & vector) const
+        constexpr Vector3F Vector3F::operator-(const Vector3F & vector) const
         {
             return Vector3F(this->x - vector.x, this->y - vector.y, this->z - vector.z);
         }
 
-        Vector3F Vector3F::operator*(const float value) const
+        constexpr Vector3F Vector3F::operator*(const float value) const
         {
             return Vector3F(this->x * value, this->y * value, this->z * value);
         }
 
-        Vector3F Vector3F::operator/(const float value) const
+        constexpr Vector3F Vector3F::operator/(const float value) const
         {
             return Vector3F(this->x / value, this->y / value, this->z / value);
         }
 
-        Vector3F & Vector3F::operator+=(const Vector3F & vector)
+        constexpr Vector3F & Vector3F::operator+=(const Vector3F & vector)
         {
             this->x += vector.x;
             this->y += vector.y;
@@ -438,7 +437,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector3F & Vector3F::operator-=(const Vector3F & vector)
+        constexpr Vector3F & Vector3F::operator-=(const Vector3F & vector)
         {
             this->x -= vector.x;
             this->y -= vector.y;
@@ -447,7 +446,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector3F & Vector3F::operator*=(const float value)
+        constexpr Vector3F & Vector3F::operator*=(const float value)
         {
             this->x *= value;
             this->y *= value;
@@ -456,10 +455,10 @@ namespace geometry
             return (*this);
         }
 
-        Vector3F & Vector3F::operator*=(const Vector3F& vector)
+        constexpr Vector3F & Vector3F::operator*=(const Vector3F& vector)
         {
             float x = this->y * vector.z - this->z * vector.y;
-            float y = this->x * vector.z - this->z * vector.x;
+            float y = this->z * vector.x - this->x * vector.z;
             float z = this->x * vector.y - this->y * vector.x;
 
             this->x = x;
@@ -469,7 +468,7 @@ namespace geometry
             return (*this);
         }
 
-        Vector3F & Vector3F::operator/=(const float value)
+        constexpr Vector3F & Vector3F::operator/=(const float value)
         {
             this->x /= value;
             this->y /= value;
@@ -478,12 +477,12 @@ namespace geometry
             return (*this);
         }
 
-        inline Vector3F operator*(const float value, const Vector3F & vector)
+        constexpr Vector3F operator*(const float value, const Vector3F & vector)
         {
             return Vector3F(vector.x * value, vector.y * value, vector.z * value);
         }
 
-        inline Vector3F operator*(const double value, const Vector3F & vector)
+        constexpr Vector3F operator*(const double value, const Vector3F & vector)
         {
             return Vector3F((float)(vector.x * value), (float)(vector.y * value), (float)(vector.z * value));
         }
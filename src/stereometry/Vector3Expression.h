@@ -0,0 +1,349 @@
+/*
+ * Copyright 2020-2021 Andrey Pokidov <andrey.pokidov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _GEOMETRY_STEREOMETRY_VECTOR3_EXPRESSION_H_
+#define _GEOMETRY_STEREOMETRY_VECTOR3_EXPRESSION_H_
+
+#include <stddef.h>
+#include <math.h>
+
+#include "Vector3.h"
+
+// Opt-in expression templates for the vector arithmetic. An expression is
+// started with expression() and is evaluated component-wise in one pass
+// without intermediate vectors:
+//
+//     Vector3F result = evaluate(expression(a) * s + b - c);
+//
+// The same expressions work over structure-of-arrays storage, where the
+// whole chain becomes a single loop the compiler can vectorize:
+//
+//     assign(target, expression(a) * s + b - c, count);
+//
+// The terms keep references to the vectors and arrays, so an expression
+// must not outlive the operands it was built from.
+
+namespace geometry
+{
+    namespace stereometry
+    {
+        // ================ Structure of arrays storage ================= //
+
+        // Non-owning view of vectors stored as three separate component arrays
+        template<typename FloatType> class Vector3Array
+        {
+        public:
+            FloatType * x;
+            FloatType * y;
+            FloatType * z;
+
+            Vector3Array() : x(0), y(0), z(0)
+            {
+            }
+
+            Vector3Array(FloatType * x, FloatType * y, FloatType * z) : x(x), y(y), z(z)
+            {
+            }
+        };
+
+        template<typename FloatType> struct Vector3Of;
+
+        template<> struct Vector3Of<float>
+        {
+            typedef Vector3F Type;
+        };
+
+        template<> struct Vector3Of<double>
+        {
+            typedef Vector3 Type;
+        };
+
+        // ===================== Expression nodes ====================== //
+
+        // Every node gives the components of the i-th vector of the
+        // expression, a single vector term ignores the index.
+        template<class ExpressionType> class Vector3Expression
+        {
+        public:
+            inline const ExpressionType & get() const
+            {
+                return static_cast<const ExpressionType &>(*this);
+            }
+        };
+
+        template<typename FloatType> class Vector3Term : public Vector3Expression<Vector3Term<FloatType> >
+        {
+        public:
+            typedef FloatType Float;
+
+            explicit Vector3Term(const BasicVector3Template<FloatType> & vector) : vector(vector)
+            {
+            }
+
+            inline FloatType x(const size_t) const { return this->vector.x; }
+            inline FloatType y(const size_t) const { return this->vector.y; }
+            inline FloatType z(const size_t) const { return this->vector.z; }
+
+        private:
+            const BasicVector3Template<FloatType> & vector;
+        };
+
+        template<typename FloatType> class Vector3ArrayTerm : public Vector3Expression<Vector3ArrayTerm<FloatType> >
+        {
+        public:
+            typedef FloatType Float;
+
+            explicit Vector3ArrayTerm(const Vector3Array<FloatType> & array) : xs(array.x), ys(array.y), zs(array.z)
+            {
+            }
+
+            inline FloatType x(const size_t index) const { return this->xs[index]; }
+            inline FloatType y(const size_t index) const { return this->ys[index]; }
+            inline FloatType z(const size_t index) const { return this->zs[index]; }
+
+        private:
+            const FloatType * xs;
+            const FloatType * ys;
+            const FloatType * zs;
+        };
+
+        template<class Left, class Right> class Vector3Sum : public Vector3Expression<Vector3Sum<Left, Right> >
+        {
+        public:
+            typedef typename Left::Float Float;
+
+            Vector3Sum(const Left & left, const Right & right) : left(left), right(right)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->left.x(index) + this->right.x(index); }
+            inline Float y(const size_t index) const { return this->left.y(index) + this->right.y(index); }
+            inline Float z(const size_t index) const { return this->left.z(index) + this->right.z(index); }
+
+        private:
+            const Left left;
+            const Right right;
+        };
+
+        template<class Left, class Right> class Vector3Difference : public Vector3Expression<Vector3Difference<Left, Right> >
+        {
+        public:
+            typedef typename Left::Float Float;
+
+            Vector3Difference(const Left & left, const Right & right) : left(left), right(right)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->left.x(index) - this->right.x(index); }
+            inline Float y(const size_t index) const { return this->left.y(index) - this->right.y(index); }
+            inline Float z(const size_t index) const { return this->left.z(index) - this->right.z(index); }
+
+        private:
+            const Left left;
+            const Right right;
+        };
+
+        template<class Operand> class Vector3Scaled : public Vector3Expression<Vector3Scaled<Operand> >
+        {
+        public:
+            typedef typename Operand::Float Float;
+
+            Vector3Scaled(const Operand & operand, const Float factor) : operand(operand), factor(factor)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->operand.x(index) * this->factor; }
+            inline Float y(const size_t index) const { return this->operand.y(index) * this->factor; }
+            inline Float z(const size_t index) const { return this->operand.z(index) * this->factor; }
+
+        private:
+            const Operand operand;
+            const Float factor;
+        };
+
+        // The vector (cross) product. Components of the operands are read
+        // twice, so it is cheapest when the operands are terms or short chains.
+        template<class Left, class Right> class Vector3Product : public Vector3Expression<Vector3Product<Left, Right> >
+        {
+        public:
+            typedef typename Left::Float Float;
+
+            Vector3Product(const Left & left, const Right & right) : left(left), right(right)
+            {
+            }
+
+            inline Float x(const size_t index) const { return this->left.y(index) * this->right.z(index) - this->left.z(index) * this->right.y(index); }
+            inline Float y(const size_t index) const { return this->left.z(index) * this->right.x(index) - this->left.x(index) * this->right.z(index); }
+            inline Float z(const size_t index) const { return this->left.x(index) * this->right.y(index) - this->left.y(index) * this->right.x(index); }
+
+        private:
+            const Left left;
+            const Right right;
+        };
+
+        // ========================= Builders ========================== //
+
+        template<typename FloatType> inline Vector3Term<FloatType> expression(const BasicVector3Template<FloatType> & vector)
+        {
+            return Vector3Term<FloatType>(vector);
+        }
+
+        template<typename FloatType> inline Vector3ArrayTerm<FloatType> expression(const Vector3Array<FloatType> & array)
+        {
+            return Vector3ArrayTerm<FloatType>(array);
+        }
+
+        template<class Left, class Right> inline Vector3Sum<Left, Right> operator+(const Vector3Expression<Left> & left, const Vector3Expression<Right> & right)
+        {
+            return Vector3Sum<Left, Right>(left.get(), right.get());
+        }
+
+        template<class Left, typename FloatType> inline Vector3Sum<Left, Vector3Term<FloatType> > operator+(const Vector3Expression<Left> & left, const BasicVector3Template<FloatType> & right)
+        {
+            return Vector3Sum<Left, Vector3Term<FloatType> >(left.get(), Vector3Term<FloatType>(right));
+        }
+
+        template<typename FloatType, class Right> inline Vector3Sum<Vector3Term<FloatType>, Right> operator+(const BasicVector3Template<FloatType> & left, const Vector3Expression<Right> & right)
+        {
+            return Vector3Sum<Vector3Term<FloatType>, Right>(Vector3Term<FloatType>(left), right.get());
+        }
+
+        template<class Left, class Right> inline Vector3Difference<Left, Right> operator-(const Vector3Expression<Left> & left, const Vector3Expression<Right> & right)
+        {
+            return Vector3Difference<Left, Right>(left.get(), right.get());
+        }
+
+        template<class Left, typename FloatType> inline Vector3Difference<Left, Vector3Term<FloatType> > operator-(const Vector3Expression<Left> & left, const BasicVector3Template<FloatType> & right)
+        {
+            return Vector3Difference<Left, Vector3Term<FloatType> >(left.get(), Vector3Term<FloatType>(right));
+        }
+
+        template<typename FloatType, class Right> inline Vector3Difference<Vector3Term<FloatType>, Right> operator-(const BasicVector3Template<FloatType> & left, const Vector3Expression<Right> & right)
+        {
+            return Vector3Difference<Vector3Term<FloatType>, Right>(Vector3Term<FloatType>(left), right.get());
+        }
+
+        template<class Operand> inline Vector3Scaled<Operand> operator*(const Vector3Expression<Operand> & operand, const typename Operand::Float factor)
+        {
+            return Vector3Scaled<Operand>(operand.get(), factor);
+        }
+
+        template<class Operand> inline Vector3Scaled<Operand> operator*(const typename Operand::Float factor, const Vector3Expression<Operand> & operand)
+        {
+            return Vector3Scaled<Operand>(operand.get(), factor);
+        }
+
+        template<class Operand> inline Vector3Scaled<Operand> operator/(const Vector3Expression<Operand> & operand, const typename Operand::Float divisor)
+        {
+            return Vector3Scaled<Operand>(operand.get(), 1 / divisor);
+        }
+
+        template<class Operand> inline Vector3Scaled<Operand> operator-(const Vector3Expression<Operand> & operand)
+        {
+            return Vector3Scaled<Operand>(operand.get(), -1);
+        }
+
+        template<class Left, class Right> inline Vector3Product<Left, Right> cross(const Vector3Expression<Left> & left, const Vector3Expression<Right> & right)
+        {
+            return Vector3Product<Left, Right>(left.get(), right.get());
+        }
+
+        // ================ Evaluation of single vectors =============== //
+
+        template<class ExpressionType> inline typename Vector3Of<typename ExpressionType::Float>::Type evaluate(const Vector3Expression<ExpressionType> & expression)
+        {
+            const ExpressionType & value = expression.get();
+            return typename Vector3Of<typename ExpressionType::Float>::Type(value.x(0), value.y(0), value.z(0));
+        }
+
+        template<typename FloatType, class ExpressionType> inline void assign(BasicVector3Template<FloatType> & target, const Vector3Expression<ExpressionType> & expression)
+        {
+            const ExpressionType & value = expression.get();
+
+            // Computed before the assignment since the target may be an operand
+            const FloatType x = value.x(0);
+            const FloatType y = value.y(0);
+            const FloatType z = value.z(0);
+
+            target.setValues(x, y, z);
+        }
+
+        template<class Left, class Right> inline typename Left::Float scalar(const Vector3Expression<Left> & left, const Vector3Expression<Right> & right)
+        {
+            return left.get().x(0) * right.get().x(0) + left.get().y(0) * right.get().y(0) + left.get().z(0) * right.get().z(0);
+        }
+
+        template<class ExpressionType> inline typename ExpressionType::Float module(const Vector3Expression<ExpressionType> & expression)
+        {
+            const ExpressionType & value = expression.get();
+
+            const typename ExpressionType::Float x = value.x(0);
+            const typename ExpressionType::Float y = value.y(0);
+            const typename ExpressionType::Float z = value.z(0);
+
+            return sqrt(x * x + y * y + z * z);
+        }
+
+        // =================== Evaluation over arrays ================== //
+
+        // The target may be one of the operands: each vector is read only
+        // at its own index before it is written.
+        template<typename FloatType, class ExpressionType> inline void assign(const Vector3Array<FloatType> & target, const Vector3Expression<ExpressionType> & expression, const size_t count)
+        {
+            const ExpressionType & value = expression.get();
+
+            FloatType * const x = target.x;
+            FloatType * const y = target.y;
+            FloatType * const z = target.z;
+
+            for (size_t i = 0; i < count; i++) {
+                const FloatType vx = value.x(i);
+                const FloatType vy = value.y(i);
+                const FloatType vz = value.z(i);
+
+                x[i] = vx;
+                y[i] = vy;
+                z[i] = vz;
+            }
+        }
+
+        template<typename FloatType, class Left, class Right> inline void scalar(FloatType * target, const Vector3Expression<Left> & left, const Vector3Expression<Right> & right, const size_t count)
+        {
+            const Left & a = left.get();
+            const Right & b = right.get();
+
+            for (size_t i = 0; i < count; i++) {
+                target[i] = a.x(i) * b.x(i) + a.y(i) * b.y(i) + a.z(i) * b.z(i);
+            }
+        }
+
+        template<typename FloatType, class ExpressionType> inline void module(FloatType * target, const Vector3Expression<ExpressionType> & expression, const size_t count)
+        {
+            const ExpressionType & value = expression.get();
+
+            for (size_t i = 0; i < count; i++) {
+                const FloatType x = value.x(i);
+                const FloatType y = value.y(i);
+                const FloatType z = value.z(i);
+
+                target[i] = sqrt(x * x + y * y + z * z);
+            }
+        }
+    } /* namespace stereometry */
+} /* namespace geometry */
+
+#endif /* _GEOMETRY_STEREOMETRY_VECTOR3_EXPRESSION_H_ */